@@ -41,6 +41,8 @@ void fmpz_poly_ramanujan_tau(fmpz_poly_t res, long n);
 
 void fmpz_ramanujan_tau(fmpz_t res, const fmpz_t n);
 
+void ramanujan_tau_nmod_vec(mp_ptr res, long n, nmod_t mod);
+
 void fmpz_divisors(fmpz_poly_t res, const fmpz_t n);
 
 void fmpz_divisor_sigma(fmpz_t res, const fmpz_t n, ulong k);
@@ -71,6 +73,40 @@ void stirling_number_1u_mat(fmpz_mat_t mat);
 void stirling_number_1_mat(fmpz_mat_t mat);
 void stirling_number_2_mat(fmpz_mat_t mat);
 
+void stirling_number_1u_nmod_vec(mp_ptr row, long n, long klen, nmod_t mod);
+void stirling_number_1_nmod_vec(mp_ptr row, long n, long klen, nmod_t mod);
+void stirling_number_2_nmod_vec(mp_ptr row, long n, long klen, nmod_t mod);
+
+void stirling_number_1u_nmod_mat(nmod_mat_t mat);
+void stirling_number_1_nmod_mat(nmod_mat_t mat);
+void stirling_number_2_nmod_mat(nmod_mat_t mat);
+
+void stirling_number_1u_vec_multi_mod(fmpz * row, long n, long klen);
+void stirling_number_1_vec_multi_mod(fmpz * row, long n, long klen);
+void stirling_number_2_vec_multi_mod(fmpz * row, long n, long klen);
+
+/* Length below which rising factorials modulo a word are expanded directly */
+#define STIRLING_NMOD_BASECASE 16
+
+/* Smallest n for which stirling_number_2_vec uses the multimodular
+   algorithm */
+#define STIRLING_2_VEC_MULTI_MOD_CUTOFF 2000
+
+/* Smallest dimension for which Stirling matrices are computed in parallel,
+   and number of tiles per thread along each side */
+#define STIRLING_MAT_PARALLEL_CUTOFF 200
+#define STIRLING_MAT_PARALLEL_TILES 4
+
+/* Multimodular evaluation of integer sequences ******************************/
+
+typedef void (*arith_vec_stream_func)(const fmpz * vec, long start,
+                                                    long len, void * data);
+
+void _arith_vec_multi_mod_stream(long len, const long * bits,
+    void (*vec_mod_p)(mp_ptr, long, nmod_t, void *), void * mod_data,
+    int sign, long block,
+    void (*func)(fmpz *, long, long, void *), void * data);
+
 /* Bell numbers **************************************************************/
 
 #if FLINT64
@@ -95,6 +131,9 @@ void bell_number_vec_recursive(fmpz * b, long n);
 
 void bell_number_vec_multi_mod(fmpz * b, long n);
 
+void bell_number_vec_multi_mod_stream(long n, long block,
+                                    arith_vec_stream_func func, void * data);
+
 mp_limb_t bell_number_nmod(ulong n, nmod_t mod);
 
 void bell_number_nmod_vec(mp_ptr b, long n, nmod_t mod);
@@ -130,6 +169,9 @@ double euler_number_size(ulong n);
 
 void euler_number_vec(fmpz * res, long n);
 
+void euler_number_vec_multi_mod_stream(long n, long block,
+                                    arith_vec_stream_func func, void * data);
+
 void _euler_number_zeta(fmpz_t res, ulong n);
 
 void euler_number(fmpz_t res, ulong n);
@@ -170,6 +212,9 @@ void _bernoulli_number_zeta(fmpz_t num, fmpz_t den, ulong n);
 
 void _bernoulli_number_vec_multi_mod(fmpz * num, fmpz * den, long n);
 
+void bernoulli_number_vec_multi_mod_stream(long n, long block,
+                                    arith_vec_stream_func func, void * data);
+
 void _bernoulli_number_vec_recursive(fmpz * num, fmpz * den, long n);
 
 void _bernoulli_number_vec_zeta(fmpz * num, fmpz * den, long n);
@@ -181,6 +226,11 @@ void _cyclotomic_polynomial(fmpz * a, ulong n, mp_ptr factors,
 
 void cyclotomic_polynomial(fmpz_poly_t poly, ulong n);
 
+void cyclotomic_polynomial_evaluate_fmpz(fmpz_t res, ulong n, const fmpz_t a);
+
+mp_limb_t cyclotomic_polynomial_evaluate_nmod(ulong n, mp_limb_t a,
+                                                            nmod_t mod);
+
 void _cyclotomic_cos_polynomial(fmpz * coeffs, long d, ulong n);
 
 void cyclotomic_cos_polynomial(fmpz_poly_t poly, ulong n);
@@ -238,6 +288,9 @@ void trig_prod_init(trig_prod_t sum)
     sum->sqrt_q = 1;
 }
 
+void _dedekind_cosine_sum_factored(trig_prod_t prod, mp_limb_t k, mp_limb_t n,
+                                                    const n_factor_t * fac);
+
 void dedekind_cosine_sum_factored(trig_prod_t prod, mp_limb_t k, mp_limb_t n);
 
 /* Number of partitions ******************************************************/
@@ -23,88 +23,72 @@
 
 ******************************************************************************/
 
+#include <stdlib.h>
 #include <mpir.h>
 #include "flint.h"
 #include "fmpz.h"
 #include "fmpz_vec.h"
-#include "ulong_extras.h"
-#include "nmod_poly.h"
-#include "nmod_vec.h"
 #include "arith.h"
 
-#define CRT_MAX_RESOLUTION 16
+typedef struct
+{
+    fmpz * res;
+    arith_vec_stream_func func;
+    void * data;
+}
+_bell_stream_struct;
 
-void
-bell_number_vec_multi_mod(fmpz * res, long n)
+static void
+_bell_number_vec_mod_p(mp_ptr res, long n, nmod_t mod, void * data)
+{
+    bell_number_nmod_vec(res, n, mod);
+}
+
+static void
+_bell_number_vec_output(fmpz * vec, long start, long len, void * data)
+{
+    _bell_stream_struct * s = (_bell_stream_struct *) data;
+
+    if (s->res != NULL)
+        _fmpz_vec_swap(s->res + start, vec, len);
+    else
+        s->func(vec, start, len, s->data);
+}
+
+static void
+_bell_number_vec_multi_mod(fmpz * res, long n, long block,
+                                    arith_vec_stream_func func, void * data)
 {
-    fmpz_comb_t comb[CRT_MAX_RESOLUTION];
-    fmpz_comb_temp_t temp[CRT_MAX_RESOLUTION];
-    mp_ptr primes, residues;
-    mp_ptr * polys;
-    nmod_t mod;
-    long i, j, k, size, prime_bits, num_primes, num_primes_k, resolution;
+    _bell_stream_struct s;
+    long * bits;
+    long k;
 
     if (n < 1)
         return;
 
-    resolution = FLINT_MAX(1, FLINT_MIN(CRT_MAX_RESOLUTION, n / 16));
-
-    size = bell_number_size(n);
-    prime_bits = FLINT_BITS - 1;
-    num_primes = (size + prime_bits - 1) / prime_bits;
-
-    primes = malloc(num_primes * sizeof(mp_limb_t));
-    residues = malloc(num_primes * sizeof(mp_limb_t));
-    polys = malloc(num_primes * sizeof(mp_ptr));
-
-    /* Compute Bell numbers mod p */
-    primes[0] = n_nextprime(1UL<<prime_bits, 0);
-    for (k = 1; k < num_primes; k++)
-        primes[k] = n_nextprime(primes[k-1], 0);
-
-    for (k = 0; k < num_primes; k++)
-    {
-        /* printf("prime %ld of %ld\n", k, num_primes); */
-        polys[k] = _nmod_vec_init(n);
-        nmod_init(&mod, primes[k]);
-        bell_number_nmod_vec(polys[k], n, mod);
-    }
-
-    /* Init CRT comb */
-    for (i = 0; i < resolution; i++)
-    {
-        fmpz_comb_init(comb[i], primes, num_primes * (i + 1) / resolution);
-        fmpz_comb_temp_init(temp[i], comb[i]);
-    }
-
-    /* Reconstruction */
+    bits = malloc(n * sizeof(long));
     for (k = 0; k < n; k++)
-    {
-        size = bell_number_size(k);
-        /* Use only as large a comb as needed */
-        num_primes_k = (size + prime_bits - 1) / prime_bits;
-        for (i = 0; i < resolution; i++)
-        {
-            if (comb[i]->num_primes >= num_primes_k)
-                break;
-        }
-        num_primes_k = comb[i]->num_primes;
-        for (j = 0; j < num_primes_k; j++)
-            residues[j] = polys[j][k];
-        fmpz_multi_CRT_ui_unsigned(res + k, residues, comb[i], temp[i]);
-    }
-
-    /* Cleanup */
-    for (k = 0; k < num_primes; k++)
-        _nmod_vec_clear(polys[k]);
-
-    for (i = 0; i < resolution; i++)
-    {
-        fmpz_comb_temp_clear(temp[i]);
-        fmpz_comb_clear(comb[i]);
-    }
-
-    free(primes);
-    free(residues);
-    free(polys);
+        bits[k] = bell_number_size(k);
+
+    s.res = res;
+    s.func = func;
+    s.data = data;
+
+    _arith_vec_multi_mod_stream(n, bits, _bell_number_vec_mod_p, NULL, 0,
+                                    block, _bell_number_vec_output, &s);
+
+    free(bits);
+}
+
+void
+bell_number_vec_multi_mod(fmpz * res, long n)
+{
+    _bell_number_vec_multi_mod(res, n, n, NULL, NULL);
+}
+
+void
+bell_number_vec_multi_mod_stream(long n, long block,
+                                    arith_vec_stream_func func, void * data)
+{
+    _bell_number_vec_multi_mod(NULL, n, block, func, data);
 }
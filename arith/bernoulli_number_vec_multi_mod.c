@@ -24,6 +24,7 @@
 ******************************************************************************/
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <math.h>
 #include "flint.h"
 #include "fmpz.h"
@@ -65,92 +66,101 @@ __bernoulli_number_vec_mod_p(mp_ptr res, mp_ptr tmp, const fmpz * den,
     }
 }
 
-#define CRT_MAX_RESOLUTION 16
+typedef struct
+{
+    fmpz * num;
+    long n;
+    fmpz * buf;
+    arith_vec_stream_func func;
+    void * data;
+}
+_bernoulli_stream_struct;
 
-void _bernoulli_number_vec_multi_mod(fmpz * num, fmpz * den, long n)
+static void
+_bernoulli_number_vec_mod_p(mp_ptr res, long m, nmod_t mod, void * data)
+{
+    mp_ptr tmp = _nmod_vec_init(m);
+    __bernoulli_number_vec_mod_p(res, tmp, (const fmpz *) data, m, mod);
+    _nmod_vec_clear(tmp);
+}
+
+/* Receives the numerators of B_{2k} for start <= k < start + len */
+static void
+_bernoulli_number_vec_output(fmpz * vec, long start, long len, void * data)
+{
+    _bernoulli_stream_struct * s = (_bernoulli_stream_struct *) data;
+    fmpz * out;
+    long k, len2;
+
+    out = (s->num != NULL) ? s->num + 2 * start : s->buf;
+    len2 = FLINT_MIN(s->n, 2 * (start + len)) - 2 * start;
+
+    for (k = 0; k < len2; k++)
+    {
+        if (k % 2 == 0)
+            fmpz_swap(out + k, vec + k / 2);
+        else if (start == 0 && k == 1)
+            fmpz_set_si(out + k, -1L);
+        else
+            fmpz_zero(out + k);
+    }
+
+    if (s->num == NULL)
+        s->func(out, 2 * start, len2, s->data);
+}
+
+static void
+__bernoulli_number_vec_multi_mod(fmpz * num, fmpz * den, long n, long block,
+                                    arith_vec_stream_func func, void * data)
 {
-    fmpz_comb_t comb[CRT_MAX_RESOLUTION];
-    fmpz_comb_temp_t temp[CRT_MAX_RESOLUTION];
-    mp_limb_t * primes;
-    mp_limb_t * residues;
-    mp_ptr * polys;
-    mp_ptr temppoly;
-    nmod_t mod;
-    long i, j, k, m, size, prime_bits, num_primes, num_primes_k, resolution;
+    _bernoulli_stream_struct s;
+    long * bits;
+    long k, m;
 
     if (n < 1)
         return;
 
-    for (i = 0; i < n; i++)
-        bernoulli_number_denom(den + i, i);
+    for (k = 0; k < n; k++)
+        bernoulli_number_denom(den + k, k);
 
     /* Number of nonzero entries (apart from B_1) */
     m = (n + 1) / 2;
-    resolution = FLINT_MAX(1, FLINT_MIN(CRT_MAX_RESOLUTION, m / 16));
+    block = FLINT_MAX(1, FLINT_MIN(block / 2, m));
 
     /* Note that the denominators must be accounted for */
-    size = bernoulli_number_size(n) + _fmpz_vec_max_bits(den, n) + 2;
-
-    prime_bits = FLINT_BITS - 1;
-    num_primes = (size + prime_bits - 1) / prime_bits;
-
-    primes = malloc(num_primes * sizeof(mp_limb_t));
-    residues = malloc(num_primes * sizeof(mp_limb_t));
-    polys = malloc(num_primes * sizeof(mp_ptr));
-
-    /* Compute Bernoulli numbers mod p */
-    primes[0] = n_nextprime(1UL<<prime_bits, 0);
-    for (k = 1; k < num_primes; k++)
-        primes[k] = n_nextprime(primes[k-1], 0);
-    temppoly = _nmod_vec_init(m);
-    for (k = 0; k < num_primes; k++)
-    {
-        polys[k] = _nmod_vec_init(m);
-        nmod_init(&mod, primes[k]);
-        __bernoulli_number_vec_mod_p(polys[k], temppoly, den, m, mod);
-    }
-
-    /* Init CRT comb */
-    for (i = 0; i < resolution; i++)
-    {
-        fmpz_comb_init(comb[i], primes, num_primes * (i + 1) / resolution);
-        fmpz_comb_temp_init(temp[i], comb[i]);
-    }
+    bits = malloc(m * sizeof(long));
+    for (k = 0; k < m; k++)
+        bits[k] = bernoulli_number_size(2 * k) + fmpz_bits(den + 2 * k) + 2;
+
+    s.num = num;
+    s.n = n;
+    s.buf = (num == NULL) ? _fmpz_vec_init(2 * block) : NULL;
+    s.func = func;
+    s.data = data;
+
+    _arith_vec_multi_mod_stream(m, bits, _bernoulli_number_vec_mod_p, den, 1,
+                                    block, _bernoulli_number_vec_output, &s);
+
+    if (num == NULL)
+        _fmpz_vec_clear(s.buf, 2 * block);
+    free(bits);
+}
 
-    /* Trivial entries */
-    if (n > 1)
-        fmpz_set_si(num + 1, -1L);
-    for (k = 3; k < n; k += 2)
-        fmpz_zero(num + k);
+void _bernoulli_number_vec_multi_mod(fmpz * num, fmpz * den, long n)
+{
+    __bernoulli_number_vec_multi_mod(num, den, n, n, NULL, NULL);
+}
 
-    /* Reconstruction */
-    for (k = 0; k < n; k += 2)
-    {
-        size = bernoulli_number_size(k) + fmpz_bits(den + k) + 2;
-        /* Use only as large a comb as needed */
-        num_primes_k = (size + prime_bits - 1) / prime_bits;
-        for (i = 0; i < resolution; i++)
-        {
-            if (comb[i]->num_primes >= num_primes_k)
-                break;
-        }
-        num_primes_k = comb[i]->num_primes;
-        for (j = 0; j < num_primes_k; j++)
-            residues[j] = polys[j][k / 2];
-        fmpz_multi_CRT_ui(num + k, residues, comb[i], temp[i]);
-    }
+void
+bernoulli_number_vec_multi_mod_stream(long n, long block,
+                                    arith_vec_stream_func func, void * data)
+{
+    fmpz * den;
 
-    /* Cleanup */
-    for (k = 0; k < num_primes; k++)
-        _nmod_vec_clear(polys[k]);
-    _nmod_vec_clear(temppoly);
-    for (i = 0; i < resolution; i++)
-    {
-        fmpz_comb_temp_clear(temp[i]);
-        fmpz_comb_clear(comb[i]);
-    }
+    if (n < 1)
+        return;
 
-    free(primes);
-    free(residues);
-    free(polys);
+    den = _fmpz_vec_init(n);
+    __bernoulli_number_vec_multi_mod(NULL, den, n, block, func, data);
+    _fmpz_vec_clear(den, n);
 }
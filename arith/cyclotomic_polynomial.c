@@ -23,6 +23,7 @@
 
 ******************************************************************************/
 
+#include <stdlib.h>
 #include <mpir.h>
 #include "flint.h"
 #include "ulong_extras.h"
@@ -32,6 +33,112 @@
 #include "arith.h"
 
 
+/*
+    Sets (a, D + 1) to the lower half of Phi_n(x) for odd squarefree n with
+    num_factors >= 2 prime factors, using word arithmetic modulo
+    2^FLINT_BITS and b as scratch space of the same length.
+
+    With p the largest prime factor and m = n / p, the factors of the
+    divisors d and dp of n pair up as G_d^{mu(m/d)}, where
+    G_d = (1 - x^{dp}) / (1 - x^d) = 1 + x^d + ... + x^{(p-1)d}. Both
+    multiplication and division by G_d take a single pass.
+
+    Returns 1 if all values computed have absolute value less than
+    2^(FLINT_BITS-3), and 0 otherwise. Each value is the sum of three
+    earlier ones, so in the first case nothing has overflowed and the
+    result is exact.
+*/
+static int
+_cyclotomic_polynomial_ui(mp_ptr a, mp_ptr b, ulong D,
+                                mp_srcptr factors, long num_factors)
+{
+    long i, j, k, e;
+    ulong d, pd, p, lo;
+    mp_limb_t t, r, ovfl;
+    mp_ptr u, v;
+
+    p = factors[num_factors - 1];
+    e = num_factors - 1;
+
+    u = a;
+    v = b;
+    u[0] = 1UL;
+    for (i = 1; i <= D; i++)
+        u[i] = 0UL;
+
+    /* Bitwise or of the absolute values of all results */
+    ovfl = 0UL;
+
+    for (k = 0; k < (1L << e); k++)
+    {
+        int mu;
+
+        mu = (e & 1) ? -1 : 1;
+        d = 1UL;
+        for (j = 0; j < e; j++)
+        {
+            if ((k >> j) & 1)
+            {
+                d *= factors[j];
+                mu = -mu;
+            }
+        }
+
+        /* G_d = 1 modulo x^{D+1} */
+        if (d > D)
+            continue;
+
+        pd = p * d;
+        lo = FLINT_MIN(pd, D + 1);
+
+        for (i = 0; i < d; i++)
+            v[i] = u[i];
+
+        if (mu == 1)
+        {
+            /* v = u G_d: v[i] = u[i] + v[i - d] - u[i - pd] */
+            for (i = d; i < lo; i++)
+            {
+                r = u[i] + v[i - d];
+                ovfl |= r ^ (-(r >> (FLINT_BITS - 1)));
+                v[i] = r;
+            }
+            for ( ; i <= D; i++)
+            {
+                t = u[i] + v[i - d];
+                r = t - u[i - pd];
+                ovfl |= r ^ (-(r >> (FLINT_BITS - 1)));
+                v[i] = r;
+            }
+        }
+        else
+        {
+            /* v = u / G_d: v[i] = u[i] - u[i - d] + v[i - pd] */
+            for (i = d; i < lo; i++)
+            {
+                r = u[i] - u[i - d];
+                ovfl |= r ^ (-(r >> (FLINT_BITS - 1)));
+                v[i] = r;
+            }
+            for ( ; i <= D; i++)
+            {
+                t = u[i] - u[i - d];
+                r = t + v[i - pd];
+                ovfl |= r ^ (-(r >> (FLINT_BITS - 1)));
+                v[i] = r;
+            }
+        }
+
+        MP_PTR_SWAP(u, v);
+    }
+
+    if (u != a)
+        for (i = 0; i <= D; i++)
+            a[i] = u[i];
+
+    return ovfl < (1UL << (FLINT_BITS - 3));
+}
+
 void
 _cyclotomic_polynomial(fmpz * a, ulong n, mp_ptr factors,
                                         long num_factors, ulong phi)
@@ -39,6 +146,7 @@ _cyclotomic_polynomial(fmpz * a, ulong n, mp_ptr factors,
     long i, k;
     int small;
     ulong D;
+    mp_ptr b;
 
     D = phi / 2;
 
@@ -59,15 +167,45 @@ _cyclotomic_polynomial(fmpz * a, ulong n, mp_ptr factors,
         return;
     }
 
-    fmpz_one(a);
-    for (i = 1; i <= D; i++)
-        fmpz_zero(a + i);
-
     /* Coefficients are guaranteed not to overflow an fmpz */
     small = (num_factors == 2) ||                  /* Always +1/0/-1*/
             (n < 10163195L) ||                     /* At most 27 bits */
             (FLINT_BITS == 64 && n < 169828113L);  /* At most 60 bits */
 
+    /*
+        Try word arithmetic first. Unless the coefficients are known to be
+        small, this only succeeds if no intermediate value overflows, in
+        which case the result is exact. Coefficients that do not fit a
+        small fmpz are then set properly.
+    */
+    _fmpz_vec_zero(a, D + 1);
+    b = malloc((D + 1) * sizeof(mp_limb_t));
+
+    if (_cyclotomic_polynomial_ui((mp_ptr) a, b, D, factors, num_factors)
+        || small)
+    {
+        free(b);
+
+        for (i = 0; i <= D; i++)
+        {
+            mp_limb_signed_t c = (mp_limb_signed_t) a[i];
+
+            if (c > COEFF_MAX || c < COEFF_MIN)
+            {
+                a[i] = 0L;
+                fmpz_set_si(a + i, c);
+            }
+        }
+
+        return;
+    }
+
+    free(b);
+
+    /* The entries of a are plain words at this point */
+    for (i = 0; i <= D; i++)
+        a[i] = (i == 0);
+
     /* Iterate over all divisors of n */
     for (k = 0; k < (1L << num_factors); k++)
     {
@@ -86,20 +224,10 @@ _cyclotomic_polynomial(fmpz * a, ulong n, mp_ptr factors,
         }
 
         /* Multiply by (x^d - 1)^{\mu(n/d)} */
-        if (small)
-        {
-            if (mu == 1)
-                for (i = D; i >= d; i--) a[i] -= a[i - d];
-            else
-                for (i = d; i <= D; i++) a[i] += a[i - d];
-        }
+        if (mu == 1)
+            for (i = D; i >= d; i--) fmpz_sub(a + i, a + i, a + i - d);
         else
-        {
-            if (mu == 1)
-                for (i = D; i >= d; i--) fmpz_sub(a + i, a + i, a + i - d);
-            else
-                for (i = d; i <= D; i++) fmpz_add(a + i, a + i, a + i - d);
-        }
+            for (i = d; i <= D; i++) fmpz_add(a + i, a + i, a + i - d);
     }
 }
 
@@ -0,0 +1,111 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <mpir.h>
+#include "flint.h"
+#include "ulong_extras.h"
+#include "fmpz.h"
+#include "arith.h"
+
+void
+cyclotomic_polynomial_evaluate_fmpz(fmpz_t res, ulong n, const fmpz_t a)
+{
+    n_factor_t factors;
+    fmpz_t b, t, num, den;
+    ulong q, s, d;
+    long i, k;
+    int mu;
+
+    if (n == 0)
+    {
+        fmpz_one(res);
+        return;
+    }
+
+    /* Phi_n(x) = Phi_q(x^s) where q is the radical of n */
+    n_factor_init(&factors);
+    n_factor(&factors, n, 1);
+    q = 1UL;
+    for (i = 0; i < factors.num; i++)
+        q *= factors.p[i];
+    s = n / q;
+
+    fmpz_init(b);
+    fmpz_pow_ui(b, a, s);
+
+    if (fmpz_is_zero(b))
+    {
+        fmpz_set_si(res, (q == 1) ? -1L : 1L);
+    }
+    else if (fmpz_is_one(b))
+    {
+        /* Phi_q(1) = p if q = p is prime */
+        fmpz_set_ui(res, (q == 1) ? 0UL : (factors.num == 1) ? q : 1UL);
+    }
+    else if (fmpz_is_pm1(b))
+    {
+        /* Phi_{2m}(-1) = Phi_m(1) for odd m > 1, and Phi_m(-1) = 1 */
+        if (q <= 2)
+            fmpz_set_si(res, (q == 1) ? -2L : 0L);
+        else if (q % 2 == 0 && factors.num == 2)
+            fmpz_set_ui(res, q / 2);
+        else
+            fmpz_one(res);
+    }
+    else
+    {
+        /* Phi_q(b) = prod_{d | q} (b^d - 1)^{mu(q/d)}, with no zero factors */
+        fmpz_init(t);
+        fmpz_init(num);
+        fmpz_init(den);
+        fmpz_one(num);
+        fmpz_one(den);
+
+        for (k = 0; k < (1L << factors.num); k++)
+        {
+            mu = (factors.num & 1) ? -1 : 1;
+            d = 1UL;
+            for (i = 0; i < factors.num; i++)
+            {
+                if ((k >> i) & 1)
+                {
+                    d *= factors.p[i];
+                    mu = -mu;
+                }
+            }
+
+            fmpz_pow_ui(t, b, d);
+            fmpz_sub_ui(t, t, 1UL);
+
+            if (mu == 1)
+                fmpz_mul(num, num, t);
+            else
+                fmpz_mul(den, den, t);
+        }
+
+        fmpz_divexact(res, num, den);
+
+        fmpz_clear(t);
+        fmpz_clear(num);
+        fmpz_clear(den);
+    }
+
+    fmpz_clear(b);
+}
@@ -0,0 +1,133 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <mpir.h>
+#include "flint.h"
+#include "ulong_extras.h"
+#include "nmod_vec.h"
+#include "arith.h"
+
+/* a^e for a prime modulus, where e may exceed a signed word */
+static mp_limb_t
+_nmod_pow_ui(mp_limb_t a, ulong e, nmod_t mod)
+{
+    if (e == 0)
+        return 1UL;
+
+    return n_powmod2_preinv(a, 1 + (e - 1) % (mod.n - 1), mod.n, mod.ninv);
+}
+
+mp_limb_t
+cyclotomic_polynomial_evaluate_nmod(ulong n, mp_limb_t a, nmod_t mod)
+{
+    n_factor_t factors;
+    mp_limb_t b, t, num, den, v, p;
+    ulong m, q, s, d, pe;
+    long i, k;
+    int mu, is_root;
+
+    p = mod.n;
+
+    if (n == 0)
+        return 1UL;
+
+    /*
+        Write n = m p^e with p not dividing m. Over GF(p),
+        Phi_{m p^e}(x) = Phi_m(x)^{(p - 1) p^{e - 1}} for e >= 1.
+    */
+    n_factor_init(&factors);
+    n_factor(&factors, n, 1);
+
+    m = n;
+    pe = 1UL;
+    q = 1UL;
+    for (i = 0, k = 0; i < factors.num; i++)
+    {
+        if (factors.p[i] == p)
+        {
+            m /= n_pow(p, factors.exp[i]);
+            pe = (p - 1) * n_pow(p, factors.exp[i] - 1);
+        }
+        else
+        {
+            factors.p[k++] = factors.p[i];
+            q *= factors.p[i];
+        }
+    }
+    factors.num = k;
+
+    /* Phi_m(x) = Phi_q(x^s) where q is the radical of m */
+    s = m / q;
+    b = _nmod_pow_ui(a, s, mod);
+
+    if (q == 1)
+    {
+        v = nmod_sub(b, 1UL, mod);
+    }
+    else
+    {
+        /* Phi_q(b) = 0 if and only if b has order exactly q */
+        is_root = (_nmod_pow_ui(b, q, mod) == 1UL);
+        for (i = 0; i < factors.num && is_root; i++)
+            is_root = (_nmod_pow_ui(b, q / factors.p[i], mod) != 1UL);
+
+        if (is_root)
+            return 0UL;
+
+        /*
+            Otherwise the factors b^d - 1 that vanish in
+            prod_{d | q} (x^d - 1)^{mu(q/d)} cancel out. Their zeros
+            at b are simple, so each can be replaced by the derivative
+            d b^(d - 1) of x^d - 1 at b.
+        */
+        num = den = 1UL;
+
+        for (k = 0; k < (1L << factors.num); k++)
+        {
+            mu = (factors.num & 1) ? -1 : 1;
+            d = 1UL;
+            for (i = 0; i < factors.num; i++)
+            {
+                if ((k >> i) & 1)
+                {
+                    d *= factors.p[i];
+                    mu = -mu;
+                }
+            }
+
+            t = _nmod_pow_ui(b, d - 1, mod);
+            if (n_mulmod2_preinv(t, b, mod.n, mod.ninv) == 1UL)
+                t = n_mulmod2_preinv(t, n_mod2_preinv(d, mod.n, mod.ninv),
+                                                        mod.n, mod.ninv);
+            else
+                t = nmod_sub(n_mulmod2_preinv(t, b, mod.n, mod.ninv),
+                                                            1UL, mod);
+
+            if (mu == 1)
+                num = n_mulmod2_preinv(num, t, mod.n, mod.ninv);
+            else
+                den = n_mulmod2_preinv(den, t, mod.n, mod.ninv);
+        }
+
+        v = n_mulmod2_preinv(num, n_invmod(den, mod.n), mod.n, mod.ninv);
+    }
+
+    return _nmod_pow_ui(v, pe, mod);
+}
@@ -24,6 +24,7 @@
 ******************************************************************************/
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <math.h>
 #include "flint.h"
 #include "fmpz.h"
@@ -62,93 +63,92 @@ __euler_number_vec_mod_p(mp_ptr res, mp_ptr tmp, long m, nmod_t mod)
     }
 }
 
-#define CRT_MAX_RESOLUTION 16
+typedef struct
+{
+    fmpz * res;
+    long n;
+    fmpz * buf;
+    arith_vec_stream_func func;
+    void * data;
+}
+_euler_stream_struct;
 
-void __euler_number_vec_multi_mod(fmpz * res, long n)
+static void
+_euler_number_vec_mod_p(mp_ptr res, long m, nmod_t mod, void * data)
 {
-    fmpz_comb_t comb[CRT_MAX_RESOLUTION];
-    fmpz_comb_temp_t temp[CRT_MAX_RESOLUTION];
-    mp_limb_t * primes;
-    mp_limb_t * residues;
-    mp_ptr * polys;
-    mp_ptr temppoly;
-    nmod_t mod;
-    long i, j, k, m, size, prime_bits, num_primes, num_primes_k, resolution;
+    mp_ptr tmp = _nmod_vec_init(m);
+    __euler_number_vec_mod_p(res, tmp, m, mod);
+    _nmod_vec_clear(tmp);
+}
 
-    if (n < 1)
-        return;
+/* Receives |E_{2k}| for start <= k < start + len */
+static void
+_euler_number_vec_output(fmpz * vec, long start, long len, void * data)
+{
+    _euler_stream_struct * s = (_euler_stream_struct *) data;
+    fmpz * out;
+    long k, len2;
 
-    /* Number of nonzero entries */
-    m = (n + 1) / 2;
+    out = (s->res != NULL) ? s->res + 2 * start : s->buf;
+    len2 = FLINT_MIN(s->n, 2 * (start + len)) - 2 * start;
 
-    resolution = FLINT_MAX(1, FLINT_MIN(CRT_MAX_RESOLUTION, m / 16));
+    for (k = 0; k < len2; k++)
+    {
+        if (k % 2)
+            fmpz_zero(out + k);
+        else
+        {
+            fmpz_swap(out + k, vec + k / 2);
+            if ((start + k / 2) % 2)
+                fmpz_neg(out + k, out + k);
+        }
+    }
 
-    size = euler_number_size(n);
-    prime_bits = FLINT_BITS - 1;
-    num_primes = (size + prime_bits - 1) / prime_bits;
+    if (s->res == NULL)
+        s->func(out, 2 * start, len2, s->data);
+}
 
-    primes = malloc(num_primes * sizeof(mp_limb_t));
-    residues = malloc(num_primes * sizeof(mp_limb_t));
-    polys = malloc(num_primes * sizeof(mp_ptr));
+static void
+_euler_number_vec_multi_mod(fmpz * res, long n, long block,
+                                    arith_vec_stream_func func, void * data)
+{
+    _euler_stream_struct s;
+    long * bits;
+    long k, m;
 
-    /* Compute Euler numbers mod p */
-    primes[0] = n_nextprime(1UL<<prime_bits, 0);
-    for (k = 1; k < num_primes; k++)
-        primes[k] = n_nextprime(primes[k-1], 0);
-    temppoly = _nmod_vec_init(m);
-    for (k = 0; k < num_primes; k++)
-    {
-        polys[k] = _nmod_vec_init(m);
-        nmod_init(&mod, primes[k]);
-        __euler_number_vec_mod_p(polys[k], temppoly, m, mod);
-    }
+    if (n < 1)
+        return;
 
-    /* Init CRT comb */
-    for (i = 0; i < resolution; i++)
-    {
-        fmpz_comb_init(comb[i], primes, num_primes * (i + 1) / resolution);
-        fmpz_comb_temp_init(temp[i], comb[i]);
-    }
+    /* Number of nonzero entries */
+    m = (n + 1) / 2;
+    block = FLINT_MAX(1, FLINT_MIN(block / 2, m));
 
-    /* Trivial entries */
-    for (k = 1; k < n; k += 2)
-        fmpz_zero(res + k);
+    bits = malloc(m * sizeof(long));
+    for (k = 0; k < m; k++)
+        bits[k] = euler_number_size(2 * k);
 
-    /* Reconstruction */
-    for (k = 0; k < n; k += 2)
-    {
-        size = euler_number_size(k);
-        /* Use only as large a comb as needed */
-        num_primes_k = (size + prime_bits - 1) / prime_bits;
-        for (i = 0; i < resolution; i++)
-        {
-            if (comb[i]->num_primes >= num_primes_k)
-                break;
-        }
-        num_primes_k = comb[i]->num_primes;
-        for (j = 0; j < num_primes_k; j++)
-            residues[j] = polys[j][k / 2];
-        fmpz_multi_CRT_ui_unsigned(res + k, residues, comb[i], temp[i]);
-        if (k % 4)
-            fmpz_neg(res + k, res + k);
-    }
+    s.res = res;
+    s.n = n;
+    s.buf = (res == NULL) ? _fmpz_vec_init(2 * block) : NULL;
+    s.func = func;
+    s.data = data;
 
-    /* Cleanup */
-    for (k = 0; k < num_primes; k++)
-        _nmod_vec_clear(polys[k]);
-    _nmod_vec_clear(temppoly);
-    for (i = 0; i < resolution; i++)
-    {
-        fmpz_comb_temp_clear(temp[i]);
-        fmpz_comb_clear(comb[i]);
-    }
+    _arith_vec_multi_mod_stream(m, bits, _euler_number_vec_mod_p, NULL, 0,
+                                    block, _euler_number_vec_output, &s);
 
-    free(primes);
-    free(residues);
-    free(polys);
+    if (res == NULL)
+        _fmpz_vec_clear(s.buf, 2 * block);
+    free(bits);
 }
 
 void euler_number_vec(fmpz * res, long n)
 {
-    __euler_number_vec_multi_mod(res, n);
+    _euler_number_vec_multi_mod(res, n, n, NULL, NULL);
+}
+
+void
+euler_number_vec_multi_mod_stream(long n, long block,
+                                    arith_vec_stream_func func, void * data)
+{
+    _euler_number_vec_multi_mod(NULL, n, block, func, data);
 }
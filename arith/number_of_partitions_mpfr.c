@@ -26,6 +26,7 @@
 ******************************************************************************/
 
 #include <math.h>
+#include <stdlib.h>
 #include <mpir.h>
 #include <mpfr.h>
 #include "flint.h"
@@ -47,6 +48,26 @@
 
 #define VERBOSE 0
 
+/* Terms from k onwards are evaluated in blocks of length
+   min(k / PARTITIONS_BLOCK_DIVISOR, PARTITIONS_TAIL_BLOCK), at least one */
+#define PARTITIONS_BLOCK_DIVISOR 16
+#define PARTITIONS_TAIL_BLOCK 4096
+
+/*
+    Minimal polynomials of cos(pi p / q) and their derivatives, indexed by
+    q or 2q as in cos_minpoly_index, for the cosines that mpfr_cos_pi_pq
+    evaluates by Newton iteration. They are computed before the terms are
+    evaluated in parallel, as fmpz_poly arithmetic is not thread-safe;
+    entries that are not needed are left empty.
+ */
+typedef struct
+{
+    fmpz_poly_struct * poly;
+    fmpz_poly_struct * deriv;
+    long len;
+}
+cos_minpoly_tab_struct;
+
 
 static double
 partitions_remainder_bound(double n, double terms)
@@ -224,11 +245,10 @@ fmpz_poly_evaluate_mpfr(mpfr_t res, const fmpz_poly_t f, const mpfr_t a)
 }
 
 void
-findroot(mpfr_t x, fmpz_poly_t poly, double x0)
+findroot(mpfr_t x, const fmpz_poly_t poly, const fmpz_poly_t poly2, double x0)
 {
     long i, prec, initial_prec, target_prec, guard_bits;
     long precs[FLINT_BITS];
-    fmpz_poly_t poly2;
     mpfr_t t, u, xn;
 
     initial_prec = 48;
@@ -239,8 +259,6 @@ findroot(mpfr_t x, fmpz_poly_t poly, double x0)
     mpfr_init2(xn, 53);
     mpfr_set_d(xn, x0, MPFR_RNDN);
 
-    fmpz_poly_init(poly2);
-    fmpz_poly_derivative(poly2, poly);
     guard_bits = fmpz_poly_max_bits(poly2);
     guard_bits = FLINT_ABS(guard_bits);
 
@@ -263,18 +281,15 @@ findroot(mpfr_t x, fmpz_poly_t poly, double x0)
 
     mpfr_set(x, xn, MPFR_RNDN);
 
-    fmpz_poly_clear(poly2);
     mpfr_clear(t);
     mpfr_clear(u);
     mpfr_clear(xn);
 }
 
-void cos_minpoly(fmpz_poly_t poly, long p, long q)
+static __inline__ long
+cos_minpoly_index(long p, long q)
 {
-    if (p % 2 == 0)
-        cyclotomic_cos_polynomial(poly, q);
-    else
-        cyclotomic_cos_polynomial(poly, 2 * q);
+    return (p % 2 == 0) ? q : 2 * q;
 }
 
 int use_newton(long prec, long q)
@@ -284,7 +299,74 @@ int use_newton(long prec, long q)
     return 0;
 }
 
-void mpfr_cos_pi_pq(mpfr_t t, mp_limb_signed_t p, mp_limb_signed_t q)
+static void
+cos_minpoly_tab_init(cos_minpoly_tab_struct * tab, ulong n, long N0, long N)
+{
+    trig_prod_t prod;
+    long i, k, p, q, d, prec;
+
+    prec = partitions_prec_bound(n, N0, N);
+    for (q = 0; use_newton(prec, q + 1); q++) ;
+
+    tab->len = 2 * q + 1;
+    tab->poly = malloc(tab->len * sizeof(fmpz_poly_struct));
+    tab->deriv = malloc(tab->len * sizeof(fmpz_poly_struct));
+
+    for (i = 0; i < tab->len; i++)
+    {
+        fmpz_poly_init(tab->poly + i);
+        fmpz_poly_init(tab->deriv + i);
+    }
+
+    /* Only the leading terms have enough precision to use Newton iteration */
+    for (k = N0; k <= N && (prec = partitions_prec_bound(n, k, N)) > 400; k++)
+    {
+        trig_prod_init(prod);
+        dedekind_cosine_sum_factored(prod, k, n % k);
+
+        if (prod->prefactor == 0)
+            continue;
+
+        for (i = 0; i < prod->n; i++)
+        {
+            p = FLINT_ABS(prod->cos_p[i]);
+            q = prod->cos_q[i];
+            p %= (2 * q);
+            if (p >= q)
+                p = 2 * q - p;
+
+            if (use_newton(prec, q))
+            {
+                d = n_gcd(q, p);
+                d = cos_minpoly_index(p / d, q / d);
+
+                if (tab->poly[d].length == 0)
+                {
+                    cyclotomic_cos_polynomial(tab->poly + d, d);
+                    fmpz_poly_derivative(tab->deriv + d, tab->poly + d);
+                }
+            }
+        }
+    }
+}
+
+static void
+cos_minpoly_tab_clear(cos_minpoly_tab_struct * tab)
+{
+    long i;
+
+    for (i = 0; i < tab->len; i++)
+    {
+        fmpz_poly_clear(tab->poly + i);
+        fmpz_poly_clear(tab->deriv + i);
+    }
+
+    free(tab->poly);
+    free(tab->deriv);
+}
+
+void mpfr_cos_pi_pq(mpfr_t t, mp_limb_signed_t p, mp_limb_signed_t q,
+                                        const cos_minpoly_tab_struct * tab)
 {
     /* Force 0 <= p < q */
     p = FLINT_ABS(p);
@@ -294,15 +376,13 @@ void mpfr_cos_pi_pq(mpfr_t t, mp_limb_signed_t p, mp_limb_signed_t q)
 
     if (use_newton(mpfr_get_prec(t), q))
     {
-        fmpz_poly_t poly;
-        long d;
-        fmpz_poly_init(poly);
+        long d, i;
         d = n_gcd(q, p);
         q /= d;
         p /= d;
-        cos_minpoly(poly, p, q);
-        findroot(t, poly, cos(3.1415926535897932385 * p / q));
-        fmpz_poly_clear(poly);
+        i = cos_minpoly_index(p, q);
+        findroot(t, tab->poly + i, tab->deriv + i,
+            cos(3.1415926535897932385 * p / q));
     }
     else
     {
@@ -331,7 +411,8 @@ void mpfr_cos_pi_pq(mpfr_t t, mp_limb_signed_t p, mp_limb_signed_t q)
 }
 
 void
-eval_trig_prod(mpfr_t sum, trig_prod_t prod)
+eval_trig_prod(mpfr_t sum, trig_prod_t prod,
+                                        const cos_minpoly_tab_struct * tab)
 {
     int i;
 
@@ -375,7 +456,7 @@ eval_trig_prod(mpfr_t sum, trig_prod_t prod)
 
         for (i = 0; i < prod->n; i++)
         {
-            mpfr_cos_pi_pq(t, prod->cos_p[i], prod->cos_q[i]);
+            mpfr_cos_pi_pq(t, prod->cos_p[i], prod->cos_q[i], tab);
             mpfr_mul(sum, sum, t, MPFR_RNDN);
         }
 
@@ -384,7 +465,7 @@ eval_trig_prod(mpfr_t sum, trig_prod_t prod)
 }
 
 void
-sinh_cosh_divk_precomp(mpfr_t sh, mpfr_t ch, mpfr_t ex, long k)
+sinh_cosh_divk_precomp(mpfr_t sh, mpfr_t ch, const mpfr_t ex, long k)
 {
     mpfr_t t;
     mpfr_root(ch, ex, k, MPFR_RNDN);
@@ -400,14 +481,200 @@ sinh_cosh_divk_precomp(mpfr_t sh, mpfr_t ch, mpfr_t ex, long k)
 }
 
 
+
+/*
+    Writes the factorisations of k0, ..., k0 + len - 1 to fac, sieving
+    with the given primes, which must include all primes up to the square
+    root of the largest k. The primes come out in increasing order, as
+    from n_factor.
+ */
+static void
+partitions_factor_block(n_factor_t * fac, mp_limb_t * rem, long k0, long len,
+                                    const mp_limb_t * primes, long num_primes)
+{
+    long i, j;
+    mp_limb_t p;
+    int e;
+
+    for (i = 0; i < len; i++)
+    {
+        fac[i].num = 0;
+        rem[i] = k0 + i;
+    }
+
+    for (j = 0; j < num_primes; j++)
+    {
+        p = primes[j];
+
+        if (p * p > k0 + len - 1)
+            break;
+
+        for (i = (p - k0 % p) % p; i < len; i += p)
+        {
+            e = 0;
+            do
+            {
+                rem[i] /= p;
+                e++;
+            } while (rem[i] % p == 0);
+
+            fac[i].p[fac[i].num] = p;
+            fac[i].exp[fac[i].num] = e;
+            fac[i].num++;
+        }
+    }
+
+    for (i = 0; i < len; i++)
+    {
+        if (rem[i] != 1)
+        {
+            fac[i].p[fac[i].num] = rem[i];
+            fac[i].exp[fac[i].num] = 1;
+            fac[i].num++;
+        }
+    }
+}
+
+typedef struct
+{
+    ulong n;
+    long N;
+    const long * starts;
+    __mpfr_struct * sums;
+    mpfr_srcptr C;
+    mpfr_srcptr exp1;
+    const __mpz_struct * n24;
+    double Cd;
+    const mp_limb_t * primes;
+    long num_primes;
+    const cos_minpoly_tab_struct * tab;
+}
+partitions_block_struct;
+
+/*
+    Sums the terms k0 <= k < k1 of block b into sums[b]. Terms needing
+    more than double precision are evaluated as described in the
+    documentation; the others are evaluated entirely in doubles and
+    added up with compensated summation.
+ */
+static void
+partitions_block_worker(void * arg, long b)
+{
+    partitions_block_struct * s = (partitions_block_struct *) arg;
+    long k, k0, k1, prec;
+    n_factor_t * fac;
+    mp_limb_t * rem;
+    trig_prod_t prod;
+    mpfr_ptr acc;
+    mpfr_t t1, t2, t3, t4;
+    double dsum, dcomp, n24d;
+    int i;
+
+    k0 = s->starts[b];
+    k1 = s->starts[b + 1];
+    acc = s->sums + b;
+
+    fac = malloc((k1 - k0) * sizeof(n_factor_t));
+    rem = malloc((k1 - k0) * sizeof(mp_limb_t));
+    partitions_factor_block(fac, rem, k0, k1 - k0, s->primes, s->num_primes);
+
+    prec = partitions_prec_bound(s->n, k0, s->N);
+    mpfr_init2(acc, FLINT_MAX(prec, DOUBLE_PREC) + FLINT_BIT_COUNT(k1 - k0) + 32);
+    mpfr_set_ui(acc, 0, MPFR_RNDN);
+
+    mpfr_init2(t1, DOUBLE_PREC);
+    mpfr_init2(t2, DOUBLE_PREC);
+    mpfr_init2(t3, DOUBLE_PREC);
+    mpfr_init2(t4, DOUBLE_PREC);
+
+    dsum = 0.0;
+    dcomp = 0.0;
+    n24d = mpz_get_d(s->n24);
+
+    for (k = k0; k < k1; k++)
+    {
+        trig_prod_init(prod);
+        _dedekind_cosine_sum_factored(prod, k, s->n % k, fac + (k - k0));
+
+        if (prod->prefactor == 0)
+            continue;
+
+        /* Compute A_k(n) * sqrt(3/k) * 4 / (24*n-1) */
+        prod->prefactor *= 4;
+        prod->sqrt_p *= 3;
+        prod->sqrt_q *= k;
+
+        prec = partitions_prec_bound(s->n, k, s->N);
+
+        if (prec <= DOUBLE_PREC)
+        {
+            double z, t, u;
+
+            t = prod->prefactor * sqrt((double) prod->sqrt_p
+                                        / (double) prod->sqrt_q);
+            for (i = 0; i < prod->n; i++)
+                t *= cos_pi_pq(prod->cos_p[i], prod->cos_q[i]);
+
+            /* Multiply by (cosh(z) - sinh(z)/z) where z = C / k */
+            z = s->Cd / k;
+            t = t * (cosh(z) - sinh(z) / z) / n24d;
+
+            /* Neumaier summation */
+            u = dsum + t;
+            if (fabs(dsum) >= fabs(t))
+                dcomp += (dsum - u) + t;
+            else
+                dcomp += (t - u) + dsum;
+            dsum = u;
+        }
+        else
+        {
+            mpfr_set_prec(t1, prec);
+            mpfr_set_prec(t2, prec);
+            mpfr_set_prec(t3, prec);
+            mpfr_set_prec(t4, prec);
+
+            eval_trig_prod(t1, prod, s->tab);
+            mpfr_div_z(t1, t1, s->n24, MPFR_RNDN);
+
+            /* Multiply by (cosh(z) - sinh(z)/z) where z = C / k */
+            mpfr_div_ui(t2, s->C, k, MPFR_RNDN);
+
+            if (k < 35)
+                sinh_cosh_divk_precomp(t3, t4, s->exp1, k);
+            else
+                mpfr_sinh_cosh(t3, t4, t2, MPFR_RNDN);
+
+            mpfr_div(t3, t3, t2, MPFR_RNDN);
+            mpfr_sub(t2, t4, t3, MPFR_RNDN);
+            mpfr_mul(t1, t1, t2, MPFR_RNDN);
+
+            mpfr_add(acc, acc, t1, MPFR_RNDN);
+        }
+    }
+
+    mpfr_add_d(acc, acc, dsum, MPFR_RNDN);
+    mpfr_add_d(acc, acc, dcomp, MPFR_RNDN);
+
+    mpfr_clear(t1);
+    mpfr_clear(t2);
+    mpfr_clear(t3);
+    mpfr_clear(t4);
+    free(fac);
+    free(rem);
+}
+
 void
 _number_of_partitions_mpfr(mpfr_t x, ulong n, long N0, long N)
 {
-    trig_prod_t prod;
-    mpfr_t acc, C, t1, t2, t3, t4, exp1;
+    partitions_block_struct s;
+    cos_minpoly_tab_struct tab;
+    mpfr_t C, t1, t2, exp1, r;
+    mp_limb_t * primes;
+    long * starts;
     mpz_t n24;
-    double Cd;
-    long k, prec, guard_bits;
+    long b, k, num_blocks, num_primes, prec, guard_bits;
+    mp_limb_t p;
 #if VERBOSE
     timeit_t t0;
 #endif
@@ -424,15 +691,9 @@ _number_of_partitions_mpfr(mpfr_t x, ulong n, long N0, long N)
     prec = FLINT_MAX(prec, DOUBLE_PREC);
 
     mpfr_set_prec(x, prec);
-    mpfr_init2(acc, prec);
     mpfr_init2(C, prec);
     mpfr_init2(t1, prec);
     mpfr_init2(t2, prec);
-    mpfr_init2(t3, prec);
-    mpfr_init2(t4, prec);
-
-    mpfr_set_ui(x, 0, MPFR_RNDN);
-    mpfr_set_ui(acc, 0, MPFR_RNDN);
 
     mpz_init(n24);
     mpz_set_ui(n24, n);
@@ -453,7 +714,6 @@ _number_of_partitions_mpfr(mpfr_t x, ulong n, long N0, long N)
     mpfr_sqrt_z(t2, n24, MPFR_RNDN);
     mpfr_mul(t1, t1, t2, MPFR_RNDN);
     mpfr_div_ui(C, t1, 6, MPFR_RNDN);
-    Cd = mpfr_get_d(C, MPFR_RNDN);
 
     mpfr_init2(exp1, prec);
     mpfr_exp(exp1, C, prec);
@@ -463,70 +723,66 @@ _number_of_partitions_mpfr(mpfr_t x, ulong n, long N0, long N)
     printf("TERM 1: %ld ms\n", t0->cpu);
 #endif
 
-    for (k = N0; k <= N; k++)
+    /* Precomputations shared by the threads */
+    cos_minpoly_tab_init(&tab, n, N0, N);
+
+    num_primes = 0;
+    primes = malloc((n_sqrt(N) + 1) * sizeof(mp_limb_t));
+    for (p = 2; p * p <= N; p = n_nextprime(p, 1))
+        primes[num_primes++] = p;
+
+    num_blocks = 0;
+    starts = malloc((N - N0 + 2) * sizeof(long));
+    for (k = N0; k <= N; k += FLINT_MAX(1,
+                FLINT_MIN(k / PARTITIONS_BLOCK_DIVISOR, PARTITIONS_TAIL_BLOCK)))
+        starts[num_blocks++] = k;
+    starts[num_blocks] = N + 1;
+
+    s.n = n;
+    s.N = N;
+    s.starts = starts;
+    s.sums = malloc(num_blocks * sizeof(__mpfr_struct));
+    s.C = C;
+    s.exp1 = exp1;
+    s.n24 = n24;
+    s.Cd = mpfr_get_d(C, MPFR_RNDN);
+    s.primes = primes;
+    s.num_primes = num_primes;
+    s.tab = &tab;
+
+    flint_parallel_do(partitions_block_worker, &s, num_blocks,
+                                                    flint_get_num_threads());
+
+    /*
+        Add up the blocks from the smallest terms upwards, in a fixed order
+        so that the result does not depend on the number of threads. The
+        partial sums only need the precision of the largest block so far.
+     */
+    mpfr_init2(r, mpfr_get_prec(s.sums + num_blocks - 1));
+    mpfr_set_ui(r, 0, MPFR_RNDN);
+
+    for (b = num_blocks - 1; b >= 0; b--)
     {
-        trig_prod_init(prod);
-        dedekind_cosine_sum_factored(prod, k, n % k);
-
-        if (prod->prefactor != 0)
-        {
-            if (prec > DOUBLE_PREC)
-            {
-                prec = partitions_prec_bound(n, k, N);
-                mpfr_set_prec(t1, prec);
-                mpfr_set_prec(t2, prec);
-                mpfr_set_prec(t3, prec);
-                mpfr_set_prec(t4, prec);
-            }
-
-            /* Compute A_k(n) * sqrt(3/k) * 4 / (24*n-1) */
-            prod->prefactor *= 4;
-            prod->sqrt_p *= 3;
-            prod->sqrt_q *= k;
-            eval_trig_prod(t1, prod);
-            mpfr_div_z(t1, t1, n24, MPFR_RNDN);
+        if (mpfr_get_prec(s.sums + b) > mpfr_get_prec(r))
+            mpfr_prec_round(r, mpfr_get_prec(s.sums + b), MPFR_RNDN);
 
-            /* Multiply by (cosh(z) - sinh(z)/z) where z = C / k */
-            if (prec <= DOUBLE_PREC)
-            {
-                double z = Cd / k;
-                mpfr_mul_d(t1, t1, cosh(z) - sinh(z)/z, MPFR_RNDN);
-            }
-            else
-            {
-                mpfr_div_ui(t2, C, k, MPFR_RNDN);
-
-                if (k < 35)
-                    sinh_cosh_divk_precomp(t3, t4, exp1, k);
-                else
-                    mpfr_sinh_cosh(t3, t4, t2, MPFR_RNDN);
-
-                mpfr_div(t3, t3, t2, MPFR_RNDN);
-                mpfr_sub(t2, t4, t3, MPFR_RNDN);
-                mpfr_mul(t1, t1, t2, MPFR_RNDN);
-            }
-
-            /* Add to accumulator */
-            mpfr_add(acc, acc, t1, MPFR_RNDN);
-            if (mpfr_get_prec(acc) > 2 * prec + 32)
-            {
-                mpfr_add(x, x, acc, MPFR_RNDN);
-                mpfr_set_prec(acc, prec + 32);
-                mpfr_set_ui(acc, 0, MPFR_RNDN);
-            }
-        }
+        mpfr_add(r, r, s.sums + b, MPFR_RNDN);
+        mpfr_clear(s.sums + b);
     }
 
-    mpfr_add(x, x, acc, MPFR_RNDN);
+    mpfr_set(x, r, MPFR_RNDN);
+
+    mpfr_clear(r);
+    free(s.sums);
+    free(starts);
+    free(primes);
+    cos_minpoly_tab_clear(&tab);
 
     mpz_clear(n24);
-    mpfr_clear(acc);
     mpfr_clear(exp1);
     mpfr_clear(C);
     mpfr_clear(t1);
     mpfr_clear(t2);
-    mpfr_clear(t3);
-    mpfr_clear(t4);
 }
 
 void
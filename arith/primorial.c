@@ -30,6 +30,7 @@
 #include "fmpz.h"
 #include "arith.h"
 #include "ulong_extras.h"
+#include "mpn_extras.h"
 
 #if FLINT64
 #define LARGEST_ULONG_PRIMORIAL 52
@@ -50,86 +51,11 @@ const ulong ULONG_PRIMORIALS[] =
 };
 
 
-#define PROD_LIMBS_DIRECT_CUTOFF 50
-
-mp_size_t mpn_prod_limbs_direct(mp_limb_t * result, const mp_limb_t * factors,
-    mp_size_t n)
-{
-    mp_size_t k, len;
-    mp_limb_t top;
-    if (n < 1)
-    {
-        result[0] = 1UL;
-        return 1;
-    }
-    result[0] = factors[0];
-    len = 1;
-    for (k=1; k<n; k++)
-    {
-        top = mpn_mul_1(result, result, len, factors[k]);
-        if (top)
-        {
-            result[len] = top;
-            len++;
-        }
-    }
-    return len;
-}
-
-mp_size_t mpn_prod_limbs_balanced(mp_limb_t * result, mp_limb_t * scratch,
-                             const mp_limb_t * factors, mp_size_t n, ulong bits)
-{
-    mp_size_t an, bn, alen, blen, len;
-    mp_limb_t top;
-
-    if (n < PROD_LIMBS_DIRECT_CUTOFF)
-        return mpn_prod_limbs_direct(result, factors, n);
-
-    an = n/2;
-    bn = n - an;
-    
-    alen = mpn_prod_limbs_balanced(scratch, result, factors, an, bits);
-    blen = mpn_prod_limbs_balanced(scratch + alen, result, factors + an, bn, bits);
-    len = alen + blen;
-
-    if (alen <= blen)
-        top = mpn_mul(result, scratch + alen, blen, scratch, alen);
-    else
-        top = mpn_mul(result, scratch, alen, scratch + alen, blen);
-
-    if (!top)
-        len--;
-    
-    return len;
-}
-
-/*
-    Set result to the product of the given factors, return the
-    length of the result. It is assumed that no factors are zero.
-    bits must be set to some bound on the bit size of the entries
-    in factors. If no bound is known, simply use FLINT_BITS.
-*/
-mp_size_t mpn_prod_limbs(mp_limb_t * result, const mp_limb_t * factors,
-    mp_size_t n, ulong bits)
-{
-    mp_size_t len, limbs;
-    mp_limb_t * scratch;
-    
-    if (n < PROD_LIMBS_DIRECT_CUTOFF)
-        return mpn_prod_limbs_direct(result, factors, n);
-
-    limbs = (n * bits - 1)/FLINT_BITS + 2; 
-
-    scratch = malloc(sizeof(mp_limb_t) * limbs);
-    len = mpn_prod_limbs_balanced(result, scratch, factors, n, bits);
-    free(scratch);
-    
-    return len;
-}
-
 void fmpz_primorial(fmpz_t res, long n)
 {
-    mp_size_t len, pi;
+    mp_size_t len;
+    mp_limb_t * primes;
+    long pi;
     ulong bits;
     __mpz_struct * mpz_ptr;
 
@@ -142,14 +68,14 @@ void fmpz_primorial(fmpz_t res, long n)
         return;
     }
 
-    pi = n_prime_pi(n);
-    
-    n_compute_primes(pi);
-    bits = FLINT_BIT_COUNT(flint_primes[pi - 1]);
+    primes = n_sieve_primes(&pi, n);
+    bits = FLINT_BIT_COUNT(primes[pi - 1]);
     
     mpz_ptr = _fmpz_promote(res);
-    mpz_realloc2(mpz_ptr, pi*bits);
+    mpz_realloc2(mpz_ptr, pi*bits + 2*FLINT_BITS);
     
-    len = mpn_prod_limbs(mpz_ptr->_mp_d, flint_primes, pi, bits);
+    len = mpn_prod_limbs(mpz_ptr->_mp_d, primes, pi, bits);
     mpz_ptr->_mp_size = len;
+
+    free(primes);
 }
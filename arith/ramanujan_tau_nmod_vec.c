@@ -0,0 +1,68 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+
+#include <mpir.h>
+#include "flint.h"
+#include "arith.h"
+#include "ulong_extras.h"
+#include "nmod_vec.h"
+#include "nmod_poly.h"
+
+void
+ramanujan_tau_nmod_vec(mp_ptr res, long n, nmod_t mod)
+{
+    long j, k, jv, kv, m;
+    mp_limb_t c;
+    mp_ptr t;
+
+    if (n < 1)
+        return;
+
+    res[0] = 0UL;
+    m = n - 1;
+
+    if (m == 0)
+        return;
+
+    t = _nmod_vec_init(m);
+    _nmod_vec_zero(t, m);
+
+    /* Square of \sum_k (-1)^k (2k+1) q^(k(k+1)/2), which is sparse */
+    for (j = jv = 0; jv < m; jv += ++j)
+    {
+        for (k = kv = 0; jv + kv < m; kv += ++k)
+        {
+            c = n_mulmod2_preinv(2*j+1, 2*k+1, mod.n, mod.ninv);
+
+            if ((j + k) & 1)
+                t[jv + kv] = nmod_sub(t[jv + kv], c, mod);
+            else
+                t[jv + kv] = nmod_add(t[jv + kv], c, mod);
+        }
+    }
+
+    /* Raise to the fourth power */
+    _nmod_poly_mullow(res + 1, t, m, t, m, m, mod);
+    _nmod_poly_mullow(t, res + 1, m, res + 1, m, m, mod);
+    _nmod_vec_set(res + 1, t, m);
+
+    _nmod_vec_clear(t);
+}
@@ -142,6 +142,12 @@ stirling_number_2_vec(fmpz * row, long n, long klen)
     if (klen < 1)
         return;
 
+    if (n >= STIRLING_2_VEC_MULTI_MOD_CUTOFF)
+    {
+        stirling_number_2_vec_multi_mod(row, n, klen);
+        return;
+    }
+
     fmpz_one(row);
     for (m = 1; m <= n; m++)
         _fmpz_stirling_next_row(row, row, m, klen, 2);
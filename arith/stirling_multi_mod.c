@@ -0,0 +1,152 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <math.h>
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "nmod_vec.h"
+#include "arith.h"
+
+/*
+    Sets bits[k] to an upper bound for the number of bits of |s(n, k)|
+    (kind 0) or S(n, k) (kind 2) for 0 <= k < len. Uses S(n, k) <= k^n / k!
+    and |s(n, k)| <= (n - 1)! H_{n-1}^(k-1) / (k-1)! <= n!, where
+    H_{n-1} <= 1 + log n. Requires lf[i] = log2(i!) for i < len and
+    lfn = log2((n - 1)!).
+*/
+static void
+_stirling_bits(long * bits, long n, long len, int kind,
+                                    const double * lf, double lfn)
+{
+    double x, lh;
+    long k;
+
+    lh = (n > 1) ? log(1.0 + log(n)) / log(2.0) : 0.0;
+
+    for (k = 0; k < len; k++)
+    {
+        if (k == 0 || k >= n)
+            x = 0.0;
+        else if (kind == 0)
+            x = FLINT_MIN(lfn + (k - 1) * lh - lf[k - 1],
+                          lfn + log(n) / log(2.0));
+        else
+            x = n * (log(k) / log(2.0)) - lf[k];
+
+        bits[k] = (long) (FLINT_MAX(x, 0.0) * (1.0 + 1e-12)) + 3;
+    }
+}
+
+static double *
+_log2_fac_tab(long len)
+{
+    double * lf;
+    long i;
+
+    lf = malloc(FLINT_MAX(len, 1) * sizeof(double));
+    lf[0] = 0.0;
+    for (i = 1; i < len; i++)
+        lf[i] = lf[i - 1] + log(i) / log(2.0);
+
+    return lf;
+}
+
+typedef struct
+{
+    long n;
+    int kind;
+}
+_stirling_mod_struct;
+
+static void
+_stirling_vec_mod_p(mp_ptr res, long len, nmod_t mod, void * data)
+{
+    _stirling_mod_struct * s = (_stirling_mod_struct *) data;
+
+    if (s->kind == 0)
+        stirling_number_1u_nmod_vec(res, s->n, len, mod);
+    else
+        stirling_number_2_nmod_vec(res, s->n, len, mod);
+}
+
+static void
+_stirling_vec_set(fmpz * vec, long start, long len, void * data)
+{
+    fmpz * row = (fmpz *) data;
+    long i;
+
+    for (i = 0; i < len; i++)
+        fmpz_swap(row + start + i, vec + i);
+}
+
+static void
+_stirling_vec_multi_mod(fmpz * row, long n, long klen, int kind)
+{
+    _stirling_mod_struct s;
+    double * lf, lfn;
+    long * bits;
+    long i;
+
+    if (klen < 1)
+        return;
+
+    lf = _log2_fac_tab(klen);
+    lfn = 0.0;
+    if (kind == 0)
+        for (i = 1; i < n; i++)
+            lfn += log(i) / log(2.0);
+
+    bits = malloc(klen * sizeof(long));
+    _stirling_bits(bits, n, klen, kind, lf, lfn);
+
+    s.n = n;
+    s.kind = kind;
+
+    _arith_vec_multi_mod_stream(klen, bits, _stirling_vec_mod_p, &s, 0,
+                                                klen, _stirling_vec_set, row);
+
+    free(bits);
+    free(lf);
+}
+
+void
+stirling_number_1u_vec_multi_mod(fmpz * row, long n, long klen)
+{
+    _stirling_vec_multi_mod(row, n, klen, 0);
+}
+
+void
+stirling_number_1_vec_multi_mod(fmpz * row, long n, long klen)
+{
+    long k;
+
+    _stirling_vec_multi_mod(row, n, klen, 0);
+
+    for (k = (n + 1) % 2; k < klen; k += 2)
+        fmpz_neg(row + k, row + k);
+}
+
+void
+stirling_number_2_vec_multi_mod(fmpz * row, long n, long klen)
+{
+    _stirling_vec_multi_mod(row, n, klen, 2);
+}
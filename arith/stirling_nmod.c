@@ -0,0 +1,244 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "ulong_extras.h"
+#include "nmod_vec.h"
+#include "nmod_poly.h"
+#include "nmod_mat.h"
+#include "arith.h"
+
+/*
+    Sets res to (x + a)(x + a + 1) ... (x + b - 1) truncated to length
+    trunc, writing min(b - a + 1, trunc) coefficients.
+*/
+static void
+_nmod_rising_factorial(mp_ptr res, long a, long b, long trunc, nmod_t mod)
+{
+    long i, j, len, mid, nleft, nright;
+    mp_ptr left, right;
+    mp_limb_t c;
+
+    if (b - a <= STIRLING_NMOD_BASECASE)
+    {
+        res[0] = 1UL;
+        len = 1;
+
+        for (j = a; j < b; j++)
+        {
+            c = n_mod2_preinv(j, mod.n, mod.ninv);
+
+            if (len < trunc)
+                res[len++] = 0UL;
+
+            for (i = len - 1; i > 0; i--)
+                res[i] = nmod_add(n_mulmod2_preinv(res[i], c, mod.n,
+                                            mod.ninv), res[i - 1], mod);
+            res[0] = n_mulmod2_preinv(res[0], c, mod.n, mod.ninv);
+        }
+    }
+    else
+    {
+        mid = (a + b) / 2;
+        nleft = FLINT_MIN(mid - a + 1, trunc);
+        nright = FLINT_MIN(b - mid + 1, trunc);
+
+        left = _nmod_vec_init(nleft);
+        right = _nmod_vec_init(nright);
+
+        _nmod_rising_factorial(left, a, mid, trunc, mod);
+        _nmod_rising_factorial(right, mid, b, trunc, mod);
+
+        /* nright >= nleft */
+        _nmod_poly_mullow(res, right, nright, left, nleft,
+                            FLINT_MIN(nleft + nright - 1, trunc), mod);
+
+        _nmod_vec_clear(left);
+        _nmod_vec_clear(right);
+    }
+}
+
+void
+stirling_number_1u_nmod_vec(mp_ptr row, long n, long klen, nmod_t mod)
+{
+    long m;
+
+    if (klen < 1)
+        return;
+
+    m = FLINT_MIN(klen, n + 1);
+    _nmod_rising_factorial(row, 0, n, m, mod);
+    _nmod_vec_zero(row + m, klen - m);
+}
+
+void
+stirling_number_1_nmod_vec(mp_ptr row, long n, long klen, nmod_t mod)
+{
+    long k;
+
+    stirling_number_1u_nmod_vec(row, n, klen, mod);
+
+    for (k = (n + 1) % 2; k < klen; k += 2)
+        row[k] = nmod_neg(row[k], mod);
+}
+
+void
+stirling_number_2_nmod_vec(mp_ptr row, long n, long klen, nmod_t mod)
+{
+    long i, j, k, m, q, * spf;
+    mp_ptr a, b;
+    mp_limb_t t;
+
+    if (klen < 1)
+        return;
+
+    m = FLINT_MIN(klen, n + 1);
+
+    /* The factorials are not invertible; use the recurrence */
+    if ((mp_limb_t) (m - 1) >= mod.n)
+    {
+        _nmod_vec_zero(row, m);
+        row[0] = 1UL;
+
+        for (i = 1; i <= n; i++)
+        {
+            for (k = FLINT_MIN(i, m - 1); k > 0; k--)
+                row[k] = nmod_add(row[k - 1], n_mulmod2_preinv(row[k],
+                    n_mod2_preinv(k, mod.n, mod.ninv), mod.n, mod.ninv), mod);
+            row[0] = 0UL;
+        }
+
+        _nmod_vec_zero(row + m, klen - m);
+        return;
+    }
+
+    /*
+        S(n, k) = sum_{j=0}^k (-1)^(k-j) j^n / (j! (k-j)!), the
+        convolution of a_j = j^n / j! and b_i = (-1)^i / i!
+    */
+    a = _nmod_vec_init(m);
+    b = _nmod_vec_init(m);
+
+    for (j = 2, t = 1UL; j < m; j++)
+        t = n_mulmod2_preinv(t, j, mod.n, mod.ninv);
+    t = n_invmod(t, mod.n);
+    for (j = m - 1; j >= 0; j--)
+    {
+        b[j] = t;
+        t = n_mulmod2_preinv(t, FLINT_MAX(j, 1), mod.n, mod.ninv);
+    }
+
+    /* j^n is completely multiplicative in j; only powmod at primes */
+    spf = calloc(m, sizeof(long));
+    a[0] = (n == 0);
+    if (m > 1)
+        a[1] = 1UL;
+    for (q = 2; q < m; q++)
+    {
+        if (spf[q] == 0)
+        {
+            a[q] = n_powmod2_preinv(q, n, mod.n, mod.ninv);
+            if (q <= (m - 1) / q)
+                for (j = q * q; j < m; j += q)
+                    if (spf[j] == 0)
+                        spf[j] = q;
+        }
+        else
+            a[q] = n_mulmod2_preinv(a[spf[q]], a[q / spf[q]],
+                                                mod.n, mod.ninv);
+    }
+    free(spf);
+
+    for (j = 0; j < m; j++)
+        a[j] = n_mulmod2_preinv(a[j], b[j], mod.n, mod.ninv);
+    for (j = 1; j < m; j += 2)
+        b[j] = nmod_neg(b[j], mod);
+
+    _nmod_poly_mullow(row, a, m, b, m, m, mod);
+    _nmod_vec_zero(row + m, klen - m);
+
+    _nmod_vec_clear(a);
+    _nmod_vec_clear(b);
+}
+
+static void
+_stirling_nmod_mat(mp_ptr * rows, long r, long c, int kind, nmod_t mod)
+{
+    long i, k, m;
+    mp_limb_t d;
+
+    if (r == 0 || c == 0)
+        return;
+
+    _nmod_vec_zero(rows[0], c);
+    rows[0][0] = 1UL;
+
+    for (i = 1; i < r; i++)
+    {
+        m = FLINT_MIN(i, c);
+
+        _nmod_vec_zero(rows[i], c);
+        if (i < c)
+            rows[i][i] = 1UL;
+
+        if (m < 2)
+            continue;
+
+        if (kind == 2)
+        {
+            for (k = 1; k < m; k++)
+                rows[i][k] = nmod_add(rows[i - 1][k - 1],
+                    n_mulmod2_preinv(rows[i - 1][k],
+                        n_mod2_preinv(k, mod.n, mod.ninv), mod.n, mod.ninv),
+                    mod);
+        }
+        else
+        {
+            d = n_mod2_preinv(i - 1, mod.n, mod.ninv);
+            if (kind == 1)
+                d = nmod_neg(d, mod);
+
+            _nmod_vec_scalar_mul_nmod(rows[i] + 1, rows[i - 1] + 1,
+                                                        m - 1, d, mod);
+            _nmod_vec_add(rows[i] + 1, rows[i] + 1, rows[i - 1],
+                                                        m - 1, mod);
+        }
+    }
+}
+
+void
+stirling_number_1u_nmod_mat(nmod_mat_t mat)
+{
+    _stirling_nmod_mat(mat->rows, mat->r, mat->c, 0, mat->mod);
+}
+
+void
+stirling_number_1_nmod_mat(nmod_mat_t mat)
+{
+    _stirling_nmod_mat(mat->rows, mat->r, mat->c, 1, mat->mod);
+}
+
+void
+stirling_number_2_nmod_mat(nmod_mat_t mat)
+{
+    _stirling_nmod_mat(mat->rows, mat->r, mat->c, 2, mat->mod);
+}
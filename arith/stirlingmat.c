@@ -23,6 +23,8 @@
 
 ******************************************************************************/
 
+#include <stdlib.h>
+#include <mpir.h>
 #include "flint.h"
 #include "fmpz.h"
 #include "arith.h"
@@ -72,14 +74,130 @@ _fmpz_stirling_next_row(fmpz * new, fmpz * prev, long n, long klen, int kind)
     fmpz_clear(u);
 }
 
+typedef struct
+{
+    __mpz_struct ** rows;
+    long r;
+    long c;
+    long nb;
+    long step;
+    int kind;
+}
+_stirling_mat_struct;
+
+/*
+    Fills one tile of the matrix, the t-th on the current antidiagonal of
+    an nb x nb grid of tiles. Entry (i, k) depends on (i - 1, k - 1) and
+    (i - 1, k), so the tiles on one antidiagonal only depend on earlier
+    antidiagonals.
+*/
+static void
+_stirling_mat_tile_worker(void * arg, long t)
+{
+    _stirling_mat_struct * s = (_stirling_mat_struct *) arg;
+    __mpz_struct ** rows = s->rows;
+    long a, b, i, i0, i1, k, k0, k1;
+
+    a = FLINT_MAX(0, s->step - s->nb + 1) + t;
+    b = s->step - a;
+
+    i0 = FLINT_MAX(1, (a * s->r) / s->nb);
+    i1 = ((a + 1) * s->r) / s->nb;
+    k0 = (b * s->c) / s->nb;
+    k1 = ((b + 1) * s->c) / s->nb;
+
+    for (i = i0; i < i1; i++)
+    {
+        for (k = FLINT_MAX(k0, 1); k < FLINT_MIN(k1, i); k++)
+        {
+            switch (s->kind)
+            {
+            case 0:
+                mpz_mul_ui(rows[i] + k, rows[i - 1] + k, i - 1UL);
+                mpz_add(rows[i] + k, rows[i] + k, rows[i - 1] + k - 1);
+                break;
+            case 1:
+                mpz_mul_ui(rows[i] + k, rows[i - 1] + k, i - 1UL);
+                mpz_sub(rows[i] + k, rows[i - 1] + k - 1, rows[i] + k);
+                break;
+            case 2:
+                mpz_mul_ui(rows[i] + k, rows[i - 1] + k, k);
+                mpz_add(rows[i] + k, rows[i] + k, rows[i - 1] + k - 1);
+                break;
+            }
+        }
+
+        if (i >= k0 && i < k1)
+            mpz_set_ui(rows[i] + i, 1UL);
+    }
+}
+
+/*
+    Computes the matrix with mpz entries in parallel, sweeping the tiles
+    antidiagonal by antidiagonal, then moves the entries into the fmpz
+    matrix in the main thread.
+*/
+static void
+_fmpz_stirling_mat_parallel(fmpz ** rows, long r, long c, int kind,
+                                                        long num_threads)
+{
+    _stirling_mat_struct s;
+    __mpz_struct * entries;
+    long i, j, num;
+
+    entries = malloc(r * c * sizeof(__mpz_struct));
+    s.rows = malloc(r * sizeof(__mpz_struct *));
+    for (i = 0; i < r * c; i++)
+        mpz_init(entries + i);
+    for (i = 0; i < r; i++)
+        s.rows[i] = entries + i * c;
+
+    mpz_set_ui(s.rows[0], 1UL);
+
+    s.r = r;
+    s.c = c;
+    s.nb = STIRLING_MAT_PARALLEL_TILES * num_threads;
+    s.kind = kind;
+
+    for (s.step = 0; s.step < 2 * s.nb - 1; s.step++)
+    {
+        num = FLINT_MIN(s.step, s.nb - 1)
+            - FLINT_MAX(0, s.step - s.nb + 1) + 1;
+
+        flint_parallel_do(_stirling_mat_tile_worker, &s, num, num_threads);
+    }
+
+    for (i = 0; i < r; i++)
+    {
+        for (j = 0; j < c; j++)
+        {
+            mpz_swap(_fmpz_promote(rows[i] + j), s.rows[i] + j);
+            _fmpz_demote_val(rows[i] + j);
+            mpz_clear(s.rows[i] + j);
+        }
+    }
+
+    free(s.rows);
+    free(entries);
+}
+
 static void
 _fmpz_stirling_mat(fmpz ** rows, long r, long c, int kind)
 {
+    long num_threads;
     long i, j;
 
     if (r == 0 || c == 0)
         return;
 
+    num_threads = flint_get_num_threads();
+
+    if (num_threads > 1 && FLINT_MIN(r, c) >= STIRLING_MAT_PARALLEL_CUTOFF)
+    {
+        _fmpz_stirling_mat_parallel(rows, r, c, kind, num_threads);
+        return;
+    }
+
     fmpz_one(rows[0]);
     for (i = 1; i < c; i++)
         fmpz_zero(rows[0] + i);
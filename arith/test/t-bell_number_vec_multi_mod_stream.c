@@ -0,0 +1,101 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "arith.h"
+#include "fmpz_vec.h"
+#include "ulong_extras.h"
+
+typedef struct
+{
+    fmpz * vec;
+    long next;
+}
+stream_struct;
+
+static void
+collect(const fmpz * vec, long start, long len, void * data)
+{
+    stream_struct * s = (stream_struct *) data;
+
+    if (start != s->next || len < 1)
+    {
+        printf("FAIL (block):\n");
+        printf("start = %ld, len = %ld, expected start = %ld\n",
+            start, len, s->next);
+        abort();
+    }
+
+    _fmpz_vec_set(s->vec + start, vec, len);
+    s->next = start + len;
+}
+
+int main(void)
+{
+    flint_rand_t state;
+    stream_struct s;
+    fmpz * b1;
+    fmpz * b2;
+    long n, block;
+
+    const long maxn = 1000;
+
+    printf("bell_number_vec_multi_mod_stream....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    b1 = _fmpz_vec_init(maxn);
+    b2 = _fmpz_vec_init(maxn);
+
+    for (n = 0; n < maxn; n += (n < 50) ? + 1 : n/4)
+    {
+        block = n_randint(state, n + 3) + 1;
+
+        bell_number_vec_recursive(b1, n);
+
+        _fmpz_vec_zero(b2, n);
+        s.vec = b2;
+        s.next = 0;
+
+        flint_set_num_threads(n_randint(state, 4) + 1);
+        bell_number_vec_multi_mod_stream(n, block, collect, &s);
+        flint_set_num_threads(1);
+
+        if (s.next != n || !_fmpz_vec_equal(b1, b2, n))
+        {
+            printf("FAIL:\n");
+            printf("n = %ld, block = %ld\n", n, block);
+            abort();
+        }
+    }
+
+    _fmpz_vec_clear(b1, maxn);
+    _fmpz_vec_clear(b2, maxn);
+
+    flint_randclear(state);
+    _fmpz_cleanup();
+    printf("PASS\n");
+    return 0;
+}
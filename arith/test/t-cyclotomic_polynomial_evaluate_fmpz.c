@@ -0,0 +1,91 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "arith.h"
+#include "fmpz.h"
+#include "fmpz_poly.h"
+#include "ulong_extras.h"
+
+int main(void)
+{
+    fmpz_poly_t P;
+    fmpz_t a, x, y;
+    ulong n;
+    long i;
+    flint_rand_t state;
+
+    printf("cyclotomic_polynomial_evaluate_fmpz....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    fmpz_poly_init(P);
+    fmpz_init(a);
+    fmpz_init(x);
+    fmpz_init(y);
+
+    for (i = 0; i < 2000; i++)
+    {
+        n = n_randint(state, 1000);
+
+        /* Mostly values close to 0, where the special cases are */
+        if (n_randint(state, 2))
+            fmpz_set_si(a, (long) n_randint(state, 7) - 3);
+        else
+            fmpz_randtest(a, state, 20);
+
+        cyclotomic_polynomial(P, n);
+        fmpz_poly_evaluate_fmpz(y, P, a);
+
+        if (n_randint(state, 2))
+        {
+            cyclotomic_polynomial_evaluate_fmpz(x, n, a);
+        }
+        else
+        {
+            fmpz_set(x, a);
+            cyclotomic_polynomial_evaluate_fmpz(x, n, x);
+        }
+
+        if (!fmpz_equal(x, y))
+        {
+            printf("FAIL:\n");
+            printf("n = %lu, a = ", n); fmpz_print(a); printf("\n");
+            printf("x = "); fmpz_print(x); printf("\n");
+            printf("y = "); fmpz_print(y); printf("\n");
+            abort();
+        }
+    }
+
+    fmpz_poly_clear(P);
+    fmpz_clear(a);
+    fmpz_clear(x);
+    fmpz_clear(y);
+
+    flint_randclear(state);
+
+    _fmpz_cleanup();
+    printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,83 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "arith.h"
+#include "fmpz.h"
+#include "fmpz_poly.h"
+#include "ulong_extras.h"
+
+int main(void)
+{
+    fmpz_poly_t P;
+    mp_limb_t a, p, x, y;
+    nmod_t mod;
+    ulong n;
+    long i;
+    flint_rand_t state;
+
+    printf("cyclotomic_polynomial_evaluate_nmod....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    fmpz_poly_init(P);
+
+    for (i = 0; i < 10000; i++)
+    {
+        n = n_randint(state, 1000);
+
+        /* Small primes often divide n or have a root of Phi_n */
+        if (n_randint(state, 4))
+            p = n_nth_prime(1 + n_randint(state, 30));
+        else
+            p = n_randtest_prime(state, 0);
+
+        /* Multiples of p are interesting as well */
+        if (n_randint(state, 4) == 0 && n != 0 && n <= 1000 / p)
+            n *= p;
+
+        nmod_init(&mod, p);
+        a = n_randint(state, p);
+
+        cyclotomic_polynomial(P, n);
+        y = fmpz_poly_evaluate_mod(P, a, p);
+        x = cyclotomic_polynomial_evaluate_nmod(n, a, mod);
+
+        if (x != y)
+        {
+            printf("FAIL:\n");
+            printf("n = %lu, a = %lu, p = %lu\n", n, a, p);
+            printf("x = %lu, y = %lu\n", x, y);
+            abort();
+        }
+    }
+
+    fmpz_poly_clear(P);
+
+    flint_randclear(state);
+
+    _fmpz_cleanup();
+    printf("PASS\n");
+    return 0;
+}
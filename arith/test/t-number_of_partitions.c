@@ -140,7 +140,9 @@ int main(void)
 
     for (i = 0; testdata[i][0] != 0; i++)
     {
+        flint_set_num_threads(n_randint(state, 4) + 1);
         number_of_partitions(p, testdata[i][0]);
+        flint_set_num_threads(1);
 
         if (fmpz_fdiv_ui(p, 1000000000) != testdata[i][1])
         {
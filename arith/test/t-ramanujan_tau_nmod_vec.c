@@ -0,0 +1,102 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "arith.h"
+#include "fmpz.h"
+#include "fmpz_poly.h"
+#include "nmod_vec.h"
+#include "ulong_extras.h"
+
+int main(void)
+{
+    flint_rand_t state;
+    fmpz_poly_t p;
+    fmpz_t k, s;
+    nmod_t mod;
+    mp_ptr r;
+    long i, n, iter;
+
+    printf("ramanujan_tau_nmod_vec....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    /* Compare with the integer values */
+    for (iter = 0; iter < 200; iter++)
+    {
+        n = n_randint(state, 300);
+        nmod_init(&mod, n_randtest_not_zero(state));
+
+        fmpz_poly_init(p);
+        r = _nmod_vec_init(n);
+
+        fmpz_poly_ramanujan_tau(p, n);
+        ramanujan_tau_nmod_vec(r, n, mod);
+
+        for (i = 0; i < n; i++)
+        {
+            if (r[i] != fmpz_fdiv_ui(p->coeffs + i, mod.n))
+            {
+                printf("FAIL:\n");
+                printf("n = %ld, mod = %lu, i = %ld\n", n, mod.n, i);
+                abort();
+            }
+        }
+
+        fmpz_poly_clear(p);
+        _nmod_vec_clear(r);
+    }
+
+    /* Ramanujan's congruence tau(n) = sigma_11(n) mod 691 */
+    n = 3000;
+    nmod_init(&mod, 691);
+    r = _nmod_vec_init(n);
+    fmpz_init(k);
+    fmpz_init(s);
+
+    ramanujan_tau_nmod_vec(r, n, mod);
+
+    for (i = 1; i < n; i++)
+    {
+        fmpz_set_ui(k, i);
+        fmpz_divisor_sigma(s, k, 11);
+
+        if (r[i] != fmpz_fdiv_ui(s, 691))
+        {
+            printf("FAIL:\n");
+            printf("tau(%ld) mod 691 = %lu\n", i, r[i]);
+            abort();
+        }
+    }
+
+    _nmod_vec_clear(r);
+    fmpz_clear(k);
+    fmpz_clear(s);
+
+    flint_randclear(state);
+    _fmpz_cleanup();
+    printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,227 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "arith.h"
+#include "fmpz_vec.h"
+#include "fmpz_mat.h"
+#include "nmod_vec.h"
+#include "nmod_mat.h"
+#include "ulong_extras.h"
+
+int main(void)
+{
+    fmpz_mat_t A, B;
+    nmod_mat_t C, D;
+    fmpz * row, * row2;
+    mp_ptr r, r2;
+    nmod_t mod;
+    mp_limb_t p;
+    long i, n, k, klen, kind;
+    flint_rand_t state;
+
+    printf("stirling_multi_mod....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    /* Rows modulo p, including primes smaller than n */
+    for (i = 0; i < 1000; i++)
+    {
+        n = n_randint(state, 150);
+        klen = n_randint(state, 170);
+        kind = n_randint(state, 3);
+        p = n_randtest_prime(state, 0);
+        nmod_init(&mod, p);
+
+        row = _fmpz_vec_init(klen);
+        r = _nmod_vec_init(klen);
+        r2 = _nmod_vec_init(klen);
+
+        for (k = 0; k < klen; k++)
+        {
+            if (kind == 0)
+                stirling_number_1u(row + k, n, k);
+            else if (kind == 1)
+                stirling_number_1(row + k, n, k);
+            else
+                stirling_number_2(row + k, n, k);
+        }
+
+        _fmpz_vec_get_nmod_vec(r, row, klen, mod);
+
+        if (kind == 0)
+            stirling_number_1u_nmod_vec(r2, n, klen, mod);
+        else if (kind == 1)
+            stirling_number_1_nmod_vec(r2, n, klen, mod);
+        else
+            stirling_number_2_nmod_vec(r2, n, klen, mod);
+
+        if (!_nmod_vec_equal(r, r2, klen))
+        {
+            printf("FAIL (nmod_vec):\n");
+            printf("kind = %ld, n = %ld, klen = %ld, p = %lu\n",
+                kind, n, klen, p);
+            abort();
+        }
+
+        _fmpz_vec_clear(row, klen);
+        _nmod_vec_clear(r);
+        _nmod_vec_clear(r2);
+    }
+
+    /* Matrices modulo p */
+    for (i = 0; i < 100; i++)
+    {
+        long rows = n_randint(state, 50);
+        long cols = n_randint(state, 50);
+
+        kind = n_randint(state, 3);
+        p = n_randtest_prime(state, 0);
+
+        fmpz_mat_init(A, rows, cols);
+        nmod_mat_init(C, rows, cols, p);
+        nmod_mat_init(D, rows, cols, p);
+
+        if (kind == 0)
+        {
+            stirling_number_1u_mat(A);
+            stirling_number_1u_nmod_mat(D);
+        }
+        else if (kind == 1)
+        {
+            stirling_number_1_mat(A);
+            stirling_number_1_nmod_mat(D);
+        }
+        else
+        {
+            stirling_number_2_mat(A);
+            stirling_number_2_nmod_mat(D);
+        }
+
+        fmpz_mat_get_nmod_mat(C, A);
+
+        if (!nmod_mat_equal(C, D))
+        {
+            printf("FAIL (nmod_mat):\n");
+            printf("kind = %ld, r = %ld, c = %ld, p = %lu\n",
+                kind, rows, cols, p);
+            abort();
+        }
+
+        fmpz_mat_clear(A);
+        nmod_mat_clear(C);
+        nmod_mat_clear(D);
+    }
+
+    /* Multimodular rows */
+    for (i = 0; i < 200; i++)
+    {
+        n = n_randint(state, 400);
+        klen = n_randint(state, 420);
+        kind = n_randint(state, 3);
+
+        row = _fmpz_vec_init(klen);
+        row2 = _fmpz_vec_init(klen);
+
+        flint_set_num_threads(n_randint(state, 4) + 1);
+
+        if (kind == 0)
+        {
+            stirling_number_1u_vec(row, n, klen);
+            stirling_number_1u_vec_multi_mod(row2, n, klen);
+        }
+        else if (kind == 1)
+        {
+            stirling_number_1_vec(row, n, klen);
+            stirling_number_1_vec_multi_mod(row2, n, klen);
+        }
+        else
+        {
+            for (k = 0; k < klen; k++)
+                stirling_number_2(row + k, n, k);
+            stirling_number_2_vec_multi_mod(row2, n, klen);
+        }
+
+        flint_set_num_threads(1);
+
+        if (!_fmpz_vec_equal(row, row2, FLINT_MIN(klen, n + 1)))
+        {
+            printf("FAIL (vec_multi_mod):\n");
+            printf("kind = %ld, n = %ld, klen = %ld\n", kind, n, klen);
+            abort();
+        }
+
+        _fmpz_vec_clear(row, klen);
+        _fmpz_vec_clear(row2, klen);
+    }
+
+    /* Matrices computed in parallel */
+    for (i = 0; i < 6; i++)
+    {
+        long rows = STIRLING_MAT_PARALLEL_CUTOFF + n_randint(state, 100);
+        long cols = STIRLING_MAT_PARALLEL_CUTOFF + n_randint(state, 100);
+
+        kind = i % 3;
+
+        fmpz_mat_init(A, rows, cols);
+        fmpz_mat_init(B, rows, cols);
+
+        /* Entries that must be overwritten */
+        fmpz_mat_randtest(B, state, 100);
+
+        if (kind == 0)
+            stirling_number_1u_mat(A);
+        else if (kind == 1)
+            stirling_number_1_mat(A);
+        else
+            stirling_number_2_mat(A);
+
+        flint_set_num_threads(n_randint(state, 3) + 2);
+
+        if (kind == 0)
+            stirling_number_1u_mat(B);
+        else if (kind == 1)
+            stirling_number_1_mat(B);
+        else
+            stirling_number_2_mat(B);
+
+        flint_set_num_threads(1);
+
+        if (!fmpz_mat_equal(A, B))
+        {
+            printf("FAIL (parallel mat):\n");
+            printf("kind = %ld, r = %ld, c = %ld\n", kind, rows, cols);
+            abort();
+        }
+
+        fmpz_mat_clear(A);
+        fmpz_mat_clear(B);
+    }
+
+    flint_randclear(state);
+
+    _fmpz_cleanup();
+    printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,175 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "fmpz_vec.h"
+#include "nmod_vec.h"
+#include "ulong_extras.h"
+#include "arith.h"
+
+#define CRT_MAX_RESOLUTION 16
+
+typedef struct
+{
+    long len;
+    const mp_limb_t * primes;
+    const long * first;
+    mp_ptr * residues;
+    void (*vec_mod_p)(mp_ptr, long, nmod_t, void *);
+    void * mod_data;
+}
+_vec_multi_mod_struct;
+
+/* Computes the sequence modulo the j-th prime, keeping only the entries
+   from first[j] onwards, as the earlier ones do not need this prime */
+static void
+_vec_multi_mod_worker(void * arg, long j)
+{
+    _vec_multi_mod_struct * s = (_vec_multi_mod_struct *) arg;
+    mp_ptr t;
+    nmod_t mod;
+
+    nmod_init(&mod, s->primes[j]);
+    t = _nmod_vec_init(s->len);
+    s->vec_mod_p(t, s->len, mod, s->mod_data);
+
+    s->residues[j] = _nmod_vec_init(s->len - s->first[j]);
+    _nmod_vec_set(s->residues[j], t + s->first[j], s->len - s->first[j]);
+
+    _nmod_vec_clear(t);
+}
+
+void
+_arith_vec_multi_mod_stream(long len, const long * bits,
+    void (*vec_mod_p)(mp_ptr, long, nmod_t, void *), void * mod_data,
+    int sign, long block,
+    void (*func)(fmpz *, long, long, void *), void * data)
+{
+    fmpz_comb_t comb[CRT_MAX_RESOLUTION];
+    long cstart[CRT_MAX_RESOLUTION + 1];
+    _vec_multi_mod_struct s;
+    mp_limb_t * primes;
+    mp_ptr * residues, * rptr;
+    long * first;
+    fmpz * vec;
+    long i, j, k, c0, c1, a, b, need, max_bits, prime_bits;
+    long num_primes, num_combs, resolution;
+
+    if (len < 1)
+        return;
+
+    prime_bits = FLINT_BITS - 1;
+
+    for (k = 0, max_bits = 1; k < len; k++)
+        max_bits = FLINT_MAX(max_bits, bits[k]);
+    num_primes = (max_bits + prime_bits - 1) / prime_bits;
+
+    primes = malloc(num_primes * sizeof(mp_limb_t));
+    primes[0] = n_nextprime(1UL << prime_bits, 0);
+    for (j = 1; j < num_primes; j++)
+        primes[j] = n_nextprime(primes[j - 1], 0);
+
+    /*
+        Combs of increasing size, each used for a range of consecutive
+        entries; the entries in [cstart[i], cstart[i + 1]) are reconstructed
+        with comb[i]. The bit sizes are made nondecreasing first.
+     */
+    resolution = FLINT_MAX(1, FLINT_MIN(CRT_MAX_RESOLUTION, len / 16));
+    num_combs = 0;
+    for (i = 0; i < resolution; i++)
+    {
+        j = FLINT_MAX(1, num_primes * (i + 1) / resolution);
+        if (num_combs == 0 || comb[num_combs - 1]->num_primes < j)
+            fmpz_comb_init(comb[num_combs++], primes, j);
+    }
+
+    cstart[0] = 0;
+    for (i = 0, k = 0, max_bits = 1; i < num_combs; i++)
+    {
+        for ( ; k < len; k++)
+        {
+            max_bits = FLINT_MAX(max_bits, bits[k]);
+            need = (max_bits + prime_bits - 1) / prime_bits;
+            if (need > comb[i]->num_primes)
+                break;
+        }
+        cstart[i + 1] = k;
+    }
+
+    /* The first entry using each prime */
+    first = malloc(num_primes * sizeof(long));
+    for (i = 0, j = 0; i < num_combs; i++)
+        for ( ; j < comb[i]->num_primes; j++)
+            first[j] = cstart[i];
+
+    /* Residues, one prime per task */
+    residues = malloc(num_primes * sizeof(mp_ptr));
+    s.len = len;
+    s.primes = primes;
+    s.first = first;
+    s.residues = residues;
+    s.vec_mod_p = vec_mod_p;
+    s.mod_data = mod_data;
+
+    flint_parallel_do(_vec_multi_mod_worker, &s, num_primes,
+                                                    flint_get_num_threads());
+
+    /* Reconstruction, one block of entries at a time */
+    block = FLINT_MAX(1, FLINT_MIN(block, len));
+    vec = _fmpz_vec_init(block);
+    rptr = malloc(num_primes * sizeof(mp_ptr));
+
+    for (c0 = 0; c0 < len; c0 = c1)
+    {
+        c1 = FLINT_MIN(len, c0 + block);
+
+        for (i = 0; i < num_combs; i++)
+        {
+            a = FLINT_MAX(c0, cstart[i]);
+            b = FLINT_MIN(c1, cstart[i + 1]);
+
+            if (a >= b)
+                continue;
+
+            for (j = 0; j < comb[i]->num_primes; j++)
+                rptr[j] = residues[j] + (a - first[j]);
+
+            _fmpz_vec_multi_CRT_ui(vec + (a - c0), rptr, b - a, comb[i], sign);
+        }
+
+        func(vec, c0, c1 - c0, data);
+    }
+
+    _fmpz_vec_clear(vec, block);
+    free(rptr);
+
+    for (j = 0; j < num_primes; j++)
+        _nmod_vec_clear(residues[j]);
+    for (i = 0; i < num_combs; i++)
+        fmpz_comb_clear(comb[i]);
+
+    free(residues);
+    free(first);
+    free(primes);
+}
@@ -0,0 +1,258 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#define _POSIX_C_SOURCE 200112L  /* for fileno, mmap and sysconf */
+
+#undef ulong /* interferes with system includes */
+#include <stdio.h>
+#include <string.h>
+#include <limits.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#define ulong unsigned long
+
+#include <mpir.h>
+#include "flint.h"
+
+/*
+    Layout of the header:
+
+        bytes 0-7     the magic string "FLINTBIN"
+        byte 8        FLINT_BIN_VERSION
+        byte 9        number of bytes per limb
+        byte 10       byte order of the writer, 1 (little) or 2 (big endian)
+        byte 11       type of the object
+        bytes 12-15   zero
+        bytes 16-     the limbs r, c, mod, num_big and num_limbs
+
+    padded with zeros to FLINT_BIN_HEADER_BYTES bytes. For polynomials r
+    is the length and c is 1. Entries of nmod types are stored as r c
+    limbs. Entries of fmpz types are stored as r c limbs holding the
+    values of small entries and zero for large entries, followed by an
+    index of num_big pairs (position, signed size) of the large entries,
+    followed by their num_limbs limbs.
+ */
+
+static const char _flint_bin_magic[8] = "FLINTBIN";
+
+#define FLINT_BIN_LIMB_OFFSET 16
+
+static int
+_flint_bin_byte_order(void)
+{
+    mp_limb_t x = 1UL;
+    return (*((unsigned char *) &x) == 1) ? 1 : 2;
+}
+
+static mp_limb_t
+_flint_bin_swap_limb(mp_limb_t x)
+{
+    mp_limb_t y = 0UL;
+    int i;
+
+    for (i = 0; i < (int) sizeof(mp_limb_t); i++)
+    {
+        y = (y << 8) | (x & 0xffUL);
+        x >>= 8;
+    }
+
+    return y;
+}
+
+static int
+_flint_bin_parse_header(flint_bin_header_t h, const unsigned char * buf)
+{
+    mp_limb_t x[5], max, n;
+    int i;
+
+    if (memcmp(buf, _flint_bin_magic, 8) != 0
+        || buf[8] != FLINT_BIN_VERSION || buf[9] != sizeof(mp_limb_t)
+        || (buf[10] != 1 && buf[10] != 2)
+        || buf[11] < FLINT_BIN_FMPZ_POLY || buf[11] > FLINT_BIN_NMOD_MAT)
+        return 0;
+
+    h->type = buf[11];
+    h->swap = (buf[10] != _flint_bin_byte_order());
+
+    memcpy(x, buf + FLINT_BIN_LIMB_OFFSET, sizeof(x));
+    if (h->swap)
+        for (i = 0; i < 5; i++)
+            x[i] = _flint_bin_swap_limb(x[i]);
+
+    h->r = x[0];
+    h->c = x[1];
+    h->mod = x[2];
+    h->num_big = x[3];
+    h->num_limbs = x[4];
+
+    /* The header may come from an untrusted file; reject sizes whose
+       number of limbs, or of bytes, would not fit in a long */
+    max = (LONG_MAX - FLINT_BIN_HEADER_BYTES) / sizeof(mp_limb_t);
+    if (h->r > max || h->c > max || (h->c != 0 && h->r > max / h->c))
+        return 0;
+
+    n = h->r * h->c;
+    if (h->num_big > (max - n) / 2)
+        return 0;
+
+    n += 2 * h->num_big;
+    if (h->num_limbs > max - n)
+        return 0;
+
+    return 1;
+}
+
+void
+flint_bin_header_init(flint_bin_header_t h, int type,
+                                mp_limb_t r, mp_limb_t c, mp_limb_t mod)
+{
+    h->type = type;
+    h->swap = 0;
+    h->r = r;
+    h->c = c;
+    h->mod = mod;
+    h->num_big = 0;
+    h->num_limbs = 0;
+}
+
+int
+flint_bin_write_header(FILE * file, const flint_bin_header_t h)
+{
+    unsigned char buf[FLINT_BIN_HEADER_BYTES];
+    mp_limb_t x[5];
+
+    memset(buf, 0, FLINT_BIN_HEADER_BYTES);
+    memcpy(buf, _flint_bin_magic, 8);
+    buf[8] = FLINT_BIN_VERSION;
+    buf[9] = sizeof(mp_limb_t);
+    buf[10] = _flint_bin_byte_order();
+    buf[11] = h->type;
+
+    x[0] = h->r;
+    x[1] = h->c;
+    x[2] = h->mod;
+    x[3] = h->num_big;
+    x[4] = h->num_limbs;
+    memcpy(buf + FLINT_BIN_LIMB_OFFSET, x, sizeof(x));
+
+    return fwrite(buf, 1, FLINT_BIN_HEADER_BYTES, file)
+                                            == FLINT_BIN_HEADER_BYTES;
+}
+
+int
+flint_bin_read_header(flint_bin_header_t h, FILE * file)
+{
+    unsigned char buf[FLINT_BIN_HEADER_BYTES];
+
+    if (fread(buf, 1, FLINT_BIN_HEADER_BYTES, file) != FLINT_BIN_HEADER_BYTES)
+        return 0;
+
+    return _flint_bin_parse_header(h, buf);
+}
+
+size_t
+flint_bin_size(const flint_bin_header_t h)
+{
+    mp_limb_t n = h->r * h->c;
+
+    if (h->type == FLINT_BIN_FMPZ_POLY || h->type == FLINT_BIN_FMPZ_MAT)
+        n += 2 * h->num_big + h->num_limbs;
+
+    return FLINT_BIN_HEADER_BYTES + n * sizeof(mp_limb_t);
+}
+
+int
+flint_bin_write_limbs(FILE * file, mp_srcptr x, long n)
+{
+    return fwrite(x, sizeof(mp_limb_t), n, file) == (size_t) n;
+}
+
+int
+flint_bin_read_limbs(mp_ptr x, long n, FILE * file,
+                                            const flint_bin_header_t h)
+{
+    long i;
+
+    if (fread(x, sizeof(mp_limb_t), n, file) != (size_t) n)
+        return 0;
+
+    if (h->swap)
+        for (i = 0; i < n; i++)
+            x[i] = _flint_bin_swap_limb(x[i]);
+
+    return 1;
+}
+
+void *
+flint_bin_mmap(FILE * file, const flint_bin_header_t h)
+{
+    long page, pos, start;
+    size_t size;
+    struct stat st;
+    char * map;
+
+    if (h->swap)
+        return NULL;
+
+    page = sysconf(_SC_PAGESIZE);
+    pos = ftell(file) - FLINT_BIN_HEADER_BYTES;
+    if (pos < 0)
+        return NULL;
+
+    start = pos - pos % page;
+    size = flint_bin_size(h);
+
+    /* Accessing a mapping beyond the end of the file is fatal */
+    if (fstat(fileno(file), &st) != 0 || st.st_size < pos
+        || (off_t) size > st.st_size - pos)
+        return NULL;
+
+    /* Private mapping, so that the object can be modified in memory */
+    map = mmap(NULL, size + (pos - start), PROT_READ | PROT_WRITE,
+                                        MAP_PRIVATE, fileno(file), start);
+    if (map == MAP_FAILED)
+        return NULL;
+
+    if (fseek(file, pos + size, SEEK_SET) != 0)
+    {
+        munmap(map, size + (pos - start));
+        return NULL;
+    }
+
+    return map + (pos - start) + FLINT_BIN_HEADER_BYTES;
+}
+
+void
+flint_bin_munmap(void * data)
+{
+    flint_bin_header_t h;
+    unsigned char * header;
+    size_t page, offset;
+
+    header = (unsigned char *) data - FLINT_BIN_HEADER_BYTES;
+    _flint_bin_parse_header(h, header);
+
+    page = sysconf(_SC_PAGESIZE);
+    offset = ((size_t) header) % page;
+
+    munmap(header - offset, flint_bin_size(h) + offset);
+}
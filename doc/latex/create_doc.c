@@ -42,6 +42,8 @@ static char * docsin[] = {
     "../../nmod_mat/doc/nmod_mat.txt",
     "../../nmod_poly/doc/nmod_poly.txt",
     "../../nmod_poly_mat/doc/nmod_poly_mat.txt",
+    "../../gf2_mat/doc/gf2_mat.txt",
+    "../../nmod_sparse_mat/doc/nmod_sparse_mat.txt",
     "../../fmpz_mod_poly/doc/fmpz_mod_poly.txt",
     "../../padic/doc/padic.txt", 
     "../../arith/doc/arith.txt", 
@@ -66,6 +68,8 @@ static char * docsout[] = {
     "input/nmod_mat.tex",
     "input/nmod_poly.tex",
     "input/nmod_poly_mat.tex",
+    "input/gf2_mat.tex",
+    "input/nmod_sparse_mat.tex",
     "input/fmpz_mod_poly.tex",
     "input/padic.tex", 
     "input/arith.tex", 
@@ -26,6 +26,10 @@
 #ifndef FLINT_H
 #define FLINT_H
 
+#undef ulong /* interferes with system includes */
+#include <stdio.h>
+#define ulong unsigned long
+
 #include <mpir.h>
 #include <mpfr.h>
 #include "longlong.h"
@@ -41,6 +45,59 @@
 
 extern char version[];
 
+int flint_get_num_threads(void);
+
+void flint_set_num_threads(int num_threads);
+
+void flint_parallel_do(void (*func)(void *, long), void * data, long n,
+                                                            int num_threads);
+
+/*
+    Binary serialisation. An object is stored as a header of
+    FLINT_BIN_HEADER_BYTES bytes followed by arrays of limbs in the byte
+    order of the machine that wrote it.
+ */
+
+#define FLINT_BIN_VERSION 1
+#define FLINT_BIN_HEADER_BYTES 64
+
+#define FLINT_BIN_FMPZ_POLY 1
+#define FLINT_BIN_FMPZ_MAT 2
+#define FLINT_BIN_NMOD_POLY 3
+#define FLINT_BIN_NMOD_MAT 4
+
+typedef struct
+{
+    int type;
+    int swap;               /* written with the opposite byte order */
+    mp_limb_t r;
+    mp_limb_t c;
+    mp_limb_t mod;
+    mp_limb_t num_big;      /* number of fmpz entries stored as limbs */
+    mp_limb_t num_limbs;    /* total number of limbs of these entries */
+}
+flint_bin_header_struct;
+
+typedef flint_bin_header_struct flint_bin_header_t[1];
+
+void flint_bin_header_init(flint_bin_header_t h, int type,
+                                mp_limb_t r, mp_limb_t c, mp_limb_t mod);
+
+int flint_bin_write_header(FILE * file, const flint_bin_header_t h);
+
+int flint_bin_read_header(flint_bin_header_t h, FILE * file);
+
+size_t flint_bin_size(const flint_bin_header_t h);
+
+int flint_bin_write_limbs(FILE * file, mp_srcptr x, long n);
+
+int flint_bin_read_limbs(mp_ptr x, long n, FILE * file,
+                                            const flint_bin_header_t h);
+
+void * flint_bin_mmap(FILE * file, const flint_bin_header_t h);
+
+void flint_bin_munmap(void * data);
+
 #define ulong unsigned long
 
 #if __GMP_BITS_PER_MP_LIMB == 64
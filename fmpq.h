@@ -269,6 +269,12 @@ int
 fmpq_reconstruct_fmpz_2(fmpq_t res, const fmpz_t a, const fmpz_t m,
                                         const fmpz_t N, const fmpz_t D);
 
+int _fmpq_reconstruct_fmpz_vec_2(fmpz * num, fmpz_t den, const fmpz * a,
+    long len, const fmpz_t m, const fmpz_t N, const fmpz_t D);
+
+int _fmpq_reconstruct_fmpz_vec(fmpz * num, fmpz_t den, const fmpz * a,
+    long len, const fmpz_t m);
+
 mp_bitcnt_t fmpq_height_bits(const fmpq_t x);
 
 void fmpq_height(fmpz_t height, const fmpq_t x);
@@ -331,7 +337,25 @@ void fmpq_bsplit_sum_pq(fmpq_bsplit_t s, const fmpq * pq, long n1, long n2);
 void fmpq_bsplit_sum_abpq(fmpq_bsplit_t s,
         const fmpq * ab, const fmpq * pq, long n1, long n2);
 
+/* Remove common factors of P and Q while merging */
+#define FMPQ_BSPLIT_REMOVE_GCD 1
+
+void _fmpq_bsplit_sum(fmpq_bsplit_t s, const fmpq * ab, const fmpq * cd,
+                            const fmpq * pq, long n1, long n2, int flags);
+
 void fmpq_bsplit_sum_abcdpq(fmpq_bsplit_t s,
         const fmpq * ab, const fmpq * cd, const fmpq * pq, long n1, long n2);
 
+/* Number of bits of the modulus above which rational reconstruction
+   uses the half-gcd */
+#define FMPQ_RECONSTRUCT_HGCD_CUTOFF 128
+
+/* Number of terms above which binary splitting computes the two halves
+   of a sum in separate threads */
+#define FMPQ_BSPLIT_PARALLEL_CUTOFF 256
+
+/* Size in limbs of the right denominator above which common factors are
+   no longer removed while merging */
+#define FMPQ_BSPLIT_GCD_MAX_LIMBS 64
+
 #endif
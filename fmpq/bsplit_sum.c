@@ -0,0 +1,313 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "fmpq.h"
+
+/*
+    The recursion works on mpz's, so that subtrees can be computed in
+    separate threads without going through the fmpz memory manager.
+    Which of the fields are used depends on which of ab and cd are given.
+ */
+typedef struct
+{
+    mpz_t P, Q, B, T, C, D, V;
+}
+_bsplit_mpz_struct;
+
+typedef struct
+{
+    const fmpq * ab;
+    const fmpq * cd;
+    const fmpq * pq;
+    int flags;
+}
+_bsplit_series_struct;
+
+typedef struct
+{
+    _bsplit_mpz_struct * s;     /* two results */
+    const _bsplit_series_struct * series;
+    long n1, m, n2;
+    int threads[2];
+}
+_bsplit_fork_struct;
+
+static void
+_bsplit_rec(_bsplit_mpz_struct * s, const _bsplit_series_struct * series,
+                                            long n1, long n2, int threads);
+
+static void
+_bsplit_mpz_init(_bsplit_mpz_struct * s)
+{
+    mpz_init(s->P);
+    mpz_init(s->Q);
+    mpz_init(s->B);
+    mpz_init(s->T);
+    mpz_init(s->C);
+    mpz_init(s->D);
+    mpz_init(s->V);
+}
+
+static void
+_bsplit_mpz_clear(_bsplit_mpz_struct * s)
+{
+    mpz_clear(s->P);
+    mpz_clear(s->Q);
+    mpz_clear(s->B);
+    mpz_clear(s->T);
+    mpz_clear(s->C);
+    mpz_clear(s->D);
+    mpz_clear(s->V);
+}
+
+static void
+_bsplit_leaf(_bsplit_mpz_struct * s, const _bsplit_series_struct * series,
+                                                                    long k)
+{
+    const fmpq * pq = series->pq + k;
+
+    fmpz_get_mpz(s->P, fmpq_numref(pq));
+    fmpz_get_mpz(s->Q, fmpq_denref(pq));
+
+    if (series->ab == NULL)
+    {
+        mpz_set(s->T, s->P);
+    }
+    else
+    {
+        const fmpq * ab = series->ab + k;
+
+        fmpz_get_mpz(s->B, fmpq_denref(ab));
+        fmpz_get_mpz(s->T, fmpq_numref(ab));
+
+        if (series->cd != NULL)
+        {
+            const fmpq * cd = series->cd + k;
+
+            fmpz_get_mpz(s->C, fmpq_numref(cd));
+            fmpz_get_mpz(s->D, fmpq_denref(cd));
+            mpz_mul(s->V, s->T, s->C);
+            mpz_mul(s->V, s->V, s->P);
+        }
+
+        mpz_mul(s->T, s->T, s->P);
+    }
+}
+
+/*
+    Merges R into L, clearing the parts of R as soon as they are no longer
+    needed. A common factor g of LP and RQ divides every term of the merged
+    P, Q, T and V, and removing it from LP and RQ beforehand leaves both the
+    sums and the ratio P / Q unchanged.
+ */
+static void
+_bsplit_merge(_bsplit_mpz_struct * L, _bsplit_mpz_struct * R,
+                                    const _bsplit_series_struct * series)
+{
+    mpz_t t, u, v;
+
+    if ((series->flags & FMPQ_BSPLIT_REMOVE_GCD) &&
+        mpz_size(R->Q) <= FMPQ_BSPLIT_GCD_MAX_LIMBS)
+    {
+        mpz_init(t);
+        mpz_gcd(t, L->P, R->Q);
+        if (mpz_cmp_ui(t, 1UL) != 0)
+        {
+            mpz_divexact(L->P, L->P, t);
+            mpz_divexact(R->Q, R->Q, t);
+        }
+        mpz_clear(t);
+    }
+
+    if (series->ab == NULL)
+    {
+        /* T = LT RQ + LP RT */
+        mpz_mul(L->T, L->T, R->Q);
+        mpz_addmul(L->T, L->P, R->T);
+        mpz_realloc2(R->T, 0);
+    }
+    else if (series->cd == NULL)
+    {
+        /* T = LT RB RQ + LB LP RT */
+        if (mpz_cmp_ui(R->B, 1UL) != 0)
+            mpz_mul(L->T, L->T, R->B);
+        mpz_mul(L->T, L->T, R->Q);
+
+        if (mpz_cmp_ui(L->B, 1UL) != 0)
+            mpz_mul(R->T, R->T, L->B);
+        mpz_addmul(L->T, R->T, L->P);
+        mpz_realloc2(R->T, 0);
+
+        mpz_mul(L->B, L->B, R->B);
+        mpz_realloc2(R->B, 0);
+    }
+    else
+    {
+        mpz_init(t);
+        mpz_init(u);
+        mpz_init(v);
+
+        /* T = LB LP RT + RB RQ LT */
+        mpz_mul(u, L->B, L->P);
+        mpz_mul(t, u, R->T);
+        mpz_realloc2(R->T, 0);
+        mpz_mul(v, R->B, R->Q);
+        mpz_mul(L->T, L->T, v);
+        mpz_add(L->T, L->T, t);
+
+        /* V = RD (RB RQ LV + LC LB LP RT) + LD LB LP RV */
+        mpz_mul(u, u, R->V);
+        mpz_realloc2(R->V, 0);
+        mpz_mul(u, u, L->D);
+        mpz_mul(v, v, L->V);
+        mpz_addmul(v, t, L->C);
+        mpz_mul(v, v, R->D);
+        mpz_add(L->V, u, v);
+
+        mpz_clear(t);
+        mpz_clear(u);
+        mpz_clear(v);
+
+        /* C = LC RD + RC LD */
+        mpz_mul(L->C, L->C, R->D);
+        mpz_addmul(L->C, R->C, L->D);
+        mpz_realloc2(R->C, 0);
+
+        mpz_mul(L->D, L->D, R->D);
+        mpz_realloc2(R->D, 0);
+        mpz_mul(L->B, L->B, R->B);
+        mpz_realloc2(R->B, 0);
+    }
+
+    mpz_mul(L->Q, L->Q, R->Q);
+    mpz_realloc2(R->Q, 0);
+    mpz_mul(L->P, L->P, R->P);
+    mpz_realloc2(R->P, 0);
+}
+
+static void
+_bsplit_fork_worker(void * arg, long i)
+{
+    _bsplit_fork_struct * f = (_bsplit_fork_struct *) arg;
+
+    if (i == 0)
+        _bsplit_rec(f->s, f->series, f->n1, f->m, f->threads[0]);
+    else
+        _bsplit_rec(f->s + 1, f->series, f->m, f->n2, f->threads[1]);
+}
+
+static void
+_bsplit_rec(_bsplit_mpz_struct * s, const _bsplit_series_struct * series,
+                                            long n1, long n2, int threads)
+{
+    if (n2 - n1 == 1)
+    {
+        _bsplit_leaf(s, series, n1);
+    }
+    else
+    {
+        _bsplit_mpz_struct R[2];
+        long m = (n1 + n2) / 2;
+
+        _bsplit_mpz_init(R + 1);
+
+        if (threads > 1 && n2 - n1 >= FMPQ_BSPLIT_PARALLEL_CUTOFF)
+        {
+            _bsplit_fork_struct f;
+
+            R[0] = *s;
+            f.s = R;
+            f.series = series;
+            f.n1 = n1;
+            f.m = m;
+            f.n2 = n2;
+            f.threads[0] = (threads + 1) / 2;
+            f.threads[1] = threads / 2;
+
+            flint_parallel_do(_bsplit_fork_worker, &f, 2, 2);
+
+            *s = R[0];
+        }
+        else
+        {
+            _bsplit_rec(s, series, n1, m, 1);
+            _bsplit_rec(R + 1, series, m, n2, 1);
+        }
+
+        _bsplit_merge(s, R + 1, series);
+        _bsplit_mpz_clear(R + 1);
+    }
+}
+
+static void
+_bsplit_move(fmpz_t f, mpz_t z)
+{
+    mpz_swap(_fmpz_promote(f), z);
+    _fmpz_demote_val(f);
+}
+
+void
+_fmpq_bsplit_sum(fmpq_bsplit_t s, const fmpq * ab, const fmpq * cd,
+                            const fmpq * pq, long n1, long n2, int flags)
+{
+    _bsplit_series_struct series;
+    _bsplit_mpz_struct r;
+
+    if (n2 <= n1)
+    {
+        if (cd == NULL)
+        {
+            fmpz_zero(s->P);
+            fmpz_one(s->Q);
+        }
+        return;
+    }
+
+    series.ab = ab;
+    series.cd = (ab == NULL) ? NULL : cd;
+    series.pq = pq;
+    series.flags = flags;
+
+    _bsplit_mpz_init(&r);
+    _bsplit_rec(&r, &series, n1, n2, flint_get_num_threads());
+
+    _bsplit_move(s->P, r.P);
+    _bsplit_move(s->Q, r.Q);
+    _bsplit_move(s->T, r.T);
+
+    if (ab != NULL)
+    {
+        _bsplit_move(s->B, r.B);
+
+        if (cd != NULL)
+        {
+            _bsplit_move(s->C, r.C);
+            _bsplit_move(s->D, r.D);
+            _bsplit_move(s->V, r.V);
+        }
+    }
+
+    _bsplit_mpz_clear(&r);
+}
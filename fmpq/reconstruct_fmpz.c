@@ -26,6 +26,7 @@
 #include <mpir.h>
 #include "flint.h"
 #include "fmpz.h"
+#include "fmpz_vec.h"
 #include "fmpq.h"
 #include "ulong_extras.h"
 
@@ -62,6 +63,30 @@ _fmpq_reconstruct_fmpz_2(fmpz_t n, fmpz_t d,
     fmpz_set(r, m); fmpz_zero(s);
     fmpz_set(n, a); fmpz_one(d);
 
+    /* Skip ahead to the first remainder with no more bits than N. If the
+       remainders are (r, n) = M^(-1) (m, a), the cofactors of a are
+       given up to sign by the first row of M. */
+    if (fmpz_bits(m) >= FMPQ_RECONSTRUCT_HGCD_CUTOFF)
+    {
+        fmpz * M = _fmpz_vec_init(4);
+
+        fmpz_one(M + 0);
+        fmpz_one(M + 3);
+
+        if (_fmpz_hgcd(M, r, n, fmpz_bits(N)) > 0)
+        {
+            fmpz_swap(d, M + 0);
+            fmpz_neg(s, M + 1);
+        }
+        else
+        {
+            fmpz_neg(d, M + 0);
+            fmpz_swap(s, M + 1);
+        }
+
+        _fmpz_vec_clear(M, 4);
+    }
+
     while (fmpz_cmpabs(n, N) > 0)
     {
         fmpz_fdiv_q(q, r, n);
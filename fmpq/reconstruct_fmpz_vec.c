@@ -0,0 +1,111 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <mpir.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "fmpz_vec.h"
+#include "fmpq.h"
+
+int
+_fmpq_reconstruct_fmpz_vec_2(fmpz * num, fmpz_t den, const fmpz * a,
+    long len, const fmpz_t m, const fmpz_t N, const fmpz_t D)
+{
+    fmpz_t h, t, q, g;
+    long i;
+    int success = 1;
+
+    fmpz_init(h);
+    fmpz_init(t);
+    fmpz_init(q);
+    fmpz_init(g);
+
+    fmpz_fdiv_q_2exp(h, m, 1);
+    fmpz_one(den);
+
+    for (i = 0; i < len; i++)
+    {
+        /* Reconstruct den a_i = t / q, sharing the denominator found so
+           far; den q is then the least common denominator, as q is
+           coprime to t. If den a_i is congruent to a small integer t,
+           then q = 1 and no reconstruction is needed */
+        fmpz_mul(g, den, a + i);
+        fmpz_mod(g, g, m);
+        if (fmpz_cmp(g, h) > 0)
+            fmpz_sub(t, g, m);
+        else
+            fmpz_set(t, g);
+
+        if (fmpz_cmpabs(t, N) <= 0)
+        {
+            fmpz_swap(num + i, t);
+            continue;
+        }
+
+        if (_fmpq_reconstruct_fmpz_2(t, q, g, m, N, D))
+        {
+            if (!fmpz_is_one(q))
+                _fmpz_vec_scalar_mul_fmpz(num, num, i, q);
+            fmpz_swap(num + i, t);
+            fmpz_mul(den, den, q);
+            continue;
+        }
+
+        /* Otherwise the numerator of den a_i may be too large, so try
+           a_i on its own and set den <- lcm(den, q) */
+        if (!_fmpq_reconstruct_fmpz_2(t, q, a + i, m, N, D))
+        {
+            success = 0;
+            break;
+        }
+
+        fmpz_gcd(g, den, q);
+        fmpz_divexact(q, q, g);
+        fmpz_divexact(g, den, g);
+
+        if (!fmpz_is_one(q))
+            _fmpz_vec_scalar_mul_fmpz(num, num, i, q);
+        fmpz_mul(num + i, t, g);
+        fmpz_mul(den, den, q);
+    }
+
+    fmpz_clear(h);
+    fmpz_clear(t);
+    fmpz_clear(q);
+    fmpz_clear(g);
+
+    return success;
+}
+
+int
+_fmpq_reconstruct_fmpz_vec(fmpz * num, fmpz_t den, const fmpz * a,
+    long len, const fmpz_t m)
+{
+    fmpz_t N;
+    int result;
+
+    fmpz_init(N);
+    fmpz_fdiv_q_2exp(N, m, 1);
+    fmpz_sqrt(N, N);
+    result = _fmpq_reconstruct_fmpz_vec_2(num, den, a, len, m, N, N);
+    fmpz_clear(N);
+
+    return result;
+}
@@ -0,0 +1,130 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "fmpq.h"
+#include "fmpz_vec.h"
+#include "ulong_extras.h"
+
+int
+main(void)
+{
+    int i;
+    flint_rand_t state;
+    flint_randinit(state);
+
+    printf("bsplit_sum....");
+    fflush(stdout);
+
+    /* Compare threaded and reduced sums with the serial ones */
+    for (i = 0; i < 300; i++)
+    {
+        fmpq *ab, *cd, *pq;
+        fmpq_t s1, s2;
+        fmpq_bsplit_t sum1, sum2;
+        long k, n;
+        int type, flags;
+
+        n = n_randint(state, 2 * FMPQ_BSPLIT_PARALLEL_CUTOFF + 10);
+        type = n_randint(state, 3);
+        flags = n_randint(state, 2) ? FMPQ_BSPLIT_REMOVE_GCD : 0;
+
+        ab = _fmpq_vec_init(n);
+        cd = _fmpq_vec_init(n);
+        pq = _fmpq_vec_init(n);
+
+        fmpq_init(s1);
+        fmpq_init(s2);
+
+        for (k = 0; k < n; k++) fmpq_randtest(ab + k, state, 10);
+        for (k = 0; k < n; k++) fmpq_randtest(cd + k, state, 10);
+        for (k = 0; k < n; k++) fmpq_randtest(pq + k, state, 10);
+
+        fmpq_bsplit_init(sum1);
+        fmpq_bsplit_init(sum2);
+
+        if (type == 0)
+            fmpq_bsplit_sum_pq(sum1, pq, 0, n);
+        else if (type == 1)
+            fmpq_bsplit_sum_abpq(sum1, ab, pq, 0, n);
+        else
+            fmpq_bsplit_sum_abcdpq(sum1, ab, cd, pq, 0, n);
+
+        flint_set_num_threads(n_randint(state, 4) + 1);
+        _fmpq_bsplit_sum(sum2, type ? ab : NULL, type == 2 ? cd : NULL, pq,
+                                                                0, n, flags);
+        flint_set_num_threads(1);
+
+        fmpq_bsplit_get_fmpq(s1, sum1);
+        fmpq_bsplit_get_fmpq(s2, sum2);
+
+        if (!fmpq_equal(s1, s2) || (flags == 0 &&
+            (!fmpz_equal(sum1->P, sum2->P) || !fmpz_equal(sum1->Q, sum2->Q) ||
+             !fmpz_equal(sum1->T, sum2->T) || !fmpz_equal(sum1->V, sum2->V))))
+        {
+            printf("FAIL\n");
+            printf("n = %ld, type = %d, flags = %d\n", n, type, flags);
+            printf("s1: "); fmpq_print(s1); printf("\n");
+            printf("s2: "); fmpq_print(s2); printf("\n");
+            abort();
+        }
+
+        /* The ratio P / Q is preserved when removing common factors */
+        if (n > 0)
+        {
+            fmpz_t t, u;
+
+            fmpz_init(t);
+            fmpz_init(u);
+
+            fmpz_mul(t, sum1->P, sum2->Q);
+            fmpz_mul(u, sum2->P, sum1->Q);
+
+            if (!fmpz_equal(t, u))
+            {
+                printf("FAIL (P / Q)\n");
+                printf("n = %ld, type = %d, flags = %d\n", n, type, flags);
+                abort();
+            }
+
+            fmpz_clear(t);
+            fmpz_clear(u);
+        }
+
+        fmpq_bsplit_clear(sum1);
+        fmpq_bsplit_clear(sum2);
+        fmpq_clear(s1);
+        fmpq_clear(s2);
+
+        _fmpq_vec_clear(ab, n);
+        _fmpq_vec_clear(cd, n);
+        _fmpq_vec_clear(pq, n);
+    }
+
+    flint_randclear(state);
+    _fmpz_cleanup();
+    printf("PASS\n");
+    return 0;
+}
@@ -29,6 +29,7 @@
 #include "flint.h"
 #include "fmpz.h"
 #include "fmpq.h"
+#include "ulong_extras.h"
 #include "profiler.h"
 
 int
@@ -57,7 +58,11 @@ main(void)
         fmpz_init(res);
         mpz_init(tmp);
 
-        fmpq_randtest(x, state, 100);
+        /* Some large inputs to exercise the half-gcd */
+        if (i % 50 == 0)
+            fmpq_randtest(x, state, 2000 + n_randint(state, 2000));
+        else
+            fmpq_randtest(x, state, 100);
 
         /* Modulus m >= 2*max(|n|,d)^2 */
         if (fmpz_cmpabs(&x->num, &x->den) >= 0)
@@ -66,11 +71,22 @@ main(void)
             fmpz_mul(mod, &x->den, &x->den);
         fmpz_mul_2exp(mod, mod, 1);
 
-        /* Next prime greater than or equal */
-        fmpz_get_mpz(tmp, mod);
-        mpz_sub_ui(tmp, tmp, 1UL);
-        mpz_nextprime(tmp, tmp);
-        fmpz_set_mpz(mod, tmp);
+        if (i % 50 == 0)
+        {
+            /* Finding large primes is slow; take m = 1 mod d instead */
+            fmpz_fdiv_q(mod, mod, &x->den);
+            fmpz_add_ui(mod, mod, 1UL);
+            fmpz_mul(mod, mod, &x->den);
+            fmpz_add_ui(mod, mod, 1UL);
+        }
+        else
+        {
+            /* Next prime greater than or equal */
+            fmpz_get_mpz(tmp, mod);
+            mpz_sub_ui(tmp, tmp, 1UL);
+            mpz_nextprime(tmp, tmp);
+            fmpz_set_mpz(mod, tmp);
+        }
 
         modresult = fmpq_mod_fmpz(res, x, mod);
         result = fmpq_reconstruct_fmpz(y, res, mod);
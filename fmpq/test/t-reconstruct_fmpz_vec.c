@@ -0,0 +1,249 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "fmpz_vec.h"
+#include "fmpq.h"
+#include "ulong_extras.h"
+
+int
+main(void)
+{
+    int i;
+    flint_rand_t state;
+    flint_randinit(state);
+
+    printf("reconstruct_fmpz_vec....");
+    fflush(stdout);
+
+    /* Vectors of rationals with mostly common denominators */
+    for (i = 0; i < 2000; i++)
+    {
+        fmpq * x;
+        fmpz * a, * num;
+        fmpz_t mod, den, t, g;
+        long j, len;
+        mp_bitcnt_t bits;
+        int result;
+
+        len = n_randint(state, 20);
+        bits = 1 + n_randint(state, (i % 50 == 0) ? 3000 : 100);
+
+        x = _fmpq_vec_init(len);
+        a = _fmpz_vec_init(len);
+        num = _fmpz_vec_init(len);
+        fmpz_init(mod);
+        fmpz_init(den);
+        fmpz_init(t);
+        fmpz_init(g);
+
+        fmpz_randtest_not_zero(den, state, bits);
+        fmpz_abs(den, den);
+
+        for (j = 0; j < len; j++)
+        {
+            if (n_randint(state, 4))
+            {
+                fmpz_randtest(fmpq_numref(x + j), state, bits);
+                fmpz_set(fmpq_denref(x + j), den);
+                fmpq_canonicalise(x + j);
+            }
+            else
+                fmpq_randtest(x + j, state, bits);
+        }
+
+        /* Modulus m >= 2 (2^bits L)^2 with L the product of the
+           denominators, bounding den x_j and den, and coprime to L */
+        fmpz_one(t);
+        for (j = 0; j < len; j++)
+            fmpz_mul(t, t, fmpq_denref(x + j));
+        fmpz_mul(mod, t, t);
+        fmpz_mul_2exp(mod, mod, 2 * bits + 1);
+        fmpz_add_ui(mod, mod, 1UL);
+
+        for (j = 0; j < len; j++)
+            fmpq_mod_fmpz(a + j, x + j, mod);
+
+        result = _fmpq_reconstruct_fmpz_vec(num, den, a, len, mod);
+
+        if (!result)
+        {
+            printf("FAIL: reconstruction failed\n");
+            abort();
+        }
+
+        for (j = 0; j < len; j++)
+        {
+            fmpz_mul(t, num + j, fmpq_denref(x + j));
+            fmpz_mul(g, den, fmpq_numref(x + j));
+
+            if (!fmpz_equal(t, g))
+            {
+                printf("FAIL: wrong result\n");
+                printf("j = %ld\n", j);
+                printf("x = "), fmpq_print(x + j), printf("\n");
+                printf("num = "), fmpz_print(num + j), printf("\n");
+                printf("den = "), fmpz_print(den), printf("\n");
+                abort();
+            }
+        }
+
+        /* The denominator must be the least common one */
+        fmpz_zero(g);
+        for (j = 0; j < len; j++)
+            fmpz_gcd(g, g, num + j);
+        fmpz_gcd(g, g, den);
+
+        if (!fmpz_is_one(g))
+        {
+            printf("FAIL: denominator not minimal\n");
+            printf("den = "), fmpz_print(den), printf("\n");
+            abort();
+        }
+
+        _fmpq_vec_clear(x, len);
+        _fmpz_vec_clear(a, len);
+        _fmpz_vec_clear(num, len);
+        fmpz_clear(mod);
+        fmpz_clear(den);
+        fmpz_clear(t);
+        fmpz_clear(g);
+    }
+
+    /* Common denominators larger than the bound, as 1/p, 1/(pq) */
+    for (i = 0; i < 1000; i++)
+    {
+        fmpz a[2], num[2];
+        fmpz_t mod, den, p, q, t;
+        mp_bitcnt_t bits;
+        int result;
+
+        bits = 2 + n_randint(state, 200);
+
+        fmpz_init(a), fmpz_init(a + 1);
+        fmpz_init(num), fmpz_init(num + 1);
+        fmpz_init(mod);
+        fmpz_init(den);
+        fmpz_init(p);
+        fmpz_init(q);
+        fmpz_init(t);
+
+        /* p, q < 2^bits and m > 2^(2 bits + 1), so p, q <= D */
+        fmpz_randtest_unsigned(p, state, bits);
+        fmpz_randtest_unsigned(q, state, bits);
+        fmpz_add_ui(p, p, 2UL);
+        fmpz_add_ui(q, q, 2UL);
+        fmpz_mul(t, p, q);
+        fmpz_mul_2exp(mod, t, bits + 3);
+        fmpz_add_ui(mod, mod, 1UL);
+
+        fmpz_invmod(a, p, mod);
+        fmpz_invmod(a + 1, t, mod);
+
+        result = _fmpq_reconstruct_fmpz_vec(num, den, a, 2, mod)
+            && fmpz_equal(den, t) && fmpz_equal(num, q) && fmpz_is_one(num + 1);
+
+        if (!result)
+        {
+            printf("FAIL: shared denominator\n");
+            printf("p = "), fmpz_print(p), printf("\n");
+            printf("q = "), fmpz_print(q), printf("\n");
+            abort();
+        }
+
+        fmpz_clear(a), fmpz_clear(a + 1);
+        fmpz_clear(num), fmpz_clear(num + 1);
+        fmpz_clear(mod);
+        fmpz_clear(den);
+        fmpz_clear(p);
+        fmpz_clear(q);
+        fmpz_clear(t);
+    }
+
+    /* Random residues: succeeds if every entry can be reconstructed */
+    for (i = 0; i < 2000; i++)
+    {
+        fmpz * a, * num;
+        fmpz_t mod, den, n, d, t;
+        long j, len;
+        int result, result2;
+
+        len = n_randint(state, 10);
+
+        a = _fmpz_vec_init(len);
+        num = _fmpz_vec_init(len);
+        fmpz_init(mod);
+        fmpz_init(den);
+        fmpz_init(n);
+        fmpz_init(d);
+        fmpz_init(t);
+
+        fmpz_randtest_unsigned(mod, state, 2 + n_randint(state, 200));
+        fmpz_add_ui(mod, mod, 2UL);
+
+        for (j = 0; j < len; j++)
+        {
+            fmpz_randtest_unsigned(a + j, state, 200);
+            fmpz_mod(a + j, a + j, mod);
+        }
+
+        result = _fmpq_reconstruct_fmpz_vec(num, den, a, len, mod);
+
+        result2 = 1;
+        for (j = 0; j < len && result2; j++)
+            result2 = _fmpq_reconstruct_fmpz(n, d, a + j, mod);
+
+        if (result2 && !result)
+        {
+            printf("FAIL: result = %d, expected %d\n", result, result2);
+            abort();
+        }
+
+        /* The entries must be congruent to num / den */
+        for (j = 0; j < len && result; j++)
+        {
+            fmpz_mul(t, den, a + j);
+            fmpz_sub(t, t, num + j);
+
+            if (!fmpz_divisible(t, mod))
+            {
+                printf("FAIL: inconsistent result\n");
+                abort();
+            }
+        }
+
+        _fmpz_vec_clear(a, len);
+        _fmpz_vec_clear(num, len);
+        fmpz_clear(mod);
+        fmpz_clear(den);
+        fmpz_clear(n);
+        fmpz_clear(d);
+        fmpz_clear(t);
+    }
+
+    flint_randclear(state);
+    _fmpz_cleanup();
+    printf("PASS\n");
+    return 0;
+}
@@ -35,48 +35,40 @@ int
 fmpq_mat_set_fmpz_mat_mod_fmpz(fmpq_mat_t X,
                                     const fmpz_mat_t Xmod, const fmpz_t mod)
 {
-    fmpz_t num, den, t, u, d;
-    long i, j;
-
-    int success = 1;
-
-    fmpz_init(num);
+    fmpz * a, * num;
+    fmpz_t den;
+    long i, j, len;
+    int success;
+
+    len = Xmod->r * Xmod->c;
+    a = _fmpz_vec_init(len);
+    num = _fmpz_vec_init(len);
     fmpz_init(den);
-    fmpz_init(d);
-    fmpz_init(t);
-    fmpz_init(u);
-
-    fmpz_one(d);
 
     for (i = 0; i < Xmod->r; i++)
-    {
         for (j = 0; j < Xmod->c; j++)
-        {
-            /* TODO: handle various special cases efficiently; zeros,
-                     small integers, etc. */
-            fmpz_mul(t, d, fmpz_mat_entry(Xmod, i, j));
-            fmpz_fdiv_qr(u, t, t, mod);
+            fmpz_mod(a + i * Xmod->c + j, fmpz_mat_entry(Xmod, i, j), mod);
 
-            success = _fmpq_reconstruct_fmpz(num, den, t, mod);
+    /* The denominator found for one entry is shared with the rest, so
+       that entries with a common denominator need no reconstruction */
+    success = _fmpq_reconstruct_fmpz_vec(num, den, a, len, mod);
 
-            fmpz_mul(den, den, d);
-            fmpz_set(d, den);
-
-            if (!success)
-                goto cleanup;
-
-            fmpz_set(fmpq_mat_entry_num(X, i, j), num);
-            fmpz_set(fmpq_mat_entry_den(X, i, j), den);
-            fmpq_canonicalise(fmpq_mat_entry(X, i, j));
+    if (success)
+    {
+        for (i = 0; i < Xmod->r; i++)
+        {
+            for (j = 0; j < Xmod->c; j++)
+            {
+                fmpz_swap(fmpq_mat_entry_num(X, i, j), num + i * Xmod->c + j);
+                fmpz_set(fmpq_mat_entry_den(X, i, j), den);
+                fmpq_canonicalise(fmpq_mat_entry(X, i, j));
+            }
         }
     }
 
-cleanup:
-    fmpz_clear(num);
+    _fmpz_vec_clear(a, len);
+    _fmpz_vec_clear(num, len);
     fmpz_clear(den);
-    fmpz_clear(d);
-    fmpz_clear(t);
-    fmpz_clear(u);
 
     return success;
 }
@@ -37,23 +37,23 @@ fmpq_mat_solve_dixon(fmpq_mat_t X, const fmpq_mat_t A, const fmpq_mat_t B)
     fmpz_mat_t Anum;
     fmpz_mat_t Bnum;
     fmpz_mat_t Xnum;
-    fmpz_t mod;
+    fmpz_t den;
     int success;
 
     fmpz_mat_init(Anum, A->r, A->c);
     fmpz_mat_init(Bnum, B->r, B->c);
     fmpz_mat_init(Xnum, B->r, B->c);
-    fmpz_init(mod);
+    fmpz_init(den);
 
     fmpq_mat_get_fmpz_mat_rowwise_2(Anum, Bnum, NULL, A, B);
-    success = fmpz_mat_solve_dixon(Xnum, mod, Anum, Bnum);
+    success = fmpz_mat_solve_dixon_den(Xnum, den, Anum, Bnum);
     if (success)
-        success = fmpq_mat_set_fmpz_mat_mod_fmpz(X, Xnum, mod);
+        fmpq_mat_set_fmpz_mat_div_fmpz(X, Xnum, den);
 
     fmpz_mat_clear(Anum);
     fmpz_mat_clear(Bnum);
     fmpz_mat_clear(Xnum);
-    fmpz_clear(mod);
+    fmpz_clear(den);
 
     return success;
 }
@@ -92,6 +92,27 @@ void _fmpz_demote(fmpz_t f)
 
 void _fmpz_demote_val(fmpz_t f);
 
+/*
+    Sets m to an mpz with the value of f which may only be read from. If f
+    is small its absolute value is stored at limb, otherwise m shares the
+    limbs of f. Unlike fmpz_get_mpz this does not allocate.
+ */
+static __inline__
+void _fmpz_get_mpz_view(__mpz_struct * m, mp_limb_t * limb, const fmpz_t f)
+{
+    fmpz c = *f;
+
+    if (COEFF_IS_MPZ(c))
+        *m = *COEFF_TO_PTR(c);
+    else
+    {
+        *limb = (c < 0L) ? -c : c;
+        m->_mp_d = limb;
+        m->_mp_alloc = 1;
+        m->_mp_size = (c > 0L) - (c < 0L);
+    }
+}
+
 static __inline__
 void fmpz_init(fmpz_t f)
 {
@@ -363,6 +384,144 @@ void fmpz_powm_ui(fmpz_t f, const fmpz_t g, ulong exp, const fmpz_t m);
 
 void fmpz_powm(fmpz_t f, const fmpz_t g, const fmpz_t e, const fmpz_t m);
 
+/*
+    Precomputed data for exponentiation modulo a fixed m. For odd m the
+    arithmetic is done in Montgomery form with R = 2^(n FLINT_BITS),
+    where n is the number of limbs of m.
+ */
+typedef struct
+{
+    mpz_t m;
+    mp_size_t n;
+    mp_limb_t ninv;     /* -1/m mod 2^FLINT_BITS */
+    mp_ptr one;         /* R mod m */
+    int mont;           /* whether m is odd and greater than 1 */
+}
+fmpz_powm_ctx_struct;
+
+typedef fmpz_powm_ctx_struct fmpz_powm_ctx_t[1];
+
+/*
+    Table of g^(j 2^(k i)) for 0 <= i < rows and 1 <= j < 2^k for
+    exponentiation of a fixed base g
+ */
+typedef struct
+{
+    mp_ptr table;
+    mp_ptr top;         /* g^(2^(k rows)) */
+    long rows;
+    int k;
+    mpz_t g;
+}
+fmpz_powm_base_struct;
+
+typedef fmpz_powm_base_struct fmpz_powm_base_t[1];
+
+void fmpz_powm_ctx_init(fmpz_powm_ctx_t ctx, const fmpz_t m);
+
+void fmpz_powm_ctx_clear(fmpz_powm_ctx_t ctx);
+
+void _fmpz_powm_mulredc(mp_ptr r, mp_srcptr a, mp_srcptr b, mp_ptr t,
+                                            const fmpz_powm_ctx_t ctx);
+
+void _fmpz_powm_to_mont(mp_ptr r, const __mpz_struct * x,
+                                            const fmpz_powm_ctx_t ctx);
+
+void _fmpz_powm_from_mont(__mpz_struct * r, mp_srcptr x,
+                                            const fmpz_powm_ctx_t ctx);
+
+void _fmpz_powm_mont(mp_ptr r, mp_srcptr g, mp_srcptr e, mp_size_t en,
+                                            const fmpz_powm_ctx_t ctx);
+
+void _fmpz_powm_precomp(__mpz_struct * r, const __mpz_struct * g,
+                    const __mpz_struct * e, const fmpz_powm_ctx_t ctx);
+
+void fmpz_powm_precomp(fmpz_t f, const fmpz_t g, const fmpz_t e,
+                                            const fmpz_powm_ctx_t ctx);
+
+void fmpz_powm_base_init(fmpz_powm_base_t B, const fmpz_t g,
+                        mp_bitcnt_t bits, const fmpz_powm_ctx_t ctx);
+
+void fmpz_powm_base_clear(fmpz_powm_base_t B);
+
+void _fmpz_powm_base(__mpz_struct * r, const __mpz_struct * e,
+                const fmpz_powm_base_t B, const fmpz_powm_ctx_t ctx);
+
+void fmpz_powm_base(fmpz_t f, const fmpz_t e, const fmpz_powm_base_t B,
+                                            const fmpz_powm_ctx_t ctx);
+
+/* r = a b / R mod m for a, b in [0, m), with the result in [0, m) */
+static __inline__ void
+_fmpz_powm_mulredc_reduced(mp_ptr r, mp_srcptr a, mp_srcptr b, mp_ptr t,
+                                            const fmpz_powm_ctx_t ctx)
+{
+    _fmpz_powm_mulredc(r, a, b, t, ctx);
+
+    if (mpn_cmp(r, ctx->m->_mp_d, ctx->n) >= 0)
+        mpn_sub_n(r, r, ctx->m->_mp_d, ctx->n);
+}
+
+void _fmpz_powm_lucas_v(mp_ptr V, mp_srcptr P, mp_srcptr e, mp_size_t en,
+                                            const fmpz_powm_ctx_t ctx);
+
+/* Primality testing *********************************************************/
+
+/*
+    Certificate of primality of n > 2^FLINT_BITS. Each q[i] is a prime
+    dividing n - 1 (type[i] = 1) or n + 1 (type[i] = -1), proven prime
+    by sub[i] if it does not fit in a limb. An empty certificate stands
+    for n being small enough for a fixed set of Miller-Rabin bases.
+ */
+typedef struct fmpz_prime_cert_struct
+{
+    fmpz * q;
+    int * type;
+    ulong * a;          /* Pocklington witnesses for q[i] of type 1 */
+    struct fmpz_prime_cert_struct ** sub;
+    ulong P;            /* Lucas parameter shared by all q[i] of type -1 */
+    long num;
+    long alloc;
+}
+fmpz_prime_cert_struct;
+
+typedef fmpz_prime_cert_struct fmpz_prime_cert_t[1];
+
+int _fmpz_is_strong_probabprime(const __mpz_struct * a,
+                                            const fmpz_powm_ctx_t ctx);
+
+int fmpz_is_strong_probabprime(const fmpz_t n, const fmpz_t a);
+
+int _fmpz_is_probabprime_lucas(const fmpz_powm_ctx_t ctx);
+
+int fmpz_is_probabprime_lucas(const fmpz_t n);
+
+int fmpz_is_probabprime(const fmpz_t n);
+
+int _fmpz_is_prime_small(const fmpz_t n);
+
+int _fmpz_is_prime_pocklington(const fmpz_t n, const fmpz_t q, ulong a,
+                                            const fmpz_powm_ctx_t ctx);
+
+int _fmpz_is_prime_morrison(const fmpz_t n, const fmpz_t q, ulong P,
+                                            const fmpz_powm_ctx_t ctx);
+
+int _fmpz_is_prime_bls(const fmpz_t n, const fmpz_t F1, const fmpz_t F2);
+
+void fmpz_prime_cert_init(fmpz_prime_cert_t cert);
+
+void fmpz_prime_cert_clear(fmpz_prime_cert_t cert);
+
+void _fmpz_prime_cert_append(fmpz_prime_cert_t cert, const fmpz_t q,
+                            int type, ulong a, fmpz_prime_cert_struct * sub);
+
+void fmpz_prime_cert_print(const fmpz_prime_cert_t cert);
+
+int fmpz_prime_cert_verify(const fmpz_prime_cert_t cert, const fmpz_t n);
+
+int fmpz_is_prime_cert(fmpz_prime_cert_t cert, const fmpz_t n);
+
+int fmpz_is_prime(const fmpz_t n);
+
 double fmpz_dlog(const fmpz_t x);
 long fmpz_flog(const fmpz_t x, const fmpz_t b);
 long fmpz_flog_ui(const fmpz_t x, ulong b);
@@ -391,6 +550,8 @@ void fmpz_lcm(fmpz_t f, const fmpz_t g, const fmpz_t h);
 
 void fmpz_gcdinv(fmpz_t d, fmpz_t a, const fmpz_t f, const fmpz_t g);
 
+int _fmpz_hgcd(fmpz * M, fmpz_t a, fmpz_t b, mp_bitcnt_t s);
+
 int fmpz_invmod(fmpz_t f, const fmpz_t g, const fmpz_t h);
 
 long _fmpz_remove(fmpz_t x, const fmpz_t f, double finv);
@@ -543,6 +704,34 @@ void fmpz_CRT_ui_unsigned(fmpz_t out, const fmpz_t r1, const fmpz_t m1,
 
 #define FLINT_FMPZ_LOG_MULTI_MOD_CUTOFF 2
 
+/* Number of bits to be removed below which _fmpz_hgcd performs single
+   Euclidean steps, and number of guard bits kept in its recursion */
+#define FMPZ_HGCD_CUTOFF 64
+#define FMPZ_HGCD_GUARD_BITS 2
+
+/* Smallest n for which fmpz_fac_ui uses the prime-swing algorithm */
+#define FMPZ_FAC_UI_SWING_CUTOFF 20000
+
+/* Smallest min(k, n - k) for which fmpz_bin_uiui uses the prime
+   factorisation of the binomial coefficient, and largest ratio n / k */
+#define FMPZ_BIN_UIUI_KUMMER_CUTOFF 500
+#define FMPZ_BIN_UIUI_KUMMER_RATIO 200
+
+/* Largest window size used by fmpz_powm_base_init */
+#define FMPZ_POWM_BASE_MAX_WINDOW 6
+
+/* Number of primes tried by trial division before the probable prime
+   test, and for the partial factorisations of n - 1 and n + 1 when
+   proving primality */
+#define FMPZ_IS_PROBABPRIME_TRIAL_PRIMES 256
+#define FMPZ_IS_PRIME_TRIAL_PRIMES 10000
+
+/* Number of Pocklington bases and Lucas parameters tried per proof */
+#define FMPZ_IS_PRIME_WITNESSES 200
+
+/* Number of combs kept by fmpz_comb_cache_get when not in use */
+#define FMPZ_COMB_CACHE_SIZE 4
+
 typedef struct
 {
     mp_limb_t * primes;
@@ -572,6 +761,11 @@ void fmpz_comb_temp_clear(fmpz_comb_temp_t temp);
 void fmpz_comb_init(fmpz_comb_t comb, mp_limb_t * primes, long num_primes);
 void fmpz_comb_clear(fmpz_comb_t comb);
 
+const fmpz_comb_struct * fmpz_comb_cache_get(const mp_limb_t * primes,
+                                                        long num_primes);
+void fmpz_comb_cache_release(const fmpz_comb_struct * comb);
+void fmpz_comb_cache_clear(void);
+
 void fmpz_multi_mod_ui(mp_limb_t * out, const fmpz_t in,
     const fmpz_comb_t comb, fmpz_comb_temp_t temp);
 
@@ -29,11 +29,76 @@
 #include "flint.h"
 #include "ulong_extras.h"
 #include "fmpz.h"
+#include "mpn_extras.h"
+
+/*
+    Sets r to binomial(n, k) for k <= n - k as the product of p^e over
+    the primes p <= n, where by Kummer's theorem e is the number of
+    carries when adding k and n - k in base p. Then p^e <= n.
+*/
+static void
+_fmpz_bin_uiui_kummer(mpz_t r, ulong n, ulong k)
+{
+    mp_limb_t * primes, * factors;
+    mp_limb_t p, pe, a, b, c;
+    long i, len, num_primes;
+
+    primes = n_sieve_primes(&num_primes, n);
+    factors = malloc(num_primes * sizeof(mp_limb_t));
+
+    len = 0;
+    for (i = 0; i < num_primes; i++)
+    {
+        p = primes[i];
+
+        /* Primes in (n - k, n] divide once, those in (n/2, n - k] not */
+        if (p > n - k)
+        {
+            factors[len++] = p;
+            continue;
+        }
+        if (p > n / 2)
+            continue;
+
+        a = n;
+        b = k;
+        c = n - k;
+        pe = 1;
+
+        do
+        {
+            a /= p;
+            b /= p;
+            c /= p;
+            if (a - b - c)
+                pe *= p;
+        } while (a >= p);
+
+        if (pe != 1)
+            factors[len++] = pe;
+    }
+
+    mpz_realloc2(r, len * FLINT_BIT_COUNT(n) + 2 * FLINT_BITS);
+    r->_mp_size = mpn_prod_limbs(r->_mp_d, factors, len, FLINT_BIT_COUNT(n));
+
+    free(factors);
+    free(primes);
+}
 
-/* TODO: speedup for small n,k */
 void fmpz_bin_uiui(fmpz_t res, ulong n, ulong k)
 {
-    __mpz_struct * t = _fmpz_promote(res);
-    mpz_bin_uiui(t, n, k);
+    __mpz_struct * t;
+
+    if (k <= n)
+        k = FLINT_MIN(k, n - k);
+
+    t = _fmpz_promote(res);
+
+    if (k <= n && k >= FMPZ_BIN_UIUI_KUMMER_CUTOFF
+               && n / k <= FMPZ_BIN_UIUI_KUMMER_RATIO)
+        _fmpz_bin_uiui_kummer(t, n, k);
+    else
+        mpz_bin_uiui(t, n, k);
+
     _fmpz_demote_val(res);
 }
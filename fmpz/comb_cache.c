@@ -0,0 +1,137 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+
+#include <stdlib.h>
+#include <string.h>
+#include <mpir.h>
+#include "flint.h"
+#include "fmpz.h"
+
+/*
+    The entries are kept in order of last use. An entry is only released
+    once it is not in use and FMPZ_COMB_CACHE_SIZE more recently used
+    entries exist, so that repeated calls with the same primes share one
+    comb while the cache stays bounded.
+ */
+
+typedef struct _comb_cache_entry
+{
+    fmpz_comb_struct comb;
+    mp_limb_t * primes;
+    long refs;
+    struct _comb_cache_entry * next;
+}
+_comb_cache_entry;
+
+static _comb_cache_entry * _comb_cache = NULL;
+
+static void
+_comb_cache_entry_clear(_comb_cache_entry * e)
+{
+    fmpz_comb_clear(&e->comb);
+    free(e->primes);
+    free(e);
+}
+
+static void
+_comb_cache_trim(void)
+{
+    _comb_cache_entry * e, ** prev;
+    long i;
+
+    prev = &_comb_cache;
+    for (i = 0; (e = *prev) != NULL; i++)
+    {
+        if (i >= FMPZ_COMB_CACHE_SIZE && e->refs == 0)
+        {
+            *prev = e->next;
+            _comb_cache_entry_clear(e);
+        }
+        else
+            prev = &e->next;
+    }
+}
+
+const fmpz_comb_struct *
+fmpz_comb_cache_get(const mp_limb_t * primes, long num_primes)
+{
+    _comb_cache_entry * e, ** prev;
+
+    for (prev = &_comb_cache; (e = *prev) != NULL; prev = &e->next)
+    {
+        if (e->comb.num_primes == num_primes &&
+            memcmp(e->primes, primes, num_primes * sizeof(mp_limb_t)) == 0)
+            break;
+    }
+
+    if (e != NULL)
+    {
+        /* Move to the front */
+        *prev = e->next;
+    }
+    else
+    {
+        /* The comb keeps a pointer to the primes, so it gets its own copy */
+        e = malloc(sizeof(_comb_cache_entry));
+        e->primes = malloc(num_primes * sizeof(mp_limb_t));
+        memcpy(e->primes, primes, num_primes * sizeof(mp_limb_t));
+        fmpz_comb_init(&e->comb, e->primes, num_primes);
+        e->refs = 0;
+    }
+
+    e->refs++;
+    e->next = _comb_cache;
+    _comb_cache = e;
+
+    _comb_cache_trim();
+
+    return &e->comb;
+}
+
+void
+fmpz_comb_cache_release(const fmpz_comb_struct * comb)
+{
+    _comb_cache_entry * e;
+
+    for (e = _comb_cache; e != NULL; e = e->next)
+    {
+        if (&e->comb == comb)
+        {
+            e->refs--;
+            break;
+        }
+    }
+
+    _comb_cache_trim();
+}
+
+void
+fmpz_comb_cache_clear(void)
+{
+    _comb_cache_entry * e;
+
+    while (_comb_cache != NULL)
+    {
+        e = _comb_cache;
+        _comb_cache = e->next;
+        _comb_cache_entry_clear(e);
+    }
+}
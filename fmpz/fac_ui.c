@@ -29,6 +29,7 @@
 #include "flint.h"
 #include "ulong_extras.h"
 #include "fmpz.h"
+#include "mpn_extras.h"
 
 #if FLINT64
 #define FLINT_NUM_TINY_FACTORIALS 21
@@ -47,10 +48,86 @@ const mp_limb_t flint_tiny_factorials[] =
 #endif
 };
 
+/*
+    Sets r to the odd part of n!, using n! = (n/2)!^2 * swing(n) where
+    swing(n) = n! / (n/2)!^2 is the swinging factorial. The exponent of
+    an odd prime p in swing(m) is the number of odd values among the
+    floor(m / p^i), i >= 1, and p to that exponent is at most m. The
+    primes up to n must be given, in increasing order.
+*/
+static void
+_fmpz_fac_ui_odd_swing(mpz_t r, ulong n, const mp_limb_t * primes,
+                                                            long num_primes)
+{
+    mp_limb_t * factors;
+    mp_limb_t m, p, q, pe, t;
+    mpz_t s;
+    long i, j, len, levels;
+
+    /* Odd part of the factorial of the smallest level from the table */
+    for (levels = 0; (n >> levels) >= FLINT_NUM_TINY_FACTORIALS; levels++) ;
+    t = flint_tiny_factorials[n >> levels];
+    while (t % 2 == 0)
+        t /= 2;
+    mpz_set_ui(r, t);
+
+    factors = malloc(num_primes * sizeof(mp_limb_t));
+    mpz_init(s);
+
+    for (i = levels - 1; i >= 0; i--)
+    {
+        m = n >> i;
+
+        /* Odd prime power factors of swing(m) */
+        len = 0;
+        for (j = 1; j < num_primes && primes[j] <= m; j++)
+        {
+            p = primes[j];
+            q = m;
+            pe = 1;
+
+            do
+            {
+                q /= p;
+                if (q & 1)
+                    pe *= p;
+            } while (q >= p);
+
+            if (pe != 1)
+                factors[len++] = pe;
+        }
+
+        mpz_realloc2(s, len * FLINT_BIT_COUNT(m) + 2 * FLINT_BITS);
+        s->_mp_size = mpn_prod_limbs(s->_mp_d, factors, len,
+                                                        FLINT_BIT_COUNT(m));
+
+        mpz_mul(r, r, r);
+        mpz_mul(r, r, s);
+    }
+
+    mpz_clear(s);
+    free(factors);
+}
+
 void fmpz_fac_ui(fmpz_t f, ulong n)
 {
     if (n < FLINT_NUM_TINY_FACTORIALS)
         fmpz_set_ui(f, flint_tiny_factorials[n]);
-    else
+    else if (n < FMPZ_FAC_UI_SWING_CUTOFF)
         mpz_fac_ui(_fmpz_promote(f), n);
+    else
+    {
+        __mpz_struct * r = _fmpz_promote(f);
+        mp_limb_t * primes, t;
+        long num_primes, ones;
+
+        primes = n_sieve_primes(&num_primes, n);
+        _fmpz_fac_ui_odd_swing(r, n, primes, num_primes);
+        free(primes);
+
+        /* The power of two in n! is n minus the number of ones of n */
+        for (t = n, ones = 0; t != 0; t &= t - 1)
+            ones++;
+        mpz_mul_2exp(r, r, n - ones);
+    }
 }
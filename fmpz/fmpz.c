@@ -83,6 +83,10 @@ void _fmpz_clear_mpz(fmpz f)
 void _fmpz_cleanup(void)
 {
     long i;
+
+    /* Cached combs hold fmpz's, so release them first */
+    fmpz_comb_cache_clear();
+
 	for (i = 0; i < fmpz_num_unused; i++)
 		mpz_clear(fmpz_arr + fmpz_unused_arr[i]);
 	
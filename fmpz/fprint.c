@@ -25,14 +25,21 @@
 
 #include <stdio.h>
 #include <mpir.h>
-
+#include "flint.h"
 #include "fmpz.h"
 
 int fmpz_fprint(FILE * file, const fmpz_t x)
 {
-	if (!COEFF_IS_MPZ(*x))
-        return fprintf(file, "%ld", *x);
-	else 
+    if (!COEFF_IS_MPZ(*x))
+    {
+        char buf[FLINT_BITS];
+        long n;
+
+        fmpz_get_str(buf, 10, x);
+        for (n = 0; buf[n] != '\0'; n++) ;
+
+        return (int) fwrite(buf, 1, n, file);
+    }
+    else
         return (int) mpz_out_str(file, 10, COEFF_TO_PTR(*x));
 }
-
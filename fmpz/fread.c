@@ -25,6 +25,9 @@
 ******************************************************************************/
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
 #include <mpir.h>
 #include "flint.h"
 #include "fmpz.h"
@@ -32,14 +35,51 @@
 int 
 fmpz_fread(FILE * file, fmpz_t f)
 {
-    mpz_t t;
-    size_t r;
+    char buf[FLINT_BITS];
+    char * str = buf;
+    long len = 0, alloc = FLINT_BITS;
+    int c, r;
 
-    mpz_init(t);
-    r = mpz_inp_str(t, file, 10);
-    fmpz_set_mpz(f, t);
-    mpz_clear(t);
+    /* Collect the digits, as mpz_inp_str does, and convert them with
+       fmpz_set_str, which avoids a temporary mpz for small values */
+    do
+        c = getc(file);
+    while (isspace(c));
 
-    return (r > 0) ? 1 : 0;
-}
+    if (c == '-')
+    {
+        str[len++] = '-';
+        c = getc(file);
+    }
+
+    if (c == EOF || !isdigit(c))
+        return 0;
+
+    while (c != EOF && isdigit(c))
+    {
+        if (len + 1 == alloc)
+        {
+            if (str == buf)
+            {
+                str = malloc(2 * alloc);
+                memcpy(str, buf, len);
+            }
+            else
+                str = realloc(str, 2 * alloc);
+            alloc *= 2;
+        }
+
+        str[len++] = c;
+        c = getc(file);
+    }
 
+    ungetc(c, file);
+    str[len] = '\0';
+
+    r = fmpz_set_str(f, str, 10);
+
+    if (str != buf)
+        free(str);
+
+    return (r == 0) ? 1 : 0;
+}
@@ -23,14 +23,66 @@
 
 ******************************************************************************/
 
+#include <stdlib.h>
 #include <mpir.h>
 #include "flint.h"
 #include "ulong_extras.h"
 #include "fmpz.h"
 
+/* Digits as used by mpz_get_str for bases up to 36 and beyond */
+static const char _fmpz_digits_lower[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+static const char _fmpz_digits_upper[] =
+    "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz";
+
 char * fmpz_get_str(char * str, int b, const fmpz_t f)
 {
-    if (!COEFF_IS_MPZ(*f))
+    const char * digits;
+    int base;
+
+    if (b >= 2 && b <= 36)
+        digits = _fmpz_digits_lower, base = b;
+    else if (b > 36 && b <= 62)
+        digits = _fmpz_digits_upper, base = b;
+    else if (b <= -2 && b >= -36)
+        digits = _fmpz_digits_upper, base = -b;
+    else
+        digits = NULL, base = 0;
+
+    if (!COEFF_IS_MPZ(*f) && digits != NULL)
+    {
+        /* Small values are converted directly, without a temporary mpz */
+        char buf[FLINT_BITS];
+        mp_limb_t u = FLINT_ABS(*f);
+        long i, n = 0;
+
+        if (base == 10)
+        {
+            do
+            {
+                buf[n++] = digits[u % 10];
+                u /= 10;
+            } while (u != 0);
+        }
+        else
+        {
+            do
+            {
+                buf[n++] = digits[u % base];
+                u /= base;
+            } while (u != 0);
+        }
+
+        if (str == NULL)
+            str = malloc(n + 2);
+
+        i = 0;
+        if (*f < 0)
+            str[i++] = '-';
+        while (n > 0)
+            str[i++] = buf[--n];
+        str[i] = '\0';
+    }
+    else if (!COEFF_IS_MPZ(*f))
     {
         mpz_t z;
 
@@ -45,4 +97,3 @@ char * fmpz_get_str(char * str, int b, const fmpz_t f)
 
     return str;
 }
-
@@ -0,0 +1,132 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <mpir.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "fmpz_vec.h"
+
+/* One Euclidean step (a, b) <- (b, a mod b), M <- M [[q, 1], [1, 0]] */
+static void
+_fmpz_hgcd_step(fmpz * M, fmpz_t a, fmpz_t b, fmpz_t q, fmpz_t r)
+{
+    fmpz_fdiv_qr(q, r, a, b);
+    fmpz_swap(a, b);
+    fmpz_swap(b, r);
+
+    fmpz_addmul(M + 1, M + 0, q);
+    fmpz_swap(M + 0, M + 1);
+    fmpz_addmul(M + 3, M + 2, q);
+    fmpz_swap(M + 2, M + 3);
+}
+
+/* M <- M M1 */
+static void
+_fmpz_hgcd_mat_mul(fmpz * M, const fmpz * M1, fmpz_t t)
+{
+    long i;
+
+    for (i = 0; i < 4; i += 2)
+    {
+        fmpz_mul(t, M + i, M1 + 0);
+        fmpz_addmul(t, M + i + 1, M1 + 2);
+        fmpz_mul(M + i + 1, M + i + 1, M1 + 3);
+        fmpz_addmul(M + i + 1, M + i, M1 + 1);
+        fmpz_swap(M + i, t);
+    }
+}
+
+int
+_fmpz_hgcd(fmpz * M, fmpz_t a, fmpz_t b, mp_bitcnt_t s)
+{
+    fmpz_t q, r, a1, b1;
+    fmpz * M1;
+    long n, p, k;
+    int sign = 1, sign1;
+
+    fmpz_init(q);
+    fmpz_init(r);
+    fmpz_init(a1);
+    fmpz_init(b1);
+    M1 = _fmpz_vec_init(4);
+
+    while (fmpz_bits(b) > s)
+    {
+        n = fmpz_bits(a);
+
+        if (n - (long) s >= FMPZ_HGCD_CUTOFF)
+        {
+            /* Reduce the leading 2(n - s) bits, or the leading half of a
+               if that is shorter, and apply the quotients found to the
+               full numbers, keeping a few guard bits in the recursion */
+            p = FLINT_MAX(2 * (long) s - n, n / 2);
+            k = n - p;
+
+            fmpz_fdiv_q_2exp(a1, a, p);
+            fmpz_fdiv_q_2exp(b1, b, p);
+
+            fmpz_one(M1 + 0);
+            fmpz_zero(M1 + 1);
+            fmpz_zero(M1 + 2);
+            fmpz_one(M1 + 3);
+
+            sign1 = _fmpz_hgcd(M1, a1, b1, k / 2 + FMPZ_HGCD_GUARD_BITS);
+
+            if (!fmpz_is_zero(M1 + 1))
+            {
+                /* (a, b) <- M1^(-1) (a, b), with det M1 = sign1 */
+                fmpz_mul(a1, M1 + 3, a);
+                fmpz_submul(a1, M1 + 1, b);
+                fmpz_mul(b1, M1 + 0, b);
+                fmpz_submul(b1, M1 + 2, a);
+
+                if (sign1 < 0)
+                {
+                    fmpz_neg(a1, a1);
+                    fmpz_neg(b1, b1);
+                }
+
+                /* The quotients are correct precisely when the new pair
+                   is a valid remainder pair; we must also not go past
+                   the first remainder below 2^s */
+                if (fmpz_sgn(b1) >= 0 && fmpz_cmp(a1, b1) > 0
+                    && fmpz_bits(a1) > s)
+                {
+                    fmpz_swap(a, a1);
+                    fmpz_swap(b, b1);
+                    _fmpz_hgcd_mat_mul(M, M1, q);
+                    sign *= sign1;
+                    continue;
+                }
+            }
+        }
+
+        _fmpz_hgcd_step(M, a, b, q, r);
+        sign = -sign;
+    }
+
+    fmpz_clear(q);
+    fmpz_clear(r);
+    fmpz_clear(a1);
+    fmpz_clear(b1);
+    _fmpz_vec_clear(M1, 4);
+
+    return sign;
+}
@@ -0,0 +1,83 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <mpir.h>
+#include "flint.h"
+#include "fmpz.h"
+
+/*
+    Given that every prime p dividing n is 1 modulo F1 | n - 1 and +-1
+    modulo F2 | n + 1, every such p is 1 or r modulo F = lcm(F1, F2),
+    where r = 1 mod F1 and r = -1 mod F2. If F^2 > n, the least prime
+    divisor of a composite n is below F, so must equal r. Returns 1 if
+    this proves n prime, 0 if r is a proper divisor of n and -1 if F is
+    too small.
+ */
+int
+_fmpz_is_prime_bls(const fmpz_t n, const fmpz_t F1, const fmpz_t F2)
+{
+    fmpz_t g, F, r, t, u;
+    int result;
+
+    fmpz_init(g);
+    fmpz_init(F);
+    fmpz_init(r);
+    fmpz_init(t);
+    fmpz_init(u);
+
+    fmpz_gcd(g, F1, F2);
+    fmpz_divexact(t, F2, g);
+    fmpz_mul(F, F1, t);
+
+    fmpz_mul(u, F, F);
+
+    if (fmpz_cmp(u, n) <= 0)
+    {
+        result = -1;
+    }
+    else
+    {
+        /* r = 1 + F1 x with (F1 / g) x = -2 / g mod F2 / g */
+        fmpz_one(r);
+
+        if (!fmpz_is_one(t))
+        {
+            long c = fmpz_is_one(g) ? -2 : -1;
+
+            fmpz_divexact(u, F1, g);
+            fmpz_mod(u, u, t);
+            fmpz_gcdinv(g, F, u, t);
+            fmpz_mul_si(F, F, c);
+            fmpz_mod(F, F, t);
+            fmpz_addmul(r, F1, F);
+        }
+
+        result = !(fmpz_cmp_ui(r, 1UL) > 0 && fmpz_cmp(r, n) < 0
+                    && fmpz_divisible(n, r));
+    }
+
+    fmpz_clear(g);
+    fmpz_clear(F);
+    fmpz_clear(r);
+    fmpz_clear(t);
+    fmpz_clear(u);
+
+    return result;
+}
@@ -0,0 +1,303 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "fmpz_factor.h"
+
+/* Whether lcm(F1, F2)^2 > n */
+static int
+_bls_enough(const fmpz_t n, const fmpz_t F1, const fmpz_t F2)
+{
+    fmpz_t F;
+    int result;
+
+    fmpz_init(F);
+    fmpz_lcm(F, F1, F2);
+    fmpz_mul(F, F, F);
+    result = (fmpz_cmp(F, n) > 0);
+    fmpz_clear(F);
+
+    return result;
+}
+
+/* Proves the cofactor R prime, with a certificate in *sub if needed */
+static int
+_prove_cofactor(fmpz_prime_cert_struct ** sub, const fmpz_t R, int want)
+{
+    int result;
+
+    *sub = NULL;
+
+    if (fmpz_is_one(R) || !fmpz_is_probabprime(R))
+        return 0;
+
+    if (!want || fmpz_abs_fits_ui(R))
+        return fmpz_is_prime(R) == 1;
+
+    *sub = malloc(sizeof(fmpz_prime_cert_struct));
+    fmpz_prime_cert_init(*sub);
+
+    result = fmpz_is_prime_cert(*sub, R);
+
+    if (result != 1)
+    {
+        fmpz_prime_cert_clear(*sub);
+        free(*sub);
+        *sub = NULL;
+    }
+
+    return result == 1;
+}
+
+/* Pocklington witnesses for the primes of fac, and R if it is not 1 */
+static int
+_prove_minus(fmpz_prime_cert_t cert, const fmpz_t n,
+                    const fmpz_factor_t fac, const fmpz_t R,
+                    fmpz_prime_cert_struct ** sub, const fmpz_powm_ctx_t ctx)
+{
+    const fmpz * q;
+    ulong a;
+    long i;
+    int result = 1;
+
+    for (i = 0; i <= fac->length && result == 1; i++)
+    {
+        q = (i < fac->length) ? fac->p + i : R;
+
+        if (fmpz_is_one(q))
+            break;
+
+        for (a = 2; a < FMPZ_IS_PRIME_WITNESSES + 2; a++)
+        {
+            result = _fmpz_is_prime_pocklington(n, q, a, ctx);
+
+            if (result != -1)
+                break;
+        }
+
+        if (result == 1 && cert != NULL)
+        {
+            _fmpz_prime_cert_append(cert, q, 1, a,
+                                            (i < fac->length) ? NULL : *sub);
+            if (i == fac->length)
+                *sub = NULL;
+        }
+    }
+
+    return result;
+}
+
+/* A Lucas parameter P which is a witness for all odd primes of fac and R */
+static int
+_prove_plus(fmpz_prime_cert_t cert, const fmpz_t n,
+                    const fmpz_factor_t fac, const fmpz_t R,
+                    fmpz_prime_cert_struct ** sub, const fmpz_powm_ctx_t ctx)
+{
+    const fmpz * q;
+    mpz_t D;
+    ulong P;
+    long i;
+    int j, result = -1;
+
+    mpz_init(D);
+
+    for (P = 3; P < FMPZ_IS_PRIME_WITNESSES + 3 && result == -1; P++)
+    {
+        mpz_set_ui(D, P * P - 4);
+        j = mpz_jacobi(D, ctx->m);
+
+        if (j == 0)
+        {
+            result = 0;
+            break;
+        }
+
+        if (j == 1)
+            continue;
+
+        result = 1;
+        for (i = 0; i <= fac->length && result == 1; i++)
+        {
+            q = (i < fac->length) ? fac->p + i : R;
+
+            if (fmpz_is_one(q))
+                break;
+
+            if (fmpz_cmp_ui(q, 2UL) != 0)
+                result = _fmpz_is_prime_morrison(n, q, P, ctx);
+        }
+    }
+
+    mpz_clear(D);
+
+    if (result == 1 && cert != NULL)
+    {
+        cert->P = P - 1;
+
+        for (i = 0; i < fac->length; i++)
+            if (fmpz_cmp_ui(fac->p + i, 2UL) != 0)
+                _fmpz_prime_cert_append(cert, fac->p + i, -1, 0UL, NULL);
+
+        if (!fmpz_is_one(R))
+        {
+            _fmpz_prime_cert_append(cert, R, -1, 0UL, *sub);
+            *sub = NULL;
+        }
+    }
+
+    return result;
+}
+
+int
+fmpz_is_prime_cert(fmpz_prime_cert_t cert, const fmpz_t n)
+{
+    fmpz_powm_ctx_t ctx;
+    fmpz_factor_t fac1, fac2;
+    fmpz_t R1, R2, F1, F2, t;
+    fmpz_prime_cert_struct * sub1, * sub2;
+    int use1, use2, result;
+
+    if (cert != NULL)
+    {
+        fmpz_prime_cert_clear(cert);
+        fmpz_prime_cert_init(cert);
+    }
+
+    if (fmpz_cmp_ui(n, 1UL) <= 0)
+        return 0;
+
+    if (fmpz_abs_fits_ui(n))
+        return n_is_prime(fmpz_get_ui(n));
+
+    if (!fmpz_is_probabprime(n))
+        return 0;
+
+    result = _fmpz_is_prime_small(n);
+    if (result != -1)
+        return result;
+
+    fmpz_factor_init(fac1);
+    fmpz_factor_init(fac2);
+    fmpz_init(R1);
+    fmpz_init(R2);
+    fmpz_init(F1);
+    fmpz_init(F2);
+    fmpz_init(t);
+    sub1 = sub2 = NULL;
+
+    /* Partial factorisations n - 1 = F1 R1 and n + 1 = F2 R2 */
+    fmpz_sub_ui(t, n, 1UL);
+    fmpz_factor_trial_partial(fac1, R1, t, FMPZ_IS_PRIME_TRIAL_PRIMES);
+    fmpz_divexact(F1, t, R1);
+
+    /* With Q = 1 the Lucas sequences only bound the odd part of F2 */
+    fmpz_add_ui(t, n, 1UL);
+    fmpz_factor_trial_partial(fac2, R2, t, FMPZ_IS_PRIME_TRIAL_PRIMES);
+    fmpz_divexact(F2, t, R2);
+    fmpz_tdiv_q_2exp(F2, F2, fmpz_val2(F2));
+
+    /* Take in the cofactors if they are prime and still needed */
+    if (!_bls_enough(n, F1, F2))
+    {
+        if (_prove_cofactor(&sub1, R1, cert != NULL))
+            fmpz_mul(F1, F1, R1);
+        else
+            fmpz_one(R1);
+    }
+    else
+        fmpz_one(R1);
+
+    if (!_bls_enough(n, F1, F2))
+    {
+        if (_prove_cofactor(&sub2, R2, cert != NULL))
+            fmpz_mul(F2, F2, R2);
+        else
+            fmpz_one(R2);
+    }
+    else
+        fmpz_one(R2);
+
+    if (!_bls_enough(n, F1, F2))
+    {
+        result = -1;
+    }
+    else
+    {
+        /* Use only one side if it suffices on its own */
+        use1 = use2 = 1;
+        fmpz_one(t);
+
+        if (_bls_enough(n, F1, t))
+            use2 = 0;
+        else if (_bls_enough(n, t, F2))
+            use1 = 0;
+
+        if (!use1)
+            fmpz_one(F1);
+        if (!use2)
+            fmpz_one(F2);
+
+        fmpz_powm_ctx_init(ctx, n);
+
+        result = 1;
+
+        if (use1)
+            result = _prove_minus(cert, n, fac1, R1, &sub1, ctx);
+
+        if (result == 1 && use2)
+            result = _prove_plus(cert, n, fac2, R2, &sub2, ctx);
+
+        if (result == 1)
+            result = _fmpz_is_prime_bls(n, F1, F2);
+
+        fmpz_powm_ctx_clear(ctx);
+    }
+
+    if (result != 1 && cert != NULL)
+    {
+        fmpz_prime_cert_clear(cert);
+        fmpz_prime_cert_init(cert);
+    }
+
+    if (sub1 != NULL)
+    {
+        fmpz_prime_cert_clear(sub1);
+        free(sub1);
+    }
+
+    if (sub2 != NULL)
+    {
+        fmpz_prime_cert_clear(sub2);
+        free(sub2);
+    }
+
+    fmpz_factor_clear(fac1);
+    fmpz_factor_clear(fac2);
+    fmpz_clear(R1);
+    fmpz_clear(R2);
+    fmpz_clear(F1);
+    fmpz_clear(F2);
+    fmpz_clear(t);
+
+    return result;
+}
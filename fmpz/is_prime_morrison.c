@@ -0,0 +1,103 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "fmpz.h"
+
+static void
+_lucas_v(mp_ptr V, mp_srcptr P, const fmpz_t e, const fmpz_powm_ctx_t ctx)
+{
+    mpz_t t;
+
+    mpz_init(t);
+    fmpz_get_mpz(t, e);
+    _fmpz_powm_lucas_v(V, P, t->_mp_d, mpz_size(t), ctx);
+    mpz_clear(t);
+}
+
+/*
+    With D = P^2 - 4 and (D / n) = -1, checks V_{n+1} = 2 and
+    gcd(V_{(n+1)/q}^2 - 4, n) = 1 for the Lucas sequence V_k(P, 1). Then
+    n divides U_{n+1} but is coprime to U_{(n+1)/q}, as D U_k^2 = V_k^2 - 4,
+    so that every prime p dividing n is (D / p) modulo the largest power
+    of q dividing n + 1. This is of use only for odd q, as V_{(n+1)/2}
+    is always +-2 for prime n with Q = 1. Returns 1 if both hold, 0 if they prove n
+    composite and -1 if P is no witness for q.
+ */
+int
+_fmpz_is_prime_morrison(const fmpz_t n, const fmpz_t q, ulong P,
+                                            const fmpz_powm_ctx_t ctx)
+{
+    mp_size_t k = ctx->n;
+    mp_ptr t, W, X, Y;
+    mpz_t w;
+    fmpz_t e, g;
+    int result;
+
+    t = malloc(3 * k * sizeof(mp_limb_t));
+    W = t;
+    X = W + k;
+    Y = X + k;
+
+    fmpz_init(e);
+    fmpz_init(g);
+    mpz_init_set_ui(w, P);
+
+    fmpz_add_ui(e, n, 1UL);
+    fmpz_divexact(e, e, q);
+
+    _fmpz_powm_to_mont(X, w, ctx);
+    _lucas_v(W, X, e, ctx);
+    _lucas_v(Y, W, q, ctx);
+
+    /* V_{n+1} = V_q(V_{(n+1)/q}) should be 2 */
+    _fmpz_powm_from_mont(w, Y, ctx);
+
+    if (mpz_cmp_ui(w, 2UL) != 0)
+    {
+        result = 0;
+    }
+    else
+    {
+        _fmpz_powm_from_mont(w, W, ctx);
+        mpz_mul(w, w, w);
+        mpz_sub_ui(w, w, 4UL);
+        mpz_mod(w, w, ctx->m);
+
+        fmpz_set_mpz(e, w);
+        fmpz_gcd(g, e, n);
+
+        if (fmpz_is_one(g))
+            result = 1;
+        else if (fmpz_equal(g, n))
+            result = -1;
+        else
+            result = 0;
+    }
+
+    mpz_clear(w);
+    fmpz_clear(e);
+    fmpz_clear(g);
+    free(t);
+
+    return result;
+}
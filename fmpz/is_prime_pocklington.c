@@ -0,0 +1,70 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <mpir.h>
+#include "flint.h"
+#include "fmpz.h"
+
+/*
+    Checks a^(n - 1) = 1 and gcd(a^((n - 1)/q) - 1, n) = 1, which show
+    that every prime divisor of n is 1 modulo the largest power of q
+    dividing n - 1. Returns 1 if both hold, 0 if they prove n composite
+    and -1 if a is no witness for q.
+ */
+int
+_fmpz_is_prime_pocklington(const fmpz_t n, const fmpz_t q, ulong a,
+                                            const fmpz_powm_ctx_t ctx)
+{
+    fmpz_t e, y, z;
+    int result;
+
+    fmpz_init(e);
+    fmpz_init_set_ui(y, a);
+    fmpz_init(z);
+
+    fmpz_sub_ui(e, n, 1UL);
+    fmpz_divexact(e, e, q);
+
+    fmpz_powm_precomp(y, y, e, ctx);
+    fmpz_powm_precomp(z, y, q, ctx);
+
+    if (!fmpz_is_one(z))
+    {
+        result = 0;
+    }
+    else
+    {
+        fmpz_sub_ui(y, y, 1UL);
+        fmpz_gcd(z, y, n);
+
+        if (fmpz_is_one(z))
+            result = 1;
+        else if (fmpz_equal(z, n))
+            result = -1;
+        else
+            result = 0;
+    }
+
+    fmpz_clear(e);
+    fmpz_clear(y);
+    fmpz_clear(z);
+
+    return result;
+}
@@ -0,0 +1,72 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <mpir.h>
+#include "flint.h"
+#include "fmpz.h"
+
+/*
+    Strong probable prime tests to the first 13 prime bases are correct
+    for all n below psi_13 = 3317044064679887385961981, by a result of
+    Sorenson and Webster. Returns -1 if n exceeds this bound.
+ */
+int
+_fmpz_is_prime_small(const fmpz_t n)
+{
+    static const ulong bases[13] =
+        { 2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41 };
+    fmpz_powm_ctx_t ctx;
+    fmpz_t bound;
+    mpz_t a;
+    int i, result;
+
+    fmpz_init(bound);
+    fmpz_set_str(bound, "3317044064679887385961981", 10);
+    result = (fmpz_cmp(n, bound) < 0);
+    fmpz_clear(bound);
+
+    if (!result)
+        return -1;
+
+    if (fmpz_cmp_ui(n, 41UL) <= 0)
+    {
+        for (i = 0; i < 13; i++)
+            if (fmpz_cmp_ui(n, bases[i]) == 0)
+                return 1;
+        return 0;
+    }
+
+    if (fmpz_is_even(n))
+        return 0;
+
+    fmpz_powm_ctx_init(ctx, n);
+    mpz_init(a);
+
+    for (i = 0; i < 13 && result; i++)
+    {
+        mpz_set_ui(a, bases[i]);
+        result = _fmpz_is_strong_probabprime(a, ctx);
+    }
+
+    mpz_clear(a);
+    fmpz_powm_ctx_clear(ctx);
+
+    return result;
+}
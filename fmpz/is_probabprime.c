@@ -0,0 +1,65 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <mpir.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "mpn_extras.h"
+#include "ulong_extras.h"
+
+/*
+    Baillie-PSW test: trial division, then a strong base 2 test and an
+    almost extra strong Lucas test sharing the Montgomery precomputation
+ */
+int
+fmpz_is_probabprime(const fmpz_t n)
+{
+    fmpz_powm_ctx_t ctx;
+    __mpz_struct * m;
+    mpz_t two;
+    int result;
+
+    if (fmpz_sgn(n) <= 0)
+        return 0;
+
+    if (fmpz_abs_fits_ui(n))
+        return n_is_probabprime(fmpz_get_ui(n));
+
+    if (fmpz_is_even(n))
+        return 0;
+
+    m = COEFF_TO_PTR(*n);
+
+    if (mpn_factor_trial(m->_mp_d, m->_mp_size, 1,
+                                    FMPZ_IS_PROBABPRIME_TRIAL_PRIMES))
+        return 0;
+
+    fmpz_powm_ctx_init(ctx, n);
+    mpz_init_set_ui(two, 2UL);
+
+    result = _fmpz_is_strong_probabprime(two, ctx)
+        && !mpz_perfect_square_p(ctx->m)
+        && _fmpz_is_probabprime_lucas(ctx);
+
+    mpz_clear(two);
+    fmpz_powm_ctx_clear(ctx);
+
+    return result;
+}
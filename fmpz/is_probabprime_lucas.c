@@ -0,0 +1,122 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "ulong_extras.h"
+
+/*
+    Almost extra strong Lucas test with Q = 1 and the first P >= 3 for
+    which (P^2 - 4 / m) = -1. Writing m + 1 = d 2^s, a prime m has
+    V_d = +-2 or V_{d 2^r} = 0 for some 0 <= r < s - 1, since V_{m+1} = 2
+    and V_{2k} = V_k^2 - 2. Assumes that m is not a square and that m
+    exceeds P^2 - 4 for the P found.
+ */
+int
+_fmpz_is_probabprime_lucas(const fmpz_powm_ctx_t ctx)
+{
+    mp_size_t n = ctx->n;
+    mp_ptr V, P, two, minus_two, t;
+    mpz_t d, x;
+    mp_bitcnt_t s, r;
+    ulong p;
+    int j, result = 0;
+
+    for (p = 3; ; p++)
+    {
+        j = mpz_ui_kronecker(p * p - 4, ctx->m);
+
+        if (j == -1)
+            break;
+
+        if (j == 0)
+            return 0;
+    }
+
+    t = malloc(6 * n * sizeof(mp_limb_t));
+    V = t + 2 * n;
+    P = V + n;
+    two = P + n;
+    minus_two = two + n;
+
+    mpz_init_set_ui(x, p);
+    _fmpz_powm_to_mont(P, x, ctx);
+    mpz_set_ui(x, 2UL);
+    _fmpz_powm_to_mont(two, x, ctx);
+    mpn_sub_n(minus_two, ctx->m->_mp_d, two, n);
+
+    /* m + 1 = d 2^s */
+    mpz_init(d);
+    mpz_add_ui(d, ctx->m, 1UL);
+    s = mpz_scan1(d, 0);
+    mpz_tdiv_q_2exp(d, d, s);
+
+    _fmpz_powm_lucas_v(V, P, d->_mp_d, mpz_size(d), ctx);
+
+    if (mpn_cmp(V, two, n) == 0 || mpn_cmp(V, minus_two, n) == 0)
+    {
+        result = 1;
+    }
+    else
+    {
+        for (r = 0; r + 1 < s; r++)
+        {
+            if (mpn_zero_p(V, n))
+            {
+                result = 1;
+                break;
+            }
+
+            _fmpz_powm_mulredc_reduced(V, V, V, t, ctx);
+            if (mpn_sub_n(V, V, two, n))
+                mpn_add_n(V, V, ctx->m->_mp_d, n);
+        }
+    }
+
+    mpz_clear(x);
+    mpz_clear(d);
+    free(t);
+
+    return result;
+}
+
+int
+fmpz_is_probabprime_lucas(const fmpz_t n)
+{
+    fmpz_powm_ctx_t ctx;
+    int result;
+
+    if (fmpz_sgn(n) <= 0)
+        return 0;
+
+    if (fmpz_abs_fits_ui(n))
+        return n_is_probabprime_lucas(fmpz_get_ui(n));
+
+    if (fmpz_is_even(n) || fmpz_is_square(n))
+        return 0;
+
+    fmpz_powm_ctx_init(ctx, n);
+    result = _fmpz_is_probabprime_lucas(ctx);
+    fmpz_powm_ctx_clear(ctx);
+
+    return result;
+}
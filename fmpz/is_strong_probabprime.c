@@ -0,0 +1,110 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "fmpz.h"
+
+int
+_fmpz_is_strong_probabprime(const __mpz_struct * a,
+                                            const fmpz_powm_ctx_t ctx)
+{
+    mp_size_t n = ctx->n;
+    mp_srcptr m = ctx->m->_mp_d;
+    mp_ptr x, y, minus_one, t;
+    mpz_t d;
+    mp_bitcnt_t s, i;
+    int result = 0;
+
+    t = malloc(6 * n * sizeof(mp_limb_t));
+    x = t + 2 * n;
+    y = x + n;
+    minus_one = y + n;
+
+    _fmpz_powm_to_mont(x, a, ctx);
+
+    if (mpn_zero_p(x, n))
+    {
+        free(t);
+        return 1;
+    }
+
+    /* m - 1 = d 2^s */
+    mpz_init(d);
+    mpz_sub_ui(d, ctx->m, 1UL);
+    s = mpz_scan1(d, 0);
+    mpz_tdiv_q_2exp(d, d, s);
+
+    mpn_sub_n(minus_one, m, ctx->one, n);
+
+    _fmpz_powm_mont(y, x, d->_mp_d, mpz_size(d), ctx);
+
+    /* The powering leaves y below R, not necessarily below m */
+    mpn_tdiv_qr(t, y, 0, y, n, m, n);
+
+    if (mpn_cmp(y, ctx->one, n) == 0 || mpn_cmp(y, minus_one, n) == 0)
+    {
+        result = 1;
+    }
+    else
+    {
+        for (i = 1; i < s; i++)
+        {
+            _fmpz_powm_mulredc_reduced(y, y, y, t, ctx);
+
+            if (mpn_cmp(y, minus_one, n) == 0)
+            {
+                result = 1;
+                break;
+            }
+
+            if (mpn_cmp(y, ctx->one, n) == 0)
+                break;
+        }
+    }
+
+    mpz_clear(d);
+    free(t);
+
+    return result;
+}
+
+int
+fmpz_is_strong_probabprime(const fmpz_t n, const fmpz_t a)
+{
+    fmpz_powm_ctx_t ctx;
+    mpz_t b;
+    int result;
+
+    if (fmpz_cmp_ui(n, 2UL) <= 0 || fmpz_is_even(n))
+        return fmpz_cmp_ui(n, 2UL) == 0;
+
+    fmpz_powm_ctx_init(ctx, n);
+    mpz_init(b);
+    fmpz_get_mpz(b, a);
+
+    result = _fmpz_is_strong_probabprime(b, ctx);
+
+    mpz_clear(b);
+    fmpz_powm_ctx_clear(ctx);
+
+    return result;
+}
@@ -0,0 +1,137 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "fmpz.h"
+
+/* Bits p, ..., p + k - 1 of the en-limb integer e */
+static mp_limb_t
+_fmpz_powm_digit(mp_srcptr e, mp_size_t en, mp_bitcnt_t p, int k)
+{
+    mp_size_t w = p / FLINT_BITS;
+    int s = p % FLINT_BITS;
+    mp_limb_t d;
+
+    if (w >= en)
+        return 0UL;
+
+    d = e[w] >> s;
+    if (s + k > FLINT_BITS && w + 1 < en)
+        d |= e[w + 1] << (FLINT_BITS - s);
+
+    return d & ((1UL << k) - 1UL);
+}
+
+void
+_fmpz_powm_base(__mpz_struct * r, const __mpz_struct * e,
+                const fmpz_powm_base_t B, const fmpz_powm_ctx_t ctx)
+{
+    mp_size_t n = ctx->n, en;
+    mp_bitcnt_t covered;
+    mp_limb_t d;
+    mp_ptr t, acc, entry;
+    long i, w;
+    int started;
+
+    if (mpz_sgn(e) < 0)
+    {
+        printf("Exception (fmpz_powm_base).  Negative exponent.\n");
+        abort();
+    }
+
+    if (!ctx->mont)
+    {
+        mpz_powm(r, B->g, e, ctx->m);
+        return;
+    }
+
+    if (mpz_sgn(e) == 0)
+    {
+        mpz_set_ui(r, 1UL);
+        return;
+    }
+
+    t = malloc(4 * n * sizeof(mp_limb_t));
+    acc = t + 2 * n;
+    entry = t + 3 * n;
+
+    en = mpz_size(e);
+    w = (1L << B->k) - 1;
+    started = 0;
+
+    for (i = 0; i < B->rows; i++)
+    {
+        d = _fmpz_powm_digit(e->_mp_d, en, i * B->k, B->k);
+
+        if (d != 0UL)
+        {
+            if (started)
+                _fmpz_powm_mulredc(acc, acc, B->table + (i * w + d - 1) * n,
+                                                                    t, ctx);
+            else
+                mpn_copyi(acc, B->table + (i * w + d - 1) * n, n);
+
+            started = 1;
+        }
+    }
+
+    /* Bits of e beyond the table use the top power g^(2^(k rows)) */
+    covered = (mp_bitcnt_t) B->rows * B->k;
+
+    if (mpz_sizeinbase(e, 2) > covered)
+    {
+        mpz_t h;
+
+        mpz_init(h);
+        mpz_tdiv_q_2exp(h, e, covered);
+        _fmpz_powm_mont(entry, B->top, h->_mp_d, mpz_size(h), ctx);
+        mpz_clear(h);
+
+        if (started)
+            _fmpz_powm_mulredc(acc, acc, entry, t, ctx);
+        else
+            mpn_copyi(acc, entry, n);
+    }
+
+    _fmpz_powm_from_mont(r, acc, ctx);
+
+    free(t);
+}
+
+void
+fmpz_powm_base(fmpz_t f, const fmpz_t e, const fmpz_powm_base_t B,
+                                            const fmpz_powm_ctx_t ctx)
+{
+    __mpz_struct ev, *ep, *r;
+    mp_limb_t el;
+
+    if (COEFF_IS_MPZ(*e))
+        ep = COEFF_TO_PTR(*e);
+    else
+        _fmpz_get_mpz_view(ep = &ev, &el, e);
+
+    r = _fmpz_promote_val(f);
+    _fmpz_powm_base(r, ep, B, ctx);
+    _fmpz_demote_val(f);
+}
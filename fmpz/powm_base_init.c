@@ -0,0 +1,78 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "fmpz.h"
+
+/*
+    Row i of the table holds g^(j 2^(k i)) for 0 < j < 2^k, in Montgomery
+    form, so that g^e is a product of one entry per nonzero k-bit digit of e.
+ */
+void
+fmpz_powm_base_init(fmpz_powm_base_t B, const fmpz_t g,
+                        mp_bitcnt_t bits, const fmpz_powm_ctx_t ctx)
+{
+    mp_size_t n = ctx->n;
+    long i, j, w;
+    mp_ptr t, row;
+    int k;
+
+    mpz_init(B->g);
+    fmpz_get_mpz(B->g, g);
+
+    B->table = NULL;
+    B->top = NULL;
+    B->rows = 0;
+    B->k = 0;
+
+    if (!ctx->mont)
+        return;
+
+    /* Trade a table of (2^k - 1) bits / k entries for bits / k products */
+    for (k = 1; k < FMPZ_POWM_BASE_MAX_WINDOW; k++)
+        if ((1UL << (k + 1)) * (k + 1) > bits)
+            break;
+
+    w = (1L << k) - 1;
+    B->k = k;
+    B->rows = (bits + k - 1) / k;
+    B->table = malloc((B->rows * w + 1) * n * sizeof(mp_limb_t));
+    B->top = B->table + B->rows * w * n;
+
+    t = malloc(2 * n * sizeof(mp_limb_t));
+
+    _fmpz_powm_to_mont(B->top, B->g, ctx);
+
+    for (i = 0; i < B->rows; i++)
+    {
+        row = B->table + i * w * n;
+
+        mpn_copyi(row, B->top, n);
+        for (j = 1; j < w; j++)
+            _fmpz_powm_mulredc(row + j * n, row + (j - 1) * n, row, t, ctx);
+
+        _fmpz_powm_mulredc(B->top, row + (w - 1) * n, row, t, ctx);
+    }
+
+    free(t);
+}
@@ -0,0 +1,67 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "fmpz.h"
+
+void
+fmpz_powm_ctx_init(fmpz_powm_ctx_t ctx, const fmpz_t m)
+{
+    mp_limb_t inv, m0, q[2];
+    mp_ptr t;
+    mp_size_t n;
+    int i;
+
+    if (fmpz_sgn(m) <= 0)
+    {
+        printf("Exception (fmpz_powm_ctx_init).  Modulus is less than 1.\n");
+        abort();
+    }
+
+    mpz_init(ctx->m);
+    fmpz_get_mpz(ctx->m, m);
+    n = ctx->n = mpz_size(ctx->m);
+    ctx->mont = mpz_odd_p(ctx->m) && !fmpz_is_one(m);
+    ctx->one = NULL;
+
+    if (!ctx->mont)
+        return;
+
+    /* Newton iteration for 1/m mod 2^FLINT_BITS, starting from 3 bits */
+    m0 = ctx->m->_mp_d[0];
+    inv = m0;
+    for (i = 0; i < 5; i++)
+        inv *= 2UL - m0 * inv;
+    ctx->ninv = -inv;
+
+    /* R mod m */
+    t = malloc((n + 1) * sizeof(mp_limb_t));
+    mpn_zero(t, n);
+    t[n] = 1UL;
+
+    ctx->one = malloc(n * sizeof(mp_limb_t));
+    mpn_tdiv_qr(q, ctx->one, 0, t, n + 1, ctx->m->_mp_d, n);
+
+    free(t);
+}
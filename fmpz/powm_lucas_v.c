@@ -0,0 +1,80 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "fmpz.h"
+
+/* r = a - b mod m for a, b in [0, m) */
+static __inline__ void
+_sub_mod(mp_ptr r, mp_srcptr a, mp_srcptr b, const fmpz_powm_ctx_t ctx)
+{
+    if (mpn_sub_n(r, a, b, ctx->n))
+        mpn_add_n(r, r, ctx->m->_mp_d, ctx->n);
+}
+
+/*
+    V = V_e(P, 1) in Montgomery form, where V_0 = 2, V_1 = P and
+    V_{k+1} = P V_k - V_{k-1}, for P in Montgomery form and reduced and
+    e of en limbs with nonzero top limb. Uses a ladder on the pair (V_k, V_{k+1})
+    using V_{2k} = V_k^2 - 2 and V_{2k+1} = V_k V_{k+1} - P
+ */
+void
+_fmpz_powm_lucas_v(mp_ptr V, mp_srcptr P, mp_srcptr e, mp_size_t en,
+                                            const fmpz_powm_ctx_t ctx)
+{
+    mp_size_t n = ctx->n;
+    mp_ptr W, two, t;
+    mp_bitcnt_t i;
+
+    t = malloc(4 * n * sizeof(mp_limb_t));
+    W = t + 2 * n;
+    two = W + n;
+
+    /* 2 R mod m */
+    if (mpn_add_n(two, ctx->one, ctx->one, n)
+        || mpn_cmp(two, ctx->m->_mp_d, n) >= 0)
+        mpn_sub_n(two, two, ctx->m->_mp_d, n);
+
+    mpn_copyi(V, two, n);
+    mpn_copyi(W, P, n);
+
+    i = (en - 1) * FLINT_BITS + FLINT_BIT_COUNT(e[en - 1]);
+    while (i-- > 0)
+    {
+        if ((e[i / FLINT_BITS] >> (i % FLINT_BITS)) & 1UL)
+        {
+            _fmpz_powm_mulredc_reduced(V, V, W, t, ctx);
+            _sub_mod(V, V, P, ctx);
+            _fmpz_powm_mulredc_reduced(W, W, W, t, ctx);
+            _sub_mod(W, W, two, ctx);
+        }
+        else
+        {
+            _fmpz_powm_mulredc_reduced(W, V, W, t, ctx);
+            _sub_mod(W, W, P, ctx);
+            _fmpz_powm_mulredc_reduced(V, V, V, t, ctx);
+            _sub_mod(V, V, two, ctx);
+        }
+    }
+
+    free(t);
+}
@@ -0,0 +1,183 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "fmpz.h"
+
+/*
+    Arithmetic on residues in Montgomery form. Residues are kept as n limbs
+    and are only reduced to [0, m) on conversion back, as a product of two
+    n-limb numbers reduces to less than R + m. None of these functions use
+    the fmpz memory manager, so they may run in several threads at once.
+ */
+
+/* r = t / R mod m, destroying t of 2n limbs */
+static void
+_fmpz_powm_redc(mp_ptr r, mp_ptr t, const fmpz_powm_ctx_t ctx)
+{
+    mp_size_t i, n = ctx->n;
+    mp_srcptr m = ctx->m->_mp_d;
+
+    /* The carry out of step i belongs at t[i + n]; it is kept in the
+       limb t[i] cleared by that step and added in at the end */
+    for (i = 0; i < n; i++)
+        t[i] = mpn_addmul_1(t + i, m, n, t[i] * ctx->ninv);
+
+    if (mpn_add_n(r, t + n, t, n))
+        mpn_sub_n(r, r, m, n);
+}
+
+/* r = a b / R mod m, using 2n limbs of scratch space t */
+void
+_fmpz_powm_mulredc(mp_ptr r, mp_srcptr a, mp_srcptr b, mp_ptr t,
+                                            const fmpz_powm_ctx_t ctx)
+{
+    if (a == b)
+        mpn_sqr(t, a, ctx->n);
+    else
+        mpn_mul_n(t, a, b, ctx->n);
+
+    _fmpz_powm_redc(r, t, ctx);
+}
+
+/* r = x R mod m, for any integer x */
+void
+_fmpz_powm_to_mont(mp_ptr r, const __mpz_struct * x,
+                                            const fmpz_powm_ctx_t ctx)
+{
+    mp_size_t n = ctx->n, xn = mpz_size(x);
+    mp_ptr t, q;
+
+    if (xn == 0)
+    {
+        mpn_zero(r, n);
+        return;
+    }
+
+    t = malloc((2 * xn + n + 1) * sizeof(mp_limb_t));
+    q = t + xn + n;
+
+    mpn_zero(t, n);
+    mpn_copyi(t + n, x->_mp_d, xn);
+    mpn_tdiv_qr(q, r, 0, t, xn + n, ctx->m->_mp_d, n);
+
+    if (mpz_sgn(x) < 0 && !mpn_zero_p(r, n))
+        mpn_sub_n(r, ctx->m->_mp_d, r, n);
+
+    free(t);
+}
+
+/* r = x / R mod m, reduced to [0, m) */
+void
+_fmpz_powm_from_mont(__mpz_struct * r, mp_srcptr x,
+                                            const fmpz_powm_ctx_t ctx)
+{
+    mp_size_t n = ctx->n;
+    mp_ptr t, d;
+
+    t = malloc(2 * n * sizeof(mp_limb_t));
+    mpn_copyi(t, x, n);
+    mpn_zero(t + n, n);
+
+    d = mpz_realloc(r, n);
+    _fmpz_powm_redc(d, t, ctx);
+
+    /* Here the result is at most m */
+    if (mpn_cmp(d, ctx->m->_mp_d, n) >= 0)
+        mpn_sub_n(d, d, ctx->m->_mp_d, n);
+
+    while (n > 0 && d[n - 1] == 0UL)
+        n--;
+    r->_mp_size = n;
+
+    free(t);
+}
+
+#define EXP_BIT(e, i) (((e)[(i) / FLINT_BITS] >> ((i) % FLINT_BITS)) & 1UL)
+
+/*
+    r = g^e in Montgomery form, where e has en > 0 limbs with the top one
+    nonzero, by left-to-right sliding window exponentiation
+ */
+void
+_fmpz_powm_mont(mp_ptr r, mp_srcptr g, mp_srcptr e, mp_size_t en,
+                                            const fmpz_powm_ctx_t ctx)
+{
+    mp_size_t n = ctx->n;
+    mp_bitcnt_t bits;
+    long i, j, w;
+    int k, started;
+    mp_ptr P, t;
+
+    bits = en * FLINT_BITS;
+    count_leading_zeros(i, e[en - 1]);
+    bits -= i;
+
+    k = (bits > 671) ? 6 : (bits > 239) ? 5 : (bits > 79) ? 4 :
+        (bits > 23) ? 3 : (bits > 7) ? 2 : 1;
+
+    /* P holds the odd powers g, g^3, ..., g^(2^k - 1) */
+    P = malloc(((1L << (k - 1)) * n + 3 * n) * sizeof(mp_limb_t));
+    t = P + (1L << (k - 1)) * n;
+
+    mpn_copyi(P, g, n);
+    if (k > 1)
+    {
+        _fmpz_powm_mulredc(t + 2 * n, g, g, t, ctx);
+        for (i = 1; i < (1L << (k - 1)); i++)
+            _fmpz_powm_mulredc(P + i * n, P + (i - 1) * n, t + 2 * n, t, ctx);
+    }
+
+    started = 0;
+
+    for (i = bits - 1; i >= 0; )
+    {
+        if (!EXP_BIT(e, i))
+        {
+            _fmpz_powm_mulredc(r, r, r, t, ctx);
+            i--;
+            continue;
+        }
+
+        /* The window e[i..j] is as long as possible and ends in a 1 */
+        j = FLINT_MAX(i - k + 1, 0);
+        while (!EXP_BIT(e, j))
+            j++;
+
+        for (w = 0; i >= j; i--)
+        {
+            w = 2 * w + EXP_BIT(e, i);
+            if (started)
+                _fmpz_powm_mulredc(r, r, r, t, ctx);
+        }
+
+        if (started)
+            _fmpz_powm_mulredc(r, r, P + (w / 2) * n, t, ctx);
+        else
+            mpn_copyi(r, P + (w / 2) * n, n);
+
+        started = 1;
+    }
+
+    free(P);
+}
@@ -0,0 +1,83 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "fmpz.h"
+
+void
+_fmpz_powm_precomp(__mpz_struct * r, const __mpz_struct * g,
+                    const __mpz_struct * e, const fmpz_powm_ctx_t ctx)
+{
+    mp_size_t n = ctx->n;
+    mp_ptr t;
+
+    if (mpz_sgn(e) < 0)
+    {
+        printf("Exception (fmpz_powm_precomp).  Negative exponent.\n");
+        abort();
+    }
+
+    if (!ctx->mont)
+    {
+        mpz_powm(r, g, e, ctx->m);
+        return;
+    }
+
+    if (mpz_sgn(e) == 0)
+    {
+        mpz_set_ui(r, 1UL);
+        return;
+    }
+
+    t = malloc(2 * n * sizeof(mp_limb_t));
+
+    _fmpz_powm_to_mont(t, g, ctx);
+    _fmpz_powm_mont(t + n, t, e->_mp_d, mpz_size(e), ctx);
+    _fmpz_powm_from_mont(r, t + n, ctx);
+
+    free(t);
+}
+
+void
+fmpz_powm_precomp(fmpz_t f, const fmpz_t g, const fmpz_t e,
+                                            const fmpz_powm_ctx_t ctx)
+{
+    __mpz_struct gv, ev, *gp, *ep, *r;
+    mp_limb_t gl, el;
+
+    /* Large operands are passed as themselves so that GMP sees aliasing */
+    if (COEFF_IS_MPZ(*g))
+        gp = COEFF_TO_PTR(*g);
+    else
+        _fmpz_get_mpz_view(gp = &gv, &gl, g);
+
+    if (COEFF_IS_MPZ(*e))
+        ep = COEFF_TO_PTR(*e);
+    else
+        _fmpz_get_mpz_view(ep = &ev, &el, e);
+
+    r = _fmpz_promote_val(f);
+    _fmpz_powm_precomp(r, gp, ep, ctx);
+    _fmpz_demote_val(f);
+}
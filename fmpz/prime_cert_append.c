@@ -0,0 +1,53 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "fmpz.h"
+
+/* Appends q with the given type and witness, taking ownership of sub */
+void
+_fmpz_prime_cert_append(fmpz_prime_cert_t cert, const fmpz_t q,
+                            int type, ulong a, fmpz_prime_cert_struct * sub)
+{
+    long i, len;
+
+    if (cert->num == cert->alloc)
+    {
+        len = FLINT_MAX(4, 2 * cert->alloc);
+
+        cert->q = realloc(cert->q, len * sizeof(fmpz));
+        cert->type = realloc(cert->type, len * sizeof(int));
+        cert->a = realloc(cert->a, len * sizeof(ulong));
+        cert->sub = realloc(cert->sub, len * sizeof(fmpz_prime_cert_struct *));
+
+        for (i = cert->alloc; i < len; i++)
+            fmpz_init(cert->q + i);
+
+        cert->alloc = len;
+    }
+
+    fmpz_set(cert->q + cert->num, q);
+    cert->type[cert->num] = type;
+    cert->a[cert->num] = a;
+    cert->sub[cert->num] = sub;
+    cert->num++;
+}
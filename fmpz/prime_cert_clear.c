@@ -0,0 +1,45 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "fmpz_vec.h"
+
+void
+fmpz_prime_cert_clear(fmpz_prime_cert_t cert)
+{
+    long i;
+
+    for (i = 0; i < cert->num; i++)
+    {
+        if (cert->sub[i] != NULL)
+        {
+            fmpz_prime_cert_clear(cert->sub[i]);
+            free(cert->sub[i]);
+        }
+    }
+
+    _fmpz_vec_clear(cert->q, cert->alloc);
+    free(cert->type);
+    free(cert->a);
+    free(cert->sub);
+}
@@ -0,0 +1,70 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdio.h>
+#include <mpir.h>
+#include "flint.h"
+#include "fmpz.h"
+
+void
+fmpz_prime_cert_print(const fmpz_prime_cert_t cert)
+{
+    long i;
+    int type, first;
+
+    printf("[");
+
+    for (type = 1; type >= -1; type -= 2)
+    {
+        first = 1;
+
+        for (i = 0; i < cert->num; i++)
+        {
+            if (cert->type[i] != type)
+                continue;
+
+            if (first)
+            {
+                if (type == -1 && i != 0)
+                    printf("; ");
+                printf(type == 1 ? "n-1: " : "n+1: ");
+                first = 0;
+            }
+            else
+                printf(", ");
+
+            fmpz_print(cert->q + i);
+
+            if (cert->sub[i] != NULL)
+            {
+                printf(" ");
+                fmpz_prime_cert_print(cert->sub[i]);
+            }
+
+            if (type == 1)
+                printf(" (%lu)", cert->a[i]);
+        }
+
+        if (type == -1 && !first)
+            printf(" (P = %lu)", cert->P);
+    }
+
+    printf("]");
+}
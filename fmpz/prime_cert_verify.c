@@ -0,0 +1,127 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <mpir.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "ulong_extras.h"
+
+int
+fmpz_prime_cert_verify(const fmpz_prime_cert_t cert, const fmpz_t n)
+{
+    fmpz_powm_ctx_t ctx;
+    fmpz_t F1, F2, t;
+    fmpz * F;
+    mpz_t D;
+    long i, v;
+    int result;
+
+    if (fmpz_cmp_ui(n, 1UL) <= 0)
+        return 0;
+
+    if (fmpz_abs_fits_ui(n))
+        return n_is_prime(fmpz_get_ui(n));
+
+    if (cert->num == 0)
+        return _fmpz_is_prime_small(n) == 1;
+
+    if (fmpz_is_even(n))
+        return 0;
+
+    fmpz_init_set_ui(F1, 1UL);
+    fmpz_init_set_ui(F2, 1UL);
+    fmpz_init(t);
+    fmpz_powm_ctx_init(ctx, n);
+    result = 1;
+
+    for (i = 0; i < cert->num && result; i++)
+    {
+        if (cert->type[i] == -1
+            && (cert->P < 3UL || fmpz_cmp_ui(cert->q + i, 2UL) == 0))
+        {
+            result = 0;
+            break;
+        }
+
+        /* Each q must be a proven prime */
+        if (fmpz_cmp_ui(cert->q + i, 1UL) <= 0)
+            result = 0;
+        else if (fmpz_abs_fits_ui(cert->q + i))
+            result = n_is_prime(fmpz_get_ui(cert->q + i));
+        else
+            result = (cert->sub[i] != NULL)
+                && fmpz_prime_cert_verify(cert->sub[i], cert->q + i);
+
+        if (!result)
+            break;
+
+        /* Each q appears once, with its full power dividing n -+ 1 */
+        F = (cert->type[i] == 1) ? F1 : F2;
+
+        if (cert->type[i] == 1)
+            fmpz_sub_ui(t, n, 1UL);
+        else if (cert->type[i] == -1)
+            fmpz_add_ui(t, n, 1UL);
+        else
+            result = 0;
+
+        if (!result || fmpz_divisible(F, cert->q + i))
+        {
+            result = 0;
+            break;
+        }
+
+        v = fmpz_remove(t, t, cert->q + i);
+        if (v == 0)
+        {
+            result = 0;
+            break;
+        }
+
+        fmpz_pow_ui(t, cert->q + i, v);
+        fmpz_mul(F, F, t);
+
+        if (cert->type[i] == 1)
+            result = (_fmpz_is_prime_pocklington(n, cert->q + i,
+                                                    cert->a[i], ctx) == 1);
+        else
+            result = (_fmpz_is_prime_morrison(n, cert->q + i,
+                                                    cert->P, ctx) == 1);
+    }
+
+    if (result && !fmpz_is_one(F2))
+    {
+        mpz_init_set_ui(D, cert->P);
+        mpz_mul(D, D, D);
+        mpz_sub_ui(D, D, 4UL);
+        result = (mpz_jacobi(D, ctx->m) == -1);
+        mpz_clear(D);
+    }
+
+    if (result)
+        result = (_fmpz_is_prime_bls(n, F1, F2) == 1);
+
+    fmpz_powm_ctx_clear(ctx);
+    fmpz_clear(F1);
+    fmpz_clear(F2);
+    fmpz_clear(t);
+
+    return result;
+}
@@ -33,10 +33,52 @@ int fmpz_set_str(fmpz_t f, char * str, int b)
     int ans;
     mpz_t copy;
 
+    /* Strings of digits whose value fits in a limb are converted
+       directly; anything else, including whitespace, goes to mpz */
+    if (b >= 2 && b <= 62)
+    {
+        const char * s = str;
+        mp_limb_t u = 0, d;
+        int neg = 0;
+
+        if (*s == '-')
+        {
+            neg = 1;
+            s++;
+        }
+
+        if (*s != '\0')
+        {
+            for ( ; *s != '\0'; s++)
+            {
+                if (*s >= '0' && *s <= '9')
+                    d = *s - '0';
+                else if (*s >= 'A' && *s <= 'Z')
+                    d = *s - 'A' + 10;
+                else if (*s >= 'a' && *s <= 'z')
+                    d = *s - 'a' + (b <= 36 ? 10 : 36);
+                else
+                    break;
+
+                if (d >= (mp_limb_t) b || u > (~0UL - d) / b)
+                    break;
+
+                u = u * b + d;
+            }
+
+            if (*s == '\0')
+            {
+                fmpz_set_ui(f, u);
+                if (neg)
+                    fmpz_neg(f, f);
+                return 0;
+            }
+        }
+    }
+
     ans = mpz_init_set_str(copy, str, b);
     if (ans == 0)
         fmpz_set_mpz(f, copy);
     mpz_clear(copy);
     return ans;
 }
-
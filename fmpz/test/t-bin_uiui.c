@@ -68,6 +68,34 @@ main(void)
         mpz_clear(z);
     }
 
+    /* Large arguments, for which the prime factorisation is used */
+    for (i = 0; i < 100; i++)
+    {
+        fmpz_init(x);
+        fmpz_init(y);
+        mpz_init(z);
+
+        n = n_randint(state, 200000);
+        k = n_randint(state, n + 1);
+
+        flint_set_num_threads(n_randint(state, 4) + 1);
+        fmpz_bin_uiui(x, n, k);
+        flint_set_num_threads(1);
+
+        mpz_bin_uiui(z, n, k);
+        fmpz_set_mpz(y, z);
+
+        if (!fmpz_equal(x, y))
+        {
+            printf("FAIL: n,k = %lu,%lu\n", n, k);
+            abort();
+        }
+
+        fmpz_clear(x);
+        fmpz_clear(y);
+        mpz_clear(z);
+    }
+
     flint_randclear(state);
 
     _fmpz_cleanup();
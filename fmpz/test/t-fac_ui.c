@@ -37,6 +37,8 @@ main(void)
     long i, n;
     fmpz_t x;
     fmpz_t y;
+    mpz_t z;
+    flint_rand_t state;
 
     printf("fac_ui....");
     fflush(stdout);
@@ -65,6 +67,31 @@ main(void)
         }
     }
 
+    /* Large arguments, for which the prime swing algorithm is used */
+    flint_randinit(state);
+    mpz_init(z);
+
+    for (i = 0; i < 20; i++)
+    {
+        n = n_randint(state, 300000);
+
+        flint_set_num_threads(n_randint(state, 4) + 1);
+        fmpz_fac_ui(x, n);
+        flint_set_num_threads(1);
+
+        mpz_fac_ui(z, n);
+        fmpz_set_mpz(y, z);
+
+        if (!fmpz_equal(x, y))
+        {
+            printf("FAIL: %ld\n", n);
+            abort();
+        }
+    }
+
+    mpz_clear(z);
+    flint_randclear(state);
+
     fmpz_clear(x);
     fmpz_clear(y);
 
@@ -0,0 +1,129 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "fmpz_vec.h"
+#include "ulong_extras.h"
+
+int
+main(void)
+{
+    int i;
+    flint_rand_t state;
+    flint_randinit(state);
+
+    printf("hgcd....");
+    fflush(stdout);
+
+    for (i = 0; i < 2000; i++)
+    {
+        fmpz_t a, b, a0, b0, q, r, t;
+        fmpz * M;
+        mp_bitcnt_t bits, s;
+        int sign, det;
+
+        fmpz_init(a);
+        fmpz_init(b);
+        fmpz_init(a0);
+        fmpz_init(b0);
+        fmpz_init(q);
+        fmpz_init(r);
+        fmpz_init(t);
+        M = _fmpz_vec_init(4);
+
+        bits = 2 + n_randint(state, (i % 20 == 0) ? 20000 : 2000);
+        fmpz_randbits(a, state, bits);
+        if (n_randint(state, 2))
+            fmpz_randbits(b, state, bits);
+        else
+            fmpz_randtest_unsigned(b, state, 1 + n_randint(state, bits));
+        fmpz_abs(a, a);
+        fmpz_abs(b, b);
+        if (fmpz_cmp(a, b) < 0)
+            fmpz_swap(a, b);
+        if (fmpz_equal(a, b))
+            fmpz_add_ui(a, a, 1UL);
+
+        s = n_randint(state, fmpz_bits(a));
+
+        fmpz_set(a0, a);
+        fmpz_set(b0, b);
+
+        fmpz_one(M + 0);
+        fmpz_one(M + 3);
+        sign = _fmpz_hgcd(M, a, b, s);
+
+        /* (a0, b0) = M (a, b) */
+        fmpz_mul(q, M + 0, a);
+        fmpz_addmul(q, M + 1, b);
+        fmpz_mul(r, M + 2, a);
+        fmpz_addmul(r, M + 3, b);
+
+        fmpz_mul(t, M + 0, M + 3);
+        fmpz_submul(t, M + 1, M + 2);
+        det = fmpz_get_si(t);
+
+        if (!fmpz_equal(q, a0) || !fmpz_equal(r, b0) || det != sign)
+        {
+            printf("FAIL (matrix):\n");
+            printf("a0 = "), fmpz_print(a0), printf("\n");
+            printf("b0 = "), fmpz_print(b0), printf("\n");
+            printf("s = %lu, sign = %d, det = %d\n", s, sign, det);
+            abort();
+        }
+
+        /* Compare with the plain Euclidean algorithm */
+        while (fmpz_bits(b0) > s)
+        {
+            fmpz_fdiv_r(t, a0, b0);
+            fmpz_swap(a0, b0);
+            fmpz_swap(b0, t);
+        }
+
+        if (!fmpz_equal(a, a0) || !fmpz_equal(b, b0))
+        {
+            printf("FAIL (remainders):\n");
+            printf("a = "), fmpz_print(a), printf("\n");
+            printf("b = "), fmpz_print(b), printf("\n");
+            printf("a0 = "), fmpz_print(a0), printf("\n");
+            printf("b0 = "), fmpz_print(b0), printf("\n");
+            printf("s = %lu\n", s);
+            abort();
+        }
+
+        fmpz_clear(a);
+        fmpz_clear(b);
+        fmpz_clear(a0);
+        fmpz_clear(b0);
+        fmpz_clear(q);
+        fmpz_clear(r);
+        fmpz_clear(t);
+        _fmpz_vec_clear(M, 4);
+    }
+
+    flint_randclear(state);
+    _fmpz_cleanup();
+    printf("PASS\n");
+    return 0;
+}
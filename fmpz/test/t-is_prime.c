@@ -0,0 +1,220 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "ulong_extras.h"
+#include "fmpz.h"
+
+/*
+    Sets n to the first prime of the form m k +- 1 with k = 1, 2, ...,
+    where m is a product of random small primes times the given factor
+ */
+static void
+randprime_smooth(fmpz_t n, flint_rand_t state, const fmpz_t factor,
+                                                mp_bitcnt_t bits, int sign)
+{
+    fmpz_t m;
+
+    fmpz_init(m);
+    fmpz_mul_ui(m, factor, 2UL);
+
+    while (fmpz_bits(m) < bits)
+        fmpz_mul_ui(m, m, n_nth_prime(n_randint(state, 1000) + 1));
+
+    fmpz_set(n, m);
+
+    while (1)
+    {
+        if (sign > 0)
+            fmpz_add_ui(n, n, 1UL);
+        else
+            fmpz_sub_ui(n, n, 1UL);
+
+        if (fmpz_is_probabprime(n))
+            break;
+
+        if (sign > 0)
+            fmpz_sub_ui(n, n, 1UL);
+        else
+            fmpz_add_ui(n, n, 1UL);
+
+        fmpz_add(n, n, m);
+    }
+
+    fmpz_clear(m);
+}
+
+static void
+check_cert(const fmpz_t n, int expected)
+{
+    fmpz_prime_cert_t cert;
+    fmpz_t t;
+    int r, result;
+
+    fmpz_prime_cert_init(cert);
+    fmpz_init(t);
+
+    r = fmpz_is_prime_cert(cert, n);
+
+    result = (r == expected) && (fmpz_is_prime(n) == expected);
+    if (result && r == 1)
+    {
+        result = fmpz_prime_cert_verify(cert, n);
+
+        /* The certificate does not prove anything else */
+        fmpz_add_ui(t, n, 2UL);
+        result = result && !fmpz_prime_cert_verify(cert, t);
+    }
+
+    if (!result)
+    {
+        printf("FAIL:\n");
+        printf("n = "), fmpz_print(n), printf("\n");
+        printf("r = %d, expected %d\n", r, expected);
+        printf("cert = "), fmpz_prime_cert_print(cert), printf("\n");
+        abort();
+    }
+
+    fmpz_prime_cert_clear(cert);
+    fmpz_clear(t);
+}
+
+int
+main(void)
+{
+    int i, result;
+    flint_rand_t state;
+
+    printf("is_prime....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    /* Random integers: proven answers agree with mpz_probab_prime_p */
+    for (i = 0; i < 3000; i++)
+    {
+        fmpz_t n;
+        mpz_t t;
+        int r1, r2;
+
+        fmpz_init(n);
+        mpz_init(t);
+
+        fmpz_randtest(n, state, n_randint(state, 200) + 1);
+
+        if (n_randint(state, 2))
+        {
+            fmpz_abs(n, n);
+            fmpz_get_mpz(t, n);
+            mpz_nextprime(t, t);
+            fmpz_set_mpz(n, t);
+        }
+
+        fmpz_get_mpz(t, n);
+        r1 = fmpz_is_prime(n);
+        r2 = (mpz_sgn(t) > 0 && mpz_probab_prime_p(t, 25) != 0);
+
+        result = (r1 == r2 || (r1 == -1 && r2 == 1));
+        if (!result)
+        {
+            printf("FAIL:\n");
+            printf("n = "), fmpz_print(n), printf("\n");
+            printf("r1 = %d, r2 = %d\n", r1, r2);
+            abort();
+        }
+
+        fmpz_clear(n);
+        mpz_clear(t);
+    }
+
+    /* Primes p with p - 1 or p + 1 smooth are proven */
+    for (i = 0; i < 300; i++)
+    {
+        fmpz_t n, one;
+
+        fmpz_init(n);
+        fmpz_init_set_ui(one, 1UL);
+
+        randprime_smooth(n, state, one, n_randint(state, 500) + 90,
+                                        n_randint(state, 2) ? 1 : -1);
+        check_cert(n, 1);
+
+        fmpz_clear(n);
+        fmpz_clear(one);
+    }
+
+    /* Chains of primes p_{i+1} = m p_i +- 1 need nested certificates */
+    for (i = 0; i < 100; i++)
+    {
+        fmpz_t n, p;
+        int j;
+
+        fmpz_init(n);
+        fmpz_init(p);
+
+        fmpz_randbits(p, state, 70);
+        fmpz_abs(p, p);
+        fmpz_sub_ui(p, p, 1UL);
+        do
+        {
+            fmpz_add_ui(p, p, 1UL);
+        } while (!fmpz_is_probabprime(p));
+
+        for (j = 0; j < 4; j++)
+        {
+            randprime_smooth(n, state, p, fmpz_bits(p) + n_randint(state, 60),
+                                            n_randint(state, 2) ? 1 : -1);
+            fmpz_swap(n, p);
+        }
+
+        check_cert(p, 1);
+
+        fmpz_clear(n);
+        fmpz_clear(p);
+    }
+
+    /* Products of primes are composite */
+    for (i = 0; i < 300; i++)
+    {
+        fmpz_t n, p, one;
+
+        fmpz_init(n);
+        fmpz_init(p);
+        fmpz_init_set_ui(one, 1UL);
+
+        randprime_smooth(n, state, one, n_randint(state, 100) + 60, 1);
+        randprime_smooth(p, state, one, n_randint(state, 100) + 60, -1);
+        fmpz_mul(n, n, p);
+
+        check_cert(n, 0);
+
+        fmpz_clear(n);
+        fmpz_clear(p);
+        fmpz_clear(one);
+    }
+
+    flint_randclear(state);
+    _fmpz_cleanup();
+    printf("PASS\n");
+    return 0;
+}
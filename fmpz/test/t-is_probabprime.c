@@ -0,0 +1,122 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "ulong_extras.h"
+#include "fmpz.h"
+
+int
+main(void)
+{
+    int i, result;
+    flint_rand_t state;
+
+    printf("is_probabprime....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    /* Compare with mpz_probab_prime_p, including near primes */
+    for (i = 0; i < 10000; i++)
+    {
+        fmpz_t n;
+        mpz_t t;
+        int r1, r2;
+
+        fmpz_init(n);
+        mpz_init(t);
+
+        fmpz_randtest(n, state, n_randint(state, 400) + 1);
+
+        if (n_randint(state, 2))
+        {
+            fmpz_abs(n, n);
+            fmpz_get_mpz(t, n);
+            mpz_nextprime(t, t);
+            if (n_randint(state, 2))
+                mpz_add_ui(t, t, 2 * n_randint(state, 3));
+            fmpz_set_mpz(n, t);
+        }
+
+        fmpz_get_mpz(t, n);
+        r1 = fmpz_is_probabprime(n);
+        r2 = (mpz_sgn(t) > 0 && mpz_probab_prime_p(t, 25) != 0);
+
+        result = (r1 == r2);
+        if (!result)
+        {
+            printf("FAIL:\n");
+            printf("n = "), fmpz_print(n), printf("\n");
+            printf("r1 = %d, r2 = %d\n", r1, r2);
+            abort();
+        }
+
+        fmpz_clear(n);
+        mpz_clear(t);
+    }
+
+    /* Strong pseudoprimes to base 2 and squares of primes are rejected */
+    {
+        const char * psp[] = {
+            "3825123056546413051",
+            "318665857834031151167461",
+            "3317044064679887385961981",
+            "1543267864443420616877677640751301"
+        };
+        fmpz_t n, a;
+
+        fmpz_init(n);
+        fmpz_init_set_ui(a, 2UL);
+
+        for (i = 0; i < 4; i++)
+        {
+            fmpz_set_str(n, (char *) psp[i], 10);
+
+            result = fmpz_is_strong_probabprime(n, a) && !fmpz_is_probabprime(n);
+            if (!result)
+            {
+                printf("FAIL (pseudoprime):\n");
+                printf("n = "), fmpz_print(n), printf("\n");
+                abort();
+            }
+        }
+
+        fmpz_set_str(n, "1000000000000000000000000000057", 10);
+        fmpz_mul(n, n, n);
+        result = !fmpz_is_probabprime(n);
+        if (!result)
+        {
+            printf("FAIL (square):\n");
+            printf("n = "), fmpz_print(n), printf("\n");
+            abort();
+        }
+
+        fmpz_clear(n);
+        fmpz_clear(a);
+    }
+
+    flint_randclear(state);
+    _fmpz_cleanup();
+    printf("PASS\n");
+    return 0;
+}
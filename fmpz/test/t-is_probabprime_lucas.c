@@ -0,0 +1,106 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "ulong_extras.h"
+#include "fmpz.h"
+
+static void
+randprime(fmpz_t p, flint_rand_t state, mp_bitcnt_t bits)
+{
+    mpz_t t;
+
+    mpz_init(t);
+    fmpz_randbits(p, state, bits);
+    fmpz_abs(p, p);
+    fmpz_get_mpz(t, p);
+    mpz_nextprime(t, t);
+    fmpz_set_mpz(p, t);
+    mpz_clear(t);
+}
+
+int
+main(void)
+{
+    int i, result;
+    flint_rand_t state;
+
+    printf("is_probabprime_lucas....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    /* Primes pass */
+    for (i = 0; i < 2000; i++)
+    {
+        fmpz_t p;
+
+        fmpz_init(p);
+        randprime(p, state, n_randint(state, 500) + 2);
+
+        result = fmpz_is_probabprime_lucas(p);
+        if (!result)
+        {
+            printf("FAIL (prime):\n");
+            printf("p = "), fmpz_print(p), printf("\n");
+            abort();
+        }
+
+        fmpz_clear(p);
+    }
+
+    /* Products of two primes and squares of primes fail */
+    for (i = 0; i < 2000; i++)
+    {
+        fmpz_t p, q, n;
+
+        fmpz_init(p);
+        fmpz_init(q);
+        fmpz_init(n);
+
+        randprime(p, state, n_randint(state, 200) + 40);
+        if (n_randint(state, 4) == 0)
+            fmpz_set(q, p);
+        else
+            randprime(q, state, n_randint(state, 200) + 40);
+        fmpz_mul(n, p, q);
+
+        result = !fmpz_is_probabprime_lucas(n);
+        if (!result)
+        {
+            printf("FAIL (composite):\n");
+            printf("p = "), fmpz_print(p), printf("\n");
+            printf("q = "), fmpz_print(q), printf("\n");
+            abort();
+        }
+
+        fmpz_clear(p);
+        fmpz_clear(q);
+        fmpz_clear(n);
+    }
+
+    flint_randclear(state);
+    _fmpz_cleanup();
+    printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,160 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "ulong_extras.h"
+#include "fmpz.h"
+
+/* Strong probable prime test straight from the definition */
+static int
+check_sprp(const mpz_t n, const mpz_t a)
+{
+    mpz_t d, x, nm1;
+    ulong s, i;
+    int result = 0;
+
+    mpz_init(d);
+    mpz_init(x);
+    mpz_init(nm1);
+
+    mpz_sub_ui(nm1, n, 1);
+    s = mpz_scan1(nm1, 0);
+    mpz_tdiv_q_2exp(d, nm1, s);
+
+    mpz_mod(x, a, n);
+    if (mpz_sgn(x) == 0)
+        result = 1;
+    else
+    {
+        mpz_powm(x, a, d, n);
+        if (mpz_cmp_ui(x, 1) == 0 || mpz_cmp(x, nm1) == 0)
+            result = 1;
+
+        for (i = 1; i < s && !result; i++)
+        {
+            mpz_mul(x, x, x);
+            mpz_mod(x, x, n);
+            if (mpz_cmp(x, nm1) == 0)
+                result = 1;
+        }
+    }
+
+    mpz_clear(d);
+    mpz_clear(x);
+    mpz_clear(nm1);
+
+    return result;
+}
+
+int
+main(void)
+{
+    int i, result;
+    flint_rand_t state;
+
+    printf("is_strong_probabprime....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    /* Compare with the definition for random odd n and bases */
+    for (i = 0; i < 10000; i++)
+    {
+        fmpz_t n, a;
+        mpz_t nn, aa;
+        int r1, r2;
+
+        fmpz_init(n);
+        fmpz_init(a);
+        mpz_init(nn);
+        mpz_init(aa);
+
+        fmpz_randtest_unsigned(n, state, 300);
+        fmpz_add_ui(n, n, 3);
+        if (fmpz_is_even(n))
+            fmpz_add_ui(n, n, 1);
+
+        if (n_randint(state, 2))
+            fmpz_randtest(a, state, 400);
+        else
+            fmpz_set_ui(a, n_randint(state, 100));
+
+        fmpz_get_mpz(nn, n);
+        fmpz_get_mpz(aa, a);
+
+        r1 = fmpz_is_strong_probabprime(n, a);
+        r2 = check_sprp(nn, aa);
+
+        result = (r1 == r2);
+        if (!result)
+        {
+            printf("FAIL:\n");
+            printf("n = "), fmpz_print(n), printf("\n");
+            printf("a = "), fmpz_print(a), printf("\n");
+            printf("r1 = %d, r2 = %d\n", r1, r2);
+            abort();
+        }
+
+        fmpz_clear(n);
+        fmpz_clear(a);
+        mpz_clear(nn);
+        mpz_clear(aa);
+    }
+
+    /* Primes pass for every base */
+    for (i = 0; i < 1000; i++)
+    {
+        fmpz_t n, a;
+        mpz_t nn;
+
+        fmpz_init(n);
+        fmpz_init(a);
+        mpz_init(nn);
+
+        fmpz_randbits(n, state, n_randint(state, 400) + 3);
+        fmpz_abs(n, n);
+        fmpz_get_mpz(nn, n);
+        mpz_nextprime(nn, nn);
+        fmpz_set_mpz(n, nn);
+
+        fmpz_randtest(a, state, 400);
+
+        result = fmpz_is_strong_probabprime(n, a);
+        if (!result)
+        {
+            printf("FAIL (prime):\n");
+            printf("n = "), fmpz_print(n), printf("\n");
+            printf("a = "), fmpz_print(a), printf("\n");
+            abort();
+        }
+
+        fmpz_clear(n);
+        fmpz_clear(a);
+        mpz_clear(nn);
+    }
+
+    flint_randclear(state);
+    _fmpz_cleanup();
+    printf("PASS\n");
+    return 0;
+}
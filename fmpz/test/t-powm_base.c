@@ -0,0 +1,114 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "ulong_extras.h"
+#include "fmpz.h"
+
+int
+main(void)
+{
+    int i, result;
+    flint_rand_t state;
+
+    printf("powm_base....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    /* Compare with fmpz_powm, including exponents longer than the table */
+    for (i = 0; i < 5000; i++)
+    {
+        fmpz_t a, b, c, m, x;
+        fmpz_powm_ctx_t ctx;
+        fmpz_powm_base_t B;
+        mp_bitcnt_t bits;
+        int j;
+
+        fmpz_init(a);
+        fmpz_init(b);
+        fmpz_init(c);
+        fmpz_init(m);
+        fmpz_init(x);
+
+        fmpz_randtest_not_zero(m, state, 300);
+        fmpz_abs(m, m);
+        if (n_randint(state, 4) != 0 && fmpz_is_even(m))
+            fmpz_add_ui(m, m, 1);
+        fmpz_randtest(a, state, 400);
+        bits = n_randint(state, 300);
+
+        fmpz_powm_ctx_init(ctx, m);
+        fmpz_powm_base_init(B, a, bits, ctx);
+
+        for (j = 0; j < 4; j++)
+        {
+            fmpz_randtest_unsigned(x, state, 1 + n_randint(state, 2) * bits);
+
+            fmpz_powm(b, a, x, m);
+            fmpz_powm_base(c, x, B, ctx);
+
+            result = (fmpz_equal(b, c));
+            if (!result)
+            {
+                printf("FAIL:\n");
+                printf("a = "), fmpz_print(a), printf("\n");
+                printf("x = "), fmpz_print(x), printf("\n");
+                printf("m = "), fmpz_print(m), printf("\n");
+                printf("b = "), fmpz_print(b), printf("\n");
+                printf("c = "), fmpz_print(c), printf("\n");
+                printf("bits = %lu\n", bits);
+                abort();
+            }
+
+            /* Check aliasing of the output and the exponent */
+            fmpz_powm_base(x, x, B, ctx);
+
+            result = (fmpz_equal(b, x));
+            if (!result)
+            {
+                printf("FAIL (aliasing):\n");
+                printf("a = "), fmpz_print(a), printf("\n");
+                printf("m = "), fmpz_print(m), printf("\n");
+                printf("b = "), fmpz_print(b), printf("\n");
+                printf("x = "), fmpz_print(x), printf("\n");
+                abort();
+            }
+        }
+
+        fmpz_powm_base_clear(B);
+        fmpz_powm_ctx_clear(ctx);
+
+        fmpz_clear(a);
+        fmpz_clear(b);
+        fmpz_clear(c);
+        fmpz_clear(m);
+        fmpz_clear(x);
+    }
+
+    flint_randclear(state);
+    _fmpz_cleanup();
+    printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,148 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "ulong_extras.h"
+#include "fmpz.h"
+
+int
+main(void)
+{
+    int i, result;
+    flint_rand_t state;
+
+    printf("powm_precomp....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    /* Compare with fmpz_powm, for several exponents per modulus */
+    for (i = 0; i < 10000; i++)
+    {
+        fmpz_t a, b, c, m, x;
+        fmpz_powm_ctx_t ctx;
+        int j;
+
+        fmpz_init(a);
+        fmpz_init(b);
+        fmpz_init(c);
+        fmpz_init(m);
+        fmpz_init(x);
+
+        fmpz_randtest_not_zero(m, state, 300);
+        fmpz_abs(m, m);
+        if (n_randint(state, 4) != 0 && fmpz_is_even(m))
+            fmpz_add_ui(m, m, 1);
+
+        fmpz_powm_ctx_init(ctx, m);
+
+        for (j = 0; j < 4; j++)
+        {
+            fmpz_randtest(a, state, 400);
+            fmpz_randtest_unsigned(x, state, 300);
+
+            fmpz_powm(b, a, x, m);
+            fmpz_powm_precomp(c, a, x, ctx);
+
+            result = (fmpz_equal(b, c));
+            if (!result)
+            {
+                printf("FAIL:\n");
+                printf("a = "), fmpz_print(a), printf("\n");
+                printf("x = "), fmpz_print(x), printf("\n");
+                printf("m = "), fmpz_print(m), printf("\n");
+                printf("b = "), fmpz_print(b), printf("\n");
+                printf("c = "), fmpz_print(c), printf("\n");
+                abort();
+            }
+        }
+
+        fmpz_powm_ctx_clear(ctx);
+
+        fmpz_clear(a);
+        fmpz_clear(b);
+        fmpz_clear(c);
+        fmpz_clear(m);
+        fmpz_clear(x);
+    }
+
+    /* Check aliasing of the output with the base and the exponent */
+    for (i = 0; i < 10000; i++)
+    {
+        fmpz_t a, b, c, m, x;
+        fmpz_powm_ctx_t ctx;
+
+        fmpz_init(a);
+        fmpz_init(b);
+        fmpz_init(c);
+        fmpz_init(m);
+        fmpz_init(x);
+
+        fmpz_randtest_not_zero(m, state, 300);
+        fmpz_abs(m, m);
+        if (n_randint(state, 4) != 0 && fmpz_is_even(m))
+            fmpz_add_ui(m, m, 1);
+
+        fmpz_powm_ctx_init(ctx, m);
+
+        fmpz_randtest(a, state, 400);
+        fmpz_randtest_unsigned(x, state, 300);
+
+        fmpz_powm_precomp(b, a, x, ctx);
+        fmpz_set(c, a);
+        fmpz_powm_precomp(c, c, x, ctx);
+
+        result = (fmpz_equal(b, c));
+        if (result)
+        {
+            fmpz_set(c, x);
+            fmpz_powm_precomp(c, a, c, ctx);
+            result = (fmpz_equal(b, c));
+        }
+
+        if (!result)
+        {
+            printf("FAIL (aliasing):\n");
+            printf("a = "), fmpz_print(a), printf("\n");
+            printf("x = "), fmpz_print(x), printf("\n");
+            printf("m = "), fmpz_print(m), printf("\n");
+            printf("b = "), fmpz_print(b), printf("\n");
+            printf("c = "), fmpz_print(c), printf("\n");
+            abort();
+        }
+
+        fmpz_powm_ctx_clear(ctx);
+
+        fmpz_clear(a);
+        fmpz_clear(b);
+        fmpz_clear(c);
+        fmpz_clear(m);
+        fmpz_clear(x);
+    }
+
+    flint_randclear(state);
+    _fmpz_cleanup();
+    printf("PASS\n");
+    return 0;
+}
@@ -60,7 +60,7 @@ int main(void)
 
         a = calloc(n, sizeof(fmpz));
         for (i = 0; i < n; i++)
-            fmpz_randtest(a + i, state, 200);
+            fmpz_randtest(a + i, state, 400);
 
         if (pipe(fd))
         {
@@ -0,0 +1,120 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "ulong_extras.h"
+
+int
+main(void)
+{
+    int i;
+    flint_rand_t state;
+
+    printf("set_str....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (i = 0; i < 100000; i++)
+    {
+        fmpz_t a, b;
+        mpz_t c;
+        int base, r;
+        char * str;
+
+        fmpz_init(a);
+        fmpz_init(b);
+        mpz_init(c);
+
+        fmpz_randtest(a, state, 200);
+        base = (int) (n_randint(state, 61) + 2);
+
+        fmpz_get_mpz(c, a);
+        str = mpz_get_str(NULL, base, c);
+
+        r = fmpz_set_str(b, str, base);
+
+        if (r != 0 || !fmpz_equal(a, b))
+        {
+            printf("FAIL:\n");
+            printf("a = "), fmpz_print(a), printf("\n");
+            printf("b = "), fmpz_print(b), printf("\n");
+            printf("base = %d, str = %s\n", base, str);
+            abort();
+        }
+
+        free(str);
+        fmpz_clear(a);
+        fmpz_clear(b);
+        mpz_clear(c);
+    }
+
+    /* Agreement with mpz_set_str on arbitrary strings */
+    for (i = 0; i < 100000; i++)
+    {
+        fmpz_t a, b;
+        mpz_t c;
+        int base, r1, r2, j, len;
+        char str[30];
+        const char * chars = "0123456789azAZ- ";
+
+        fmpz_init(a);
+        fmpz_init(b);
+        mpz_init(c);
+
+        base = (int) (n_randint(state, 61) + 2);
+        len = n_randint(state, 25);
+        for (j = 0; j < len; j++)
+        {
+            if (n_randint(state, 8) == 0)
+                str[j] = chars[n_randint(state, 16)];
+            else
+                str[j] = chars[n_randint(state, 10)];
+        }
+        str[len] = '\0';
+
+        r1 = fmpz_set_str(a, str, base);
+        r2 = mpz_set_str(c, str, base);
+        fmpz_set_mpz(b, c);
+
+        if (r1 != r2 || (r1 == 0 && !fmpz_equal(a, b)))
+        {
+            printf("FAIL (arbitrary string):\n");
+            printf("a = "), fmpz_print(a), printf("\n");
+            printf("b = "), fmpz_print(b), printf("\n");
+            printf("base = %d, str = \"%s\", r1 = %d, r2 = %d\n",
+                base, str, r1, r2);
+            abort();
+        }
+
+        fmpz_clear(a);
+        fmpz_clear(b);
+        mpz_clear(c);
+    }
+
+    flint_randclear(state);
+    _fmpz_cleanup();
+    printf("PASS\n");
+    return 0;
+}
@@ -29,6 +29,7 @@
 #include <mpir.h>
 #include "flint.h"
 #include "fmpz.h"
+#include "mpn_extras.h"
 
 typedef struct
 {
@@ -60,10 +61,19 @@ void _fmpz_factor_set_length(fmpz_factor_t factor, long newlen);
 
 void _fmpz_factor_extend_factor_ui(fmpz_factor_t factor, mp_limb_t n);
 
+mp_size_t _fmpz_factor_trial_range(fmpz_factor_t factor, mp_ptr xd,
+                                mp_size_t xsize, long start, long stop);
+
+void fmpz_factor_trial_partial(fmpz_factor_t factor, fmpz_t cofactor,
+                                        const fmpz_t n, long num_primes);
+
 void fmpz_factor(fmpz_factor_t factor, const fmpz_t n);
 
 void fmpz_factor_si(fmpz_factor_t factor, long n);
 
+void fmpz_factor_smooth_vec(int * smooth, const fmpz * vec, long len,
+                                                const mpn_factor_tree_t T);
+
 /* Expansion *****************************************************************/
 
 void fmpz_factor_expand_iterative(fmpz_t n, const fmpz_factor_t factor);
@@ -72,4 +82,10 @@ void fmpz_factor_expand_multiexp(fmpz_t n, const fmpz_factor_t factor);
 
 void fmpz_factor_expand(fmpz_t n, const fmpz_factor_t factor);
 
+/* Tuning parameters *********************************************************/
+
+/* Number of primes up to which the trial division windows of fmpz_factor
+   are widened for cofactors searched with remainder trees */
+#define FMPZ_FACTOR_TRIAL_TREE_MAX_PRIMES 65000
+
 #endif
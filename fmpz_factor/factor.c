@@ -35,12 +35,10 @@ void
 fmpz_factor(fmpz_factor_t factor, const fmpz_t n)
 {
     ulong exp;
-    mp_limb_t p;
     mpz_t x;
     mp_ptr xd;
     mp_size_t xsize;
-    long found;
-    long trial_start, trial_stop;
+    long trial_start, trial_stop, window;
 
     if (!COEFF_IS_MPZ(*n))
     {
@@ -72,52 +70,30 @@ fmpz_factor(fmpz_factor_t factor, const fmpz_t n)
         _fmpz_factor_append_ui(factor, 2UL, exp);
 
     trial_start = 1;
-    trial_stop = 1000;
 
+    /* Windows of 1000 primes, each searched until no more factors are
+       found in it.  Continuing in small windows allows quickly factoring
+       huge highly composite numbers such as factorials, which can arise
+       in some applications.  Large cofactors are searched in wider
+       windows, matching the blocks of primes of the remainder trees. */
     while (xsize > 1)
     {
-        found = mpn_factor_trial(xd, xsize, trial_start, trial_stop);
-
-        if (found)
-        {
-            p = flint_primes[found];
-            exp = 1;
-            xsize = mpn_divexact_1(xd, xsize, p);
-
-            /* Check if p^2 divides n */
-            if (mpn_divisible_1_p(xd, xsize, p))
-            {
-                /* TODO: when searching for squarefree numbers
-                   (Moebius function, etc), we can abort here. */
-                xsize = mpn_divexact_1(xd, xsize, p);
-                exp = 2;
-            }
-
-            /* If we're up to cubes, then maybe there are higher powers */
-            if (exp == 2 && mpn_divisible_1_p(xd, xsize, p))
-            {
-                xsize = mpn_divexact_1(xd, xsize, p);
-                xsize = mpn_remove_power_ascending(xd, xsize, &p, 1, &exp);
-                exp += 3;
-            }
-
-            _fmpz_factor_append_ui(factor, flint_primes[found], exp);
-            /* printf("added %lu %lu\n", flint_primes[found], exp); */
-
-            /* Continue using only trial division as long as it is successful.
-               This allows quickly factoring huge highly composite numbers
-               such as factorials, which can arise in some applications. */
-            trial_start = found + 1;
-            trial_stop = trial_start + 1000;
-            continue;
-        }
-        else
+        window = 1000;
+        if (xsize >= MPN_FACTOR_TREE_LIMBS_CUTOFF)
         {
-            /* Insert primality test, perfect power test, other factoring
-               algorithms here... */
-            trial_start = trial_stop;
-            trial_stop = trial_start + 1000;
+            window = (MPN_FACTOR_TREE_PRIMES_PER_LIMB * xsize / 1000) * 1000;
+            window = FLINT_MIN(window,
+                        FMPZ_FACTOR_TRIAL_TREE_MAX_PRIMES + 1 - trial_start);
+            window = FLINT_MAX(window, 1000);
         }
+
+        trial_stop = trial_start + window;
+        xsize = _fmpz_factor_trial_range(factor, xd, xsize,
+                                                    trial_start, trial_stop);
+
+        /* Insert primality test, perfect power test, other factoring
+           algorithms here... */
+        trial_start = trial_stop;
     }
 
     /* Any single-limb factor left? */
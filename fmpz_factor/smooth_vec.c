@@ -0,0 +1,84 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "fmpz_factor.h"
+#include "mpn_extras.h"
+
+typedef struct
+{
+    int * smooth;
+    const fmpz * vec;
+    const mpn_factor_tree_struct * T;
+}
+_smooth_vec_struct;
+
+/* Decides smoothness of the i-th entry, using only mpz arithmetic since
+   the fmpz memory manager is not thread safe */
+static void
+_smooth_vec_worker(void * arg, long i)
+{
+    _smooth_vec_struct * s = (_smooth_vec_struct *) arg;
+    const mpn_factor_tree_struct * T = s->T;
+    mpz_t x, p;
+    long j, num, * idx;
+
+    if (fmpz_is_zero(s->vec + i))
+    {
+        s->smooth[i] = 0;
+        return;
+    }
+
+    mpz_init(x);
+    mpz_init(p);
+    fmpz_get_mpz(x, s->vec + i);
+    mpz_abs(x, x);
+
+    idx = malloc(sizeof(long) * FLINT_MAX(T->num, 1));
+    num = mpn_factor_tree_trial(idx, x->_mp_d, x->_mp_size, T);
+
+    for (j = 0; j < num; j++)
+    {
+        mpz_set_ui(p, T->primes[idx[j]]);
+        mpz_remove(x, x, p);
+    }
+
+    s->smooth[i] = (mpz_cmp_ui(x, 1UL) == 0);
+
+    free(idx);
+    mpz_clear(x);
+    mpz_clear(p);
+}
+
+void
+fmpz_factor_smooth_vec(int * smooth, const fmpz * vec, long len,
+                                                const mpn_factor_tree_t T)
+{
+    _smooth_vec_struct s;
+
+    s.smooth = smooth;
+    s.vec = vec;
+    s.T = T;
+
+    flint_parallel_do(_smooth_vec_worker, &s, len, flint_get_num_threads());
+}
@@ -71,10 +71,12 @@ int main(void)
     int i, j;
     fmpz_t x;
     mpz_t y;
+    flint_rand_t state;
 
     printf("factor....");
     fflush(stdout);
 
+    flint_randinit(state);
     fmpz_init(x);
     mpz_init(y);
 
@@ -128,6 +130,16 @@ int main(void)
         }
     }
 
+    /* Large products of primes spread over many trial windows */
+    n_compute_primes(60000);
+    for (i = 0; i < 20; i++)
+    {
+        fmpz_set_ui(x, 1UL);
+        for (j = n_randint(state, 1000); j > 0; j--)
+            fmpz_mul_ui(x, x, flint_primes[n_randint(state, 60000)]);
+        check(x);
+    }
+
     /* Large negative integers */
     fmpz_set_ui(x, 10);
     fmpz_pow_ui(x, x, 100);
@@ -141,6 +153,7 @@ int main(void)
     fmpz_clear(x);
     mpz_clear(y);
 
+    flint_randclear(state);
     _fmpz_cleanup();
     printf("PASS\n");
     return 0;
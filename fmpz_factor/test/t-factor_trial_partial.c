@@ -0,0 +1,103 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "fmpz_factor.h"
+#include "ulong_extras.h"
+
+int
+main(void)
+{
+    int i, result;
+    flint_rand_t state;
+
+    printf("factor_trial_partial....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (i = 0; i < 10000; i++)
+    {
+        fmpz_factor_t factor;
+        fmpz_t n, c, m, p;
+        long j, num;
+
+        fmpz_factor_init(factor);
+        fmpz_init(n);
+        fmpz_init(c);
+        fmpz_init(m);
+        fmpz_init(p);
+
+        fmpz_randtest(n, state, 200);
+        num = n_randint(state, 2000);
+
+        /* Often include many small prime factors */
+        if (n_randint(state, 2))
+        {
+            for (j = n_randint(state, 40); j > 0; j--)
+                fmpz_mul_ui(n, n, n_nth_prime(n_randint(state, 3000) + 1));
+        }
+
+        fmpz_factor_trial_partial(factor, c, n, num);
+
+        /* The factors with the sign, times the cofactor, give back n */
+        fmpz_factor_expand(m, factor);
+        fmpz_mul(m, m, c);
+        result = fmpz_equal(m, n) && fmpz_sgn(c) >= 0;
+
+        /* The factors are primes among the first num, the cofactor
+           has none of those */
+        n_compute_primes(num);
+        for (j = 0; j < factor->length && result; j++)
+        {
+            fmpz_set_ui(p, flint_primes[num - 1]);
+            result = fmpz_cmp(factor->p + j, p) <= 0
+                && n_is_prime(fmpz_get_ui(factor->p + j));
+        }
+
+        for (j = 0; j < num && result && !fmpz_is_zero(c); j++)
+            result = !fmpz_divisible_si(c, flint_primes[j]);
+
+        if (!result)
+        {
+            printf("FAIL:\n");
+            printf("n = "), fmpz_print(n), printf("\n");
+            printf("num = %ld\n", num);
+            printf("factor = "), fmpz_factor_print(factor), printf("\n");
+            printf("c = "), fmpz_print(c), printf("\n");
+            abort();
+        }
+
+        fmpz_factor_clear(factor);
+        fmpz_clear(n);
+        fmpz_clear(c);
+        fmpz_clear(m);
+        fmpz_clear(p);
+    }
+
+    flint_randclear(state);
+    _fmpz_cleanup();
+    printf("PASS\n");
+    return 0;
+}
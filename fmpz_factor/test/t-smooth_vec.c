@@ -0,0 +1,106 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "fmpz_vec.h"
+#include "fmpz_factor.h"
+#include "mpn_extras.h"
+#include "ulong_extras.h"
+
+int main(void)
+{
+    long i, j, k, len, num;
+    mp_limb_t * primes, bound, q;
+    int * smooth, * expected;
+    fmpz * vec;
+    mpn_factor_tree_t T;
+    flint_rand_t state;
+
+    printf("smooth_vec....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (i = 0; i < 200; i++)
+    {
+        bound = n_randint(state, (i < 180) ? 1000 : 100000) + 2;
+        primes = n_sieve_primes(&num, bound);
+        mpn_factor_tree_init(T, primes, num);
+
+        len = n_randint(state, 50);
+        vec = _fmpz_vec_init(len);
+        smooth = malloc(sizeof(int) * (len + 1));
+        expected = malloc(sizeof(int) * (len + 1));
+
+        for (j = 0; j < len; j++)
+        {
+            fmpz_set_ui(vec + j, 1UL);
+            for (k = n_randint(state, 300); k > 0; k--)
+                fmpz_mul_ui(vec + j, vec + j, primes[n_randint(state, num)]);
+
+            expected[j] = 1;
+            if (n_randint(state, 2))
+            {
+                q = n_nextprime(bound + n_randint(state, 1000), 0);
+                fmpz_mul_ui(vec + j, vec + j, q);
+                expected[j] = 0;
+            }
+
+            if (n_randint(state, 2))
+                fmpz_neg(vec + j, vec + j);
+
+            if (n_randint(state, 20) == 0)
+            {
+                fmpz_zero(vec + j);
+                expected[j] = 0;
+            }
+        }
+
+        flint_set_num_threads(n_randint(state, 4) + 1);
+        fmpz_factor_smooth_vec(smooth, vec, len, T);
+        flint_set_num_threads(1);
+
+        for (j = 0; j < len; j++)
+        {
+            if (smooth[j] != expected[j])
+            {
+                printf("FAIL:\n");
+                printf("bound = %lu, j = %ld\n", bound, j);
+                fmpz_print(vec + j); printf("\n");
+                abort();
+            }
+        }
+
+        mpn_factor_tree_clear(T);
+        _fmpz_vec_clear(vec, len);
+        free(smooth);
+        free(expected);
+        free(primes);
+    }
+
+    flint_randclear(state);
+    _fmpz_cleanup();
+    printf("PASS\n");
+    return 0;
+}
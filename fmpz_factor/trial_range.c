@@ -0,0 +1,182 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "fmpz_factor.h"
+#include "mpn_extras.h"
+#include "ulong_extras.h"
+
+/* Removes the largest power of p dividing (xd, xsize), given that p does */
+static mp_size_t
+_fmpz_factor_remove_prime(ulong * exp, mp_ptr xd, mp_size_t xsize,
+                                                                mp_limb_t p)
+{
+    *exp = 1;
+    xsize = mpn_divexact_1(xd, xsize, p);
+
+    /* Check if p^2 divides n */
+    if (mpn_divisible_1_p(xd, xsize, p))
+    {
+        /* TODO: when searching for squarefree numbers
+           (Moebius function, etc), we can abort here. */
+        xsize = mpn_divexact_1(xd, xsize, p);
+        *exp = 2;
+    }
+
+    /* If we're up to cubes, then maybe there are higher powers */
+    if (*exp == 2 && mpn_divisible_1_p(xd, xsize, p))
+    {
+        xsize = mpn_divexact_1(xd, xsize, p);
+        xsize = mpn_remove_power_ascending(xd, xsize, &p, 1, exp);
+        *exp += 3;
+    }
+
+    return xsize;
+}
+
+mp_size_t
+_fmpz_factor_trial_range(fmpz_factor_t factor, mp_ptr xd, mp_size_t xsize,
+                                                        long start, long stop)
+{
+    ulong exp;
+    mp_limb_t p;
+    long found;
+
+    /* Find all the prime factors in blocks of primes whose product is
+       about as large as the remaining value */
+    if (xsize >= MPN_FACTOR_TREE_LIMBS_CUTOFF &&
+        stop - start >= MPN_FACTOR_TREE_PRIMES_CUTOFF)
+    {
+        mpn_factor_tree_t T;
+        long i, num, block, * idx;
+
+        n_compute_primes(stop);
+
+        block = FLINT_MAX(MPN_FACTOR_TREE_PRIMES_PER_LIMB * xsize,
+                                            MPN_FACTOR_TREE_PRIMES_CUTOFF);
+        block = FLINT_MIN(block, stop - start);
+        idx = malloc(sizeof(long) * block);
+
+        while (xsize >= MPN_FACTOR_TREE_LIMBS_CUTOFF && start < stop)
+        {
+            mpn_factor_tree_init(T, flint_primes + start,
+                                            FLINT_MIN(block, stop - start));
+            num = mpn_factor_tree_trial(idx, xd, xsize, T);
+            mpn_factor_tree_clear(T);
+
+            for (i = 0; i < num; i++)
+            {
+                p = flint_primes[start + idx[i]];
+                xsize = _fmpz_factor_remove_prime(&exp, xd, xsize, p);
+                _fmpz_factor_append_ui(factor, p, exp);
+            }
+
+            start += FLINT_MIN(block, stop - start);
+        }
+
+        free(idx);
+    }
+
+    while (xsize > 1 && start < stop)
+    {
+        found = mpn_factor_trial(xd, xsize, start, stop);
+
+        if (!found)
+            break;
+
+        p = flint_primes[found];
+        xsize = _fmpz_factor_remove_prime(&exp, xd, xsize, p);
+        _fmpz_factor_append_ui(factor, p, exp);
+
+        start = found + 1;
+    }
+
+    return xsize;
+}
+
+void
+fmpz_factor_trial_partial(fmpz_factor_t factor, fmpz_t cofactor,
+                                        const fmpz_t n, long num_primes)
+{
+    ulong exp;
+    mp_limb_t p, x;
+    mpz_t y;
+    mp_ptr xd;
+    mp_size_t xsize;
+    long i;
+
+    _fmpz_factor_set_length(factor, 0);
+    factor->sign = fmpz_sgn(n);
+
+    if (fmpz_is_zero(n))
+    {
+        fmpz_zero(cofactor);
+        return;
+    }
+
+    mpz_init(y);
+    fmpz_get_mpz(y, n);
+    mpz_abs(y, y);
+
+    xd = y->_mp_d;
+    xsize = y->_mp_size;
+
+    i = 1;
+    if (num_primes > 0)
+    {
+        xsize = mpn_remove_2exp(xd, xsize, &exp);
+        if (exp != 0)
+            _fmpz_factor_append_ui(factor, 2UL, exp);
+
+        xsize = _fmpz_factor_trial_range(factor, xd, xsize, 1, num_primes);
+
+        /* Continue on the single limb with the remaining primes */
+        if (xsize == 1)
+        {
+            n_compute_primes(num_primes);
+
+            x = xd[0];
+            for (i = 1; i < num_primes && x != 1UL; i++)
+            {
+                p = flint_primes[i];
+
+                if (x % p == 0)
+                {
+                    exp = 0;
+                    do
+                    {
+                        x /= p;
+                        exp++;
+                    } while (x % p == 0);
+
+                    _fmpz_factor_append_ui(factor, p, exp);
+                }
+            }
+            xd[0] = x;
+        }
+    }
+
+    y->_mp_size = xsize;
+    fmpz_set_mpz(cofactor, y);
+    mpz_clear(y);
+}
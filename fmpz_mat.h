@@ -103,6 +103,14 @@ int fmpz_mat_read(fmpz_mat_t mat)
     return fmpz_mat_fread(stdin, mat);
 }
 
+int fmpz_mat_fwrite_bin(FILE * file, const fmpz_mat_t mat);
+
+int fmpz_mat_fread_bin(FILE * file, fmpz_mat_t mat);
+
+int fmpz_mat_mmap_init(fmpz_mat_t mat, FILE * file);
+
+void fmpz_mat_mmap_clear(fmpz_mat_t mat);
+
 /* Random matrix generation  *************************************************/
 
 void fmpz_mat_randbits(fmpz_mat_t mat, flint_rand_t state, mp_bitcnt_t bits);
@@ -164,6 +172,12 @@ void fmpz_mat_mul_classical(fmpz_mat_t C, const fmpz_mat_t A,
 void fmpz_mat_mul_classical_inline(fmpz_mat_t C, const fmpz_mat_t A,
     const fmpz_mat_t B);
 
+void _fmpz_mat_mul_small(fmpz_mat_t C, const fmpz_mat_t A,
+    const fmpz_mat_t B, long bits);
+
+void fmpz_mat_mul_small(fmpz_mat_t C, const fmpz_mat_t A,
+    const fmpz_mat_t B);
+
 void _fmpz_mat_mul_multi_mod(fmpz_mat_t C, const fmpz_mat_t A,
     const fmpz_mat_t B, long bits);
 
@@ -250,6 +264,9 @@ void fmpz_mat_solve_fflu_precomp(fmpz_mat_t X, const long * perm,
 int fmpz_mat_solve_dixon(fmpz_mat_t X, fmpz_t mod,
         const fmpz_mat_t A, const fmpz_mat_t B);
 
+int fmpz_mat_solve_dixon_den(fmpz_mat_t X, fmpz_t den,
+        const fmpz_mat_t A, const fmpz_mat_t B);
+
 /* Nullspace ****************************************************************/
 
 long fmpz_mat_nullspace(fmpz_mat_t res, const fmpz_mat_t mat);
@@ -38,7 +38,7 @@ void
 fmpz_mat_det_divisor(fmpz_t d, const fmpz_mat_t A)
 {
     fmpz_mat_t X, B;
-    fmpz_t t, u, v, mod;
+    fmpz_t mod;
     long i, n;
     int success;
 
@@ -46,9 +46,6 @@ fmpz_mat_det_divisor(fmpz_t d, const fmpz_mat_t A)
 
     fmpz_mat_init(B, n, 1);
     fmpz_mat_init(X, n, 1);
-    fmpz_init(t);
-    fmpz_init(u);
-    fmpz_init(v);
     fmpz_init(mod);
 
     /* Create a "random" vector */
@@ -61,19 +58,15 @@ fmpz_mat_det_divisor(fmpz_t d, const fmpz_mat_t A)
 
     if (success)
     {
-        fmpz_one(d);
         for (i = 0; i < n; i++)
+            fmpz_mod(fmpz_mat_entry(X, i, 0), fmpz_mat_entry(X, i, 0), mod);
+
+        /* The denominator of the solution divides the determinant */
+        if (!_fmpq_reconstruct_fmpz_vec(B->entries, d, X->entries, n, mod))
         {
-            fmpz_mul(t, d, fmpz_mat_entry(X, i, 0));
-            fmpz_fdiv_qr(u, t, t, mod);
-            if (!_fmpq_reconstruct_fmpz(u, v, t, mod))
-            {
-                printf("Exception: fmpz_mat_det_divisor: "
-                       "rational reconstruction failed!\n");
-                abort();
-            }
-
-            fmpz_mul(d, v, d);
+            printf("Exception: fmpz_mat_det_divisor: "
+                   "rational reconstruction failed!\n");
+            abort();
         }
     }
     else
@@ -83,8 +76,5 @@ fmpz_mat_det_divisor(fmpz_t d, const fmpz_mat_t A)
 
     fmpz_mat_clear(B);
     fmpz_mat_clear(X);
-    fmpz_clear(t);
-    fmpz_clear(u);
-    fmpz_clear(v);
     fmpz_clear(mod);
 }
@@ -0,0 +1,60 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "fmpz_vec.h"
+#include "fmpz_mat.h"
+
+int
+fmpz_mat_mmap_init(fmpz_mat_t mat, FILE * file)
+{
+    flint_bin_header_t h;
+    fmpz * data;
+    long i;
+
+    if (!flint_bin_read_header(h, file) || h->type != FLINT_BIN_FMPZ_MAT
+        || (long) h->r < 0 || (long) h->c < 0)
+        return 0;
+
+    data = flint_bin_mmap(file, h);
+    if (data == NULL)
+        return 0;
+
+    if (!_fmpz_vec_bin_promote(data, h->r * h->c, h))
+    {
+        flint_bin_munmap(data);
+        return 0;
+    }
+
+    mat->entries = data;
+    mat->rows = malloc(h->r * sizeof(fmpz *));
+    for (i = 0; i < h->r; i++)
+        mat->rows[i] = data + i * h->c;
+
+    mat->r = h->r;
+    mat->c = h->c;
+
+    return 1;
+}
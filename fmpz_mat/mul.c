@@ -50,7 +50,7 @@ fmpz_mat_mul(fmpz_mat_t C, const fmpz_mat_t A, const fmpz_mat_t B)
 
     dim = FLINT_MIN(FLINT_MIN(m, n), k);
 
-    if (dim < 12)
+    if (dim < 4)
     {
         /* The inline version only benefits from large n */
         if (n <= 2)
@@ -68,9 +68,17 @@ fmpz_mat_mul(fmpz_mat_t C, const fmpz_mat_t A, const fmpz_mat_t B)
         ab = FLINT_ABS(ab);
         bb = FLINT_ABS(bb);
 
+        /* Every entry of C fits in a signed limb */
+        if (ab + bb + FLINT_BIT_COUNT(n) < FLINT_BITS)
+        {
+            _fmpz_mat_mul_small(C, A, B, ab + bb);
+            return;
+        }
+
         bits = ab + bb + FLINT_BIT_COUNT(n) + 1;
 
-        if (5*(ab + bb) > dim * dim || (bits > FLINT_BITS - 3 && dim < 60))
+        if (dim < 12 || 5*(ab + bb) > dim * dim
+            || (bits > FLINT_BITS - 3 && dim < 60))
         {
             fmpz_mat_mul_classical_inline(C, A, B);
         }
@@ -26,6 +26,7 @@
 #include <stdlib.h>
 #include "flint.h"
 #include "fmpz.h"
+#include "fmpz_vec.h"
 #include "fmpz_mat.h"
 #include "nmod_vec.h"
 #include "nmod_mat.h"
@@ -36,15 +37,14 @@ void
 _fmpz_mat_mul_multi_mod(fmpz_mat_t C, const fmpz_mat_t A, const fmpz_mat_t B,
     long bits)
 {
-    long i, j;
+    long i;
 
-    fmpz_comb_t comb;
-    fmpz_comb_temp_t comb_temp;
+    const fmpz_comb_struct * comb;
 
     long num_primes;
     long primes_bits;
     mp_limb_t * primes;
-    mp_limb_t * residues;
+    mp_ptr * residues;
 
     nmod_mat_t * mod_C;
     nmod_mat_t * mod_A;
@@ -69,7 +69,7 @@ _fmpz_mat_mul_multi_mod(fmpz_mat_t C, const fmpz_mat_t A, const fmpz_mat_t B,
     for (i = 1; i < num_primes; i++)
         primes[i] = n_nextprime(primes[i-1], 0);
 
-    residues = malloc(sizeof(mp_limb_t) * num_primes);
+    residues = malloc(sizeof(mp_ptr) * num_primes);
 
     mod_A = malloc(sizeof(nmod_mat_t) * num_primes);
     mod_B = malloc(sizeof(nmod_mat_t) * num_primes);
@@ -81,24 +81,17 @@ _fmpz_mat_mul_multi_mod(fmpz_mat_t C, const fmpz_mat_t A, const fmpz_mat_t B,
         nmod_mat_init(mod_C[i], C->r, C->c, primes[i]);
     }
 
-    fmpz_comb_init(comb, primes, num_primes);
-    fmpz_comb_temp_init(comb_temp, comb);
+    comb = fmpz_comb_cache_get(primes, num_primes);
 
     /* Calculate residues of A */
-    for (i = 0; i < A->r * A->c; i++)
-    {
-        fmpz_multi_mod_ui(residues, &A->entries[i], comb, comb_temp);
-        for (j = 0; j < num_primes; j++)
-            mod_A[j]->entries[i] = residues[j];
-    }
+    for (i = 0; i < num_primes; i++)
+        residues[i] = mod_A[i]->entries;
+    _fmpz_vec_multi_mod_ui(residues, A->entries, A->r * A->c, comb);
 
     /* Calculate residues of B */
-    for (i = 0; i < B->r * B->c; i++)
-    {
-        fmpz_multi_mod_ui(residues, &B->entries[i], comb, comb_temp);
-        for (j = 0; j < num_primes; j++)
-            mod_B[j]->entries[i] = residues[j];
-    }
+    for (i = 0; i < num_primes; i++)
+        residues[i] = mod_B[i]->entries;
+    _fmpz_vec_multi_mod_ui(residues, B->entries, B->r * B->c, comb);
 
     /* Multiply */
     for (i = 0; i < num_primes; i++)
@@ -107,12 +100,10 @@ _fmpz_mat_mul_multi_mod(fmpz_mat_t C, const fmpz_mat_t A, const fmpz_mat_t B,
     }
 
     /* Chinese remaindering */
-    for (i = 0; i < C->r * C->c; i++)
-    {
-        for (j = 0; j < num_primes; j++)
-            residues[j] = mod_C[j]->entries[i];
-        fmpz_multi_CRT_ui(&C->entries[i], residues, comb, comb_temp);
-    }
+    for (i = 0; i < num_primes; i++)
+        residues[i] = mod_C[i]->entries;
+    _fmpz_vec_multi_CRT_ui(C->entries, residues, C->r * C->c, comb, 1);
+    fmpz_comb_cache_release(comb);
 
     /* Cleanup */
     for (i = 0; i < num_primes; i++)
@@ -126,9 +117,6 @@ _fmpz_mat_mul_multi_mod(fmpz_mat_t C, const fmpz_mat_t A, const fmpz_mat_t B,
     free(mod_B);
     free(mod_C);
 
-    fmpz_comb_temp_clear(comb_temp);
-    fmpz_comb_clear(comb);
-
     free(residues);
     free(primes);
 }
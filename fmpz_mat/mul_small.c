@@ -0,0 +1,202 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "fmpz_mat.h"
+
+/*
+    Both kernels accumulate into a dense array Cp of longs with row stride
+    B->c. The loops run over blocks of FMPZ_MAT_MUL_SMALL_JBLOCK columns of
+    B and C and at most FMPZ_MAT_MUL_SMALL_KBLOCK rows of B, so that the
+    current block of B stays in cache while we sweep over the rows of A.
+    The innermost loops are branch-free and contiguous so that the compiler
+    can vectorise them.
+*/
+
+#define FMPZ_MAT_MUL_SMALL_JBLOCK 128
+#define FMPZ_MAT_MUL_SMALL_KBLOCK 128
+
+static void
+_fmpz_mat_mul_small_long(long * Cp, const fmpz_mat_t A, const fmpz_mat_t B)
+{
+    long i, j, k, jj, kk, jlen, klen, m, n, p;
+
+    m = A->r;
+    n = A->c;
+    p = B->c;
+
+    /* Small fmpz entries are stored as plain longs, so A and B can
+       be used as they are */
+    for (jj = 0; jj < p; jj += FMPZ_MAT_MUL_SMALL_JBLOCK)
+    {
+        jlen = FLINT_MIN(FMPZ_MAT_MUL_SMALL_JBLOCK, p - jj);
+
+        for (kk = 0; kk < n; kk += FMPZ_MAT_MUL_SMALL_KBLOCK)
+        {
+            klen = FLINT_MIN(FMPZ_MAT_MUL_SMALL_KBLOCK, n - kk);
+
+            for (i = 0; i < m; i++)
+            {
+                const long * a = A->rows[i] + kk;
+                long * c = Cp + i * p + jj;
+
+                for (k = 0; k < klen; k++)
+                {
+                    const long x = a[k];
+                    const long * b;
+
+                    if (x == 0L)
+                        continue;
+
+                    b = B->rows[kk + k] + jj;
+
+                    for (j = 0; j < jlen; j++)
+                        c[j] += x * b[j];
+                }
+            }
+        }
+    }
+}
+
+static void
+_fmpz_mat_mul_small_double(long * Cp, const fmpz_mat_t A,
+    const fmpz_mat_t B, long kblock)
+{
+    long i, j, k, jj, kk, jlen, klen, m, n, p;
+    double * Ad, * Bd, * T;
+
+    m = A->r;
+    n = A->c;
+    p = B->c;
+
+    Ad = malloc(sizeof(double) * m * n);
+    Bd = malloc(sizeof(double) * n * p);
+    T = malloc(sizeof(double) * FMPZ_MAT_MUL_SMALL_JBLOCK);
+
+    for (i = 0; i < m; i++)
+        for (k = 0; k < n; k++)
+            Ad[i * n + k] = (double) A->rows[i][k];
+
+    for (k = 0; k < n; k++)
+        for (j = 0; j < p; j++)
+            Bd[k * p + j] = (double) B->rows[k][j];
+
+    for (jj = 0; jj < p; jj += FMPZ_MAT_MUL_SMALL_JBLOCK)
+    {
+        jlen = FLINT_MIN(FMPZ_MAT_MUL_SMALL_JBLOCK, p - jj);
+
+        for (kk = 0; kk < n; kk += kblock)
+        {
+            klen = FLINT_MIN(kblock, n - kk);
+
+            for (i = 0; i < m; i++)
+            {
+                const double * a = Ad + i * n + kk;
+                long * c = Cp + i * p + jj;
+
+                for (j = 0; j < jlen; j++)
+                    T[j] = 0.0;
+
+                for (k = 0; k < klen; k++)
+                {
+                    const double x = a[k];
+                    const double * b;
+
+                    if (x == 0.0)
+                        continue;
+
+                    b = Bd + (kk + k) * p + jj;
+
+                    for (j = 0; j < jlen; j++)
+                        T[j] += x * b[j];
+                }
+
+                /* Every partial sum over this block is an integer of
+                   absolute value less than 2^FLINT_D_BITS, hence exact */
+                for (j = 0; j < jlen; j++)
+                    c[j] += (long) T[j];
+            }
+        }
+    }
+
+    free(Ad);
+    free(Bd);
+    free(T);
+}
+
+void
+_fmpz_mat_mul_small(fmpz_mat_t C, const fmpz_mat_t A, const fmpz_mat_t B,
+    long bits)
+{
+    long i, j, m, p, kblock;
+    long * Cp;
+
+    m = A->r;
+    p = B->c;
+
+    if (m == 0 || p == 0)
+        return;
+
+    Cp = calloc(m * p, sizeof(long));
+
+    /* Largest block length k with bits + FLINT_BIT_COUNT(k) <= FLINT_D_BITS */
+    if (bits < FLINT_D_BITS - 3)
+    {
+        if (FLINT_D_BITS - bits < FLINT_BIT_COUNT(FMPZ_MAT_MUL_SMALL_KBLOCK))
+            kblock = (1L << (FLINT_D_BITS - bits)) - 1;
+        else
+            kblock = FMPZ_MAT_MUL_SMALL_KBLOCK;
+
+        _fmpz_mat_mul_small_double(Cp, A, B, kblock);
+    }
+    else
+    {
+        _fmpz_mat_mul_small_long(Cp, A, B);
+    }
+
+    for (i = 0; i < m; i++)
+        for (j = 0; j < p; j++)
+            fmpz_set_si(fmpz_mat_entry(C, i, j), Cp[i * p + j]);
+
+    free(Cp);
+}
+
+void
+fmpz_mat_mul_small(fmpz_mat_t C, const fmpz_mat_t A, const fmpz_mat_t B)
+{
+    long ab, bb;
+
+    ab = fmpz_mat_max_bits(A);
+    bb = fmpz_mat_max_bits(B);
+
+    ab = FLINT_ABS(ab);
+    bb = FLINT_ABS(bb);
+
+    if (ab + bb + FLINT_BIT_COUNT(A->c) > FLINT_BITS - 1)
+    {
+        printf("Exception: fmpz_mat_mul_small: entries too large\n");
+        abort();
+    }
+
+    _fmpz_mat_mul_small(C, A, B, ab + bb);
+}
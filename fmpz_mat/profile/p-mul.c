@@ -75,6 +75,9 @@ void sample(void * arg, ulong count)
     else if (algorithm == 3)
         for (i = 0; i < count; i++)
             fmpz_mat_mul_multi_mod(C, A, B);
+    else if (algorithm == 4)
+        for (i = 0; i < count; i++)
+            fmpz_mat_mul_small(C, A, B);
 
     prof_stop();
 
@@ -87,7 +90,8 @@ void sample(void * arg, ulong count)
 
 int main(void)
 {
-    double min_default, min_classical, min_inline, min_multi_mod, max;
+    double min_default, min_classical, min_inline, min_multi_mod, min_small;
+    double max;
     mat_mul_t params;
     long bits, dim;
 
@@ -115,12 +119,24 @@ int main(void)
             params.algorithm = 3;
             prof_repeat(&min_multi_mod, &max, sample, &params);
 
-            printf("dim = %ld default/classical/inline/multi_mod %.2f %.2f %.2f %.2f (us)\n", 
-                dim, min_default, min_classical, min_inline, min_multi_mod);
+            if (2 * bits + FLINT_BIT_COUNT(dim) < FLINT_BITS)
+            {
+                params.algorithm = 4;
+                prof_repeat(&min_small, &max, sample, &params);
+            }
+            else
+                min_small = 0.0;
+
+            printf("dim = %ld default/classical/inline/multi_mod/small "
+                "%.2f %.2f %.2f %.2f %.2f (us)\n", dim, min_default,
+                min_classical, min_inline, min_multi_mod, min_small);
 
             if (min_multi_mod < 0.6*min_default)
                 printf("BAD!\n");
 
+            if (min_small != 0.0 && min_small < 0.6*min_default)
+                printf("BAD!\n");
+
             if (min_inline < 0.6*min_default)
                 printf("BAD!\n");
 
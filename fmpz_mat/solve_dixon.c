@@ -29,6 +29,7 @@
 #include "fmpz_vec.h"
 #include "fmpz_mat.h"
 #include "nmod_mat.h"
+#include "fmpq.h"
 #include "ulong_extras.h"
 
 
@@ -108,120 +109,248 @@ mp_limb_t * get_crt_primes(long * num_primes, const fmpz_mat_t A, mp_limb_t p)
 }
 
 
-static void
-_fmpz_mat_solve_dixon(fmpz_mat_t X, fmpz_t mod,
-                        const fmpz_mat_t A, const fmpz_mat_t B,
-                    const nmod_mat_t Ainv, mp_limb_t p,
-                    const fmpz_t N, const fmpz_t D)
+/* State of the p-adic lifting. After k steps, x = A^(-1) B mod p^k,
+   ppow = p^k, and d = (B - A x) / p^k exactly. The digit y_mod computed
+   in step k is only used to update d at the beginning of step k + 1, so
+   that no residue update is wasted when the lifting stops. */
+typedef struct
 {
-    fmpz_t bound, ppow;
-    fmpz_mat_t x, d, y, Ay;
+    const fmpz_mat_struct * A;
+    const nmod_mat_struct * Ainv;
+    mp_limb_t p;
+    long steps;
+    fmpz_t ppow;
     fmpz_t prod;
+    fmpz_mat_t x;
+    fmpz_mat_t d;
+    fmpz_mat_t Ay;
+    nmod_mat_t d_mod;
+    nmod_mat_t y_mod;
+    long num_primes;
     mp_limb_t * crt_primes;
     nmod_mat_t * A_mod;
-    nmod_mat_t Ay_mod, d_mod, y_mod;
-    long i, n, cols, num_primes;
+    nmod_mat_t * Ay_mod;
+}
+dixon_struct;
+
+typedef dixon_struct dixon_t[1];
+
+static void
+_dixon_init(dixon_t s, const fmpz_mat_t A, const fmpz_mat_t B,
+                                        const nmod_mat_t Ainv, mp_limb_t p)
+{
+    long i, n, cols;
 
     n = A->r;
     cols = B->c;
 
-    fmpz_init(bound);
-    fmpz_init(ppow);
-    fmpz_init(prod);
+    s->A = A;
+    s->Ainv = Ainv;
+    s->p = p;
+    s->steps = 0;
 
-    fmpz_mat_init(x, n, cols);
-    fmpz_mat_init(y, n, cols);
-    fmpz_mat_init(Ay, n, cols);
-    fmpz_mat_init_set(d, B);
+    fmpz_init(s->ppow);
+    fmpz_init(s->prod);
+    fmpz_one(s->ppow);
 
-    /* Compute bound for the needed modulus. TODO: if one of N and D
-       is much smaller than the other, we could use a tighter bound (i.e. 2ND).
-       This would require the ability to forward N and D to the
-       rational reconstruction routine.
-     */
-    if (fmpz_cmpabs(N, D) < 0)
-        fmpz_mul(bound, D, D);
-    else
-        fmpz_mul(bound, N, N);
-    fmpz_mul_ui(bound, bound, 2UL);  /* signs */
+    fmpz_mat_init(s->x, n, cols);
+    fmpz_mat_init(s->Ay, n, cols);
+    fmpz_mat_init_set(s->d, B);
+
+    nmod_mat_init(s->d_mod, n, cols, p);
+    nmod_mat_init(s->y_mod, n, cols, p);
 
-    crt_primes = get_crt_primes(&num_primes, A, p);
-    A_mod = malloc(sizeof(nmod_mat_t) * num_primes);
-    for (i = 0; i < num_primes; i++)
+    s->crt_primes = get_crt_primes(&s->num_primes, A, p);
+    s->A_mod = malloc(sizeof(nmod_mat_t) * s->num_primes);
+    s->Ay_mod = malloc(sizeof(nmod_mat_t) * s->num_primes);
+    for (i = 0; i < s->num_primes; i++)
     {
-        nmod_mat_init(A_mod[i], n, n, crt_primes[i]);
-        fmpz_mat_get_nmod_mat(A_mod[i], A);
+        nmod_mat_init(s->A_mod[i], n, n, s->crt_primes[i]);
+        nmod_mat_init(s->Ay_mod[i], n, cols, s->crt_primes[i]);
+        fmpz_mat_get_nmod_mat(s->A_mod[i], A);
     }
+}
 
-    nmod_mat_init(Ay_mod, n, cols, 1UL);
-    nmod_mat_init(d_mod, n, cols, p);
-    nmod_mat_init(y_mod, n, cols, p);
-
-    fmpz_one(ppow);
+static void
+_dixon_clear(dixon_t s)
+{
+    long i;
 
-    while (fmpz_cmp(ppow, bound) <= 0)
+    for (i = 0; i < s->num_primes; i++)
     {
-        /* y = A^(-1) * d  (mod p) */
-        fmpz_mat_get_nmod_mat(d_mod, d);
-        nmod_mat_mul(y_mod, Ainv, d_mod);
+        nmod_mat_clear(s->A_mod[i]);
+        nmod_mat_clear(s->Ay_mod[i]);
+    }
 
-        /* x = x + y * p^i    [= A^(-1) * b mod p^(i+1)] */
-        fmpz_mat_scalar_addmul_nmod_mat_fmpz(x, y_mod, ppow);
+    free(s->A_mod);
+    free(s->Ay_mod);
+    free(s->crt_primes);
 
-        /* ppow = p^(i+1) */
-        fmpz_mul_ui(ppow, ppow, p);
-        if (fmpz_cmp(ppow, bound) > 0)
-            break;
+    nmod_mat_clear(s->d_mod);
+    nmod_mat_clear(s->y_mod);
+
+    fmpz_mat_clear(s->x);
+    fmpz_mat_clear(s->d);
+    fmpz_mat_clear(s->Ay);
 
+    fmpz_clear(s->ppow);
+    fmpz_clear(s->prod);
+}
+
+/* Computes Ay modulo the i-th CRT prime. This only touches nmod_mat data,
+   so different primes can be handled by different threads. */
+static void
+_dixon_residue_worker(void * arg, long i)
+{
+    dixon_struct * s = (dixon_struct *) arg;
+    nmod_mat_t y;
+
+    /* All CRT primes are >= p, so the entries of y_mod are already
+       reduced and can be shared by all threads */
+    *y = *s->y_mod;
+    y->mod = s->A_mod[i]->mod;
+
+    nmod_mat_mul(s->Ay_mod[i], s->A_mod[i], y);
+}
+
+static void
+_dixon_step(dixon_t s)
+{
+    long i;
+
+    if (s->steps != 0)
+    {
         /* d = (d - Ay) / p */
 #if USE_SLOW_MULTIPLICATION
-        fmpz_mat_set_nmod_mat_unsigned(y, y_mod);
-        fmpz_mat_mul(Ay, A, y);
+        fmpz_mat_set_nmod_mat_unsigned(s->Ay, s->y_mod);
+        fmpz_mat_mul(s->Ay, s->A, s->Ay);
 #else
-        for (i = 0; i < num_primes; i++)
+        flint_parallel_do(_dixon_residue_worker, s, s->num_primes,
+                                                    flint_get_num_threads());
+
+        fmpz_mat_set_nmod_mat(s->Ay, s->Ay_mod[0]);
+        fmpz_set_ui(s->prod, s->crt_primes[0]);
+        for (i = 1; i < s->num_primes; i++)
         {
-            _nmod_mat_set_mod(y_mod, crt_primes[i]);
-            _nmod_mat_set_mod(Ay_mod, crt_primes[i]);
-            nmod_mat_mul(Ay_mod, A_mod[i], y_mod);
-            if (i == 0)
-            {
-                fmpz_mat_set_nmod_mat(Ay, Ay_mod);
-                fmpz_set_ui(prod, crt_primes[0]);
-            }
-            else
-            {
-                fmpz_mat_CRT_ui(Ay, Ay, prod, Ay_mod);
-                fmpz_mul_ui(prod, prod, crt_primes[i]);
-            }
+            fmpz_mat_CRT_ui(s->Ay, s->Ay, s->prod, s->Ay_mod[i]);
+            fmpz_mul_ui(s->prod, s->prod, s->crt_primes[i]);
         }
 #endif
+        fmpz_mat_sub(s->d, s->d, s->Ay);
+        fmpz_mat_scalar_divexact_ui(s->d, s->d, s->p);
+    }
+
+    /* y = A^(-1) * d  (mod p) */
+    fmpz_mat_get_nmod_mat(s->d_mod, s->d);
+    nmod_mat_mul(s->y_mod, s->Ainv, s->d_mod);
+
+    /* x = x + y * p^k    [= A^(-1) * b mod p^(k+1)] */
+    fmpz_mat_scalar_addmul_nmod_mat_fmpz(s->x, s->y_mod, s->ppow);
+
+    /* ppow = p^(k+1) */
+    fmpz_mul_ui(s->ppow, s->ppow, s->p);
+    s->steps++;
+}
+
+/* Bound for the modulus needed to recover the solution unconditionally.
+   TODO: if one of N and D is much smaller than the other, we could use
+   a tighter bound (i.e. 2ND). */
+static void
+_dixon_bound(fmpz_t bound, const fmpz_t N, const fmpz_t D)
+{
+    if (fmpz_cmpabs(N, D) < 0)
+        fmpz_mul(bound, D, D);
+    else
+        fmpz_mul(bound, N, N);
+    fmpz_mul_ui(bound, bound, 2UL);  /* signs */
+}
 
-        _nmod_mat_set_mod(y_mod, p);
-        fmpz_mat_sub(d, d, Ay);
-        fmpz_mat_scalar_divexact_ui(d, d, p);
+/* Given x = A^(-1) B mod M, attempts to find X and den with X / den equal
+   to x modulo M. The entries are reconstructed as if independently,
+   which is guaranteed to give the solution if M exceeds the bound
+   computed by _dixon_bound, but the denominator found so far is shared
+   with later entries, which then rarely need reconstruction. Returns 0
+   if some reconstruction fails or if the denominator exceeds D. */
+static int
+_dixon_reconstruct(fmpz_mat_t X, fmpz_t den, const fmpz_mat_t x,
+                            const fmpz_t M, const fmpz_t D)
+{
+    return _fmpq_reconstruct_fmpz_vec(X->entries, den, x->entries,
+                                      x->r * x->c, M)
+        && fmpz_cmp(den, D) <= 0;
+}
+
+/* Checks whether A X = den B, first modulo one of the CRT primes (which
+   differs from p) and then exactly */
+static int
+_dixon_verify(const dixon_t s, const fmpz_mat_t X, const fmpz_t den,
+                                                        const fmpz_mat_t B)
+{
+    fmpz_mat_t AX, dB;
+    int result;
+
+    if (s->num_primes > 1)
+    {
+        nmod_mat_t Xq, AXq, Bq;
+        mp_limb_t q = s->crt_primes[1];
+
+        nmod_mat_init(Xq, X->r, X->c, q);
+        nmod_mat_init(AXq, X->r, X->c, q);
+        nmod_mat_init(Bq, B->r, B->c, q);
+
+        fmpz_mat_get_nmod_mat(Xq, X);
+        fmpz_mat_get_nmod_mat(Bq, B);
+        nmod_mat_scalar_mul(Bq, Bq, fmpz_fdiv_ui(den, q));
+        nmod_mat_mul(AXq, s->A_mod[1], Xq);
+
+        result = nmod_mat_equal(AXq, Bq);
+
+        nmod_mat_clear(Xq);
+        nmod_mat_clear(AXq);
+        nmod_mat_clear(Bq);
+
+        if (!result)
+            return 0;
     }
 
-    fmpz_set(mod, ppow);
-    fmpz_mat_set(X, x);
+    fmpz_mat_init(AX, B->r, B->c);
+    fmpz_mat_init(dB, B->r, B->c);
 
-    nmod_mat_clear(y_mod);
-    nmod_mat_clear(d_mod);
-    nmod_mat_clear(Ay_mod);
+    fmpz_mat_mul(AX, s->A, X);
+    fmpz_mat_scalar_mul_fmpz(dB, B, den);
+    result = fmpz_mat_equal(AX, dB);
 
-    for (i = 0; i < num_primes; i++)
-        nmod_mat_clear(A_mod[i]);
+    fmpz_mat_clear(AX);
+    fmpz_mat_clear(dB);
 
-    free(A_mod);
-    free(crt_primes);
+    return result;
+}
 
-    fmpz_clear(bound);
-    fmpz_clear(ppow);
-    fmpz_clear(prod);
+static void
+_fmpz_mat_solve_dixon(fmpz_mat_t X, fmpz_t mod,
+                        const fmpz_mat_t A, const fmpz_mat_t B,
+                    const nmod_mat_t Ainv, mp_limb_t p,
+                    const fmpz_t N, const fmpz_t D)
+{
+    fmpz_t bound;
+    dixon_t s;
+
+    fmpz_init(bound);
+    _dixon_bound(bound, N, D);
+
+    _dixon_init(s, A, B, Ainv, p);
+
+    do
+    {
+        _dixon_step(s);
+    }
+    while (fmpz_cmp(s->ppow, bound) <= 0);
+
+    fmpz_set(mod, s->ppow);
+    fmpz_mat_set(X, s->x);
 
-    fmpz_mat_clear(x);
-    fmpz_mat_clear(y);
-    fmpz_mat_clear(d);
-    fmpz_mat_clear(Ay);
+    _dixon_clear(s);
+    fmpz_clear(bound);
 }
 
 int
@@ -256,3 +385,126 @@ fmpz_mat_solve_dixon(fmpz_mat_t X, fmpz_t mod,
 
     return p != 0;
 }
+
+/* Number of lifting steps before the first attempt at early termination;
+   subsequent attempts are spaced geometrically so that their total cost
+   stays proportional to that of the lifting */
+#define DIXON_FIRST_CHECK 4
+
+static void
+_fmpz_mat_solve_dixon_den(fmpz_mat_t X, fmpz_t den,
+                        const fmpz_mat_t A, const fmpz_mat_t B,
+                    const nmod_mat_t Ainv, mp_limb_t p,
+                    const fmpz_t N, const fmpz_t D)
+{
+    fmpz_t bound, t, num, q, last_num, last_q;
+    fmpz * x;
+    fmpz_mat_t Y;
+    dixon_t s;
+    long next_check;
+    int final, stable;
+
+    fmpz_init(bound);
+    fmpz_init(t);
+    fmpz_init(num);
+    fmpz_init(q);
+    fmpz_init(last_num);
+    fmpz_init(last_q);
+    _dixon_bound(bound, N, D);
+
+    fmpz_mat_init(Y, B->r, B->c);
+    _dixon_init(s, A, B, Ainv, p);
+
+    /* Entry used to detect when the approximation has stabilised */
+    x = fmpz_mat_entry(s->x, B->r - 1, B->c - 1);
+
+    next_check = DIXON_FIRST_CHECK;
+
+    while (1)
+    {
+        _dixon_step(s);
+
+        final = (fmpz_cmp(s->ppow, bound) > 0);
+
+        if (!final && s->steps != next_check)
+            continue;
+
+        /* Beyond the bound, reconstruction is guaranteed to succeed */
+        if (final)
+        {
+            if (!_dixon_reconstruct(Y, den, s->x, s->ppow, D))
+            {
+                printf("Exception: fmpz_mat_solve_dixon_den: "
+                       "rational reconstruction failed!\n");
+                abort();
+            }
+            break;
+        }
+
+        /* Only attempt a full reconstruction once the reconstruction of
+           one entry agrees with that at the previous check */
+        next_check += next_check / 2;
+
+        stable = 0;
+        fmpz_mod(t, x, s->ppow);
+        if (_fmpq_reconstruct_fmpz(num, q, t, s->ppow))
+        {
+            stable = fmpz_equal(num, last_num) && fmpz_equal(q, last_q);
+            fmpz_swap(num, last_num);
+            fmpz_swap(q, last_q);
+        }
+        else
+            fmpz_zero(last_q);
+
+        if (stable && _dixon_reconstruct(Y, den, s->x, s->ppow, D)
+                   && _dixon_verify(s, Y, den, B))
+            break;
+    }
+
+    fmpz_mat_swap(X, Y);
+
+    _dixon_clear(s);
+    fmpz_mat_clear(Y);
+    fmpz_clear(bound);
+    fmpz_clear(t);
+    fmpz_clear(num);
+    fmpz_clear(q);
+    fmpz_clear(last_num);
+    fmpz_clear(last_q);
+}
+
+int
+fmpz_mat_solve_dixon_den(fmpz_mat_t X, fmpz_t den,
+                        const fmpz_mat_t A, const fmpz_mat_t B)
+{
+    nmod_mat_t Ainv;
+    fmpz_t N, D;
+    mp_limb_t p;
+
+    if (!fmpz_mat_is_square(A))
+    {
+        printf("fmpz_mat_solve_dixon_den: nonsquare system matrix");
+        abort();
+    }
+
+    if (fmpz_mat_is_empty(A) || fmpz_mat_is_empty(B))
+    {
+        fmpz_one(den);
+        return 1;
+    }
+
+    fmpz_init(N);
+    fmpz_init(D);
+    fmpz_mat_solve_bound(N, D, A, B);
+
+    nmod_mat_init(Ainv, A->r, A->r, 1);
+    p = find_good_prime_and_invert(Ainv, A, D);
+    if (p != 0)
+        _fmpz_mat_solve_dixon_den(X, den, A, B, Ainv, p, N, D);
+
+    nmod_mat_clear(Ainv);
+    fmpz_clear(N);
+    fmpz_clear(D);
+
+    return p != 0;
+}
@@ -0,0 +1,190 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "fmpz_mat.h"
+#include "ulong_extras.h"
+
+int
+main(void)
+{
+    int i, j, result;
+    flint_rand_t state;
+
+    printf("fwrite_bin....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (i = 0; i < 200; i++)
+    {
+        fmpz_mat_t A[3], B, C;
+        FILE * file = tmpfile();
+
+        for (j = 0; j < 3; j++)
+        {
+            fmpz_mat_init(A[j], n_randint(state, 30), n_randint(state, 30));
+            fmpz_mat_randtest(A[j], state, n_randint(state, 2) ? 40 : 300);
+            result = fmpz_mat_fwrite_bin(file, A[j]);
+            if (!result)
+            {
+                printf("FAIL (write):\n");
+                abort();
+            }
+        }
+        rewind(file);
+
+        fmpz_mat_init(B, 0, 0);
+
+        result = fmpz_mat_fread_bin(file, B) && fmpz_mat_equal(A[0], B)
+              && fmpz_mat_mmap_init(C, file) && fmpz_mat_equal(A[1], C);
+        if (!result)
+        {
+            printf("FAIL (read):\n");
+            fmpz_mat_print_pretty(A[0]), printf("\n\n");
+            fmpz_mat_print_pretty(A[1]), printf("\n\n");
+            abort();
+        }
+
+        /* The mapped matrix may be modified in place */
+        if (C->r > 0 && C->c > 0)
+        {
+            fmpz_mul_2exp(fmpz_mat_entry(C, 0, 0), fmpz_mat_entry(C, 0, 0), 100);
+            fmpz_one(fmpz_mat_entry(C, C->r - 1, C->c - 1));
+            fmpz_mat_neg(C, C);
+        }
+        fmpz_mat_mmap_clear(C);
+
+        result = fmpz_mat_fread_bin(file, B) && fmpz_mat_equal(A[2], B)
+              && !fmpz_mat_fread_bin(file, B);
+        if (!result)
+        {
+            printf("FAIL (read):\n");
+            fmpz_mat_print_pretty(A[2]), printf("\n\n");
+            abort();
+        }
+
+        for (j = 0; j < 3; j++)
+            fmpz_mat_clear(A[j]);
+        fmpz_mat_clear(B);
+        fclose(file);
+    }
+
+    /* Hand-written files: a large entry which fits in a word, a large
+       entry with a zero top limb, and dimensions whose product wraps */
+    for (i = 0; i < 3; i++)
+    {
+        fmpz_mat_t B, C;
+        flint_bin_header_t h;
+        mp_limb_t data[6] = {0UL, 0UL, 1UL, -1L, 5UL, 0UL};
+        FILE * file = tmpfile();
+
+        if (i < 2)
+        {
+            flint_bin_header_init(h, FLINT_BIN_FMPZ_MAT, 2, 1, 0);
+            h->num_big = 1;
+            h->num_limbs = i + 1;
+            data[3] = -(long) (i + 1);
+        }
+        else
+            flint_bin_header_init(h, FLINT_BIN_FMPZ_MAT,
+                                    1UL << (FLINT_BITS - 2), 4, 0);
+
+        flint_bin_write_header(file, h);
+        flint_bin_write_limbs(file, data, 6);
+        flint_bin_write_header(file, h);
+        flint_bin_write_limbs(file, data, 6);
+        rewind(file);
+
+        fmpz_mat_init(B, 0, 0);
+
+        result = fmpz_mat_fread_bin(file, B);
+        if (result != (i == 0) || (result && (COEFF_IS_MPZ(B->entries[1])
+            || fmpz_cmp_si(B->entries + 1, -5L) != 0)))
+        {
+            printf("FAIL (read, file %d):\n", i);
+            abort();
+        }
+
+        fseek(file, FLINT_BIN_HEADER_BYTES + 6 * sizeof(mp_limb_t),
+                                                                SEEK_SET);
+        result = fmpz_mat_mmap_init(C, file);
+        if (result != (i == 0) || (result && (COEFF_IS_MPZ(C->entries[1])
+            || fmpz_cmp_si(C->entries + 1, -5L) != 0)))
+        {
+            printf("FAIL (mmap, file %d):\n", i);
+            abort();
+        }
+
+        if (result)
+            fmpz_mat_mmap_clear(C);
+        fmpz_mat_clear(B);
+        fclose(file);
+    }
+
+    /* Corrupted data is rejected or read as some matrix, without crashing */
+    for (i = 0; i < 1000; i++)
+    {
+        fmpz_mat_t A, B;
+        long size, pos;
+        FILE * file = tmpfile();
+
+        fmpz_mat_init(A, n_randint(state, 10) + 1, n_randint(state, 10) + 1);
+        fmpz_mat_randtest(A, state, 200);
+        fmpz_mat_fwrite_bin(file, A);
+
+        size = ftell(file);
+        pos = FLINT_BIN_HEADER_BYTES
+            + n_randint(state, size - FLINT_BIN_HEADER_BYTES);
+        fseek(file, pos, SEEK_SET);
+        putc(n_randint(state, 256), file);
+        rewind(file);
+
+        /* Or truncated */
+        if (n_randint(state, 2))
+        {
+            FILE * copy = tmpfile();
+
+            while (pos-- > 0)
+                putc(getc(file), copy);
+
+            fclose(file);
+            file = copy;
+            rewind(file);
+        }
+
+        fmpz_mat_init(B, 0, 0);
+        fmpz_mat_fread_bin(file, B);
+
+        fmpz_mat_clear(A);
+        fmpz_mat_clear(B);
+        fclose(file);
+    }
+
+    flint_randclear(state);
+    _fmpz_cleanup();
+    printf("PASS\n");
+    return 0;
+}
@@ -78,6 +78,7 @@ int main(void)
     }
 
     flint_randclear(state);
+    fmpz_comb_cache_clear();
     _fmpz_cleanup();
     printf("PASS\n");
     return 0;
@@ -0,0 +1,95 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "fmpz_vec.h"
+#include "fmpz_mat.h"
+#include "ulong_extras.h"
+
+int main(void)
+{
+    fmpz_mat_t A, B, C, D;
+    long i;
+    flint_rand_t state;
+
+    printf("mul_small....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (i = 0; i < 1000; i++)
+    {
+        long m, n, k, bits, ab, bb;
+
+        if (i % 50 == 0)
+        {
+            m = n_randint(state, 300);
+            n = n_randint(state, 300);
+            k = n_randint(state, 300);
+        }
+        else
+        {
+            m = n_randint(state, 50);
+            n = n_randint(state, 50);
+            k = n_randint(state, 50);
+        }
+
+        /* Largest total number of bits for which C fits in a signed limb */
+        bits = FLINT_BITS - 1 - FLINT_BIT_COUNT(n);
+        ab = n_randint(state, bits - 1) + 1;
+        bb = n_randint(state, bits - ab) + 1;
+
+        fmpz_mat_init(A, m, n);
+        fmpz_mat_init(B, n, k);
+        fmpz_mat_init(C, m, k);
+        fmpz_mat_init(D, m, k);
+
+        fmpz_mat_randtest(A, state, ab);
+        fmpz_mat_randtest(B, state, bb);
+
+        /* Make sure noise in the output is ok */
+        fmpz_mat_randtest(D, state, n_randint(state, 200) + 1);
+
+        fmpz_mat_mul_classical_inline(C, A, B);
+        fmpz_mat_mul_small(D, A, B);
+
+        if (!fmpz_mat_equal(C, D))
+        {
+            printf("FAIL: results not equal\n");
+            printf("m = %ld, n = %ld, k = %ld, ab = %ld, bb = %ld\n",
+                m, n, k, ab, bb);
+            abort();
+        }
+
+        fmpz_mat_clear(A);
+        fmpz_mat_clear(B);
+        fmpz_mat_clear(C);
+        fmpz_mat_clear(D);
+    }
+
+    flint_randclear(state);
+    _fmpz_cleanup();
+    printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,149 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "fmpz_vec.h"
+#include "fmpz_mat.h"
+#include "ulong_extras.h"
+
+int
+main(void)
+{
+    fmpz_mat_t A, X, B, AX, Bden;
+    fmpz_t den;
+    flint_rand_t state;
+    long i, m, n, r;
+    int success;
+
+    printf("solve_dixon_den....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (i = 0; i < 1000; i++)
+    {
+        m = n_randint(state, 20);
+        n = n_randint(state, 20);
+
+        flint_set_num_threads(1 + n_randint(state, 3));
+
+        fmpz_mat_init(A, m, m);
+        fmpz_mat_init(B, m, n);
+        fmpz_mat_init(Bden, m, n);
+        fmpz_mat_init(X, m, n);
+        fmpz_mat_init(AX, m, n);
+        fmpz_init(den);
+
+        fmpz_mat_randrank(A, state, m, 1+n_randint(state, 2)*n_randint(state, 100));
+
+        /* Dense */
+        if (n_randint(state, 2))
+            fmpz_mat_randops(A, state, 1+n_randint(state, 1 + m*m));
+
+        /* Either a random right-hand side, or one with a small solution
+           so that the lifting terminates early */
+        if (n_randint(state, 2))
+        {
+            fmpz_mat_randtest(B, state, 1+n_randint(state, 2)*n_randint(state, 100));
+        }
+        else
+        {
+            fmpz_mat_randtest(X, state, 1+n_randint(state, 10));
+            fmpz_mat_mul(B, A, X);
+        }
+
+        success = fmpz_mat_solve_dixon_den(X, den, A, B);
+
+        fmpz_mat_mul(AX, A, X);
+        fmpz_mat_scalar_mul_fmpz(Bden, B, den);
+
+        if (!success || fmpz_is_zero(den) || !fmpz_mat_equal(AX, Bden))
+        {
+            printf("FAIL:\n");
+            printf("AX != B * den!\n");
+            printf("A:\n"),      fmpz_mat_print_pretty(A),  printf("\n");
+            printf("B:\n"),      fmpz_mat_print_pretty(B),  printf("\n");
+            printf("X:\n"),      fmpz_mat_print_pretty(X),  printf("\n");
+            printf("den = "),    fmpz_print(den),           printf("\n");
+            printf("AX:\n"),     fmpz_mat_print_pretty(AX), printf("\n");
+            abort();
+        }
+
+        /* Test aliasing */
+        success = fmpz_mat_solve_dixon_den(B, den, A, B);
+
+        if (!success || !fmpz_mat_equal(X, B))
+        {
+            printf("FAIL:\n");
+            printf("aliasing failed!\n");
+            abort();
+        }
+
+        fmpz_mat_clear(A);
+        fmpz_mat_clear(B);
+        fmpz_mat_clear(Bden);
+        fmpz_mat_clear(X);
+        fmpz_mat_clear(AX);
+        fmpz_clear(den);
+    }
+
+    flint_set_num_threads(1);
+
+    /* Test singular systems */
+    for (i = 0; i < 1000; i++)
+    {
+        m = 1 + n_randint(state, 10);
+        n = 1 + n_randint(state, 10);
+        r = n_randint(state, m);
+
+        fmpz_mat_init(A, m, m);
+        fmpz_mat_init(B, m, n);
+        fmpz_mat_init(X, m, n);
+        fmpz_init(den);
+
+        fmpz_mat_randrank(A, state, r, 1+n_randint(state, 2)*n_randint(state, 100));
+        fmpz_mat_randtest(B, state, 1+n_randint(state, 2)*n_randint(state, 100));
+
+        /* Dense */
+        if (n_randint(state, 2))
+            fmpz_mat_randops(A, state, 1+n_randint(state, 1 + m*m));
+
+        if (fmpz_mat_solve_dixon_den(X, den, A, B) != 0)
+        {
+            printf("FAIL:\n");
+            printf("singular system, returned nonzero\n");
+            abort();
+        }
+
+        fmpz_mat_clear(A);
+        fmpz_mat_clear(B);
+        fmpz_mat_clear(X);
+        fmpz_clear(den);
+    }
+
+    flint_randclear(state);
+    _fmpz_cleanup();
+    printf("PASS\n");
+    return 0;
+}
@@ -834,6 +834,14 @@ int fmpz_poly_read_pretty(fmpz_poly_t poly, char **x)
     return fmpz_poly_fread_pretty(stdin, poly, x);
 }
 
+int fmpz_poly_fwrite_bin(FILE * file, const fmpz_poly_t poly);
+
+int fmpz_poly_fread_bin(FILE * file, fmpz_poly_t poly);
+
+int fmpz_poly_mmap_init(fmpz_poly_t poly, FILE * file);
+
+void fmpz_poly_mmap_clear(fmpz_poly_t poly);
+
 static __inline__
 void fmpz_poly_debug(const fmpz_poly_t poly)
 {
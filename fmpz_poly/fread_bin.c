@@ -0,0 +1,50 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+
+#include <stdio.h>
+#include <mpir.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "fmpz_vec.h"
+#include "fmpz_poly.h"
+
+int
+fmpz_poly_fread_bin(FILE * file, fmpz_poly_t poly)
+{
+    flint_bin_header_t h;
+    long len;
+
+    if (!flint_bin_read_header(h, file) || h->type != FLINT_BIN_FMPZ_POLY
+        || h->c != 1 || (long) h->r < 0)
+        return 0;
+
+    len = h->r;
+    fmpz_poly_fit_length(poly, len);
+    _fmpz_poly_set_length(poly, 0);
+
+    if (!_fmpz_vec_fread_bin(poly->coeffs, len, file, h))
+        return 0;
+
+    _fmpz_poly_set_length(poly, len);
+    _fmpz_poly_normalise(poly);
+
+    return 1;
+}
@@ -0,0 +1,114 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "fmpz_poly.h"
+#include "fmpz_mat.h"
+#include "ulong_extras.h"
+
+int
+main(void)
+{
+    int i, j, result;
+    flint_rand_t state;
+
+    printf("fwrite_bin....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    /* Several objects per file, so that most start off a page boundary */
+    for (i = 0; i < 200; i++)
+    {
+        fmpz_poly_t a[4], b, c;
+        fmpz_mat_t m;
+        FILE * file = tmpfile();
+
+        for (j = 0; j < 4; j++)
+        {
+            fmpz_poly_init(a[j]);
+            fmpz_poly_randtest(a[j], state, n_randint(state, 1000),
+                                        n_randint(state, 2) ? 40 : 300);
+            result = fmpz_poly_fwrite_bin(file, a[j]);
+            if (!result)
+            {
+                printf("FAIL (write):\n");
+                abort();
+            }
+        }
+        rewind(file);
+
+        fmpz_poly_init(b);
+
+        result = fmpz_poly_fread_bin(file, b) && fmpz_poly_equal(a[0], b)
+              && fmpz_poly_mmap_init(c, file) && fmpz_poly_equal(a[1], c)
+              && fmpz_poly_fread_bin(file, b) && fmpz_poly_equal(a[2], b);
+        if (!result)
+        {
+            printf("FAIL (read):\n");
+            fmpz_poly_print(a[0]), printf("\n\n");
+            fmpz_poly_print(a[1]), printf("\n\n");
+            fmpz_poly_print(a[2]), printf("\n\n");
+            abort();
+        }
+
+        /* The mapped polynomial may be modified in place */
+        if (c->length > 0)
+        {
+            fmpz_mul_2exp(c->coeffs + 0, c->coeffs + 0, 100);
+            fmpz_poly_set_coeff_si(c, c->length - 1, 1);
+            fmpz_poly_scalar_mul_ui(c, c, 3);
+        }
+        fmpz_poly_mmap_clear(c);
+
+        /* A polynomial is not a matrix */
+        fmpz_mat_init(m, 0, 0);
+        result = (fmpz_mat_fread_bin(file, m) == 0);
+        if (!result)
+        {
+            printf("FAIL (type):\n");
+            abort();
+        }
+        fmpz_mat_clear(m);
+
+        /* End of file */
+        result = (fmpz_poly_fread_bin(file, b) == 0);
+        if (!result)
+        {
+            printf("FAIL (eof):\n");
+            abort();
+        }
+
+        for (j = 0; j < 4; j++)
+            fmpz_poly_clear(a[j]);
+        fmpz_poly_clear(b);
+        fclose(file);
+    }
+
+    flint_randclear(state);
+    _fmpz_cleanup();
+    printf("PASS\n");
+    return 0;
+}
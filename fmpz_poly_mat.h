@@ -31,6 +31,7 @@
 #include "fmpz.h"
 #include "fmpz_mat.h"
 #include "fmpz_poly.h"
+#include "nmod_poly_mat.h"
 
 /* Types *********************************************************************/
 
@@ -117,6 +118,24 @@ long fmpz_poly_mat_max_bits(const fmpz_poly_mat_t A);
 
 long fmpz_poly_mat_max_length(const fmpz_poly_mat_t A);
 
+/*
+    Bits needed for the coefficients of the determinant of an n x n
+    matrix whose entries have length at most len and coefficients of
+    at most the given number of bits, including a sign bit. Every
+    coefficient is bounded by the maximum of the determinant on the
+    unit circle, which is at most (sqrt(n) len 2^bits)^n by Hadamard's
+    inequality.
+ */
+static __inline__ long
+_fmpz_poly_mat_det_bound_bits(long n, long len, long bits)
+{
+    if (n == 0 || len == 0)
+        return 1;
+
+    return n * (bits + FLINT_BIT_COUNT(len))
+        + (n * FLINT_BIT_COUNT(n) + 1) / 2 + 1;
+}
+
 /* Scalar arithmetic *********************************************************/
 
 void fmpz_poly_mat_scalar_mul_fmpz_poly(fmpz_poly_mat_t B,
@@ -144,6 +163,12 @@ void fmpz_poly_mat_mul_classical(fmpz_poly_mat_t C, const fmpz_poly_mat_t A,
 void fmpz_poly_mat_mul_KS(fmpz_poly_mat_t C, const fmpz_poly_mat_t A,
                                             const fmpz_poly_mat_t B);
 
+void _fmpz_poly_mat_mul_multi_mod(fmpz_poly_mat_t C, const fmpz_poly_mat_t A,
+                                    const fmpz_poly_mat_t B, long bits);
+
+void fmpz_poly_mat_mul_multi_mod(fmpz_poly_mat_t C, const fmpz_poly_mat_t A,
+                                            const fmpz_poly_mat_t B);
+
 void fmpz_poly_mat_sqr(fmpz_poly_mat_t B, const fmpz_poly_mat_t A);
 
 void fmpz_poly_mat_sqr_classical(fmpz_poly_mat_t B, const fmpz_poly_mat_t A);
@@ -155,6 +180,18 @@ void fmpz_poly_mat_pow(fmpz_poly_mat_t B, const fmpz_poly_mat_t A, ulong exp);
 void fmpz_poly_mat_prod(fmpz_poly_mat_t res,
                         fmpz_poly_mat_t * const factors, long n);
 
+/* Multimodular reduction and reconstruction ********************************/
+
+void fmpz_poly_mat_get_nmod_poly_mat(nmod_poly_mat_t Amod,
+                                        const fmpz_poly_mat_t A);
+
+void _fmpz_poly_mat_multi_mod_ui(nmod_poly_mat_struct * Amod,
+    const fmpz_poly_mat_t A, const fmpz_comb_t comb, fmpz_comb_temp_t temp);
+
+void _fmpz_poly_mat_multi_CRT_ui(fmpz_poly_mat_t A,
+    const nmod_poly_mat_struct * Amod,
+    const fmpz_comb_t comb, fmpz_comb_temp_t temp);
+
 /* Evaluation ****************************************************************/
 
 void fmpz_poly_mat_evaluate_fmpz(fmpz_mat_t B,
@@ -182,8 +219,12 @@ void fmpz_poly_mat_det_fflu(fmpz_poly_t det, const fmpz_poly_mat_t A);
 
 void fmpz_poly_mat_det_interpolate(fmpz_poly_t det, const fmpz_poly_mat_t A);
 
+void fmpz_poly_mat_det_multi_mod(fmpz_poly_t det, const fmpz_poly_mat_t A);
+
 long fmpz_poly_mat_rank(const fmpz_poly_mat_t A);
 
+long fmpz_poly_mat_rank_multi_mod(const fmpz_poly_mat_t A);
+
 /* Inverse *******************************************************************/
 
 int fmpz_poly_mat_inv(fmpz_poly_mat_t Ainv, fmpz_poly_t den,
@@ -201,8 +242,16 @@ int fmpz_poly_mat_solve(fmpz_poly_mat_t X, fmpz_poly_t den,
 int fmpz_poly_mat_solve_fflu(fmpz_poly_mat_t X, fmpz_poly_t den,
                             const fmpz_poly_mat_t A, const fmpz_poly_mat_t B);
 
+int fmpz_poly_mat_solve_multi_mod(fmpz_poly_mat_t X, fmpz_poly_t den,
+                            const fmpz_poly_mat_t A, const fmpz_poly_mat_t B);
+
 void fmpz_poly_mat_solve_fflu_precomp(fmpz_poly_mat_t X,
                     const long * perm,
                     const fmpz_poly_mat_t FFLU, const fmpz_poly_mat_t B);
 
+/* Tuning ********************************************************************/
+
+/* Dimension from which products modulo each prime use interpolation */
+#define FMPZ_POLY_MAT_MULTI_MOD_INTERPOLATE_DIM 10
+
 #endif
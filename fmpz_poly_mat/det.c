@@ -56,8 +56,12 @@ fmpz_poly_mat_det(fmpz_poly_t det, const fmpz_poly_mat_t A)
     {
         fmpz_poly_mat_det_fflu(det, A);
     }
-    else
+    else if (n < 24)
     {
         fmpz_poly_mat_det_interpolate(det, A);
     }
+    else
+    {
+        fmpz_poly_mat_det_multi_mod(det, A);
+    }
 }
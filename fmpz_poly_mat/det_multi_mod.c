@@ -0,0 +1,122 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "fmpz_poly.h"
+#include "fmpz_poly_mat.h"
+#include "nmod_poly_mat.h"
+#include "nmod_mat.h"
+#include "ulong_extras.h"
+
+typedef struct
+{
+    nmod_poly_mat_struct * D;
+    const nmod_poly_mat_struct * A;
+}
+_det_multi_mod_struct;
+
+static void
+_det_multi_mod_worker(void * arg, long i)
+{
+    _det_multi_mod_struct * s = (_det_multi_mod_struct *) arg;
+
+    nmod_poly_mat_det(nmod_poly_mat_entry(s->D + i, 0, 0), s->A + i);
+}
+
+void
+fmpz_poly_mat_det_multi_mod(fmpz_poly_t det, const fmpz_poly_mat_t A)
+{
+    _det_multi_mod_struct s;
+    const fmpz_comb_struct * comb;
+    fmpz_comb_temp_t comb_temp;
+    nmod_poly_mat_struct *mod_A, *mod_D;
+    fmpz_poly_mat_t D;
+    mp_limb_t * primes;
+    long i, n, len, bits, num_primes;
+
+    n = A->r;
+
+    if (n == 0)
+    {
+        fmpz_poly_one(det);
+        return;
+    }
+
+    len = fmpz_poly_mat_max_length(A);
+
+    if (len == 0)
+    {
+        fmpz_poly_zero(det);
+        return;
+    }
+
+    bits = _fmpz_poly_mat_det_bound_bits(n, len,
+                            FLINT_ABS(fmpz_poly_mat_max_bits(A)));
+
+    num_primes = (bits + NMOD_MAT_OPTIMAL_MODULUS_BITS - 1)
+                                / NMOD_MAT_OPTIMAL_MODULUS_BITS;
+
+    primes = malloc(sizeof(mp_limb_t) * num_primes);
+    primes[0] = n_nextprime(1UL << NMOD_MAT_OPTIMAL_MODULUS_BITS, 0);
+    for (i = 1; i < num_primes; i++)
+        primes[i] = n_nextprime(primes[i - 1], 0);
+
+    /* The determinant modulo each prime is held in a 1 x 1 matrix */
+    mod_A = malloc(sizeof(nmod_poly_mat_struct) * num_primes);
+    mod_D = malloc(sizeof(nmod_poly_mat_struct) * num_primes);
+    for (i = 0; i < num_primes; i++)
+    {
+        nmod_poly_mat_init(mod_A + i, n, n, primes[i]);
+        nmod_poly_mat_init(mod_D + i, 1, 1, primes[i]);
+    }
+
+    comb = fmpz_comb_cache_get(primes, num_primes);
+    fmpz_comb_temp_init(comb_temp, comb);
+
+    _fmpz_poly_mat_multi_mod_ui(mod_A, A, comb, comb_temp);
+
+    /* The determinants modulo different primes are independent */
+    s.D = mod_D;
+    s.A = mod_A;
+    flint_parallel_do(_det_multi_mod_worker, &s, num_primes,
+                                            flint_get_num_threads());
+
+    fmpz_poly_mat_init(D, 1, 1);
+    _fmpz_poly_mat_multi_CRT_ui(D, mod_D, comb, comb_temp);
+    fmpz_poly_swap(det, fmpz_poly_mat_entry(D, 0, 0));
+    fmpz_poly_mat_clear(D);
+
+    for (i = 0; i < num_primes; i++)
+    {
+        nmod_poly_mat_clear(mod_A + i);
+        nmod_poly_mat_clear(mod_D + i);
+    }
+
+    free(mod_A);
+    free(mod_D);
+
+    fmpz_comb_temp_clear(comb_temp);
+    fmpz_comb_cache_release(comb);
+
+    free(primes);
+}
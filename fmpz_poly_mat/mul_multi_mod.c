@@ -0,0 +1,153 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "fmpz_poly.h"
+#include "fmpz_poly_mat.h"
+#include "nmod_poly_mat.h"
+#include "nmod_mat.h"
+#include "ulong_extras.h"
+
+typedef struct
+{
+    nmod_poly_mat_struct * C;
+    const nmod_poly_mat_struct * A;
+    const nmod_poly_mat_struct * B;
+}
+_mul_multi_mod_struct;
+
+static void
+_mul_multi_mod_worker(void * arg, long i)
+{
+    _mul_multi_mod_struct * s = (_mul_multi_mod_struct *) arg;
+    const nmod_poly_mat_struct * A = s->A + i;
+    const nmod_poly_mat_struct * B = s->B + i;
+
+    /*
+        Kronecker substitution goes through the fmpz memory manager,
+        which is not thread-safe, so it is not used here
+     */
+    if (A->r < FMPZ_POLY_MAT_MULTI_MOD_INTERPOLATE_DIM
+        || B->r < FMPZ_POLY_MAT_MULTI_MOD_INTERPOLATE_DIM
+        || B->c < FMPZ_POLY_MAT_MULTI_MOD_INTERPOLATE_DIM)
+        nmod_poly_mat_mul_classical(s->C + i, A, B);
+    else
+        nmod_poly_mat_mul_interpolate(s->C + i, A, B);
+}
+
+void
+_fmpz_poly_mat_mul_multi_mod(fmpz_poly_mat_t C, const fmpz_poly_mat_t A,
+    const fmpz_poly_mat_t B, long bits)
+{
+    _mul_multi_mod_struct s;
+    const fmpz_comb_struct * comb;
+    fmpz_comb_temp_t comb_temp;
+    nmod_poly_mat_struct *mod_A, *mod_B, *mod_C;
+    mp_limb_t * primes;
+    long i, num_primes;
+
+    num_primes = (bits + NMOD_MAT_OPTIMAL_MODULUS_BITS - 1)
+                                / NMOD_MAT_OPTIMAL_MODULUS_BITS;
+    num_primes = FLINT_MAX(num_primes, 1);
+
+    primes = malloc(sizeof(mp_limb_t) * num_primes);
+    primes[0] = n_nextprime(1UL << NMOD_MAT_OPTIMAL_MODULUS_BITS, 0);
+    for (i = 1; i < num_primes; i++)
+        primes[i] = n_nextprime(primes[i - 1], 0);
+
+    mod_A = malloc(sizeof(nmod_poly_mat_struct) * num_primes);
+    mod_B = malloc(sizeof(nmod_poly_mat_struct) * num_primes);
+    mod_C = malloc(sizeof(nmod_poly_mat_struct) * num_primes);
+    for (i = 0; i < num_primes; i++)
+    {
+        nmod_poly_mat_init(mod_A + i, A->r, A->c, primes[i]);
+        nmod_poly_mat_init(mod_B + i, B->r, B->c, primes[i]);
+        nmod_poly_mat_init(mod_C + i, C->r, C->c, primes[i]);
+    }
+
+    comb = fmpz_comb_cache_get(primes, num_primes);
+    fmpz_comb_temp_init(comb_temp, comb);
+
+    _fmpz_poly_mat_multi_mod_ui(mod_A, A, comb, comb_temp);
+    _fmpz_poly_mat_multi_mod_ui(mod_B, B, comb, comb_temp);
+
+    /* The products modulo different primes are independent */
+    s.C = mod_C;
+    s.A = mod_A;
+    s.B = mod_B;
+    flint_parallel_do(_mul_multi_mod_worker, &s, num_primes,
+                                            flint_get_num_threads());
+
+    _fmpz_poly_mat_multi_CRT_ui(C, mod_C, comb, comb_temp);
+
+    for (i = 0; i < num_primes; i++)
+    {
+        nmod_poly_mat_clear(mod_A + i);
+        nmod_poly_mat_clear(mod_B + i);
+        nmod_poly_mat_clear(mod_C + i);
+    }
+
+    free(mod_A);
+    free(mod_B);
+    free(mod_C);
+
+    fmpz_comb_temp_clear(comb_temp);
+    fmpz_comb_cache_release(comb);
+
+    free(primes);
+}
+
+void
+fmpz_poly_mat_mul_multi_mod(fmpz_poly_mat_t C, const fmpz_poly_mat_t A,
+    const fmpz_poly_mat_t B)
+{
+    long A_len, B_len, A_bits, B_bits, bits;
+
+    if (B->r == 0)
+    {
+        fmpz_poly_mat_zero(C);
+        return;
+    }
+
+    if (fmpz_poly_mat_is_empty(C))
+        return;
+
+    A_len = fmpz_poly_mat_max_length(A);
+    B_len = fmpz_poly_mat_max_length(B);
+
+    if (A_len == 0 || B_len == 0)
+    {
+        fmpz_poly_mat_zero(C);
+        return;
+    }
+
+    A_bits = fmpz_poly_mat_max_bits(A);
+    B_bits = fmpz_poly_mat_max_bits(B);
+
+    /* Each coefficient is a sum of B->r * min(A_len, B_len) products */
+    bits = FLINT_ABS(A_bits) + FLINT_ABS(B_bits)
+        + FLINT_BIT_COUNT(FLINT_MIN(A_len, B_len))
+        + FLINT_BIT_COUNT(B->r) + 1;
+
+    _fmpz_poly_mat_mul_multi_mod(C, A, B, bits);
+}
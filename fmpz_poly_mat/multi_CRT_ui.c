@@ -0,0 +1,74 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "fmpz_poly.h"
+#include "nmod_poly.h"
+#include "fmpz_poly_mat.h"
+#include "nmod_poly_mat.h"
+
+void
+_fmpz_poly_mat_multi_CRT_ui(fmpz_poly_mat_t A,
+    const nmod_poly_mat_struct * Amod,
+    const fmpz_comb_t comb, fmpz_comb_temp_t temp)
+{
+    long i, j, k, l, len, num_primes = comb->num_primes;
+    const nmod_poly_struct * b;
+    fmpz_poly_struct * a;
+    mp_ptr r;
+
+    r = malloc(sizeof(mp_limb_t) * num_primes);
+
+    for (i = 0; i < A->r; i++)
+    {
+        for (j = 0; j < A->c; j++)
+        {
+            a = fmpz_poly_mat_entry(A, i, j);
+
+            len = 0;
+            for (l = 0; l < num_primes; l++)
+            {
+                b = nmod_poly_mat_entry(Amod + l, i, j);
+                len = FLINT_MAX(len, b->length);
+            }
+
+            fmpz_poly_fit_length(a, len);
+
+            for (k = 0; k < len; k++)
+            {
+                for (l = 0; l < num_primes; l++)
+                {
+                    b = nmod_poly_mat_entry(Amod + l, i, j);
+                    r[l] = (k < b->length) ? b->coeffs[k] : 0UL;
+                }
+
+                fmpz_multi_CRT_ui(a->coeffs + k, r, comb, temp);
+            }
+
+            _fmpz_poly_set_length(a, len);
+            _fmpz_poly_normalise(a);
+        }
+    }
+
+    free(r);
+}
@@ -40,6 +40,9 @@ fmpz_poly_mat_rank(const fmpz_poly_mat_t A)
     if (fmpz_poly_mat_is_empty(A))
         return 0;
 
+    if (FLINT_MIN(A->r, A->c) >= 8)
+        return fmpz_poly_mat_rank_multi_mod(A);
+
     fmpz_poly_mat_init_set(tmp, A);
     fmpz_poly_init(den);
     rank = fmpz_poly_mat_fflu(tmp, den, NULL, tmp, 0);
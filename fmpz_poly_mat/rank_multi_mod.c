@@ -0,0 +1,129 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "fmpz_poly.h"
+#include "fmpz_poly_mat.h"
+#include "nmod_poly_mat.h"
+#include "nmod_mat.h"
+#include "ulong_extras.h"
+
+typedef struct
+{
+    const nmod_poly_mat_struct * A;
+    long * rank;
+}
+_rank_multi_mod_struct;
+
+static void
+_rank_multi_mod_worker(void * arg, long i)
+{
+    _rank_multi_mod_struct * s = (_rank_multi_mod_struct *) arg;
+
+    s->rank[i] = nmod_poly_mat_rank(s->A + i);
+}
+
+/*
+    The rank modulo p never exceeds the rank over Z. If the rank modulo
+    each of several primes is at most r, every minor of size r + 1
+    vanishes modulo their product, and therefore vanishes over Z as soon
+    as the product exceeds twice the bound for such minors.
+ */
+long
+fmpz_poly_mat_rank_multi_mod(const fmpz_poly_mat_t A)
+{
+    _rank_multi_mod_struct s;
+    fmpz_comb_t comb;
+    fmpz_comb_temp_t comb_temp;
+    nmod_poly_mat_struct * mod_A;
+    mp_limb_t * primes;
+    long i, len, bits, rank, max_rank, num_primes, used;
+    mp_limb_t p;
+
+    if (fmpz_poly_mat_is_empty(A))
+        return 0;
+
+    len = fmpz_poly_mat_max_length(A);
+
+    if (len == 0)
+        return 0;
+
+    bits = FLINT_ABS(fmpz_poly_mat_max_bits(A));
+    max_rank = FLINT_MIN(A->r, A->c);
+
+    rank = 0;
+    used = 0;
+    p = 1UL << NMOD_MAT_OPTIMAL_MODULUS_BITS;
+
+    while (rank < max_rank)
+    {
+        num_primes = _fmpz_poly_mat_det_bound_bits(rank + 1, len, bits)
+                        - used * NMOD_MAT_OPTIMAL_MODULUS_BITS;
+
+        if (num_primes <= 0)
+            break;
+
+        num_primes = (num_primes + NMOD_MAT_OPTIMAL_MODULUS_BITS - 1)
+                                    / NMOD_MAT_OPTIMAL_MODULUS_BITS;
+
+        /* The first round uses a single prime, which is usually enough */
+        if (used == 0)
+            num_primes = 1;
+
+        primes = malloc(sizeof(mp_limb_t) * num_primes);
+        mod_A = malloc(sizeof(nmod_poly_mat_struct) * num_primes);
+        s.rank = malloc(sizeof(long) * num_primes);
+
+        for (i = 0; i < num_primes; i++)
+        {
+            p = n_nextprime(p, 0);
+            primes[i] = p;
+            nmod_poly_mat_init(mod_A + i, A->r, A->c, p);
+        }
+
+        fmpz_comb_init(comb, primes, num_primes);
+        fmpz_comb_temp_init(comb_temp, comb);
+
+        _fmpz_poly_mat_multi_mod_ui(mod_A, A, comb, comb_temp);
+
+        s.A = mod_A;
+        flint_parallel_do(_rank_multi_mod_worker, &s, num_primes,
+                                            flint_get_num_threads());
+
+        for (i = 0; i < num_primes; i++)
+        {
+            rank = FLINT_MAX(rank, s.rank[i]);
+            nmod_poly_mat_clear(mod_A + i);
+        }
+
+        used += num_primes;
+
+        fmpz_comb_temp_clear(comb_temp);
+        fmpz_comb_clear(comb);
+        free(s.rank);
+        free(mod_A);
+        free(primes);
+    }
+
+    return rank;
+}
@@ -0,0 +1,213 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "fmpz_poly.h"
+#include "fmpz_poly_mat.h"
+#include "nmod_poly_mat.h"
+#include "nmod_mat.h"
+#include "ulong_extras.h"
+
+typedef struct
+{
+    nmod_poly_mat_struct * X;
+    nmod_poly_mat_struct * D;
+    const nmod_poly_mat_struct * A;
+    const nmod_poly_mat_struct * B;
+    int * ok;
+}
+_solve_multi_mod_struct;
+
+/* Sets D[i] to det(A[i]) and X[i] to adj(A[i]) B[i] */
+static void
+_solve_multi_mod_worker(void * arg, long i)
+{
+    _solve_multi_mod_struct * s = (_solve_multi_mod_struct *) arg;
+
+    s->ok[i] = nmod_poly_mat_solve_interpolate(s->X + i,
+                nmod_poly_mat_entry(s->D + i, 0, 0), s->A + i, s->B + i);
+}
+
+int
+fmpz_poly_mat_solve_multi_mod(fmpz_poly_mat_t X, fmpz_poly_t den,
+                    const fmpz_poly_mat_t A, const fmpz_poly_mat_t B)
+{
+    _solve_multi_mod_struct s;
+    fmpz_comb_t comb;
+    fmpz_comb_temp_t comb_temp;
+    nmod_poly_mat_struct *mod_A, *mod_B, *mod_X, *mod_D, tmp;
+    fmpz_poly_mat_t D;
+    mp_limb_t *primes, *good_primes, p;
+    long i, n, m, len, bits, num_primes, good, base, k;
+    int * ok;
+    int result;
+
+    if (fmpz_poly_mat_is_empty(B))
+    {
+        fmpz_poly_one(den);
+        return 1;
+    }
+
+    n = A->r;
+    m = B->c;
+
+    len = fmpz_poly_mat_max_length(A);
+
+    if (len == 0)
+    {
+        fmpz_poly_zero(den);
+        return 0;
+    }
+
+    /*
+        The entries of adj(A) B are determinants of A with one column
+        replaced by a column of B, so a common bound covers them and
+        det(A).
+     */
+    len = FLINT_MAX(len, fmpz_poly_mat_max_length(B));
+    bits = FLINT_MAX(FLINT_ABS(fmpz_poly_mat_max_bits(A)),
+                     FLINT_ABS(fmpz_poly_mat_max_bits(B)));
+    bits = _fmpz_poly_mat_det_bound_bits(n, len, bits);
+
+    num_primes = (bits + NMOD_MAT_OPTIMAL_MODULUS_BITS - 1)
+                                / NMOD_MAT_OPTIMAL_MODULUS_BITS;
+
+    primes = malloc(sizeof(mp_limb_t) * num_primes);
+    good_primes = malloc(sizeof(mp_limb_t) * num_primes);
+    ok = malloc(sizeof(int) * num_primes);
+    mod_A = malloc(sizeof(nmod_poly_mat_struct) * num_primes);
+    mod_B = malloc(sizeof(nmod_poly_mat_struct) * num_primes);
+    mod_X = malloc(sizeof(nmod_poly_mat_struct) * num_primes);
+    mod_D = malloc(sizeof(nmod_poly_mat_struct) * num_primes);
+
+    /*
+        Primes modulo which A is singular are discarded and replaced in
+        the next round. If this happens for all primes of the first round,
+        det(A) vanishes modulo a product of primes exceeding its bound,
+        so A is singular.
+     */
+    good = 0;
+    p = 1UL << NMOD_MAT_OPTIMAL_MODULUS_BITS;
+    result = 1;
+
+    while (good < num_primes)
+    {
+        base = good;
+        k = num_primes - good;
+
+        for (i = 0; i < k; i++)
+        {
+            p = n_nextprime(p, 0);
+            primes[i] = p;
+            nmod_poly_mat_init(mod_A + base + i, n, n, p);
+            nmod_poly_mat_init(mod_B + base + i, n, m, p);
+            nmod_poly_mat_init(mod_X + base + i, n, m, p);
+            nmod_poly_mat_init(mod_D + base + i, 1, 1, p);
+        }
+
+        fmpz_comb_init(comb, primes, k);
+        fmpz_comb_temp_init(comb_temp, comb);
+        _fmpz_poly_mat_multi_mod_ui(mod_A + base, A, comb, comb_temp);
+        _fmpz_poly_mat_multi_mod_ui(mod_B + base, B, comb, comb_temp);
+        fmpz_comb_temp_clear(comb_temp);
+        fmpz_comb_clear(comb);
+
+        /* The systems modulo different primes are independent */
+        s.X = mod_X + base;
+        s.D = mod_D + base;
+        s.A = mod_A + base;
+        s.B = mod_B + base;
+        s.ok = ok;
+        flint_parallel_do(_solve_multi_mod_worker, &s, k,
+                                            flint_get_num_threads());
+
+        for (i = 0; i < k; i++)
+        {
+            if (ok[i])
+            {
+                good_primes[good] = primes[i];
+                tmp = mod_X[good];
+                mod_X[good] = mod_X[base + i];
+                mod_X[base + i] = tmp;
+                tmp = mod_D[good];
+                mod_D[good] = mod_D[base + i];
+                mod_D[base + i] = tmp;
+                good++;
+            }
+        }
+
+        for (i = 0; i < k; i++)
+        {
+            nmod_poly_mat_clear(mod_A + base + i);
+            nmod_poly_mat_clear(mod_B + base + i);
+        }
+
+        for (i = good; i < base + k; i++)
+        {
+            nmod_poly_mat_clear(mod_X + i);
+            nmod_poly_mat_clear(mod_D + i);
+        }
+
+        if (good == 0)
+        {
+            result = 0;
+            break;
+        }
+    }
+
+    if (result)
+    {
+        fmpz_comb_init(comb, good_primes, num_primes);
+        fmpz_comb_temp_init(comb_temp, comb);
+
+        fmpz_poly_mat_init(D, 1, 1);
+        _fmpz_poly_mat_multi_CRT_ui(D, mod_D, comb, comb_temp);
+        fmpz_poly_swap(den, fmpz_poly_mat_entry(D, 0, 0));
+        fmpz_poly_mat_clear(D);
+
+        _fmpz_poly_mat_multi_CRT_ui(X, mod_X, comb, comb_temp);
+
+        fmpz_comb_temp_clear(comb_temp);
+        fmpz_comb_clear(comb);
+
+        for (i = 0; i < num_primes; i++)
+        {
+            nmod_poly_mat_clear(mod_X + i);
+            nmod_poly_mat_clear(mod_D + i);
+        }
+    }
+    else
+    {
+        fmpz_poly_zero(den);
+    }
+
+    free(mod_A);
+    free(mod_B);
+    free(mod_X);
+    free(mod_D);
+    free(ok);
+    free(good_primes);
+    free(primes);
+
+    return result;
+}
@@ -0,0 +1,94 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "flint.h"
+#include "fmpz_poly.h"
+#include "fmpz_poly_mat.h"
+
+int
+main(void)
+{
+    flint_rand_t state;
+    long i;
+
+    printf("rank_multi_mod....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (i = 0; i < 1000; i++)
+    {
+        fmpz_poly_mat_t A, L, R, T;
+        fmpz_poly_t den;
+        long m, n, k, bits, deg, rank, rank2;
+        float density;
+
+        m = n_randint(state, 12);
+        n = n_randint(state, 12);
+        k = n_randint(state, 12);
+        deg = 1 + n_randint(state, 5);
+        bits = 1 + n_randint(state, 100);
+        density = n_randint(state, 100) * 0.01;
+
+        fmpz_poly_mat_init(A, m, n);
+
+        /* Products of thin matrices are rank deficient */
+        if (n_randint(state, 2))
+        {
+            fmpz_poly_mat_init(L, m, k);
+            fmpz_poly_mat_init(R, k, n);
+            fmpz_poly_mat_randtest_sparse(L, state, deg, bits, density);
+            fmpz_poly_mat_randtest_sparse(R, state, deg, bits, density);
+            fmpz_poly_mat_mul(A, L, R);
+            fmpz_poly_mat_clear(L);
+            fmpz_poly_mat_clear(R);
+        }
+        else
+        {
+            fmpz_poly_mat_randtest_sparse(A, state, deg, bits, density);
+        }
+
+        rank = fmpz_poly_mat_rank_multi_mod(A);
+
+        fmpz_poly_mat_init_set(T, A);
+        fmpz_poly_init(den);
+        rank2 = fmpz_poly_mat_fflu(T, den, NULL, T, 0);
+        fmpz_poly_mat_clear(T);
+        fmpz_poly_clear(den);
+
+        if (rank != rank2)
+        {
+            printf("FAIL:\n");
+            printf("A:\n");
+            fmpz_poly_mat_print(A, "x");
+            printf("rank_multi_mod: %ld, fflu: %ld\n", rank, rank2);
+            abort();
+        }
+
+        fmpz_poly_mat_clear(A);
+    }
+
+    flint_randclear(state);
+    _fmpz_cleanup();
+    printf("PASS\n");
+    return 0;
+}
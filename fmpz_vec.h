@@ -78,6 +78,14 @@ int _fmpz_vec_read(fmpz ** vec, long * len)
     return _fmpz_vec_fread(stdin, vec, len);
 }
 
+int _fmpz_vec_fwrite_bin(FILE * file, const fmpz * vec, long len,
+                                                flint_bin_header_t h);
+
+int _fmpz_vec_fread_bin(fmpz * vec, long len, FILE * file,
+                                            const flint_bin_header_t h);
+
+int _fmpz_vec_bin_promote(fmpz * vec, long len, const flint_bin_header_t h);
+
 /*  Conversions  *************************************************************/
 
 void _fmpz_vec_set_nmod_vec(fmpz * res, 
@@ -86,6 +94,12 @@ void _fmpz_vec_set_nmod_vec(fmpz * res,
 void _fmpz_vec_get_nmod_vec(mp_ptr res, 
                                     const fmpz * poly, long len, nmod_t mod);
 
+void _fmpz_vec_multi_mod_ui(mp_ptr * out, const fmpz * vec, long len,
+    const fmpz_comb_t comb);
+
+void _fmpz_vec_multi_CRT_ui(fmpz * out, mp_ptr * residues, long len,
+    const fmpz_comb_t comb, int sign);
+
 /*  Assignment and basic manipulation  ***************************************/
 
 void _fmpz_vec_set(fmpz * vec1, const fmpz * vec2, long len2);
@@ -186,11 +200,27 @@ void _fmpz_vec_prod(fmpz_t res, const fmpz * vec, long len);
 
 void _fmpz_vec_mod_fmpz(fmpz *res, const fmpz *vec, long len, const fmpz_t p);
 
+/*  Modular exponentiation  **************************************************/
+
+void _fmpz_vec_powm_precomp(fmpz * res, const fmpz * g, const fmpz * e,
+                                    long len, const fmpz_powm_ctx_t ctx);
+
+void _fmpz_vec_powm_base(fmpz * res, const fmpz * e, long len,
+                    const fmpz_powm_base_t B, const fmpz_powm_ctx_t ctx);
+
 /*  Gaussian content  ********************************************************/
 
 void _fmpz_vec_content(fmpz_t res, const fmpz * vec, long len);
 
 void _fmpz_vec_lcm(fmpz_t res, const fmpz * vec, long len);
 
+void _fmpz_vec_batch_gcd(fmpz * res, const fmpz * vec, long len,
+                                                        int out_of_core);
+
+/*  Tuning parameters  *******************************************************/
+
+/* Number of integers converted together by the multimodular functions */
+#define FMPZ_VEC_MULTI_MOD_BLOCK 8
+
 #endif
 
@@ -0,0 +1,277 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "fmpz_vec.h"
+
+/*
+    The tree levels are arrays of mpz's, so that the nodes of a level can
+    be computed in parallel without going through the memory manager.
+    Level 0 consists of read-only views of the input. The last node of a
+    level of odd length is carried up unchanged.
+ */
+
+typedef struct
+{
+    __mpz_struct * out;
+    const __mpz_struct * in;
+    long n;             /* length of in */
+    long num_tasks;
+}
+_prod_level_struct;
+
+typedef struct
+{
+    __mpz_struct * out;
+    const __mpz_struct * parent;
+    const __mpz_struct * node;
+    long n;             /* length of node */
+    int leaf;
+    long num_tasks;
+}
+_rem_level_struct;
+
+static void
+_prod_level_worker(void * arg, long k)
+{
+    _prod_level_struct * s = (_prod_level_struct *) arg;
+    long j, start, stop, m = (s->n + 1) / 2;
+
+    start = (k * m) / s->num_tasks;
+    stop = ((k + 1) * m) / s->num_tasks;
+
+    for (j = start; j < stop; j++)
+    {
+        if (2 * j + 1 < s->n)
+            mpz_mul(s->out + j, s->in + 2 * j, s->in + 2 * j + 1);
+        else
+            mpz_set(s->out + j, s->in + 2 * j);
+    }
+}
+
+/*
+    Reduces the remainder of each parent modulo the square of its children;
+    at the leaves x, the remainder r = P mod x^2 then gives gcd(x, P / x)
+    as gcd(x, r / x)
+ */
+static void
+_rem_level_worker(void * arg, long k)
+{
+    _rem_level_struct * s = (_rem_level_struct *) arg;
+    long j, start, stop;
+    mpz_t t;
+
+    start = (k * s->n) / s->num_tasks;
+    stop = ((k + 1) * s->n) / s->num_tasks;
+
+    mpz_init(t);
+
+    for (j = start; j < stop; j++)
+    {
+        mpz_mul(t, s->node + j, s->node + j);
+        mpz_mod(s->out + j, s->parent + j / 2, t);
+
+        if (s->leaf)
+        {
+            mpz_divexact(s->out + j, s->out + j, s->node + j);
+            mpz_gcd(s->out + j, s->out + j, s->node + j);
+        }
+    }
+
+    mpz_clear(t);
+}
+
+static __mpz_struct *
+_mpz_vec_init(long len)
+{
+    __mpz_struct * v = malloc(len * sizeof(__mpz_struct));
+    long i;
+
+    for (i = 0; i < len; i++)
+        mpz_init(v + i);
+
+    return v;
+}
+
+static void
+_mpz_vec_clear(__mpz_struct * v, long len)
+{
+    long i;
+
+    for (i = 0; i < len; i++)
+        mpz_clear(v + i);
+
+    free(v);
+}
+
+static void
+_batch_gcd_write_level(FILE * file, const __mpz_struct * v, long len)
+{
+    long i;
+
+    for (i = 0; i < len; i++)
+    {
+        if (mpz_out_raw(file, v + i) == 0)
+        {
+            printf("Exception (_fmpz_vec_batch_gcd).  Write failed.\n");
+            abort();
+        }
+    }
+
+    rewind(file);
+}
+
+static void
+_batch_gcd_read_level(__mpz_struct * v, FILE * file, long len)
+{
+    long i;
+
+    for (i = 0; i < len; i++)
+    {
+        if (mpz_inp_raw(v + i, file) == 0)
+        {
+            printf("Exception (_fmpz_vec_batch_gcd).  Read failed.\n");
+            abort();
+        }
+    }
+}
+
+void
+_fmpz_vec_batch_gcd(fmpz * res, const fmpz * vec, long len, int out_of_core)
+{
+    __mpz_struct ** T, * R, * node;
+    mp_limb_t * limbs;
+    FILE ** files;
+    long * n;
+    long i, l, depth, num_threads;
+
+    if (len <= 1)
+    {
+        if (len == 1)
+            fmpz_one(res);
+        return;
+    }
+
+    for (i = 0; i < len; i++)
+    {
+        if (fmpz_is_zero(vec + i))
+        {
+            printf("Exception (_fmpz_vec_batch_gcd).  Zero entry.\n");
+            abort();
+        }
+    }
+
+    num_threads = flint_get_num_threads();
+
+    for (depth = 0, l = len; l > 1; l = (l + 1) / 2)
+        depth++;
+
+    T = malloc((depth + 1) * sizeof(__mpz_struct *));
+    n = malloc((depth + 1) * sizeof(long));
+    files = malloc((depth + 1) * sizeof(FILE *));
+
+    /* Level 0 views the absolute values of the input */
+    limbs = malloc(len * sizeof(mp_limb_t));
+    T[0] = malloc(len * sizeof(__mpz_struct));
+    n[0] = len;
+    for (i = 0; i < len; i++)
+    {
+        _fmpz_get_mpz_view(T[0] + i, limbs + i, vec + i);
+        T[0][i]._mp_size = FLINT_ABS(T[0][i]._mp_size);
+    }
+
+    /* Product tree */
+    for (l = 0; l < depth; l++)
+    {
+        _prod_level_struct s;
+
+        n[l + 1] = (n[l] + 1) / 2;
+        T[l + 1] = _mpz_vec_init(n[l + 1]);
+
+        s.out = T[l + 1];
+        s.in = T[l];
+        s.n = n[l];
+        s.num_tasks = FLINT_MIN(num_threads, n[l + 1]);
+
+        flint_parallel_do(_prod_level_worker, &s, s.num_tasks, num_threads);
+
+        /* Only the level being multiplied out stays in memory */
+        if (out_of_core && l > 0)
+        {
+            files[l] = tmpfile();
+            if (files[l] == NULL)
+            {
+                printf("Exception (_fmpz_vec_batch_gcd).  "
+                       "Could not create temporary file.\n");
+                abort();
+            }
+
+            _batch_gcd_write_level(files[l], T[l], n[l]);
+            _mpz_vec_clear(T[l], n[l]);
+        }
+    }
+
+    /* Remainder tree; the remainder at the root is the product itself */
+    R = T[depth];
+
+    for (l = depth - 1; l >= 0; l--)
+    {
+        _rem_level_struct s;
+
+        if (out_of_core && l > 0)
+        {
+            node = _mpz_vec_init(n[l]);
+            _batch_gcd_read_level(node, files[l], n[l]);
+            fclose(files[l]);
+        }
+        else
+            node = T[l];
+
+        s.out = _mpz_vec_init(n[l]);
+        s.parent = R;
+        s.node = node;
+        s.n = n[l];
+        s.leaf = (l == 0);
+        s.num_tasks = FLINT_MIN(num_threads, n[l]);
+
+        flint_parallel_do(_rem_level_worker, &s, s.num_tasks, num_threads);
+
+        _mpz_vec_clear(R, n[l + 1]);
+        if (l > 0)
+            _mpz_vec_clear(node, n[l]);
+
+        R = s.out;
+    }
+
+    for (i = 0; i < len; i++)
+        fmpz_set_mpz(res + i, R + i);
+
+    _mpz_vec_clear(R, len);
+    free(T[0]);
+    free(limbs);
+    free(T);
+    free(n);
+    free(files);
+}
@@ -0,0 +1,66 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <mpir.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "fmpz_vec.h"
+
+int
+_fmpz_vec_bin_promote(fmpz * vec, long len, const flint_bin_header_t h)
+{
+    __mpz_struct * m;
+    mp_srcptr index, limbs;
+    mp_limb_t total;
+    long i, k, n, size;
+
+    index = (mp_srcptr) (vec + len);
+    limbs = index + 2 * h->num_big;
+
+    if (h->num_big > (mp_limb_t) len)
+        return 0;
+
+    for (k = 0, total = 0; k < h->num_big; k++)
+    {
+        i = index[2 * k];
+        n = (long) index[2 * k + 1];
+        size = FLINT_ABS(n);
+
+        if (index[2 * k] >= (mp_limb_t) len || vec[i] != 0L
+            || size <= 0 || (mp_limb_t) size > h->num_limbs - total
+            || limbs[size - 1] == 0UL)
+        {
+            /* Release the promotions done so far */
+            _fmpz_vec_zero(vec, len);
+            return 0;
+        }
+
+        total += size;
+        m = _fmpz_promote(vec + i);
+        mpz_realloc2(m, size * FLINT_BITS);
+        mpn_copyi(m->_mp_d, limbs, size);
+        m->_mp_size = n;
+        _fmpz_demote_val(vec + i);
+
+        limbs += size;
+    }
+
+    return 1;
+}
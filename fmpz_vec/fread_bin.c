@@ -0,0 +1,95 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <mpir.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "fmpz_vec.h"
+
+int
+_fmpz_vec_fread_bin(fmpz * vec, long len, FILE * file,
+                                            const flint_bin_header_t h)
+{
+    __mpz_struct * m;
+    mp_ptr index = NULL;
+    mp_limb_t limbs;
+    long i, k, n, size;
+
+    _fmpz_vec_zero(vec, len);
+
+    if (h->num_big > (mp_limb_t) len)
+        return 0;
+
+    /* Small entries are read in place; the slots of large ones are zero */
+    if (!flint_bin_read_limbs((mp_ptr) vec, len, file, h))
+    {
+        mpn_zero((mp_ptr) vec, len);
+        return 0;
+    }
+
+    /* Values out of range must be cleared before they are taken for mpz's */
+    for (i = 0; i < len; i++)
+    {
+        if (vec[i] < COEFF_MIN || vec[i] > COEFF_MAX)
+        {
+            mpn_zero((mp_ptr) vec, len);
+            return 0;
+        }
+    }
+
+    index = malloc(2 * h->num_big * sizeof(mp_limb_t) + 1);
+    if (!flint_bin_read_limbs(index, 2 * h->num_big, file, h))
+        goto fail;
+
+    for (k = 0, limbs = 0; k < h->num_big; k++)
+    {
+        i = index[2 * k];
+        n = (long) index[2 * k + 1];
+        size = FLINT_ABS(n);
+
+        if (index[2 * k] >= (mp_limb_t) len || vec[i] != 0L
+            || size <= 0 || (mp_limb_t) size > h->num_limbs - limbs)
+            goto fail;
+
+        limbs += size;
+        m = _fmpz_promote(vec + i);
+        mpz_realloc2(m, size * FLINT_BITS);
+
+        if (!flint_bin_read_limbs(m->_mp_d, size, file, h)
+            || m->_mp_d[size - 1] == 0UL)
+        {
+            _fmpz_demote(vec + i);
+            goto fail;
+        }
+
+        m->_mp_size = n;
+        _fmpz_demote_val(vec + i);
+    }
+
+    free(index);
+    return 1;
+
+fail:
+    _fmpz_vec_zero(vec, len);
+    free(index);
+    return 0;
+}
@@ -0,0 +1,97 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdio.h>
+#include <mpir.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "fmpz_vec.h"
+
+#define BUFFER_LIMBS 256
+
+int
+_fmpz_vec_fwrite_bin(FILE * file, const fmpz * vec, long len,
+                                                flint_bin_header_t h)
+{
+    mp_limb_t buf[BUFFER_LIMBS];
+    __mpz_struct * m;
+    long i, n;
+
+    h->num_big = 0;
+    h->num_limbs = 0;
+
+    for (i = 0; i < len; i++)
+    {
+        if (COEFF_IS_MPZ(vec[i]))
+        {
+            h->num_big++;
+            h->num_limbs += mpz_size(COEFF_TO_PTR(vec[i]));
+        }
+    }
+
+    if (!flint_bin_write_header(file, h))
+        return 0;
+
+    /* Values of small entries */
+    for (i = 0, n = 0; i < len; i++)
+    {
+        buf[n++] = COEFF_IS_MPZ(vec[i]) ? 0UL : (mp_limb_t) vec[i];
+
+        if (n == BUFFER_LIMBS)
+        {
+            if (!flint_bin_write_limbs(file, buf, n))
+                return 0;
+            n = 0;
+        }
+    }
+
+    /* Index of large entries */
+    for (i = 0; i < len; i++)
+    {
+        if (COEFF_IS_MPZ(vec[i]))
+        {
+            if (n + 2 > BUFFER_LIMBS)
+            {
+                if (!flint_bin_write_limbs(file, buf, n))
+                    return 0;
+                n = 0;
+            }
+
+            buf[n++] = i;
+            buf[n++] = (mp_limb_t) (long) COEFF_TO_PTR(vec[i])->_mp_size;
+        }
+    }
+
+    if (!flint_bin_write_limbs(file, buf, n))
+        return 0;
+
+    /* Limbs of large entries */
+    for (i = 0; i < len; i++)
+    {
+        if (COEFF_IS_MPZ(vec[i]))
+        {
+            m = COEFF_TO_PTR(vec[i]);
+            if (!flint_bin_write_limbs(file, m->_mp_d, mpz_size(m)))
+                return 0;
+        }
+    }
+
+    return 1;
+}
@@ -0,0 +1,232 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "ulong_extras.h"
+#include "fmpz.h"
+#include "fmpz_vec.h"
+#include "nmod_vec.h"
+
+typedef struct
+{
+    fmpz * out;
+    mp_ptr * residues;
+    long len;
+    const fmpz_comb_struct * comb;
+    int sign;
+    long num_tasks;
+}
+_multi_CRT_struct;
+
+/*
+    Reconstructs out[0], ..., out[len - 1], len <= FMPZ_VEC_MULTI_MOD_BLOCK,
+    from residues[i][0], ..., residues[i][len - 1], combining one level of
+    the comb at a time for the whole block. The level l of T holds the
+    values of the block modulo the nodes of level l of the comb.
+ */
+static void
+_fmpz_vec_multi_CRT_ui_block(__mpz_struct ** out, mp_ptr * residues,
+    long len, const fmpz_comb_struct * comb, int sign, __mpz_struct ** T,
+    mpz_t t, mpz_t t2)
+{
+    __mpz_struct ML, MR, R, * A, * B;
+    mp_limb_t ML_limb, MR_limb, R_limb, inv, u;
+    long i, j, b, l, num;
+    long n = comb->n, num_primes = comb->num_primes;
+    nmod_t mod;
+
+    /* First layer of reconstruction */
+    for (i = 0, j = 0; i + 2 <= num_primes; i += 2, j++)
+    {
+        mod = comb->mod[i + 1];
+        inv = fmpz_get_ui(comb->res[0] + j);
+
+        for (b = 0; b < len; b++)
+        {
+            u = n_mod2_preinv(residues[i][b], mod.n, mod.ninv);
+            u = nmod_sub(residues[i + 1][b], u, mod);
+            u = nmod_mul(u, inv, mod);
+
+            mpz_set_ui(T[0] + j * len + b, u);
+            mpz_mul_ui(T[0] + j * len + b, T[0] + j * len + b,
+                                                        comb->primes[i]);
+            mpz_add_ui(T[0] + j * len + b, T[0] + j * len + b,
+                                                        residues[i][b]);
+        }
+    }
+
+    if (i < num_primes)
+        for (b = 0; b < len; b++)
+            mpz_set_ui(T[0] + j * len + b, residues[i][b]);
+
+    /* Compute other layers of reconstruction */
+    for (l = 1, num = 1L << (n - 1); l < n; l++, num /= 2)
+    {
+        for (i = 0, j = 0; i < num; i += 2, j++)
+        {
+            if (fmpz_is_one(comb->comb[l - 1] + i + 1))
+            {
+                if (!fmpz_is_one(comb->comb[l - 1] + i))
+                    for (b = 0; b < len; b++)
+                        mpz_swap(T[l] + j * len + b, T[l - 1] + i * len + b);
+                continue;
+            }
+
+            _fmpz_get_mpz_view(&ML, &ML_limb, comb->comb[l - 1] + i);
+            _fmpz_get_mpz_view(&MR, &MR_limb, comb->comb[l - 1] + i + 1);
+            _fmpz_get_mpz_view(&R, &R_limb, comb->res[l] + j);
+
+            for (b = 0; b < len; b++)
+            {
+                A = T[l - 1] + i * len + b;
+                B = T[l - 1] + (i + 1) * len + b;
+
+                mpz_fdiv_r(t2, A, &MR);
+                mpz_sub(t, B, t2);
+                mpz_mul(t2, t, &R);
+                mpz_fdiv_r(t, t2, &MR);
+                mpz_mul(t2, t, &ML);
+                mpz_add(T[l] + j * len + b, t2, A);
+            }
+        }
+    }
+
+    /* Write out the output */
+    for (b = 0; b < len; b++)
+    {
+        A = T[n - 1] + b;
+
+        if (sign)
+        {
+            _fmpz_get_mpz_view(&ML, &ML_limb, comb->comb[n - 1]);
+            mpz_sub(t, A, &ML);
+            if (mpz_cmpabs(t, A) <= 0)
+                mpz_swap(t, A);
+        }
+
+        mpz_swap(out[b], A);
+    }
+}
+
+static void
+_multi_CRT_worker(void * arg, long k)
+{
+    _multi_CRT_struct * s = (_multi_CRT_struct *) arg;
+    const fmpz_comb_struct * comb = s->comb;
+    long i, l, b, start, stop, num_primes = comb->num_primes;
+    __mpz_struct * out[FMPZ_VEC_MULTI_MOD_BLOCK];
+    __mpz_struct ** T;
+    mp_ptr * residues;
+    mpz_t t, t2;
+
+    start = (k * s->len) / s->num_tasks;
+    stop = ((k + 1) * s->len) / s->num_tasks;
+
+    /* The output is less than a single prime */
+    if (num_primes == 1)
+    {
+        mp_limb_t r, p = comb->primes[0];
+
+        for (i = start; i < stop; i++)
+        {
+            r = s->residues[0][i];
+
+            if (s->sign && p - r < r)
+                mpz_set_si(COEFF_TO_PTR(s->out[i]), (long) (r - p));
+            else
+                mpz_set_ui(COEFF_TO_PTR(s->out[i]), r);
+        }
+        return;
+    }
+
+    residues = malloc(num_primes * sizeof(mp_ptr));
+    mpz_init(t);
+    mpz_init(t2);
+
+    T = malloc(comb->n * sizeof(__mpz_struct *));
+    for (l = 0; l < comb->n; l++)
+    {
+        T[l] = malloc((FMPZ_VEC_MULTI_MOD_BLOCK << (comb->n - l - 1))
+                                                * sizeof(__mpz_struct));
+        for (i = 0; i < (FMPZ_VEC_MULTI_MOD_BLOCK << (comb->n - l - 1)); i++)
+            mpz_init(T[l] + i);
+    }
+
+    for ( ; start < stop; start += b)
+    {
+        b = FLINT_MIN(FMPZ_VEC_MULTI_MOD_BLOCK, stop - start);
+
+        for (i = 0; i < num_primes; i++)
+            residues[i] = s->residues[i] + start;
+        for (i = 0; i < b; i++)
+            out[i] = COEFF_TO_PTR(s->out[start + i]);
+
+        _fmpz_vec_multi_CRT_ui_block(out, residues, b, comb, s->sign, T,
+                                                                    t, t2);
+    }
+
+    for (l = 0; l < comb->n; l++)
+    {
+        for (i = 0; i < (FMPZ_VEC_MULTI_MOD_BLOCK << (comb->n - l - 1)); i++)
+            mpz_clear(T[l] + i);
+        free(T[l]);
+    }
+
+    free(T);
+    mpz_clear(t);
+    mpz_clear(t2);
+    free(residues);
+}
+
+void
+_fmpz_vec_multi_CRT_ui(fmpz * out, mp_ptr * residues, long len,
+    const fmpz_comb_t comb, int sign)
+{
+    _multi_CRT_struct s;
+    long i, num_threads;
+
+    if (len == 0)
+        return;
+
+    num_threads = flint_get_num_threads();
+
+    /*
+        The memory manager is not thread-safe, so the outputs are made
+        into mpz's beforehand, which the workers then write to directly
+     */
+    for (i = 0; i < len; i++)
+        _fmpz_promote(out + i);
+
+    s.out = out;
+    s.residues = residues;
+    s.len = len;
+    s.comb = comb;
+    s.sign = sign;
+    s.num_tasks = FLINT_MIN(num_threads,
+        (len + FMPZ_VEC_MULTI_MOD_BLOCK - 1) / FMPZ_VEC_MULTI_MOD_BLOCK);
+
+    flint_parallel_do(_multi_CRT_worker, &s, s.num_tasks, num_threads);
+
+    for (i = 0; i < len; i++)
+        _fmpz_demote_val(out + i);
+}
@@ -0,0 +1,173 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "fmpz_vec.h"
+
+typedef struct
+{
+    mp_ptr * out;
+    const fmpz * vec;
+    long len;
+    const fmpz_comb_struct * comb;
+    long num_tasks;
+}
+_multi_mod_struct;
+
+/*
+    Reduces vec[0], ..., vec[len - 1], len <= FMPZ_VEC_MULTI_MOD_BLOCK,
+    modulo the primes of the comb, one level of the comb at a time, so
+    that each node is used for the whole block while it is in cache.
+    The level l of T holds the remainders of the block modulo the nodes
+    of level l of the comb, node by node.
+ */
+static void
+_fmpz_vec_multi_mod_ui_block(mp_ptr * out, const fmpz * vec, long len,
+    const fmpz_comb_struct * comb, __mpz_struct ** T)
+{
+    __mpz_struct X[FMPZ_VEC_MULTI_MOD_BLOCK], m;
+    mp_limb_t X_limb[FMPZ_VEC_MULTI_MOD_BLOCK], m_limb;
+    __mpz_struct * src;
+    long i, j, k, b, l, top, num, stride, bits;
+    long n = comb->n, num_primes = comb->num_primes;
+
+    for (b = 0; b < len; b++)
+        _fmpz_get_mpz_view(X + b, X_limb + b, vec + b);
+
+    /* Find level in comb with entries bigger than the input integers */
+    bits = FLINT_ABS(_fmpz_vec_max_bits(vec, len));
+    top = 0;
+    while (top < n - 1 && fmpz_bits(comb->comb[top]) <= bits)
+        top++;
+
+    for (l = top - 1; l > FLINT_FMPZ_LOG_MULTI_MOD_CUTOFF; l--)
+    {
+        num = 1L << (n - l - 1);
+
+        for (i = 0; i < num; i++)
+        {
+            _fmpz_get_mpz_view(&m, &m_limb, comb->comb[l] + i);
+
+            for (b = 0; b < len; b++)
+            {
+                src = (l == top - 1) ? X + b : T[l + 1] + (i / 2) * len + b;
+                mpz_fdiv_r(T[l] + i * len + b, src, &m);
+            }
+        }
+    }
+
+    /* Do basecase */
+    l++;
+    stride = 1L << (l + 1);
+
+    for (i = 0, j = 0; j < num_primes; i++, j += stride)
+    {
+        for (k = j; k < FLINT_MIN(j + stride, num_primes); k++)
+        {
+            for (b = 0; b < len; b++)
+            {
+                src = (l == top) ? X + b : T[l] + i * len + b;
+                out[k][b] = mpz_fdiv_ui(src, comb->primes[k]);
+            }
+        }
+    }
+}
+
+static void
+_multi_mod_worker(void * arg, long t)
+{
+    _multi_mod_struct * s = (_multi_mod_struct *) arg;
+    const fmpz_comb_struct * comb = s->comb;
+    long i, l, b, start, stop, num_primes = comb->num_primes;
+    __mpz_struct ** T;
+    mp_ptr * out;
+
+    start = (t * s->len) / s->num_tasks;
+    stop = ((t + 1) * s->len) / s->num_tasks;
+
+    out = malloc(num_primes * sizeof(mp_ptr));
+
+    if (num_primes == 1)
+    {
+        for (i = start; i < stop; i++)
+            s->out[0][i] = fmpz_fdiv_ui(s->vec + i, comb->primes[0]);
+        free(out);
+        return;
+    }
+
+    T = malloc(comb->n * sizeof(__mpz_struct *));
+    for (l = 0; l < comb->n; l++)
+    {
+        T[l] = malloc((FMPZ_VEC_MULTI_MOD_BLOCK << (comb->n - l - 1))
+                                                * sizeof(__mpz_struct));
+        for (i = 0; i < (FMPZ_VEC_MULTI_MOD_BLOCK << (comb->n - l - 1)); i++)
+            mpz_init(T[l] + i);
+    }
+
+    for ( ; start < stop; start += b)
+    {
+        b = FLINT_MIN(FMPZ_VEC_MULTI_MOD_BLOCK, stop - start);
+
+        for (i = 0; i < num_primes; i++)
+            out[i] = s->out[i] + start;
+
+        _fmpz_vec_multi_mod_ui_block(out, s->vec + start, b, comb, T);
+    }
+
+    for (l = 0; l < comb->n; l++)
+    {
+        for (i = 0; i < (FMPZ_VEC_MULTI_MOD_BLOCK << (comb->n - l - 1)); i++)
+            mpz_clear(T[l] + i);
+        free(T[l]);
+    }
+
+    free(T);
+    free(out);
+}
+
+void
+_fmpz_vec_multi_mod_ui(mp_ptr * out, const fmpz * vec, long len,
+    const fmpz_comb_t comb)
+{
+    _multi_mod_struct s;
+    long num_threads;
+
+    if (len == 0)
+        return;
+
+    num_threads = flint_get_num_threads();
+
+    s.out = out;
+    s.vec = vec;
+    s.len = len;
+    s.comb = comb;
+    s.num_tasks = FLINT_MIN(num_threads,
+        (len + FMPZ_VEC_MULTI_MOD_BLOCK - 1) / FMPZ_VEC_MULTI_MOD_BLOCK);
+
+    /*
+        The workers only read from fmpz's, so that the memory manager,
+        which is not thread-safe, is not used in parallel
+     */
+    flint_parallel_do(_multi_mod_worker, &s, s.num_tasks, num_threads);
+}
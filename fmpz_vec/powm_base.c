@@ -0,0 +1,88 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "fmpz.h"
+#include "fmpz_vec.h"
+
+typedef struct
+{
+    fmpz * res;
+    const fmpz * e;
+    long len;
+    const fmpz_powm_base_struct * B;
+    const fmpz_powm_ctx_struct * ctx;
+    long num_tasks;
+}
+_vec_powm_base_struct;
+
+static void
+_vec_powm_base_worker(void * arg, long k)
+{
+    _vec_powm_base_struct * s = (_vec_powm_base_struct *) arg;
+    __mpz_struct ev, *ep;
+    mp_limb_t el;
+    long i, start, stop;
+
+    start = (k * s->len) / s->num_tasks;
+    stop = ((k + 1) * s->len) / s->num_tasks;
+
+    for (i = start; i < stop; i++)
+    {
+        if (COEFF_IS_MPZ(s->e[i]))
+            ep = COEFF_TO_PTR(s->e[i]);
+        else
+            _fmpz_get_mpz_view(ep = &ev, &el, s->e + i);
+
+        _fmpz_powm_base(COEFF_TO_PTR(s->res[i]), ep, s->B, s->ctx);
+    }
+}
+
+void
+_fmpz_vec_powm_base(fmpz * res, const fmpz * e, long len,
+                    const fmpz_powm_base_t B, const fmpz_powm_ctx_t ctx)
+{
+    _vec_powm_base_struct s;
+    long i, num_threads;
+
+    if (len == 0)
+        return;
+
+    num_threads = flint_get_num_threads();
+
+    /* The workers write to the outputs as mpz's, see _fmpz_vec_multi_CRT_ui */
+    for (i = 0; i < len; i++)
+        _fmpz_promote_val(res + i);
+
+    s.res = res;
+    s.e = e;
+    s.len = len;
+    s.B = B;
+    s.ctx = ctx;
+    s.num_tasks = FLINT_MIN(num_threads, len);
+
+    flint_parallel_do(_vec_powm_base_worker, &s, s.num_tasks, num_threads);
+
+    for (i = 0; i < len; i++)
+        _fmpz_demote_val(res + i);
+}
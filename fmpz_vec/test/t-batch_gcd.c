@@ -0,0 +1,110 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "ulong_extras.h"
+#include "fmpz.h"
+#include "fmpz_vec.h"
+
+int
+main(void)
+{
+    int i, result;
+    flint_rand_t state;
+
+    printf("batch_gcd....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    /* Compare with the gcd with the product of the other entries */
+    for (i = 0; i < 2000; i++)
+    {
+        fmpz *a, *b, *c;
+        fmpz_t p;
+        long j, k, len;
+
+        len = n_randint(state, 40);
+
+        a = _fmpz_vec_init(len);
+        b = _fmpz_vec_init(len);
+        c = _fmpz_vec_init(len);
+        fmpz_init(p);
+
+        for (j = 0; j < len; j++)
+        {
+            do fmpz_randtest(a + j, state, 100);
+            while (fmpz_is_zero(a + j));
+        }
+
+        /* Plant some common factors */
+        for (k = n_randint(state, 4); k > 0 && len > 0; k--)
+        {
+            fmpz_randtest_not_zero(p, state, 60);
+            fmpz_mul(a + n_randint(state, len), a + n_randint(state, len), p);
+            fmpz_mul(a + n_randint(state, len), a + n_randint(state, len), p);
+        }
+
+        for (j = 0; j < len; j++)
+        {
+            fmpz_one(p);
+            for (k = 0; k < len; k++)
+                if (k != j)
+                    fmpz_mul(p, p, a + k);
+            fmpz_gcd(c + j, a + j, p);
+        }
+
+        flint_set_num_threads(n_randint(state, 4) + 1);
+        if (n_randint(state, 2))
+        {
+            _fmpz_vec_batch_gcd(b, a, len, n_randint(state, 2));
+        }
+        else
+        {
+            _fmpz_vec_set(b, a, len);
+            _fmpz_vec_batch_gcd(b, b, len, n_randint(state, 2));
+        }
+        flint_set_num_threads(1);
+
+        result = _fmpz_vec_equal(b, c, len);
+        if (!result)
+        {
+            printf("FAIL:\n");
+            _fmpz_vec_print(a, len), printf("\n\n");
+            _fmpz_vec_print(b, len), printf("\n\n");
+            _fmpz_vec_print(c, len), printf("\n\n");
+            abort();
+        }
+
+        _fmpz_vec_clear(a, len);
+        _fmpz_vec_clear(b, len);
+        _fmpz_vec_clear(c, len);
+        fmpz_clear(p);
+    }
+
+    flint_randclear(state);
+    _fmpz_cleanup();
+    printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,125 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "ulong_extras.h"
+#include "fmpz.h"
+#include "fmpz_vec.h"
+
+int
+main(void)
+{
+    int result;
+    long i, j, len, num_primes;
+    fmpz * a, * b;
+    fmpz_t M;
+    mp_limb_t * primes;
+    mp_ptr * res;
+    const fmpz_comb_struct * comb;
+    flint_rand_t state;
+
+    printf("multi_CRT_ui....");
+    fflush(stdout);
+
+    flint_randinit(state);
+    fmpz_init(M);
+
+    for (i = 0; i < 1000; i++)
+    {
+        int sign = n_randint(state, 2);
+
+        len = n_randint(state, 50);
+        num_primes = n_randint(state, 40) + 1;
+
+        primes = malloc(num_primes * sizeof(mp_limb_t));
+        primes[0] = n_nextprime(n_randbits(state,
+                                n_randint(state, FLINT_BITS - 2) + 2), 0);
+        for (j = 1; j < num_primes; j++)
+            primes[j] = n_nextprime(primes[j - 1], 0);
+
+        fmpz_set_ui(M, 1UL);
+        for (j = 0; j < num_primes; j++)
+            fmpz_mul_ui(M, M, primes[j]);
+
+        /* Random integers in [0, M) or [-M/2, M/2] */
+        a = _fmpz_vec_init(len);
+        b = _fmpz_vec_init(len);
+        for (j = 0; j < len; j++)
+        {
+            fmpz_randm(a + j, state, M);
+            if (sign)
+            {
+                fmpz_mul_2exp(b + j, a + j, 1);
+                if (fmpz_cmp(b + j, M) > 0)
+                    fmpz_sub(a + j, a + j, M);
+            }
+        }
+        _fmpz_vec_randtest(b, state, len, 200);
+
+        res = malloc(num_primes * sizeof(mp_ptr));
+        for (j = 0; j < num_primes; j++)
+            res[j] = malloc((len + 1) * sizeof(mp_limb_t));
+
+        /* Cached combs are shared between calls */
+        comb = fmpz_comb_cache_get(primes, num_primes);
+        result = (comb == fmpz_comb_cache_get(primes, num_primes));
+        if (!result)
+        {
+            printf("FAIL (cache):\n");
+            abort();
+        }
+
+        flint_set_num_threads(n_randint(state, 4) + 1);
+        _fmpz_vec_multi_mod_ui(res, a, len, comb);
+        _fmpz_vec_multi_CRT_ui(b, res, len, comb, sign);
+        flint_set_num_threads(1);
+
+        fmpz_comb_cache_release(comb);
+        fmpz_comb_cache_release(comb);
+
+        result = _fmpz_vec_equal(a, b, len);
+        if (!result)
+        {
+            printf("FAIL:\n");
+            printf("num_primes = %ld, sign = %d\n", num_primes, sign);
+            _fmpz_vec_print(a, len), printf("\n\n");
+            _fmpz_vec_print(b, len), printf("\n\n");
+            abort();
+        }
+
+        for (j = 0; j < num_primes; j++)
+            free(res[j]);
+        free(res);
+        free(primes);
+        _fmpz_vec_clear(a, len);
+        _fmpz_vec_clear(b, len);
+    }
+
+    fmpz_comb_cache_clear();
+    fmpz_clear(M);
+    flint_randclear(state);
+    _fmpz_cleanup();
+    printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,107 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "ulong_extras.h"
+#include "fmpz.h"
+#include "fmpz_vec.h"
+
+int
+main(void)
+{
+    int result;
+    long i, j, k, len, num_primes;
+    fmpz * a;
+    mp_limb_t * primes, * r;
+    mp_ptr * out;
+    fmpz_comb_t comb;
+    fmpz_comb_temp_t comb_temp;
+    flint_rand_t state;
+
+    printf("multi_mod_ui....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (i = 0; i < 1000; i++)
+    {
+        len = n_randint(state, 50);
+        num_primes = n_randint(state, 40) + 1;
+
+        primes = malloc(num_primes * sizeof(mp_limb_t));
+        primes[0] = n_nextprime(n_randbits(state,
+                                n_randint(state, FLINT_BITS - 2) + 2), 0);
+        for (j = 1; j < num_primes; j++)
+            primes[j] = n_nextprime(primes[j - 1], 0);
+
+        a = _fmpz_vec_init(len);
+        _fmpz_vec_randtest(a, state, len, n_randint(state, 3000) + 1);
+
+        out = malloc(num_primes * sizeof(mp_ptr));
+        for (j = 0; j < num_primes; j++)
+            out[j] = malloc((len + 1) * sizeof(mp_limb_t));
+        r = malloc(num_primes * sizeof(mp_limb_t));
+
+        fmpz_comb_init(comb, primes, num_primes);
+        fmpz_comb_temp_init(comb_temp, comb);
+
+        flint_set_num_threads(n_randint(state, 4) + 1);
+        _fmpz_vec_multi_mod_ui(out, a, len, comb);
+        flint_set_num_threads(1);
+
+        for (k = 0; k < len; k++)
+        {
+            fmpz_multi_mod_ui(r, a + k, comb, comb_temp);
+
+            for (j = 0; j < num_primes; j++)
+            {
+                result = (out[j][k] == r[j]);
+                if (!result)
+                {
+                    printf("FAIL:\n");
+                    printf("k = %ld, j = %ld, num_primes = %ld\n",
+                                                        k, j, num_primes);
+                    fmpz_print(a + k), printf("\n");
+                    printf("%lu %lu\n", out[j][k], r[j]);
+                    abort();
+                }
+            }
+        }
+
+        fmpz_comb_temp_clear(comb_temp);
+        fmpz_comb_clear(comb);
+
+        for (j = 0; j < num_primes; j++)
+            free(out[j]);
+        free(out);
+        free(r);
+        free(primes);
+        _fmpz_vec_clear(a, len);
+    }
+
+    flint_randclear(state);
+    _fmpz_cleanup();
+    printf("PASS\n");
+    return 0;
+}
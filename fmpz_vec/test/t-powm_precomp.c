@@ -0,0 +1,136 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "ulong_extras.h"
+#include "fmpz.h"
+#include "fmpz_vec.h"
+
+int
+main(void)
+{
+    int i, result;
+    flint_rand_t state;
+
+    printf("powm_precomp....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    /* Compare with fmpz_powm, for variable and fixed bases */
+    for (i = 0; i < 1000; i++)
+    {
+        fmpz *g, *e, *r, *s;
+        fmpz_t a, m;
+        fmpz_powm_ctx_t ctx;
+        fmpz_powm_base_t B;
+        long j, len;
+
+        len = n_randint(state, 20);
+
+        g = _fmpz_vec_init(len);
+        e = _fmpz_vec_init(len);
+        r = _fmpz_vec_init(len);
+        s = _fmpz_vec_init(len);
+        fmpz_init(a);
+        fmpz_init(m);
+
+        fmpz_randtest_not_zero(m, state, 200);
+        fmpz_abs(m, m);
+        if (n_randint(state, 4) != 0 && fmpz_is_even(m))
+            fmpz_add_ui(m, m, 1);
+        fmpz_randtest(a, state, 200);
+
+        for (j = 0; j < len; j++)
+        {
+            fmpz_randtest(g + j, state, 200);
+            fmpz_randtest_unsigned(e + j, state, 200);
+        }
+
+        fmpz_powm_ctx_init(ctx, m);
+        fmpz_powm_base_init(B, a, 150, ctx);
+
+        flint_set_num_threads(n_randint(state, 4) + 1);
+        _fmpz_vec_powm_precomp(r, g, e, len, ctx);
+        flint_set_num_threads(1);
+
+        for (j = 0; j < len; j++)
+            fmpz_powm(s + j, g + j, e + j, m);
+
+        result = _fmpz_vec_equal(r, s, len);
+        if (!result)
+        {
+            printf("FAIL (variable base):\n");
+            _fmpz_vec_print(r, len), printf("\n\n");
+            _fmpz_vec_print(s, len), printf("\n\n");
+            abort();
+        }
+
+        flint_set_num_threads(n_randint(state, 4) + 1);
+        _fmpz_vec_powm_base(r, e, len, B, ctx);
+        flint_set_num_threads(1);
+
+        for (j = 0; j < len; j++)
+            fmpz_powm(s + j, a, e + j, m);
+
+        result = _fmpz_vec_equal(r, s, len);
+        if (!result)
+        {
+            printf("FAIL (fixed base):\n");
+            _fmpz_vec_print(r, len), printf("\n\n");
+            _fmpz_vec_print(s, len), printf("\n\n");
+            abort();
+        }
+
+        /* Check aliasing of the output and the bases */
+        for (j = 0; j < len; j++)
+            fmpz_powm(s + j, g + j, e + j, m);
+
+        _fmpz_vec_powm_precomp(g, g, e, len, ctx);
+
+        result = _fmpz_vec_equal(g, s, len);
+        if (!result)
+        {
+            printf("FAIL (aliasing):\n");
+            _fmpz_vec_print(g, len), printf("\n\n");
+            _fmpz_vec_print(s, len), printf("\n\n");
+            abort();
+        }
+
+        fmpz_powm_base_clear(B);
+        fmpz_powm_ctx_clear(ctx);
+
+        _fmpz_vec_clear(g, len);
+        _fmpz_vec_clear(e, len);
+        _fmpz_vec_clear(r, len);
+        _fmpz_vec_clear(s, len);
+        fmpz_clear(a);
+        fmpz_clear(m);
+    }
+
+    flint_randclear(state);
+    _fmpz_cleanup();
+    printf("PASS\n");
+    return 0;
+}
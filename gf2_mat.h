@@ -0,0 +1,209 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#ifndef GF2_MAT_H
+#define GF2_MAT_H
+
+#undef ulong /* interferes with system includes */
+#include <stdlib.h>
+#define ulong unsigned long
+
+#include <mpir.h>
+#include "flint.h"
+#include "nmod_mat.h"
+
+/*
+    Dense matrices over GF(2). Entry (i, j) is bit j % FLINT_BITS of
+    limb j / FLINT_BITS of row i. Bits beyond the last column of a row
+    are not part of the matrix; they are zero in matrices allocated by
+    gf2_mat_init, but may belong to other columns in a window.
+ */
+typedef struct
+{
+    mp_limb_t * entries;
+    long r;
+    long c;
+    mp_limb_t ** rows;
+}
+gf2_mat_struct;
+
+typedef gf2_mat_struct gf2_mat_t[1];
+
+#define GF2_MAT_LIMBS(c) (((c) + FLINT_BITS - 1) / FLINT_BITS)
+
+/* Mask of the bits of the last limb of a row of c > 0 columns */
+#define GF2_MAT_LAST_MASK(c) \
+    (((c) % FLINT_BITS) ? ((1UL << ((c) % FLINT_BITS)) - 1UL) : ~0UL)
+
+#define gf2_mat_nrows(mat) ((mat)->r)
+#define gf2_mat_ncols(mat) ((mat)->c)
+
+static __inline__ int
+gf2_mat_get_entry(const gf2_mat_t mat, long i, long j)
+{
+    return (mat->rows[i][j / FLINT_BITS] >> (j % FLINT_BITS)) & 1UL;
+}
+
+static __inline__ void
+gf2_mat_set_entry(gf2_mat_t mat, long i, long j, int x)
+{
+    mp_limb_t bit = 1UL << (j % FLINT_BITS);
+
+    if (x & 1)
+        mat->rows[i][j / FLINT_BITS] |= bit;
+    else
+        mat->rows[i][j / FLINT_BITS] &= ~bit;
+}
+
+static __inline__ void
+gf2_mat_flip_entry(gf2_mat_t mat, long i, long j)
+{
+    mat->rows[i][j / FLINT_BITS] ^= (1UL << (j % FLINT_BITS));
+}
+
+/* Row operations on vectors of c bits, leaving bits beyond c unchanged */
+
+static __inline__ void
+_gf2_vec_xor(mp_ptr r, mp_srcptr a, mp_srcptr b, long c)
+{
+    long i, n;
+    mp_limb_t mask;
+
+    if (c == 0)
+        return;
+
+    n = GF2_MAT_LIMBS(c) - 1;
+    mask = GF2_MAT_LAST_MASK(c);
+
+    for (i = 0; i < n; i++)
+        r[i] = a[i] ^ b[i];
+
+    r[n] = (r[n] & ~mask) | ((a[n] ^ b[n]) & mask);
+}
+
+static __inline__ void
+_gf2_vec_set(mp_ptr r, mp_srcptr a, long c)
+{
+    long i, n;
+    mp_limb_t mask;
+
+    if (c == 0)
+        return;
+
+    n = GF2_MAT_LIMBS(c) - 1;
+    mask = GF2_MAT_LAST_MASK(c);
+
+    for (i = 0; i < n; i++)
+        r[i] = a[i];
+
+    r[n] = (r[n] & ~mask) | (a[n] & mask);
+}
+
+static __inline__ int
+_gf2_vec_is_zero(mp_srcptr a, long c)
+{
+    long i, n;
+
+    if (c == 0)
+        return 1;
+
+    n = GF2_MAT_LIMBS(c) - 1;
+
+    for (i = 0; i < n; i++)
+        if (a[i] != 0UL)
+            return 0;
+
+    return (a[n] & GF2_MAT_LAST_MASK(c)) == 0UL;
+}
+
+/* Memory management */
+
+void gf2_mat_init(gf2_mat_t mat, long rows, long cols);
+void gf2_mat_init_set(gf2_mat_t mat, const gf2_mat_t src);
+void gf2_mat_clear(gf2_mat_t mat);
+
+void gf2_mat_window_init(gf2_mat_t window, const gf2_mat_t mat,
+                                 long r1, long c1, long r2, long c2);
+void gf2_mat_window_clear(gf2_mat_t window);
+
+/* Basic manipulation */
+
+void gf2_mat_set(gf2_mat_t B, const gf2_mat_t A);
+void gf2_mat_swap(gf2_mat_t A, gf2_mat_t B);
+void gf2_mat_zero(gf2_mat_t mat);
+void gf2_mat_one(gf2_mat_t mat);
+int gf2_mat_is_zero(const gf2_mat_t mat);
+int gf2_mat_equal(const gf2_mat_t A, const gf2_mat_t B);
+
+static __inline__ int
+gf2_mat_is_empty(const gf2_mat_t mat)
+{
+    return (mat->r == 0) || (mat->c == 0);
+}
+
+void gf2_mat_transpose(gf2_mat_t B, const gf2_mat_t A);
+
+void gf2_mat_set_nmod_mat(gf2_mat_t B, const nmod_mat_t A);
+void gf2_mat_get_nmod_mat(nmod_mat_t B, const gf2_mat_t A);
+
+/* Random matrix generation */
+
+void gf2_mat_randtest(gf2_mat_t mat, flint_rand_t state);
+void gf2_mat_randsparse(gf2_mat_t mat, flint_rand_t state, long density);
+
+/* Input and output */
+
+void gf2_mat_print_pretty(const gf2_mat_t mat);
+
+/* Arithmetic */
+
+void gf2_mat_add(gf2_mat_t C, const gf2_mat_t A, const gf2_mat_t B);
+
+void gf2_mat_mul(gf2_mat_t C, const gf2_mat_t A, const gf2_mat_t B);
+void gf2_mat_mul_classical(gf2_mat_t C, const gf2_mat_t A, const gf2_mat_t B);
+void _gf2_mat_addmul_m4rm(gf2_mat_t C, const gf2_mat_t A, const gf2_mat_t B);
+void gf2_mat_mul_m4rm(gf2_mat_t C, const gf2_mat_t A, const gf2_mat_t B);
+void gf2_mat_mul_strassen(gf2_mat_t C, const gf2_mat_t A, const gf2_mat_t B);
+
+/* Gaussian elimination */
+
+long _gf2_mat_m4ri(long * P, gf2_mat_t A, int full);
+long gf2_mat_echelon(long * P, gf2_mat_t A);
+long gf2_mat_rref(long * P, gf2_mat_t A);
+long gf2_mat_rank(const gf2_mat_t A);
+long gf2_mat_nullspace(gf2_mat_t X, const gf2_mat_t A);
+
+/* Tuning parameters *********************************************************/
+
+/* Number of columns of A below which classical multiplication is used */
+#define GF2_MAT_MUL_M4RM_CUTOFF 24
+
+/* Dimension above which Strassen multiplication is used */
+#define GF2_MAT_MUL_STRASSEN_CUTOFF 1024
+
+/* Maximum number of rows combined in one Four Russians table */
+#define GF2_MAT_M4R_MAX_K 8
+
+/* Number of tables used at a time and width in limbs of the column
+   blocks in Four Russians multiplication */
+#define GF2_MAT_M4RM_TABLES 4
+#define GF2_MAT_M4RM_BLOCK 16
+
+#endif
@@ -0,0 +1,52 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "gf2_mat.h"
+
+int
+gf2_mat_equal(const gf2_mat_t A, const gf2_mat_t B)
+{
+    long i, j, n;
+    mp_limb_t mask;
+
+    if (A->r != B->r || A->c != B->c)
+        return 0;
+
+    if (A->r == 0 || A->c == 0)
+        return 1;
+
+    n = GF2_MAT_LIMBS(A->c) - 1;
+    mask = GF2_MAT_LAST_MASK(A->c);
+
+    for (i = 0; i < A->r; i++)
+    {
+        for (j = 0; j < n; j++)
+            if (A->rows[i][j] != B->rows[i][j])
+                return 0;
+
+        if ((A->rows[i][n] ^ B->rows[i][n]) & mask)
+            return 0;
+    }
+
+    return 1;
+}
@@ -0,0 +1,44 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "gf2_mat.h"
+
+void
+gf2_mat_init(gf2_mat_t mat, long rows, long cols)
+{
+    if ((rows) && (cols))
+    {
+        long i, n = GF2_MAT_LIMBS(cols);
+
+        mat->entries = calloc(rows * n, sizeof(mp_limb_t));
+        mat->rows = malloc(rows * sizeof(mp_limb_t *));
+
+        for (i = 0; i < rows; i++)
+            mat->rows[i] = mat->entries + i * n;
+    }
+    else
+        mat->entries = NULL;
+
+    mat->r = rows;
+    mat->c = cols;
+}
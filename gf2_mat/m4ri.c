@@ -0,0 +1,153 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "longlong.h"
+#include "gf2_mat.h"
+
+/* Bit j of row i of A after reduction by the kk pivot rows starting
+   at row r, whose pivots are in the columns pivcols */
+static __inline__ int
+_reduced_bit(const gf2_mat_t A, long i, long j, long r, long kk,
+                                                 const long * pivcols)
+{
+    long t;
+    int x = gf2_mat_get_entry(A, i, j);
+
+    for (t = 0; t < kk; t++)
+        if (gf2_mat_get_entry(A, i, pivcols[t]))
+            x ^= gf2_mat_get_entry(A, r + t, j);
+
+    return x;
+}
+
+/*
+    Gaussian elimination by the Method of the Four Russians (M4RI).
+    The columns are processed in strips of up to k columns. Within a strip,
+    pivots are found by classical elimination, keeping the pivot rows
+    reduced with respect to each other; the remaining rows are then
+    cleared in the strip using a table of all 2^k combinations of the
+    pivot rows, at the cost of one row addition per row.
+
+    If full is nonzero, rows above the pivots are cleared as well,
+    giving the reduced row echelon form. Returns the rank.
+ */
+long
+_gf2_mat_m4ri(long * P, gf2_mat_t A, int full)
+{
+    long i, j, t, m, n, k, kk, kmax, r, c, off, w;
+    long pivcols[GF2_MAT_M4R_MAX_K];
+    mp_ptr T, u;
+    mp_limb_t idx;
+
+    m = A->r;
+    n = A->c;
+
+    for (i = 0; i < m; i++)
+        P[i] = i;
+
+    if (m == 0 || n == 0)
+        return 0;
+
+    k = FLINT_BIT_COUNT(FLINT_MIN(m, n));
+    k = FLINT_MAX(1, FLINT_MIN(GF2_MAT_M4R_MAX_K, (3 * k) / 4));
+
+    T = calloc(GF2_MAT_LIMBS(n) << k, sizeof(mp_limb_t));
+
+    r = c = 0;
+
+    while (r < m && c < n)
+    {
+        kmax = FLINT_MIN(k, n - c);
+
+        /* Only the limbs from the one containing column c onwards are
+           nonzero in the rows being reduced */
+        off = c / FLINT_BITS;
+        w = n - off * FLINT_BITS;
+
+        kk = 0;
+        for (j = c; j < c + kmax && r + kk < m; j++)
+        {
+            for (i = r + kk; i < m; i++)
+                if (_reduced_bit(A, i, j, r, kk, pivcols))
+                    break;
+
+            if (i == m)
+                continue;
+
+            /* Reduce the new pivot row by the earlier ones */
+            for (t = 0; t < kk; t++)
+                if (gf2_mat_get_entry(A, i, pivcols[t]))
+                    _gf2_vec_xor(A->rows[i] + off, A->rows[i] + off,
+                                 A->rows[r + t] + off, w);
+
+            u = A->rows[i];
+            A->rows[i] = A->rows[r + kk];
+            A->rows[r + kk] = u;
+
+            t = P[i];
+            P[i] = P[r + kk];
+            P[r + kk] = t;
+
+            /* Clear column j in the earlier pivot rows */
+            for (t = 0; t < kk; t++)
+                if (gf2_mat_get_entry(A, r + t, j))
+                    _gf2_vec_xor(A->rows[r + t] + off, A->rows[r + t] + off,
+                                 A->rows[r + kk] + off, w);
+
+            pivcols[kk] = j;
+            kk++;
+        }
+
+        if (kk != 0)
+        {
+            for (idx = 1; idx < (1UL << kk); idx++)
+            {
+                count_trailing_zeros(t, idx);
+                _gf2_vec_xor(T + idx * GF2_MAT_LIMBS(w),
+                             T + (idx & (idx - 1UL)) * GF2_MAT_LIMBS(w),
+                             A->rows[r + t] + off, w);
+            }
+
+            for (i = (full ? 0 : r + kk); i < m; i++)
+            {
+                if (i >= r && i < r + kk)
+                    continue;
+
+                idx = 0UL;
+                for (t = 0; t < kk; t++)
+                    idx |= ((mp_limb_t) gf2_mat_get_entry(A, i, pivcols[t])) << t;
+
+                if (idx != 0UL)
+                    _gf2_vec_xor(A->rows[i] + off, A->rows[i] + off,
+                                 T + idx * GF2_MAT_LIMBS(w), w);
+            }
+        }
+
+        r += kk;
+        c = j;
+    }
+
+    free(T);
+
+    return r;
+}
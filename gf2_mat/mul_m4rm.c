@@ -0,0 +1,148 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "longlong.h"
+#include "gf2_mat.h"
+
+/*
+    Sets C = C + AB using the Method of the Four Russians: the rows of B
+    are processed in groups of k, for each of which a table of all 2^k
+    linear combinations is built; every row of C then needs one table
+    lookup and one row addition per group.
+
+    To save memory traffic, GF2_MAT_M4RM_TABLES tables are built at a
+    time and added to each row of C in a single pass, and the columns of
+    B and C are processed in blocks of GF2_MAT_M4RM_BLOCK limbs so that
+    the tables stay in cache. As k is a power of two dividing FLINT_BITS,
+    the bits of A selecting a combination never straddle a limb.
+ */
+void
+_gf2_mat_addmul_m4rm(gf2_mat_t C, const gf2_mat_t A, const gf2_mat_t B)
+{
+    long i, j, l, q, t, k, kk, nt, n, b, s, nl, wb;
+    mp_ptr T, Ti[GF2_MAT_M4RM_TABLES];
+    mp_ptr c;
+    mp_limb_t idx, kmask, w, mask;
+
+    b = A->c;
+    n = GF2_MAT_LIMBS(B->c);
+
+    if (A->r == 0 || b == 0 || B->c == 0)
+        return;
+
+    k = FLINT_MIN(GF2_MAT_M4R_MAX_K, FLINT_BIT_COUNT(A->r) - 1);
+    k = FLINT_MAX(k, 1);
+    while (FLINT_BITS % (k * GF2_MAT_M4RM_TABLES) != 0)
+        k--;
+    kmask = (1UL << k) - 1UL;
+
+    nl = FLINT_MIN(n, GF2_MAT_M4RM_BLOCK);
+    T = calloc((GF2_MAT_M4RM_TABLES * nl) << k, sizeof(mp_limb_t));
+
+    for (s = 0; s < n; s += GF2_MAT_M4RM_BLOCK)
+    {
+        /* Columns s * FLINT_BITS, ..., s * FLINT_BITS + wb - 1 */
+        nl = FLINT_MIN(n - s, GF2_MAT_M4RM_BLOCK);
+        wb = FLINT_MIN(nl * FLINT_BITS, B->c - s * FLINT_BITS);
+        mask = GF2_MAT_LAST_MASK(wb);
+
+        /* Entry zero of each table is the zero row */
+        for (q = 0; q < GF2_MAT_M4RM_TABLES; q++)
+        {
+            Ti[q] = T + ((q * nl) << k);
+            for (l = 0; l < nl; l++)
+                Ti[q][l] = 0UL;
+        }
+
+        for (j = 0; j < b; j += k * GF2_MAT_M4RM_TABLES)
+        {
+            /* Table q holds the combinations of rows j + qk, ... of B */
+            for (q = 0, nt = 0; q < GF2_MAT_M4RM_TABLES && j + q * k < b; q++)
+            {
+                kk = FLINT_MIN(k, b - j - q * k);
+                nt++;
+
+                for (idx = 1; idx < (1UL << kk); idx++)
+                {
+                    count_trailing_zeros(t, idx);
+                    _gf2_vec_xor(Ti[q] + idx * nl,
+                                 Ti[q] + (idx & (idx - 1UL)) * nl,
+                                 B->rows[j + q * k + t] + s, wb);
+                }
+            }
+
+            for (i = 0; i < A->r; i++)
+            {
+                mp_srcptr r[GF2_MAT_M4RM_TABLES] = {NULL};
+
+                w = A->rows[i][j / FLINT_BITS] >> (j % FLINT_BITS);
+                if (j + k * GF2_MAT_M4RM_TABLES > b)
+                    w &= (1UL << (b - j)) - 1UL;
+
+                if (w == 0UL)
+                    continue;
+
+                for (q = 0; q < nt; q++)
+                {
+                    idx = (w >> (q * k)) & kmask;
+                    r[q] = Ti[q] + idx * nl;
+                }
+
+                c = C->rows[i] + s;
+
+                for (l = 0; l < nl - 1; l++)
+                {
+                    w = r[0][l];
+                    for (q = 1; q < nt; q++)
+                        w ^= r[q][l];
+                    c[l] ^= w;
+                }
+
+                w = r[0][l];
+                for (q = 1; q < nt; q++)
+                    w ^= r[q][l];
+                c[l] ^= (w & mask);
+            }
+        }
+    }
+
+    free(T);
+}
+
+void
+gf2_mat_mul_m4rm(gf2_mat_t C, const gf2_mat_t A, const gf2_mat_t B)
+{
+    if (C == A || C == B)
+    {
+        gf2_mat_t T;
+        gf2_mat_init(T, A->r, B->c);
+        gf2_mat_mul_m4rm(T, A, B);
+        gf2_mat_set(C, T);
+        gf2_mat_clear(T);
+        return;
+    }
+
+    gf2_mat_zero(C);
+    _gf2_mat_addmul_m4rm(C, A, B);
+}
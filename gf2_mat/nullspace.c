@@ -0,0 +1,88 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "gf2_mat.h"
+
+long
+gf2_mat_nullspace(gf2_mat_t X, const gf2_mat_t A)
+{
+    long i, j, k, m, n, rank, nullity;
+    long * p;
+    long * pivots;
+    long * nonpivots;
+    gf2_mat_t tmp;
+
+    m = A->r;
+    n = A->c;
+
+    p = malloc(sizeof(long) * FLINT_MAX(m, n));
+
+    gf2_mat_init_set(tmp, A);
+    rank = gf2_mat_rref(p, tmp);
+    nullity = n - rank;
+
+    gf2_mat_zero(X);
+
+    if (rank == 0)
+    {
+        for (i = 0; i < nullity; i++)
+            gf2_mat_set_entry(X, i, i, 1);
+    }
+    else if (nullity)
+    {
+        pivots = p;            /* length = rank */
+        nonpivots = p + rank;  /* length = nullity */
+
+        for (i = j = k = 0; i < rank; i++)
+        {
+            while (!gf2_mat_get_entry(tmp, i, j))
+            {
+                nonpivots[k] = j;
+                k++;
+                j++;
+            }
+            pivots[i] = j;
+            j++;
+        }
+        while (k < nullity)
+        {
+            nonpivots[k] = j;
+            k++;
+            j++;
+        }
+
+        for (i = 0; i < nullity; i++)
+        {
+            for (j = 0; j < rank; j++)
+                if (gf2_mat_get_entry(tmp, j, nonpivots[i]))
+                    gf2_mat_set_entry(X, pivots[j], i, 1);
+
+            gf2_mat_set_entry(X, nonpivots[i], i, 1);
+        }
+    }
+
+    free(p);
+    gf2_mat_clear(tmp);
+
+    return nullity;
+}
@@ -0,0 +1,104 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "profiler.h"
+#include "flint.h"
+#include "gf2_mat.h"
+#include "ulong_extras.h"
+
+typedef struct
+{
+    ulong dim;
+    int algorithm;
+} mat_mul_t;
+
+void sample(void * arg, ulong count)
+{
+    mat_mul_t * params = (mat_mul_t *) arg;
+    ulong i, dim = params->dim;
+    int algorithm = params->algorithm;
+    flint_rand_t state;
+
+    gf2_mat_t A, B, C;
+
+    flint_randinit(state);
+
+    gf2_mat_init(A, dim, dim);
+    gf2_mat_init(B, dim, dim);
+    gf2_mat_init(C, dim, dim);
+
+    gf2_mat_randtest(A, state);
+    gf2_mat_randtest(B, state);
+
+    prof_start();
+
+    if (algorithm == 0)
+        for (i = 0; i < count; i++)
+            gf2_mat_mul_classical(C, A, B);
+    else if (algorithm == 1)
+        for (i = 0; i < count; i++)
+            gf2_mat_mul_m4rm(C, A, B);
+    else
+        for (i = 0; i < count; i++)
+            gf2_mat_mul_strassen(C, A, B);
+
+    prof_stop();
+
+    gf2_mat_clear(A);
+    gf2_mat_clear(B);
+    gf2_mat_clear(C);
+
+    flint_randclear(state);
+}
+
+int main(void)
+{
+    double min_classical, min_m4rm, min_strassen, max;
+    mat_mul_t params;
+    long dim;
+
+    printf("gf2_mat_mul:\n");
+
+    for (dim = 2; dim <= 4096; dim = (long) ((double) dim * 1.2) + 1)
+    {
+        params.dim = dim;
+
+        if (dim <= 512)
+        {
+            params.algorithm = 0;
+            prof_repeat(&min_classical, &max, sample, &params);
+        }
+        else
+            min_classical = 0.0;
+
+        params.algorithm = 1;
+        prof_repeat(&min_m4rm, &max, sample, &params);
+
+        params.algorithm = 2;
+        prof_repeat(&min_strassen, &max, sample, &params);
+
+        printf("dim = %ld, classical %.2f us m4rm %.2f us strassen %.2f us\n", 
+            dim, min_classical, min_m4rm, min_strassen);
+    }
+
+    return 0;
+}
@@ -0,0 +1,47 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "ulong_extras.h"
+#include "gf2_mat.h"
+
+void
+gf2_mat_randtest(gf2_mat_t mat, flint_rand_t state)
+{
+    long i, j, n;
+    mp_limb_t mask;
+
+    if (mat->c == 0)
+        return;
+
+    n = GF2_MAT_LIMBS(mat->c) - 1;
+    mask = GF2_MAT_LAST_MASK(mat->c);
+
+    for (i = 0; i < mat->r; i++)
+    {
+        for (j = 0; j < n; j++)
+            mat->rows[i][j] = n_randtest(state);
+
+        mat->rows[i][n] = (mat->rows[i][n] & ~mask)
+                        | (n_randtest(state) & mask);
+    }
+}
@@ -0,0 +1,48 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "gf2_mat.h"
+
+long
+gf2_mat_rank(const gf2_mat_t A)
+{
+    long m, n, rank;
+    long * perm;
+    gf2_mat_t tmp;
+
+    m = A->r;
+    n = A->c;
+
+    if (m == 0 || n == 0)
+        return 0;
+
+    gf2_mat_init_set(tmp, A);
+    perm = malloc(sizeof(long) * m);
+
+    rank = gf2_mat_echelon(perm, tmp);
+
+    free(perm);
+    gf2_mat_clear(tmp);
+
+    return rank;
+}
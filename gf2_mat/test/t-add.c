@@ -0,0 +1,99 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "nmod_mat.h"
+#include "gf2_mat.h"
+#include "ulong_extras.h"
+
+int
+main(void)
+{
+    long i;
+    flint_rand_t state;
+    flint_randinit(state);
+
+    printf("add....");
+    fflush(stdout);
+
+    for (i = 0; i < 1000; i++)
+    {
+        gf2_mat_t A, B, C;
+        nmod_mat_t D, E, F;
+        long m, n;
+
+        m = n_randint(state, 100);
+        n = n_randint(state, 200);
+
+        gf2_mat_init(A, m, n);
+        gf2_mat_init(B, m, n);
+        gf2_mat_init(C, m, n);
+        nmod_mat_init(D, m, n, 2);
+        nmod_mat_init(E, m, n, 2);
+        nmod_mat_init(F, m, n, 2);
+
+        gf2_mat_randtest(A, state);
+        gf2_mat_randtest(B, state);
+        gf2_mat_add(C, A, B);
+
+        gf2_mat_get_nmod_mat(D, A);
+        gf2_mat_get_nmod_mat(E, B);
+        nmod_mat_add(D, D, E);
+        gf2_mat_get_nmod_mat(F, C);
+
+        if (!nmod_mat_equal(D, F))
+        {
+            printf("FAIL: results not equal\n");
+            abort();
+        }
+
+        /* A + B + B = A, with aliasing */
+        gf2_mat_add(C, C, B);
+
+        if (!gf2_mat_equal(C, A))
+        {
+            printf("FAIL: aliasing\n");
+            abort();
+        }
+
+        gf2_mat_add(C, C, C);
+
+        if (!gf2_mat_is_zero(C))
+        {
+            printf("FAIL: A + A != 0\n");
+            abort();
+        }
+
+        gf2_mat_clear(A);
+        gf2_mat_clear(B);
+        gf2_mat_clear(C);
+        nmod_mat_clear(D);
+        nmod_mat_clear(E);
+        nmod_mat_clear(F);
+    }
+
+    flint_randclear(state);
+
+    printf("PASS\n");
+    return 0;
+}
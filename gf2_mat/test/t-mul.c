@@ -0,0 +1,116 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "nmod_mat.h"
+#include "gf2_mat.h"
+#include "ulong_extras.h"
+
+int
+main(void)
+{
+    long i;
+    flint_rand_t state;
+    flint_randinit(state);
+
+    printf("mul....");
+    fflush(stdout);
+
+    for (i = 0; i < 1000; i++)
+    {
+        gf2_mat_t A, B, C, D;
+        nmod_mat_t E, F, G, H;
+        long m, k, n;
+
+        m = n_randint(state, 150);
+        k = n_randint(state, 150);
+        n = n_randint(state, 150);
+
+        gf2_mat_init(A, m, k);
+        gf2_mat_init(B, k, n);
+        gf2_mat_init(C, m, n);
+        gf2_mat_init(D, m, n);
+        nmod_mat_init(E, m, k, 2);
+        nmod_mat_init(F, k, n, 2);
+        nmod_mat_init(G, m, n, 2);
+        nmod_mat_init(H, m, n, 2);
+
+        gf2_mat_randtest(A, state);
+        gf2_mat_randtest(B, state);
+        gf2_mat_get_nmod_mat(E, A);
+        gf2_mat_get_nmod_mat(F, B);
+        nmod_mat_mul(G, E, F);
+
+        gf2_mat_mul_classical(C, A, B);
+        gf2_mat_get_nmod_mat(H, C);
+
+        if (!nmod_mat_equal(G, H))
+        {
+            printf("FAIL: classical\n");
+            abort();
+        }
+
+        gf2_mat_mul_m4rm(D, A, B);
+
+        if (!gf2_mat_equal(C, D))
+        {
+            printf("FAIL: m4rm\n");
+            abort();
+        }
+
+        gf2_mat_randtest(D, state);
+        gf2_mat_mul(D, A, B);
+
+        if (!gf2_mat_equal(C, D))
+        {
+            printf("FAIL: mul\n");
+            abort();
+        }
+
+        /* Aliasing */
+        if (k == n)
+        {
+            gf2_mat_mul(A, A, B);
+
+            if (!gf2_mat_equal(A, C))
+            {
+                printf("FAIL: aliasing\n");
+                abort();
+            }
+        }
+
+        gf2_mat_clear(A);
+        gf2_mat_clear(B);
+        gf2_mat_clear(C);
+        gf2_mat_clear(D);
+        nmod_mat_clear(E);
+        nmod_mat_clear(F);
+        nmod_mat_clear(G);
+        nmod_mat_clear(H);
+    }
+
+    flint_randclear(state);
+
+    printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,75 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "gf2_mat.h"
+#include "ulong_extras.h"
+
+int
+main(void)
+{
+    long i;
+    flint_rand_t state;
+    flint_randinit(state);
+
+    printf("mul_strassen....");
+    fflush(stdout);
+
+    for (i = 0; i < 5; i++)
+    {
+        gf2_mat_t A, B, C, D;
+        long m, k, n;
+
+        m = GF2_MAT_MUL_STRASSEN_CUTOFF + n_randint(state, 200);
+        k = GF2_MAT_MUL_STRASSEN_CUTOFF + n_randint(state, 200);
+        n = GF2_MAT_MUL_STRASSEN_CUTOFF + n_randint(state, 200);
+
+        gf2_mat_init(A, m, k);
+        gf2_mat_init(B, k, n);
+        gf2_mat_init(C, m, n);
+        gf2_mat_init(D, m, n);
+
+        gf2_mat_randtest(A, state);
+        gf2_mat_randtest(B, state);
+
+        gf2_mat_mul_m4rm(C, A, B);
+        gf2_mat_mul_strassen(D, A, B);
+
+        if (!gf2_mat_equal(C, D))
+        {
+            printf("FAIL: results not equal\n");
+            printf("m = %ld, k = %ld, n = %ld\n", m, k, n);
+            abort();
+        }
+
+        gf2_mat_clear(A);
+        gf2_mat_clear(B);
+        gf2_mat_clear(C);
+        gf2_mat_clear(D);
+    }
+
+    flint_randclear(state);
+
+    printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,92 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "gf2_mat.h"
+#include "ulong_extras.h"
+
+int
+main(void)
+{
+    long i;
+    flint_rand_t state;
+    flint_randinit(state);
+
+    printf("nullspace....");
+    fflush(stdout);
+
+    for (i = 0; i < 1000; i++)
+    {
+        gf2_mat_t A, B, ker;
+        long m, n, r, nullity, nulrank;
+
+        m = n_randint(state, 150);
+        n = n_randint(state, 150);
+        r = n_randint(state, FLINT_MIN(m, n) + 1);
+
+        gf2_mat_init(A, m, n);
+        gf2_mat_init(ker, n, n);
+        gf2_mat_init(B, m, n);
+
+        /* Rank at most r */
+        {
+            gf2_mat_t L, U;
+            gf2_mat_init(L, m, r);
+            gf2_mat_init(U, r, n);
+            gf2_mat_randtest(L, state);
+            gf2_mat_randsparse(U, state, n_randint(state, 1000));
+            gf2_mat_mul(A, L, U);
+            gf2_mat_clear(L);
+            gf2_mat_clear(U);
+        }
+
+        r = gf2_mat_rank(A);
+        nullity = gf2_mat_nullspace(ker, A);
+        nulrank = gf2_mat_rank(ker);
+
+        if (nullity != nulrank || nullity + r != n)
+        {
+            printf("FAIL:\n");
+            printf("rank(A) = %ld, nullity = %ld, rank(ker) = %ld\n",
+                r, nullity, nulrank);
+            abort();
+        }
+
+        gf2_mat_mul(B, A, ker);
+
+        if (!gf2_mat_is_zero(B))
+        {
+            printf("FAIL: A * ker != 0\n");
+            abort();
+        }
+
+        gf2_mat_clear(A);
+        gf2_mat_clear(ker);
+        gf2_mat_clear(B);
+    }
+
+    flint_randclear(state);
+
+    printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,141 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "nmod_mat.h"
+#include "gf2_mat.h"
+#include "ulong_extras.h"
+
+/* Random m x n matrix of rank at most r, with density d / 1000 */
+static void
+_randlowrank(gf2_mat_t A, flint_rand_t state, long r, long d)
+{
+    gf2_mat_t L, U;
+
+    gf2_mat_init(L, A->r, r);
+    gf2_mat_init(U, r, A->c);
+    gf2_mat_randsparse(L, state, d);
+    gf2_mat_randsparse(U, state, d);
+    gf2_mat_mul(A, L, U);
+    gf2_mat_clear(L);
+    gf2_mat_clear(U);
+}
+
+/* Gauss-Jordan elimination mod 2, returning the rank */
+static long
+_naive_rref(nmod_mat_t A)
+{
+    long i, j, k, r = 0;
+    mp_ptr t;
+
+    for (j = 0; j < A->c && r < A->r; j++)
+    {
+        for (i = r; i < A->r && nmod_mat_entry(A, i, j) == 0UL; i++) ;
+
+        if (i == A->r)
+            continue;
+
+        t = A->rows[i];
+        A->rows[i] = A->rows[r];
+        A->rows[r] = t;
+
+        for (i = 0; i < A->r; i++)
+            if (i != r && nmod_mat_entry(A, i, j) != 0UL)
+                for (k = j; k < A->c; k++)
+                    nmod_mat_entry(A, i, k) ^= nmod_mat_entry(A, r, k);
+
+        r++;
+    }
+
+    return r;
+}
+
+int
+main(void)
+{
+    long i;
+    flint_rand_t state;
+    flint_randinit(state);
+
+    printf("rref....");
+    fflush(stdout);
+
+    for (i = 0; i < 1000; i++)
+    {
+        gf2_mat_t A, B;
+        nmod_mat_t C, D;
+        long m, n, r, rank1, rank2, rank3;
+        long * P;
+
+        m = n_randint(state, 150);
+        n = n_randint(state, 150);
+        r = n_randint(state, FLINT_MIN(m, n) + 1);
+
+        gf2_mat_init(A, m, n);
+        gf2_mat_init(B, m, n);
+        nmod_mat_init(C, m, n, 2);
+        nmod_mat_init(D, m, n, 2);
+        P = malloc(sizeof(long) * m);
+
+        if (n_randint(state, 2))
+            gf2_mat_randtest(A, state);
+        else
+            _randlowrank(A, state, r, 1 + n_randint(state, 1000));
+
+        gf2_mat_get_nmod_mat(C, A);
+        rank1 = _naive_rref(C);
+
+        gf2_mat_set(B, A);
+        rank2 = gf2_mat_rref(P, B);
+        gf2_mat_get_nmod_mat(D, B);
+
+        if (rank1 != rank2 || !nmod_mat_equal(C, D))
+        {
+            printf("FAIL: rref\n");
+            printf("rank1 = %ld, rank2 = %ld\n", rank1, rank2);
+            gf2_mat_print_pretty(A);
+            gf2_mat_print_pretty(B);
+            abort();
+        }
+
+        rank3 = gf2_mat_rank(A);
+
+        if (rank1 != rank3)
+        {
+            printf("FAIL: rank\n");
+            printf("rank1 = %ld, rank3 = %ld\n", rank1, rank3);
+            abort();
+        }
+
+        gf2_mat_clear(A);
+        gf2_mat_clear(B);
+        nmod_mat_clear(C);
+        nmod_mat_clear(D);
+        free(P);
+    }
+
+    flint_randclear(state);
+
+    printf("PASS\n");
+    return 0;
+}
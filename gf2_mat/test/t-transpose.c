@@ -0,0 +1,81 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "nmod_mat.h"
+#include "gf2_mat.h"
+#include "ulong_extras.h"
+
+int
+main(void)
+{
+    long i;
+    flint_rand_t state;
+    flint_randinit(state);
+
+    printf("transpose....");
+    fflush(stdout);
+
+    for (i = 0; i < 1000; i++)
+    {
+        gf2_mat_t A, B;
+        nmod_mat_t C, D, E;
+        long m, n;
+
+        m = n_randint(state, 200);
+        n = n_randint(state, 200);
+
+        gf2_mat_init(A, m, n);
+        gf2_mat_init(B, n, m);
+        nmod_mat_init(C, m, n, 2);
+        nmod_mat_init(D, n, m, 2);
+        nmod_mat_init(E, n, m, 2);
+
+        gf2_mat_randtest(A, state);
+        gf2_mat_transpose(B, A);
+
+        gf2_mat_get_nmod_mat(C, A);
+        nmod_mat_transpose(D, C);
+        gf2_mat_get_nmod_mat(E, B);
+
+        if (!nmod_mat_equal(D, E))
+        {
+            printf("FAIL:\n");
+            printf("m = %ld, n = %ld\n", m, n);
+            gf2_mat_print_pretty(A);
+            gf2_mat_print_pretty(B);
+            abort();
+        }
+
+        gf2_mat_clear(A);
+        gf2_mat_clear(B);
+        nmod_mat_clear(C);
+        nmod_mat_clear(D);
+        nmod_mat_clear(E);
+    }
+
+    flint_randclear(state);
+
+    printf("PASS\n");
+    return 0;
+}
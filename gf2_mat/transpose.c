@@ -0,0 +1,75 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "longlong.h"
+#include "gf2_mat.h"
+
+void
+gf2_mat_transpose(gf2_mat_t B, const gf2_mat_t A)
+{
+    long i, j, k, n;
+    mp_limb_t w;
+
+    if (B->r != A->c || B->c != A->r)
+    {
+        printf("Exception: gf2_mat_transpose: incompatible dimensions\n");
+        abort();
+    }
+
+    if (A == B)
+    {
+        gf2_mat_t T;
+        gf2_mat_init(T, A->c, A->r);
+        gf2_mat_transpose(T, A);
+        gf2_mat_set(B, T);
+        gf2_mat_clear(T);
+        return;
+    }
+
+    gf2_mat_zero(B);
+
+    if (A->c == 0)
+        return;
+
+    n = GF2_MAT_LIMBS(A->c);
+
+    /* Scatter the set bits of each row of A into column i of B */
+    for (i = 0; i < A->r; i++)
+    {
+        for (k = 0; k < n; k++)
+        {
+            w = A->rows[i][k];
+
+            if (k == n - 1)
+                w &= GF2_MAT_LAST_MASK(A->c);
+
+            while (w != 0UL)
+            {
+                count_trailing_zeros(j, w);
+                w &= (w - 1UL);
+                gf2_mat_flip_entry(B, k * FLINT_BITS + j, i);
+            }
+        }
+    }
+}
@@ -0,0 +1,49 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "gf2_mat.h"
+
+void
+gf2_mat_window_init(gf2_mat_t window, const gf2_mat_t mat,
+    long r1, long c1, long r2, long c2)
+{
+    long i;
+
+    if (c1 % FLINT_BITS != 0)
+    {
+        printf("Exception: gf2_mat_window_init: column offset %ld "
+               "is not a multiple of FLINT_BITS\n", c1);
+        abort();
+    }
+
+    window->entries = NULL;
+
+    window->rows = malloc((r2 - r1) * sizeof(mp_limb_t *));
+
+    for (i = 0; i < r2 - r1; i++)
+        window->rows[i] = mat->rows[r1 + i] + c1 / FLINT_BITS;
+
+    window->r = r2 - r1;
+    window->c = c2 - c1;
+}
@@ -98,6 +98,60 @@ mp_size_t mpn_remove_power_ascending(mp_ptr x, mp_size_t xsize,
 
 int mpn_factor_trial(mp_srcptr x, mp_size_t xsize, long start, long stop);
 
+/*
+    Product tree of a list of primes. The leaves (level 0) are products
+    of consecutive primes packed into single limbs, and node j of level
+    k + 1 is the product of nodes 2j and 2j + 1 of level k, or a copy of
+    node 2j if that is the last one.
+ */
+typedef struct
+{
+    mp_ptr * prods;         /* nodes of level k */
+    mp_size_t ** offs;      /* offset of node j in prods[k] */
+    mp_size_t ** sizes;     /* number of limbs of node j */
+    long * len;             /* number of nodes of level k */
+    long depth;             /* number of levels */
+    mp_ptr primes;
+    long * leaf_start;      /* leaf j holds primes leaf_start[j], ... */
+    long num;
+}
+mpn_factor_tree_struct;
+
+typedef mpn_factor_tree_struct mpn_factor_tree_t[1];
+
+void mpn_factor_tree_init(mpn_factor_tree_t T, const mp_limb_t * primes,
+                                                                long num);
+
+void mpn_factor_tree_clear(mpn_factor_tree_t T);
+
+void mpn_factor_tree_rem(mp_ptr res, mp_srcptr x, mp_size_t xsize,
+                                                const mpn_factor_tree_t T);
+
+long mpn_factor_tree_trial(long * found, mp_srcptr x, mp_size_t xsize,
+                                                const mpn_factor_tree_t T);
+
+/* Number of limbs of x and number of primes from which mpn_factor_trial
+   reduces x with remainder trees instead of dividing by each prime, and
+   the number of primes per limb of x in each tree */
+#define MPN_FACTOR_TREE_LIMBS_CUTOFF 64
+#define MPN_FACTOR_TREE_PRIMES_CUTOFF 128
+#define MPN_FACTOR_TREE_PRIMES_PER_LIMB 2
+
+/* Number of factors below which products of limbs are computed directly,
+   and number of (packed) factors above which the product tree is split
+   over several threads */
+#define MPN_PROD_LIMBS_DIRECT_CUTOFF 50
+#define MPN_PROD_LIMBS_PARALLEL_CUTOFF 4096
+
+mp_size_t mpn_prod_limbs_direct(mp_limb_t * result, const mp_limb_t * factors,
+    mp_size_t n);
+
+mp_size_t mpn_prod_limbs_balanced(mp_limb_t * result, mp_limb_t * scratch,
+    const mp_limb_t * factors, mp_size_t n, ulong bits);
+
+mp_size_t mpn_prod_limbs(mp_limb_t * result, const mp_limb_t * factors,
+    mp_size_t n, ulong bits);
+
 int mpn_divides(mp_ptr q, mp_srcptr array1, 
          mp_size_t limbs1, mp_srcptr arrayg, mp_size_t limbsg, mp_ptr temp);
 
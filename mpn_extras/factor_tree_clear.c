@@ -0,0 +1,44 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "mpn_extras.h"
+
+void
+mpn_factor_tree_clear(mpn_factor_tree_t T)
+{
+    long k;
+
+    for (k = 0; k < T->depth; k++)
+    {
+        free(T->prods[k]);
+        free(T->offs[k]);
+        free(T->sizes[k]);
+    }
+
+    free(T->prods);
+    free(T->offs);
+    free(T->sizes);
+    free(T->len);
+    free(T->primes);
+    free(T->leaf_start);
+}
@@ -0,0 +1,139 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "mpn_extras.h"
+#include "longlong.h"
+
+typedef struct
+{
+    mpn_factor_tree_struct * T;
+    long k;
+}
+_factor_tree_level_struct;
+
+/* Computes node j of level k + 1 from its children on level k */
+static void
+_factor_tree_node_worker(void * arg, long j)
+{
+    _factor_tree_level_struct * s = (_factor_tree_level_struct *) arg;
+    mpn_factor_tree_struct * T = s->T;
+    long k = s->k;
+    mp_ptr a, b, c;
+    mp_size_t alen, blen;
+
+    a = T->prods[k] + T->offs[k][2*j];
+    alen = T->sizes[k][2*j];
+    c = T->prods[k + 1] + T->offs[k + 1][j];
+
+    if (2*j + 1 < T->len[k])
+    {
+        b = T->prods[k] + T->offs[k][2*j + 1];
+        blen = T->sizes[k][2*j + 1];
+        MPN_MUL(c, T->sizes[k + 1][j], a, alen, b, blen);
+    }
+    else
+        MPN_SET(c, T->sizes[k + 1][j], a, alen);
+}
+
+void
+mpn_factor_tree_init(mpn_factor_tree_t T, const mp_limb_t * primes, long num)
+{
+    _factor_tree_level_struct s;
+    mp_limb_t hi, lo, acc;
+    long i, j, k, n;
+
+    T->num = num;
+    T->primes = malloc(sizeof(mp_limb_t) * FLINT_MAX(num, 1));
+    T->leaf_start = malloc(sizeof(long) * (num + 1));
+
+    for (i = 0; i < num; i++)
+        T->primes[i] = primes[i];
+
+    /* There are at most FLINT_BITS levels as num < 2^(FLINT_BITS - 1) */
+    T->prods = malloc(sizeof(mp_ptr) * FLINT_BITS);
+    T->offs = malloc(sizeof(mp_size_t *) * FLINT_BITS);
+    T->sizes = malloc(sizeof(mp_size_t *) * FLINT_BITS);
+    T->len = malloc(sizeof(long) * FLINT_BITS);
+
+    T->depth = 0;
+    T->leaf_start[0] = 0;
+
+    if (num == 0)
+        return;
+
+    /* Leaves: runs of consecutive primes whose product fits in a limb */
+    T->prods[0] = malloc(sizeof(mp_limb_t) * num);
+    T->offs[0] = malloc(sizeof(mp_size_t) * num);
+    T->sizes[0] = malloc(sizeof(mp_size_t) * num);
+
+    n = 0;
+    for (i = 0; i < num; i = j)
+    {
+        acc = primes[i];
+        for (j = i + 1; j < num; j++)
+        {
+            umul_ppmm(hi, lo, acc, primes[j]);
+            if (hi != 0UL)
+                break;
+            acc = lo;
+        }
+        T->leaf_start[n] = i;
+        T->prods[0][n] = acc;
+        T->offs[0][n] = n;
+        T->sizes[0][n] = 1;
+        n++;
+    }
+    T->leaf_start[n] = num;
+    T->len[0] = n;
+
+    T->depth = 1;
+    for (i = n; i > 1; i = (i + 1) / 2)
+        T->depth++;
+
+    /* Each level is allocated in one block, with room for the full
+       sum of the sizes of the children of each node */
+    s.T = T;
+    for (k = 0; k + 1 < T->depth; k++)
+    {
+        mp_size_t off = 0;
+
+        n = (T->len[k] + 1) / 2;
+        T->len[k + 1] = n;
+        T->offs[k + 1] = malloc(sizeof(mp_size_t) * n);
+        T->sizes[k + 1] = malloc(sizeof(mp_size_t) * n);
+
+        for (j = 0; j < n; j++)
+        {
+            T->offs[k + 1][j] = off;
+            off += T->sizes[k][2*j];
+            if (2*j + 1 < T->len[k])
+                off += T->sizes[k][2*j + 1];
+        }
+
+        T->prods[k + 1] = malloc(sizeof(mp_limb_t) * off);
+
+        s.k = k;
+        flint_parallel_do(_factor_tree_node_worker, &s, n,
+                                                    flint_get_num_threads());
+    }
+}
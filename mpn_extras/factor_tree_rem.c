@@ -0,0 +1,184 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "mpn_extras.h"
+
+/*
+    Scaled remainder tree of Bernstein. Instead of x mod N, each node N
+    carries an approximation y / B^L to the fraction {x / N}, where
+    B = 2^FLINT_BITS and L is one more than the number of limbs of N.
+    For a child C with sibling S we have {x / C} = {{x / N} S}, so that
+    y for C is read off from the low L limbs of y S without any
+    division. All approximations are truncations, so the error at a
+    leaf p is below (depth + 2) p / B in the cyclic sense, and x mod p
+    is recovered by rounding y p / B^2.
+ */
+
+typedef struct
+{
+    mp_ptr res;
+    mp_srcptr x;
+    mp_size_t xsize;
+    const mpn_factor_tree_struct * T;
+    long K;
+    long num_blocks;
+}
+_factor_tree_rem_struct;
+
+static void
+_factor_tree_rem_descend(mp_ptr res, const mpn_factor_tree_struct * T,
+        long k, long j, mp_srcptr y, mp_size_t ylen, mp_ptr * ybuf, mp_ptr t)
+{
+    mp_srcptr a, b;
+    mp_size_t alen, blen, len;
+    mp_limb_t p, r;
+
+    while (k > 0 && 2*j + 1 >= T->len[k - 1])
+    {
+        /* Only child, equal to its parent */
+        k--;
+        j = 2*j;
+    }
+
+    if (k == 0)
+    {
+        p = T->prods[0][j];
+        t[2] = mpn_mul_1(t, y, 2, p);
+        r = t[2] + (t[1] >> (FLINT_BITS - 1));
+        res[j] = (r >= p) ? r - p : r;
+        return;
+    }
+
+    a = T->prods[k - 1] + T->offs[k - 1][2*j];
+    alen = T->sizes[k - 1][2*j];
+    b = T->prods[k - 1] + T->offs[k - 1][2*j + 1];
+    blen = T->sizes[k - 1][2*j + 1];
+
+    mpn_mul(t, y, ylen, b, blen);
+    len = alen + 1;
+    mpn_copyi(ybuf[k - 1], t + ylen - len, len);
+    _factor_tree_rem_descend(res, T, k - 1, 2*j, ybuf[k - 1], len, ybuf, t);
+
+    mpn_mul(t, y, ylen, a, alen);
+    len = blen + 1;
+    mpn_copyi(ybuf[k - 1], t + ylen - len, len);
+    _factor_tree_rem_descend(res, T, k - 1, 2*j + 1, ybuf[k - 1], len, ybuf, t);
+}
+
+/* Handles the i-th block of nodes on level K */
+static void
+_factor_tree_rem_worker(void * arg, long i)
+{
+    _factor_tree_rem_struct * s = (_factor_tree_rem_struct *) arg;
+    const mpn_factor_tree_struct * T = s->T;
+    mp_srcptr x = s->x, N;
+    mp_size_t xsize = s->xsize, n, maxn;
+    mp_ptr * ybuf, t, q, r;
+    long j, j0, j1, k, K = s->K;
+
+    j0 = (i * T->len[K]) / s->num_blocks;
+    j1 = ((i + 1) * T->len[K]) / s->num_blocks;
+
+    if (K == 0)
+    {
+        for (j = j0; j < j1; j++)
+            s->res[j] = mpn_mod_1(x, xsize, T->prods[0][j]);
+        return;
+    }
+
+    ybuf = malloc(sizeof(mp_ptr) * (K + 1));
+
+    maxn = 0;
+    for (k = 0; k <= K; k++)
+    {
+        n = 0;
+        for (j = j0 << (K - k); j < T->len[k] && j < (j1 << (K - k)); j++)
+            n = FLINT_MAX(n, T->sizes[k][j]);
+        ybuf[k] = malloc(sizeof(mp_limb_t) * (n + 1));
+        maxn = FLINT_MAX(maxn, n);
+    }
+
+    t = malloc(sizeof(mp_limb_t) * (2 * maxn + 2));
+    q = malloc(sizeof(mp_limb_t) * (FLINT_MAX(xsize, 2 * maxn + 1) + 1));
+    r = malloc(sizeof(mp_limb_t) * (2 * maxn + 1));
+
+    for (j = j0; j < j1; j++)
+    {
+        N = T->prods[K] + T->offs[K][j];
+        n = T->sizes[K][j];
+
+        /* r = x mod N, shifted up by n + 1 limbs */
+        mpn_zero(r, n + 1);
+        if (xsize >= n)
+            mpn_tdiv_qr(q, r + n + 1, 0, x, xsize, N, n);
+        else
+        {
+            mpn_copyi(r + n + 1, x, xsize);
+            mpn_zero(r + n + 1 + xsize, n - xsize);
+        }
+
+        /* y = floor(r B^(n + 1) / N) */
+        mpn_tdiv_qr(q, t, 0, r, 2 * n + 1, N, n);
+        mpn_copyi(ybuf[K], q, n + 1);
+
+        _factor_tree_rem_descend(s->res, T, K, j, ybuf[K], n + 1, ybuf, t);
+    }
+
+    for (k = 0; k <= K; k++)
+        free(ybuf[k]);
+    free(ybuf);
+    free(t);
+    free(q);
+    free(r);
+}
+
+void
+mpn_factor_tree_rem(mp_ptr res, mp_srcptr x, mp_size_t xsize,
+                                                const mpn_factor_tree_t T)
+{
+    _factor_tree_rem_struct s;
+    long K, num_threads;
+
+    if (T->depth == 0)
+        return;
+
+    if (xsize == 0)
+    {
+        mpn_zero(res, T->len[0]);
+        return;
+    }
+
+    /* Start from the lowest level whose nodes are as large as x */
+    for (K = 0; K + 1 < T->depth && T->sizes[K][0] < xsize; K++) ;
+
+    num_threads = flint_get_num_threads();
+
+    s.res = res;
+    s.x = x;
+    s.xsize = xsize;
+    s.T = T;
+    s.K = K;
+    s.num_blocks = FLINT_MAX(FLINT_MIN(num_threads, T->len[K]), 1);
+
+    flint_parallel_do(_factor_tree_rem_worker, &s, s.num_blocks, num_threads);
+}
@@ -0,0 +1,52 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "mpn_extras.h"
+
+long
+mpn_factor_tree_trial(long * found, mp_srcptr x, mp_size_t xsize,
+                                                const mpn_factor_tree_t T)
+{
+    mp_ptr res;
+    mp_limb_t r;
+    long i, j, num;
+
+    if (T->depth == 0)
+        return 0;
+
+    res = malloc(sizeof(mp_limb_t) * T->len[0]);
+    mpn_factor_tree_rem(res, x, xsize, T);
+
+    num = 0;
+    for (j = 0; j < T->len[0]; j++)
+    {
+        r = res[j];
+        for (i = T->leaf_start[j]; i < T->leaf_start[j + 1]; i++)
+            if (r % T->primes[i] == 0UL)
+                found[num++] = i;
+    }
+
+    free(res);
+
+    return num;
+}
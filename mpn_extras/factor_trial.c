@@ -36,6 +36,38 @@ int mpn_factor_trial(mp_srcptr x, mp_size_t xsize, long start, long stop)
 {
     long i;
     n_compute_primes(stop);
+
+    /* Blocks of primes whose product is about as large as x */
+    if (xsize >= MPN_FACTOR_TREE_LIMBS_CUTOFF &&
+        stop - start >= MPN_FACTOR_TREE_PRIMES_CUTOFF)
+    {
+        mpn_factor_tree_t T;
+        long * found, block, num;
+
+        block = FLINT_MAX(MPN_FACTOR_TREE_PRIMES_PER_LIMB * xsize,
+                                            MPN_FACTOR_TREE_PRIMES_CUTOFF);
+        block = FLINT_MIN(block, stop - start);
+        found = malloc(sizeof(long) * block);
+
+        for (i = start; i < stop; i += block)
+        {
+            mpn_factor_tree_init(T, flint_primes + i,
+                                                FLINT_MIN(block, stop - i));
+            num = mpn_factor_tree_trial(found, x, xsize, T);
+            mpn_factor_tree_clear(T);
+
+            if (num)
+            {
+                i += found[0];
+                break;
+            }
+        }
+
+        free(found);
+
+        return (i < stop) ? i : 0;
+    }
+
     for (i = start; i < stop; i++)
     {
         if (mpn_divisible_1_p(x, xsize, flint_primes[i]))
@@ -0,0 +1,233 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+/******************************************************************************
+
+    Copyright (C) 2010 Fredrik Johansson
+    Copyright (C) 2010 William Hart
+
+******************************************************************************/
+
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "mpn_extras.h"
+#include "longlong.h"
+
+mp_size_t mpn_prod_limbs_direct(mp_limb_t * result, const mp_limb_t * factors,
+    mp_size_t n)
+{
+    mp_size_t k, len;
+    mp_limb_t top;
+    if (n < 1)
+    {
+        result[0] = 1UL;
+        return 1;
+    }
+    result[0] = factors[0];
+    len = 1;
+    for (k=1; k<n; k++)
+    {
+        top = mpn_mul_1(result, result, len, factors[k]);
+        if (top)
+        {
+            result[len] = top;
+            len++;
+        }
+    }
+    return len;
+}
+
+mp_size_t mpn_prod_limbs_balanced(mp_limb_t * result, mp_limb_t * scratch,
+                             const mp_limb_t * factors, mp_size_t n, ulong bits)
+{
+    mp_size_t an, bn, alen, blen, len;
+    mp_limb_t top;
+
+    if (n < MPN_PROD_LIMBS_DIRECT_CUTOFF)
+        return mpn_prod_limbs_direct(result, factors, n);
+
+    an = n/2;
+    bn = n - an;
+    
+    alen = mpn_prod_limbs_balanced(scratch, result, factors, an, bits);
+    blen = mpn_prod_limbs_balanced(scratch + alen, result, factors + an, bn, bits);
+    len = alen + blen;
+
+    if (alen <= blen)
+        top = mpn_mul(result, scratch + alen, blen, scratch, alen);
+    else
+        top = mpn_mul(result, scratch, alen, scratch + alen, blen);
+
+    if (!top)
+        len--;
+    
+    return len;
+}
+
+/*
+    Multiplies runs of consecutive factors together as long as the product
+    fits in a limb, writing the results to packed. Returns the number
+    of limbs written.
+*/
+static mp_size_t
+_mpn_prod_limbs_pack(mp_limb_t * packed, const mp_limb_t * factors,
+                                                                mp_size_t n)
+{
+    mp_size_t i, len;
+    mp_limb_t hi, lo, acc;
+
+    len = 0;
+    acc = factors[0];
+
+    for (i = 1; i < n; i++)
+    {
+        umul_ppmm(hi, lo, acc, factors[i]);
+
+        if (hi == 0UL)
+            acc = lo;
+        else
+        {
+            packed[len++] = acc;
+            acc = factors[i];
+        }
+    }
+
+    packed[len++] = acc;
+
+    return len;
+}
+
+typedef struct
+{
+    const mp_limb_t * factors;
+    mp_size_t n;
+    mp_limb_t ** prods;
+    mp_size_t * lens;
+    long num;
+}
+_prod_limbs_struct;
+
+/* Computes the product of the i-th of num equal chunks of the factors */
+static void
+_prod_limbs_leaf_worker(void * arg, long i)
+{
+    _prod_limbs_struct * s = (_prod_limbs_struct *) arg;
+    mp_size_t start, stop;
+    mp_limb_t * scratch;
+
+    start = (i * s->n) / s->num;
+    stop = ((i + 1) * s->n) / s->num;
+
+    s->prods[i] = malloc((stop - start + 1) * sizeof(mp_limb_t));
+    scratch = malloc((stop - start + 1) * sizeof(mp_limb_t));
+    s->lens[i] = mpn_prod_limbs_balanced(s->prods[i], scratch,
+                            s->factors + start, stop - start, FLINT_BITS);
+    free(scratch);
+}
+
+/* Replaces products 2i and 2i + 1 by their product, stored at 2i */
+static void
+_prod_limbs_node_worker(void * arg, long i)
+{
+    _prod_limbs_struct * s = (_prod_limbs_struct *) arg;
+    mp_limb_t * a = s->prods[2*i], * b = s->prods[2*i + 1], * c;
+    mp_size_t alen = s->lens[2*i], blen = s->lens[2*i + 1], len;
+
+    c = malloc((alen + blen) * sizeof(mp_limb_t));
+    MPN_MUL(c, len, a, alen, b, blen);
+
+    free(a);
+    free(b);
+    s->prods[2*i] = c;
+    s->lens[2*i] = len;
+}
+
+/*
+    Set result to the product of the given factors, return the
+    length of the result. It is assumed that no factors are zero.
+    bits must be set to some bound on the bit size of the entries
+    in factors. If no bound is known, simply use FLINT_BITS.
+    The result needs space for (n * bits) / FLINT_BITS + 2 limbs.
+*/
+mp_size_t mpn_prod_limbs(mp_limb_t * result, const mp_limb_t * factors,
+    mp_size_t n, ulong bits)
+{
+    mp_size_t len, m;
+    mp_limb_t * packed, * scratch;
+    long i, num, num_threads;
+
+    if (n < 1)
+        return mpn_prod_limbs_direct(result, factors, n);
+
+    packed = malloc(sizeof(mp_limb_t) * n);
+    m = _mpn_prod_limbs_pack(packed, factors, n);
+
+    num_threads = flint_get_num_threads();
+
+    if (m < MPN_PROD_LIMBS_DIRECT_CUTOFF)
+    {
+        len = mpn_prod_limbs_direct(result, packed, m);
+    }
+    else if (num_threads == 1 || m < MPN_PROD_LIMBS_PARALLEL_CUTOFF)
+    {
+        scratch = malloc(sizeof(mp_limb_t) * (m + 1));
+        len = mpn_prod_limbs_balanced(result, scratch, packed, m, FLINT_BITS);
+        free(scratch);
+    }
+    else
+    {
+        _prod_limbs_struct s;
+
+        /* A power of two number of chunks, at least one per thread */
+        for (num = 1; num < num_threads; num *= 2) ;
+
+        s.factors = packed;
+        s.n = m;
+        s.num = num;
+        s.prods = malloc(num * sizeof(mp_limb_t *));
+        s.lens = malloc(num * sizeof(mp_size_t));
+
+        flint_parallel_do(_prod_limbs_leaf_worker, &s, num, num_threads);
+
+        /* Combine the chunks up the tree, one level at a time */
+        for ( ; num > 1; num /= 2)
+        {
+            flint_parallel_do(_prod_limbs_node_worker, &s, num / 2,
+                                                            num_threads);
+
+            for (i = 1; i < num / 2; i++)
+            {
+                s.prods[i] = s.prods[2*i];
+                s.lens[i] = s.lens[2*i];
+            }
+        }
+
+        len = s.lens[0];
+        mpn_copyi(result, s.prods[0], len);
+
+        free(s.prods[0]);
+        free(s.prods);
+        free(s.lens);
+    }
+
+    free(packed);
+
+    return len;
+}
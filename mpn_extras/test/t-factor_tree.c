@@ -0,0 +1,160 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "mpn_extras.h"
+#include "ulong_extras.h"
+
+int main(void)
+{
+    long i, j, k, num, count, count2;
+    long * found;
+    mp_limb_t * primes, * res;
+    mp_size_t xsize;
+    mpz_t x;
+    mpn_factor_tree_t T;
+    flint_rand_t state;
+
+    printf("factor_tree....");
+    fflush(stdout);
+
+    flint_randinit(state);
+    _flint_rand_init_gmp(state);
+    mpz_init(x);
+
+    for (i = 0; i < 5000; i++)
+    {
+        ulong bits = n_randint(state, FLINT_BITS - 1) + 2;
+
+        /* Arbitrary nonzero moduli, or consecutive primes */
+        if (n_randint(state, 2))
+        {
+            num = n_randint(state, (i < 4800) ? 100 : 5000);
+            primes = malloc(sizeof(mp_limb_t) * (num + 1));
+            for (j = 0; j < num; j++)
+                primes[j] = n_randbits(state, n_randint(state, bits - 1) + 2);
+        }
+        else
+        {
+            primes = n_sieve_primes(&num, n_randint(state,
+                                            (i < 4800) ? 1000 : 100000) + 2);
+        }
+
+        mpz_rrandomb(x, state->gmp_state,
+            n_randint(state, (i < 4800) ? 2000 : 20000) + 1);
+        if (num > 0)
+            for (k = n_randint(state, 5); k > 0; k--)
+                mpz_mul_ui(x, x, primes[n_randint(state, num)]);
+        if (n_randint(state, 20) == 0)
+            mpz_set_ui(x, 0UL);
+        xsize = mpz_size(x);
+
+        flint_set_num_threads(n_randint(state, 4) + 1);
+        mpn_factor_tree_init(T, primes, num);
+
+        res = malloc(sizeof(mp_limb_t) * (num + 1));
+        mpn_factor_tree_rem(res, x->_mp_d, xsize, T);
+
+        for (j = 0; j < (T->depth ? T->len[0] : 0); j++)
+        {
+            if (res[j] != mpz_fdiv_ui(x, T->prods[0][j]))
+            {
+                printf("FAIL (rem):\n");
+                printf("i = %ld, num = %ld, xsize = %ld, j = %ld\n",
+                    i, num, xsize, j);
+                abort();
+            }
+        }
+
+        found = malloc(sizeof(long) * (num + 1));
+        count = mpn_factor_tree_trial(found, x->_mp_d, xsize, T);
+        flint_set_num_threads(1);
+
+        count2 = 0;
+        for (j = 0; j < num; j++)
+        {
+            if (mpz_divisible_ui_p(x, primes[j]))
+            {
+                if (count2 >= count || found[count2] != j)
+                {
+                    printf("FAIL (trial):\n");
+                    printf("i = %ld, num = %ld, xsize = %ld, j = %ld\n",
+                        i, num, xsize, j);
+                    abort();
+                }
+                count2++;
+            }
+        }
+
+        if (count != count2)
+        {
+            printf("FAIL (count):\n");
+            printf("i = %ld, count = %ld, count2 = %ld\n", i, count, count2);
+            abort();
+        }
+
+        mpn_factor_tree_clear(T);
+        free(res);
+        free(found);
+        free(primes);
+    }
+
+    /* mpn_factor_trial with and without the tree */
+    for (i = 0; i < 200; i++)
+    {
+        long start, stop;
+        int r1;
+
+        start = n_randint(state, 2000) + 1;
+        stop = start + n_randint(state, 3000);
+        n_compute_primes(stop);
+
+        mpz_rrandomb(x, state->gmp_state, n_randint(state, 10000) + 1);
+        mpz_setbit(x, 0);
+        for (k = n_randint(state, 3); k > 0; k--)
+            mpz_mul_ui(x, x, flint_primes[n_randint(state, stop) + 1]);
+        xsize = mpz_size(x);
+
+        r1 = mpn_factor_trial(x->_mp_d, xsize, start, stop);
+
+        for (j = start; j < stop; j++)
+            if (mpz_divisible_ui_p(x, flint_primes[j]))
+                break;
+        if (j == stop)
+            j = 0;
+
+        if (r1 != j)
+        {
+            printf("FAIL (factor_trial):\n");
+            printf("start = %ld, stop = %ld, r1 = %d, j = %ld\n",
+                start, stop, r1, j);
+            abort();
+        }
+    }
+
+    mpz_clear(x);
+    flint_randclear(state);
+
+    printf("PASS\n");
+    return 0;
+}
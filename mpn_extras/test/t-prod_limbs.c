@@ -0,0 +1,89 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "mpn_extras.h"
+#include "ulong_extras.h"
+
+int main(void)
+{
+    long i, j, n;
+    ulong bits;
+    mp_limb_t * factors, * res;
+    mp_size_t len;
+    mpz_t a, b;
+    flint_rand_t state;
+
+    printf("prod_limbs....");
+    fflush(stdout);
+
+    flint_randinit(state);
+    /* don't init a */
+    mpz_init(b);
+
+    for (i = 0; i < 1000; i++)
+    {
+        if (i < 900)
+            n = n_randint(state, 300);
+        else
+            n = n_randint(state, 20000);
+
+        bits = n_randint(state, FLINT_BITS) + 1;
+
+        factors = malloc((n + 1) * sizeof(mp_limb_t));
+        res = malloc(((n * bits) / FLINT_BITS + 2) * sizeof(mp_limb_t));
+
+        mpz_set_ui(b, 1UL);
+        for (j = 0; j < n; j++)
+        {
+            do {
+                factors[j] = n_randbits(state, n_randint(state, bits) + 1);
+            } while (factors[j] == 0UL);
+
+            mpz_mul_ui(b, b, factors[j]);
+        }
+
+        flint_set_num_threads(n_randint(state, 4) + 1);
+        len = mpn_prod_limbs(res, factors, n, bits);
+        flint_set_num_threads(1);
+
+        a->_mp_d = res;
+        a->_mp_size = len;
+
+        if (mpz_cmp(a, b) != 0)
+        {
+            printf("FAIL:\n");
+            printf("n = %ld, bits = %lu\n", n, bits);
+            abort();
+        }
+
+        free(factors);
+        free(res);
+    }
+
+    mpz_clear(b);
+    flint_randclear(state);
+
+    printf("PASS\n");
+    return 0;
+}
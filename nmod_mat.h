@@ -84,6 +84,14 @@ void nmod_mat_randtriu(nmod_mat_t mat, flint_rand_t state, int unit);
 
 void nmod_mat_print_pretty(const nmod_mat_t mat);
 
+int nmod_mat_fwrite_bin(FILE * file, const nmod_mat_t mat);
+
+int nmod_mat_fread_bin(FILE * file, nmod_mat_t mat);
+
+int nmod_mat_mmap_init(nmod_mat_t mat, FILE * file);
+
+void nmod_mat_mmap_clear(nmod_mat_t mat);
+
 int nmod_mat_equal(const nmod_mat_t mat1, const nmod_mat_t mat2);
 
 void nmod_mat_zero(nmod_mat_t mat);
@@ -188,8 +196,18 @@ long nmod_mat_nullspace(nmod_mat_t X, const nmod_mat_t A);
 #define NMOD_MAT_SOLVE_TRI_ROWS_CUTOFF 64
 #define NMOD_MAT_SOLVE_TRI_COLS_CUTOFF 64
 
-/* Cutoff between classical and recursive LU decomposition */
-#define NMOD_MAT_LU_RECURSIVE_CUTOFF 4
+/* Cutoff between classical and recursive LU decomposition; this is
+   the width of the panels factored by the classical algorithm. On
+   x86-64, 16 is 5-35% faster than 4 for n <= 512 and equal at n = 1000 */
+#define NMOD_MAT_LU_RECURSIVE_CUTOFF 16
+
+/* Minimum number of columns per thread when splitting LU updates and
+   triangular solves over several threads */
+#define NMOD_MAT_PARALLEL_COLS_CUTOFF 64
+
+/* Minimum number of rows of the right hand side, or of the block row
+   eliminated in an LU update, for using several threads */
+#define NMOD_MAT_PARALLEL_ROWS_CUTOFF 64
 
 /*
    Suggested initial modulus size for multimodular algorithms. This should
@@ -0,0 +1,58 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+
+#include <stdio.h>
+#include <mpir.h>
+#include "flint.h"
+#include "nmod_mat.h"
+
+int
+nmod_mat_fread_bin(FILE * file, nmod_mat_t mat)
+{
+    flint_bin_header_t h;
+    long i, len;
+
+    if (!flint_bin_read_header(h, file) || h->type != FLINT_BIN_NMOD_MAT
+        || (long) h->r < 0 || (long) h->c < 0 || h->mod == 0UL)
+        return 0;
+
+    nmod_mat_clear(mat);
+    nmod_mat_init(mat, h->r, h->c, h->mod);
+
+    len = h->r * h->c;
+
+    if (!flint_bin_read_limbs(mat->entries, len, file, h))
+    {
+        nmod_mat_zero(mat);
+        return 0;
+    }
+
+    for (i = 0; i < len; i++)
+    {
+        if (mat->entries[i] >= h->mod)
+        {
+            nmod_mat_zero(mat);
+            return 0;
+        }
+    }
+
+    return 1;
+}
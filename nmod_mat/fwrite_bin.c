@@ -0,0 +1,47 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+
+#include <stdio.h>
+#include <mpir.h>
+#include "flint.h"
+#include "nmod_mat.h"
+
+int
+nmod_mat_fwrite_bin(FILE * file, const nmod_mat_t mat)
+{
+    flint_bin_header_t h;
+    long i;
+
+    flint_bin_header_init(h, FLINT_BIN_NMOD_MAT, mat->r, mat->c, mat->mod.n);
+
+    if (!flint_bin_write_header(file, h))
+        return 0;
+
+    if (mat->c == 0)
+        return 1;
+
+    /* Row by row, since mat may be a window */
+    for (i = 0; i < mat->r; i++)
+        if (!flint_bin_write_limbs(file, mat->rows[i], mat->c))
+            return 0;
+
+    return 1;
+}
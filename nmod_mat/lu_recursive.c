@@ -59,10 +59,51 @@ _apply_permutation(long * AP, nmod_mat_t A, long * P,
 }
 
 
+typedef struct
+{
+    nmod_mat_struct * A;
+    long r1;
+    long n1;
+    long num_blocks;
+}
+_lu_update_struct;
+
+/*
+    Updates the i-th block of columns to the right of the pivot columns:
+    solves A00 X = A01 and subtracts A10 X from A11. Distinct blocks of
+    columns touch disjoint entries and can be processed concurrently.
+ */
+static void
+_lu_update_worker(void * arg, long i)
+{
+    _lu_update_struct * s = (_lu_update_struct *) arg;
+    nmod_mat_t A00, A10, A01, A11;
+    long m, r1, c0, c1, w;
+
+    m = s->A->r;
+    r1 = s->r1;
+    w = s->A->c - s->n1;
+    c0 = s->n1 + (i * w) / s->num_blocks;
+    c1 = s->n1 + ((i + 1) * w) / s->num_blocks;
+
+    nmod_mat_window_init(A00, s->A, 0, 0, r1, r1);
+    nmod_mat_window_init(A10, s->A, r1, 0, m, r1);
+    nmod_mat_window_init(A01, s->A, 0, c0, r1, c1);
+    nmod_mat_window_init(A11, s->A, r1, c0, m, c1);
+
+    nmod_mat_solve_tril(A01, A00, A01, 1);
+    nmod_mat_submul(A11, A11, A10, A01);
+
+    nmod_mat_window_clear(A00);
+    nmod_mat_window_clear(A10);
+    nmod_mat_window_clear(A01);
+    nmod_mat_window_clear(A11);
+}
+
 long 
 nmod_mat_lu_recursive(long * P, nmod_mat_t A, int rank_check)
 {
-    long i, j, m, n, r1, r2, n1;
+    long i, j, m, n, r1, r2, n1, num_threads, num_blocks;
     nmod_mat_t A0, A1, A00, A01, A10, A11;
     long * P1;
 
@@ -104,7 +145,21 @@ nmod_mat_lu_recursive(long * P, nmod_mat_t A, int rank_check)
     nmod_mat_window_init(A01, A, 0, n1, r1, n);
     nmod_mat_window_init(A11, A, r1, n1, m, n);
 
-    if (r1 != 0)
+    num_threads = flint_get_num_threads();
+    num_blocks = FLINT_MIN(num_threads, (n - n1) / NMOD_MAT_PARALLEL_COLS_CUTOFF);
+
+    if (r1 != 0 && num_blocks > 1 && r1 >= NMOD_MAT_PARALLEL_ROWS_CUTOFF)
+    {
+        _lu_update_struct s;
+
+        s.A = A;
+        s.r1 = r1;
+        s.n1 = n1;
+        s.num_blocks = num_blocks;
+
+        flint_parallel_do(_lu_update_worker, &s, num_blocks, num_threads);
+    }
+    else if (r1 != 0)
     {
         nmod_mat_solve_tril(A01, A00, A01, 1);
         nmod_mat_submul(A11, A11, A10, A01);
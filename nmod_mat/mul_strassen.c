@@ -31,12 +31,113 @@
 #include "nmod_vec.h"
 #include "nmod_mat.h"
 
+#define STRASSEN_BASECASE(a, b, c) \
+    ((a) <= NMOD_MAT_MUL_STRASSEN_INNER_CUTOFF || \
+     (b) <= NMOD_MAT_MUL_STRASSEN_INNER_CUTOFF || \
+     (c) <= NMOD_MAT_MUL_STRASSEN_INNER_CUTOFF)
+
+/*
+    Number of limbs of scratch space needed by _nmod_mat_mul_strassen
+    for an a x b by b x c product: two temporaries per recursion level,
+    which is at most 2/3 n^2 in total for n x n matrices.
+ */
+static long
+_nmod_mat_mul_strassen_work(long a, long b, long c)
+{
+    long anr, anc, bnc, size = 0;
 
-void
-nmod_mat_mul_strassen(nmod_mat_t C, const nmod_mat_t A, const nmod_mat_t B)
+    while (!STRASSEN_BASECASE(a, b, c))
+    {
+        anr = a / 2;
+        anc = b / 2;
+        bnc = c / 2;
+
+        size += anr * FLINT_MAX(bnc, anc) + anc * bnc;
+
+        a = anr;
+        b = anc;
+        c = bnc;
+    }
+
+    return size;
+}
+
+/* Sets up an r x c matrix with row stride s whose entries live in buf */
+static void
+_nmod_mat_init_buf(nmod_mat_t X, long r, long c, long s,
+                                         mp_ptr buf, nmod_t mod)
+{
+    long i;
+
+    X->entries = buf;
+    X->r = r;
+    X->c = c;
+    X->rows = malloc(sizeof(mp_ptr) * r);
+    X->mod = mod;
+
+    for (i = 0; i < r; i++)
+        X->rows[i] = buf + i * s;
+}
+
+/* Handles the last row and column of odd-sized operands */
+static void
+_nmod_mat_mul_strassen_peel(nmod_mat_t C, const nmod_mat_t A,
+                                          const nmod_mat_t B)
+{
+    long a, b, c, anr, anc, bnr, bnc;
+
+    a = A->r;
+    b = A->c;
+    c = B->c;
+
+    anr = a / 2;
+    anc = b / 2;
+    bnr = anc;
+    bnc = c / 2;
+
+    if (c > 2*bnc) /* A by last col of B -> last col of C */
+    {
+        nmod_mat_t Bc, Cc;
+        nmod_mat_window_init(Bc, B, 0, 2*bnc, b, c);
+        nmod_mat_window_init(Cc, C, 0, 2*bnc, a, c);
+        nmod_mat_mul_classical(Cc, A, Bc);
+        nmod_mat_window_clear(Bc);
+        nmod_mat_window_clear(Cc);
+    }
+
+    if (a > 2*anr) /* last row of A by B -> last row of C */
+    {
+        nmod_mat_t Ar, Cr;
+        nmod_mat_window_init(Ar, A, 2*anr, 0, a, b);
+        nmod_mat_window_init(Cr, C, 2*anr, 0, a, c);
+        nmod_mat_mul_classical(Cr, Ar, B);
+        nmod_mat_window_clear(Ar);
+        nmod_mat_window_clear(Cr);
+    }
+
+    if (b > 2*anc) /* last col of A by last row of B -> C */
+    {
+        nmod_mat_t Ac, Br, Cb;
+        nmod_mat_window_init(Ac, A, 0, 2*anc, 2*anr, b);
+        nmod_mat_window_init(Br, B, 2*bnr, 0, b, 2*bnc);
+        nmod_mat_window_init(Cb, C, 0, 0, 2*anr, 2*bnc);
+        nmod_mat_addmul_classical(Cb, Cb, Ac, Br);
+        nmod_mat_window_clear(Ac);
+        nmod_mat_window_clear(Br);
+        nmod_mat_window_clear(Cb);
+    }
+}
+
+/*
+    Serial Strassen-Winograd multiplication using the scratch space
+    work, of at least _nmod_mat_mul_strassen_work(a, b, c) limbs.
+ */
+static void
+_nmod_mat_mul_strassen(nmod_mat_t C, const nmod_mat_t A,
+                                     const nmod_mat_t B, mp_ptr work)
 {
     long a, b, c;
-    long anr, anc, bnr, bnc;
+    long anr, anc, bnr, bnc, s;
 
     nmod_mat_t A11, A12, A21, A22;
     nmod_mat_t B11, B12, B21, B22;
@@ -47,9 +148,7 @@ nmod_mat_mul_strassen(nmod_mat_t C, const nmod_mat_t A, const nmod_mat_t B)
     b = A->c;
     c = B->c;
 
-    if (a <= NMOD_MAT_MUL_STRASSEN_INNER_CUTOFF ||
-        b <= NMOD_MAT_MUL_STRASSEN_INNER_CUTOFF ||
-        c <= NMOD_MAT_MUL_STRASSEN_INNER_CUTOFF)
+    if (STRASSEN_BASECASE(a, b, c))
     {
         nmod_mat_mul(C, A, B);
         return;
@@ -75,10 +174,10 @@ nmod_mat_mul_strassen(nmod_mat_t C, const nmod_mat_t A, const nmod_mat_t B)
     nmod_mat_window_init(C21, C, anr, 0, 2*anr, bnc);
     nmod_mat_window_init(C22, C, anr, bnc, 2*anr, 2*bnc);
 
-    nmod_mat_init(X1, anr, FLINT_MAX(bnc, anc), A->mod.n);
-    nmod_mat_init(X2, anc, bnc, A->mod.n);
-
-    X1->c = anc;
+    s = FLINT_MAX(bnc, anc);
+    _nmod_mat_init_buf(X1, anr, anc, s, work, A->mod);
+    _nmod_mat_init_buf(X2, anc, bnc, bnc, work + anr * s, A->mod);
+    work += anr * s + anc * bnc;
 
     /*
         See Jean-Guillaume Dumas, Clement Pernet, Wei Zhou; "Memory
@@ -89,21 +188,21 @@ nmod_mat_mul_strassen(nmod_mat_t C, const nmod_mat_t A, const nmod_mat_t B)
 
     nmod_mat_sub(X1, A11, A21);
     nmod_mat_sub(X2, B22, B12);
-    nmod_mat_mul_strassen(C21, X1, X2);
+    _nmod_mat_mul_strassen(C21, X1, X2, work);
 
     nmod_mat_add(X1, A21, A22);
     nmod_mat_sub(X2, B12, B11);
-    nmod_mat_mul_strassen(C22, X1, X2);
+    _nmod_mat_mul_strassen(C22, X1, X2, work);
 
     nmod_mat_sub(X1, X1, A11);
     nmod_mat_sub(X2, B22, X2);
-    nmod_mat_mul_strassen(C12, X1, X2);
+    _nmod_mat_mul_strassen(C12, X1, X2, work);
 
     nmod_mat_sub(X1, A12, X1);
-    nmod_mat_mul_strassen(C11, X1, B22);
+    _nmod_mat_mul_strassen(C11, X1, B22, work);
 
     X1->c = bnc;
-    nmod_mat_mul_strassen(X1, A11, B11);
+    _nmod_mat_mul_strassen(X1, A11, B11, work);
 
     nmod_mat_add(C12, X1, C12);
     nmod_mat_add(C21, C12, C21);
@@ -111,16 +210,15 @@ nmod_mat_mul_strassen(nmod_mat_t C, const nmod_mat_t A, const nmod_mat_t B)
     nmod_mat_add(C22, C21, C22);
     nmod_mat_add(C12, C12, C11);
     nmod_mat_sub(X2, X2, B21);
-    nmod_mat_mul_strassen(C11, A22, X2);
-
-    nmod_mat_clear(X2);
+    _nmod_mat_mul_strassen(C11, A22, X2, work);
 
     nmod_mat_sub(C21, C21, C11);
-    nmod_mat_mul_strassen(C11, A12, B21);
+    _nmod_mat_mul_strassen(C11, A12, B21, work);
 
     nmod_mat_add(C11, X1, C11);
 
-    nmod_mat_clear(X1);
+    nmod_mat_window_clear(X1);
+    nmod_mat_window_clear(X2);
 
     nmod_mat_window_clear(A11);
     nmod_mat_window_clear(A12);
@@ -137,35 +235,183 @@ nmod_mat_mul_strassen(nmod_mat_t C, const nmod_mat_t A, const nmod_mat_t B)
     nmod_mat_window_clear(C21);
     nmod_mat_window_clear(C22);
 
-    if (c > 2*bnc) /* A by last col of B -> last col of C */
+    _nmod_mat_mul_strassen_peel(C, A, B);
+}
+
+typedef struct
+{
+    nmod_mat_struct A[4];
+    nmod_mat_struct B[4];
+    nmod_mat_struct * P[7];
+}
+_strassen_struct;
+
+/*
+    Computes the i-th of the seven Winograd products. Each task forms
+    its own operands, so that only the running tasks hold temporaries.
+ */
+static void
+_nmod_mat_mul_strassen_worker(void * arg, long i)
+{
+    _strassen_struct * s = (_strassen_struct *) arg;
+    nmod_mat_struct *A11, *A12, *A21, *A22, *B11, *B12, *B21, *B22;
+    nmod_mat_t S, T;
+
+    A11 = s->A + 0; A12 = s->A + 1; A21 = s->A + 2; A22 = s->A + 3;
+    B11 = s->B + 0; B12 = s->B + 1; B21 = s->B + 2; B22 = s->B + 3;
+
+    if (i == 2 || i >= 4)
+        nmod_mat_init(S, A11->r, A11->c, A11->mod.n);
+    if (i >= 3)
+        nmod_mat_init(T, B11->r, B11->c, B11->mod.n);
+
+    switch (i)
     {
-        nmod_mat_t Bc, Cc;
-        nmod_mat_window_init(Bc, B, 0, 2*bnc, b, c);
-        nmod_mat_window_init(Cc, C, 0, 2*bnc, a, c);
-        nmod_mat_mul_classical(Cc, A, Bc);
-        nmod_mat_window_clear(Bc);
-        nmod_mat_window_clear(Cc);
+        case 0:     /* P1 = A11 B11 */
+            nmod_mat_mul_strassen(s->P[0], A11, B11);
+            break;
+
+        case 1:     /* P2 = A12 B21 */
+            nmod_mat_mul_strassen(s->P[1], A12, B21);
+            break;
+
+        case 2:     /* P3 = (A12 - A21 - A22 + A11) B22 */
+            nmod_mat_sub(S, A12, A21);
+            nmod_mat_sub(S, S, A22);
+            nmod_mat_add(S, S, A11);
+            nmod_mat_mul_strassen(s->P[2], S, B22);
+            break;
+
+        case 3:     /* P4 = A22 (B22 - B12 + B11 - B21) */
+            nmod_mat_sub(T, B22, B12);
+            nmod_mat_add(T, T, B11);
+            nmod_mat_sub(T, T, B21);
+            nmod_mat_mul_strassen(s->P[3], A22, T);
+            break;
+
+        case 4:     /* P5 = (A21 + A22) (B12 - B11) */
+            nmod_mat_add(S, A21, A22);
+            nmod_mat_sub(T, B12, B11);
+            nmod_mat_mul_strassen(s->P[4], S, T);
+            break;
+
+        case 5:     /* P6 = (A21 + A22 - A11) (B22 - B12 + B11) */
+            nmod_mat_add(S, A21, A22);
+            nmod_mat_sub(S, S, A11);
+            nmod_mat_sub(T, B22, B12);
+            nmod_mat_add(T, T, B11);
+            nmod_mat_mul_strassen(s->P[5], S, T);
+            break;
+
+        default:    /* P7 = (A11 - A21) (B22 - B12) */
+            nmod_mat_sub(S, A11, A21);
+            nmod_mat_sub(T, B22, B12);
+            nmod_mat_mul_strassen(s->P[6], S, T);
     }
 
-    if (a > 2*anr) /* last row of A by B -> last row of C */
+    if (i == 2 || i >= 4)
+        nmod_mat_clear(S);
+    if (i >= 3)
+        nmod_mat_clear(T);
+}
+
+/*
+    One level of Strassen-Winograd with the seven products computed
+    in parallel. The products are written to the four blocks of C and
+    three further temporaries.
+ */
+static void
+_nmod_mat_mul_strassen_parallel(nmod_mat_t C, const nmod_mat_t A,
+                           const nmod_mat_t B, int num_threads)
+{
+    long anr, anc, bnc, i;
+    nmod_mat_t C11, C12, C21, C22, X, Y, Z;
+    _strassen_struct s;
+
+    anr = A->r / 2;
+    anc = A->c / 2;
+    bnc = B->c / 2;
+
+    for (i = 0; i < 4; i++)
     {
-        nmod_mat_t Ar, Cr;
-        nmod_mat_window_init(Ar, A, 2*anr, 0, a, b);
-        nmod_mat_window_init(Cr, C, 2*anr, 0, a, c);
-        nmod_mat_mul_classical(Cr, Ar, B);
-        nmod_mat_window_clear(Ar);
-        nmod_mat_window_clear(Cr);
+        nmod_mat_window_init(s.A + i, A, (i / 2) * anr, (i % 2) * anc,
+                                         (i / 2 + 1) * anr, (i % 2 + 1) * anc);
+        nmod_mat_window_init(s.B + i, B, (i / 2) * anc, (i % 2) * bnc,
+                                         (i / 2 + 1) * anc, (i % 2 + 1) * bnc);
     }
 
-    if (b > 2*anc) /* last col of A by last row of B -> C */
+    nmod_mat_window_init(C11, C, 0, 0, anr, bnc);
+    nmod_mat_window_init(C12, C, 0, bnc, anr, 2*bnc);
+    nmod_mat_window_init(C21, C, anr, 0, 2*anr, bnc);
+    nmod_mat_window_init(C22, C, anr, bnc, 2*anr, 2*bnc);
+
+    nmod_mat_init(X, anr, bnc, A->mod.n);
+    nmod_mat_init(Y, anr, bnc, A->mod.n);
+    nmod_mat_init(Z, anr, bnc, A->mod.n);
+
+    s.P[0] = X;
+    s.P[1] = C11;
+    s.P[2] = C12;
+    s.P[3] = C21;
+    s.P[4] = C22;
+    s.P[5] = Y;
+    s.P[6] = Z;
+
+    flint_parallel_do(_nmod_mat_mul_strassen_worker, &s, 7, num_threads);
+
+    nmod_mat_add(C11, C11, X);      /* C11 = P1 + P2 */
+    nmod_mat_add(Y, Y, X);          /* U2 = P1 + P6 */
+    nmod_mat_add(Z, Z, Y);          /* U3 = U2 + P7 */
+    nmod_mat_add(Y, Y, C22);        /* U4 = U2 + P5 */
+    nmod_mat_add(C12, C12, Y);      /* C12 = U4 + P3 */
+    nmod_mat_sub(C21, Z, C21);      /* C21 = U3 - P4 */
+    nmod_mat_add(C22, C22, Z);      /* C22 = U3 + P5 */
+
+    nmod_mat_clear(X);
+    nmod_mat_clear(Y);
+    nmod_mat_clear(Z);
+
+    for (i = 0; i < 4; i++)
     {
-        nmod_mat_t Ac, Br, Cb;
-        nmod_mat_window_init(Ac, A, 0, 2*anc, 2*anr, b);
-        nmod_mat_window_init(Br, B, 2*bnr, 0, b, 2*bnc);
-        nmod_mat_window_init(Cb, C, 0, 0, 2*anr, 2*bnc);
-        nmod_mat_addmul_classical(Cb, Cb, Ac, Br);
-        nmod_mat_window_clear(Ac);
-        nmod_mat_window_clear(Br);
-        nmod_mat_window_clear(Cb);
+        nmod_mat_window_clear(s.A + i);
+        nmod_mat_window_clear(s.B + i);
+    }
+
+    nmod_mat_window_clear(C11);
+    nmod_mat_window_clear(C12);
+    nmod_mat_window_clear(C21);
+    nmod_mat_window_clear(C22);
+
+    _nmod_mat_mul_strassen_peel(C, A, B);
+}
+
+void
+nmod_mat_mul_strassen(nmod_mat_t C, const nmod_mat_t A, const nmod_mat_t B)
+{
+    long a, b, c;
+    int num_threads;
+    mp_ptr work;
+
+    a = A->r;
+    b = A->c;
+    c = B->c;
+
+    if (STRASSEN_BASECASE(a, b, c))
+    {
+        nmod_mat_mul(C, A, B);
+        return;
+    }
+
+    num_threads = flint_get_num_threads();
+
+    if (num_threads > 1)
+    {
+        _nmod_mat_mul_strassen_parallel(C, A, B, num_threads);
+    }
+    else
+    {
+        work = malloc(sizeof(mp_limb_t) * _nmod_mat_mul_strassen_work(a, b, c));
+        _nmod_mat_mul_strassen(C, A, B, work);
+        free(work);
     }
 }
@@ -29,11 +29,58 @@
 #include "nmod_mat.h"
 #include "nmod_vec.h"
 
+typedef struct
+{
+    nmod_mat_struct * X;
+    const nmod_mat_struct * U;
+    const nmod_mat_struct * B;
+    int unit;
+    long num_blocks;
+}
+_solve_triu_struct;
+
+/* Solves for the i-th block of columns of X; the blocks are independent */
+static void
+_solve_triu_worker(void * arg, long i)
+{
+    _solve_triu_struct * s = (_solve_triu_struct *) arg;
+    nmod_mat_t XX, BB;
+    long c0, c1;
+
+    c0 = (i * s->B->c) / s->num_blocks;
+    c1 = ((i + 1) * s->B->c) / s->num_blocks;
+
+    nmod_mat_window_init(XX, s->X, 0, c0, s->X->r, c1);
+    nmod_mat_window_init(BB, s->B, 0, c0, s->B->r, c1);
+
+    nmod_mat_solve_triu(XX, s->U, BB, s->unit);
+
+    nmod_mat_window_clear(XX);
+    nmod_mat_window_clear(BB);
+}
+
 void
 nmod_mat_solve_triu(nmod_mat_t X, const nmod_mat_t U,
                                     const nmod_mat_t B, int unit)
 {
-    if (B->r < NMOD_MAT_SOLVE_TRI_ROWS_CUTOFF ||
+    long num_threads, num_blocks;
+
+    num_threads = flint_get_num_threads();
+    num_blocks = FLINT_MIN(num_threads, B->c / NMOD_MAT_PARALLEL_COLS_CUTOFF);
+
+    if (num_blocks > 1 && B->r >= NMOD_MAT_PARALLEL_ROWS_CUTOFF)
+    {
+        _solve_triu_struct s;
+
+        s.X = X;
+        s.U = U;
+        s.B = B;
+        s.unit = unit;
+        s.num_blocks = num_blocks;
+
+        flint_parallel_do(_solve_triu_worker, &s, num_blocks, num_threads);
+    }
+    else if (B->r < NMOD_MAT_SOLVE_TRI_ROWS_CUTOFF ||
         B->c < NMOD_MAT_SOLVE_TRI_COLS_CUTOFF)
     {
         nmod_mat_solve_triu_classical(X, U, B, unit);
@@ -0,0 +1,113 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "nmod_mat.h"
+#include "ulong_extras.h"
+
+int
+main(void)
+{
+    int i, j, result;
+    flint_rand_t state;
+
+    printf("fwrite_bin....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (i = 0; i < 500; i++)
+    {
+        nmod_mat_t A[3], W, B, C;
+        mp_limb_t mod;
+        long r, c;
+        FILE * file = tmpfile();
+
+        for (j = 0; j < 3; j++)
+        {
+            nmod_mat_init(A[j], n_randint(state, 40), n_randint(state, 40),
+                                            n_randtest_not_zero(state));
+            nmod_mat_randtest(A[j], state);
+        }
+
+        /* The second object is written from a window */
+        if (A[1]->c == 0)
+            r = c = 0;
+        else
+        {
+            r = n_randint(state, A[1]->r + 1);
+            c = n_randint(state, A[1]->c + 1);
+        }
+        nmod_mat_window_init(W, A[1], 0, 0, r, c);
+
+        result = nmod_mat_fwrite_bin(file, A[0])
+              && nmod_mat_fwrite_bin(file, W)
+              && nmod_mat_fwrite_bin(file, A[2]);
+        if (!result)
+        {
+            printf("FAIL (write):\n");
+            abort();
+        }
+        rewind(file);
+
+        nmod_mat_init(B, 0, 0, 2);
+
+        result = nmod_mat_fread_bin(file, B) && nmod_mat_equal(A[0], B)
+              && B->mod.n == A[0]->mod.n
+              && nmod_mat_mmap_init(C, file) && nmod_mat_equal(W, C)
+              && C->mod.n == W->mod.n
+              && nmod_mat_fread_bin(file, B) && nmod_mat_equal(A[2], B)
+              && !nmod_mat_fread_bin(file, B);
+        if (!result)
+        {
+            printf("FAIL (read):\n");
+            nmod_mat_print_pretty(A[0]), printf("\n\n");
+            nmod_mat_print_pretty(W), printf("\n\n");
+            nmod_mat_print_pretty(A[2]), printf("\n\n");
+            abort();
+        }
+
+        /* The mapped matrix may be modified in place */
+        mod = C->mod.n;
+        nmod_mat_neg(C, C);
+        nmod_mat_neg(C, C);
+        result = nmod_mat_equal(W, C) && C->mod.n == mod;
+        if (!result)
+        {
+            printf("FAIL (neg):\n");
+            abort();
+        }
+        nmod_mat_mmap_clear(C);
+
+        nmod_mat_window_clear(W);
+        for (j = 0; j < 3; j++)
+            nmod_mat_clear(A[j]);
+        nmod_mat_clear(B);
+        fclose(file);
+    }
+
+    flint_randclear(state);
+    printf("PASS\n");
+    return 0;
+}
@@ -162,6 +162,52 @@ main(void)
         }
     }
 
+    /* Large matrices, so that the updates are split over threads */
+    for (i = 0; i < 20; i++)
+    {
+        nmod_mat_t A, LU;
+        mp_limb_t mod;
+        long m, n, r, d, rank;
+        long * P;
+
+        flint_set_num_threads(n_randint(state, 4) + 1);
+
+        m = n_randint(state, 300);
+        n = n_randint(state, 300);
+        r = n_randint(state, FLINT_MIN(m, n) + 1);
+        mod = n_randtest_prime(state, 0);
+
+        nmod_mat_init(A, m, n, mod);
+        nmod_mat_randrank(A, state, r);
+
+        if (n_randint(state, 2))
+        {
+            d = n_randint(state, 2*m*n + 1);
+            nmod_mat_randops(A, d, state);
+        }
+
+        nmod_mat_init_set(LU, A);
+        P = malloc(sizeof(long) * m);
+
+        rank = nmod_mat_lu_recursive(P, LU, 0);
+
+        if (r != rank)
+        {
+            printf("FAIL:\n");
+            printf("wrong rank!\n");
+            printf("m = %ld, n = %ld, r = %ld, rank = %ld\n", m, n, r, rank);
+            abort();
+        }
+
+        check(P, LU, A, rank);
+
+        nmod_mat_clear(A);
+        nmod_mat_clear(LU);
+        free(P);
+    }
+
+    flint_set_num_threads(1);
+
     flint_randclear(state);
     printf("PASS\n");
     return 0;
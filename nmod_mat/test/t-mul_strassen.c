@@ -48,6 +48,8 @@ main(void)
 
         long m, k, n;
 
+        flint_set_num_threads(n_randint(state, 4) + 1);
+
         m = n_randint(state, 200);
         k = n_randint(state, 200);
         n = n_randint(state, 200);
@@ -79,6 +81,8 @@ main(void)
         nmod_mat_clear(D);
     }
 
+    flint_set_num_threads(1);
+
     flint_randclear(state);
 
     printf("PASS\n");
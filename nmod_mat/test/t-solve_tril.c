@@ -48,6 +48,8 @@ main(void)
         long rows, cols;
         int unit;
 
+        flint_set_num_threads(n_randint(state, 4) + 1);
+
         m = n_randtest_prime(state, 0);
         rows = n_randint(state, 200);
         cols = n_randint(state, 200);
@@ -97,6 +99,8 @@ main(void)
         nmod_mat_clear(Y);
     }
 
+    flint_set_num_threads(1);
+
     flint_randclear(state);
 
     printf("PASS\n");
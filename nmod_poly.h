@@ -40,6 +40,9 @@
 #define NMOD_DIVREM_DIVCONQUER_CUTOFF  300
 #define NMOD_DIV_DIVCONQUER_CUTOFF     300 /* Must be <= NMOD_DIV_DIVCONQUER_CUTOFF */
 
+#define NMOD_POLY_EVALUATE_VEC_FAST_CUTOFF  48
+#define NMOD_POLY_INTERPOLATE_VEC_FAST_CUTOFF  32
+
 static __inline__
 long NMOD_DIVREM_BC_ITCH(long lenA, long lenB, nmod_t mod)
 {
@@ -304,6 +307,14 @@ int nmod_poly_read(nmod_poly_t poly)
     return nmod_poly_fread(stdin, poly);
 }
 
+int nmod_poly_fwrite_bin(FILE * file, const nmod_poly_t poly);
+
+int nmod_poly_fread_bin(FILE * file, nmod_poly_t poly);
+
+int nmod_poly_mmap_init(nmod_poly_t poly, FILE * file);
+
+void nmod_poly_mmap_clear(nmod_poly_t poly);
+
 /* Shifting  *****************************************************************/
 
 void _nmod_poly_shift_left(mp_ptr res, mp_srcptr poly, long len, long k);
@@ -560,6 +571,15 @@ void _nmod_poly_integral(mp_ptr x_int, mp_srcptr x, long len, nmod_t mod);
 
 void nmod_poly_integral(nmod_poly_t x_int, const nmod_poly_t x);
 
+/* Subproduct trees  *********************************************************/
+
+mp_ptr * _nmod_poly_tree_alloc(long len);
+
+void _nmod_poly_tree_free(mp_ptr * tree, long len);
+
+void _nmod_poly_tree_build(mp_ptr * tree, mp_srcptr roots, long len,
+                                                                 nmod_t mod);
+
 /* Evaluation  ***************************************************************/
 
 mp_limb_t _nmod_poly_evaluate_nmod(mp_srcptr poly, 
@@ -573,6 +593,21 @@ void _nmod_poly_evaluate_nmod_vec(mp_ptr ys, mp_srcptr coeffs, long len,
 void nmod_poly_evaluate_nmod_vec(mp_ptr ys,
         const nmod_poly_t poly, mp_srcptr xs, long n);
 
+void _nmod_poly_evaluate_nmod_vec_iter(mp_ptr ys, mp_srcptr coeffs, long len,
+    mp_srcptr xs, long n, nmod_t mod);
+
+void nmod_poly_evaluate_nmod_vec_iter(mp_ptr ys,
+        const nmod_poly_t poly, mp_srcptr xs, long n);
+
+void _nmod_poly_evaluate_nmod_vec_fast_precomp(mp_ptr vs, mp_srcptr poly,
+    long plen, const mp_ptr * tree, long len, nmod_t mod);
+
+void _nmod_poly_evaluate_nmod_vec_fast(mp_ptr ys, mp_srcptr poly, long plen,
+    mp_srcptr xs, long n, nmod_t mod);
+
+void nmod_poly_evaluate_nmod_vec_fast(mp_ptr ys,
+        const nmod_poly_t poly, mp_srcptr xs, long n);
+
 /* Interpolation  ************************************************************/
 
 void _nmod_poly_interpolate_nmod_vec_newton(mp_ptr poly, mp_srcptr xs,
@@ -593,6 +628,19 @@ void _nmod_poly_interpolate_nmod_vec(mp_ptr poly, mp_srcptr xs,
 void nmod_poly_interpolate_nmod_vec(nmod_poly_t poly,
                         mp_srcptr xs, mp_srcptr ys, long n);
 
+void _nmod_poly_interpolation_weights(mp_ptr w, const mp_ptr * tree,
+                        long len, nmod_t mod);
+
+void _nmod_poly_interpolate_nmod_vec_fast_precomp(mp_ptr poly, mp_srcptr ys,
+                        const mp_ptr * tree, mp_srcptr weights, long len,
+                        nmod_t mod);
+
+void _nmod_poly_interpolate_nmod_vec_fast(mp_ptr poly, mp_srcptr xs,
+                        mp_srcptr ys, long len, nmod_t mod);
+
+void nmod_poly_interpolate_nmod_vec_fast(nmod_poly_t poly,
+                        mp_srcptr xs, mp_srcptr ys, long n);
+
 /* Composition  **************************************************************/
 
 void _nmod_poly_compose_horner(mp_ptr res, mp_srcptr poly1, 
@@ -29,7 +29,7 @@
 #include "nmod_poly.h"
 
 void
-_nmod_poly_evaluate_nmod_vec(mp_ptr ys, mp_srcptr coeffs, long len,
+_nmod_poly_evaluate_nmod_vec_iter(mp_ptr ys, mp_srcptr coeffs, long len,
     mp_srcptr xs, long n, nmod_t mod)
 {
     long i;
@@ -38,6 +38,24 @@ _nmod_poly_evaluate_nmod_vec(mp_ptr ys, mp_srcptr coeffs, long len,
         ys[i] = _nmod_poly_evaluate_nmod(coeffs, len, xs[i], mod);
 }
 
+void
+nmod_poly_evaluate_nmod_vec_iter(mp_ptr ys,
+        const nmod_poly_t poly, mp_srcptr xs, long n)
+{
+    _nmod_poly_evaluate_nmod_vec_iter(ys, poly->coeffs,
+                                        poly->length, xs, n, poly->mod);
+}
+
+void
+_nmod_poly_evaluate_nmod_vec(mp_ptr ys, mp_srcptr coeffs, long len,
+    mp_srcptr xs, long n, nmod_t mod)
+{
+    if (len < NMOD_POLY_EVALUATE_VEC_FAST_CUTOFF)
+        _nmod_poly_evaluate_nmod_vec_iter(ys, coeffs, len, xs, n, mod);
+    else
+        _nmod_poly_evaluate_nmod_vec_fast(ys, coeffs, len, xs, n, mod);
+}
+
 void
 nmod_poly_evaluate_nmod_vec(mp_ptr ys,
         const nmod_poly_t poly, mp_srcptr xs, long n)
@@ -0,0 +1,127 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "nmod_vec.h"
+#include "nmod_poly.h"
+
+void
+_nmod_poly_evaluate_nmod_vec_fast_precomp(mp_ptr vs, mp_srcptr poly,
+                    long plen, const mp_ptr * tree, long len, nmod_t mod)
+{
+    long height, tree_height, i, j, pow, left;
+    mp_ptr t, u, pb, pc, swap;
+
+    if (len == 0)
+        return;
+
+    if (plen < 2 || len == 1)
+    {
+        if (plen == 0)
+            _nmod_vec_zero(vs, len);
+        else if (plen == 1)
+            for (i = 0; i < len; i++)
+                vs[i] = poly[0];
+        else
+            vs[0] = _nmod_poly_evaluate_nmod(poly, plen,
+                                        nmod_neg(tree[0][0], mod), mod);
+        return;
+    }
+
+    t = _nmod_vec_init(2 * len);
+    u = _nmod_vec_init(2 * len);
+
+    /*
+        Initial reduction by the subproducts of the highest level of
+        degree less than plen; the polynomial may be longer or shorter
+        than the number of points.
+     */
+    tree_height = FLINT_BIT_COUNT(len - 1);
+    height = FLINT_BIT_COUNT(plen - 1) - 1;
+    if (height >= tree_height)
+        height = tree_height - 1;
+    pow = 1L << height;
+
+    for (i = j = 0; i < len; i += pow, j += pow + 1)
+        _nmod_poly_rem(t + i, poly, plen, tree[height] + j,
+                                        FLINT_MIN(pow, len - i) + 1, mod);
+
+    /* descend the remainder tree */
+    for (i = height - 1; i >= 0; i--)
+    {
+        pow = 1L << i;
+        left = len;
+        pb = tree[i];
+        pc = t;
+        swap = u;
+
+        while (left >= 2 * pow)
+        {
+            _nmod_poly_rem(swap, pc, 2 * pow, pb, pow + 1, mod);
+            _nmod_poly_rem(swap + pow, pc, 2 * pow, pb + pow + 1, pow + 1, mod);
+
+            left -= 2 * pow;
+            pb += 2 * pow + 2;
+            pc += 2 * pow;
+            swap += 2 * pow;
+        }
+
+        if (left > pow)
+        {
+            _nmod_poly_rem(swap, pc, left, pb, pow + 1, mod);
+            _nmod_poly_rem(swap + pow, pc, left, pb + pow + 1,
+                                                        left - pow + 1, mod);
+        }
+        else if (left > 0)
+            _nmod_vec_set(swap, pc, left);
+
+        swap = t;
+        t = u;
+        u = swap;
+    }
+
+    _nmod_vec_set(vs, t, len);
+
+    _nmod_vec_clear(t);
+    _nmod_vec_clear(u);
+}
+
+void
+_nmod_poly_evaluate_nmod_vec_fast(mp_ptr ys, mp_srcptr poly, long plen,
+                                       mp_srcptr xs, long n, nmod_t mod)
+{
+    mp_ptr * tree;
+
+    tree = _nmod_poly_tree_alloc(n);
+    _nmod_poly_tree_build(tree, xs, n, mod);
+    _nmod_poly_evaluate_nmod_vec_fast_precomp(ys, poly, plen, tree, n, mod);
+    _nmod_poly_tree_free(tree, n);
+}
+
+void
+nmod_poly_evaluate_nmod_vec_fast(mp_ptr ys, const nmod_poly_t poly,
+                                                    mp_srcptr xs, long n)
+{
+    _nmod_poly_evaluate_nmod_vec_fast(ys, poly->coeffs, poly->length,
+                                                         xs, n, poly->mod);
+}
@@ -0,0 +1,52 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+
+#include <stdio.h>
+#include <mpir.h>
+#include "flint.h"
+#include "nmod_poly.h"
+
+int
+nmod_poly_fread_bin(FILE * file, nmod_poly_t poly)
+{
+    flint_bin_header_t h;
+    long i, len;
+
+    if (!flint_bin_read_header(h, file) || h->type != FLINT_BIN_NMOD_POLY
+        || h->c != 1 || (long) h->r < 0 || h->mod == 0UL)
+        return 0;
+
+    len = h->r;
+    nmod_poly_clear(poly);
+    nmod_poly_init2(poly, h->mod, len);
+
+    if (!flint_bin_read_limbs(poly->coeffs, len, file, h))
+        return 0;
+
+    for (i = 0; i < len; i++)
+        if (poly->coeffs[i] >= h->mod)
+            return 0;
+
+    poly->length = len;
+    _nmod_poly_normalise(poly);
+
+    return 1;
+}
@@ -0,0 +1,37 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+
+#include <stdio.h>
+#include <mpir.h>
+#include "flint.h"
+#include "nmod_poly.h"
+
+int
+nmod_poly_fwrite_bin(FILE * file, const nmod_poly_t poly)
+{
+    flint_bin_header_t h;
+
+    flint_bin_header_init(h, FLINT_BIN_NMOD_POLY, poly->length, 1,
+                                                            poly->mod.n);
+
+    return flint_bin_write_header(file, h)
+        && flint_bin_write_limbs(file, poly->coeffs, poly->length);
+}
@@ -0,0 +1,47 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+
+#include <stdio.h>
+#include <mpir.h>
+#include "flint.h"
+#include "nmod_poly.h"
+
+int
+nmod_poly_mmap_init(nmod_poly_t poly, FILE * file)
+{
+    flint_bin_header_t h;
+    mp_ptr data;
+
+    if (!flint_bin_read_header(h, file) || h->type != FLINT_BIN_NMOD_POLY
+        || h->c != 1 || (long) h->r < 0 || h->mod == 0UL)
+        return 0;
+
+    data = flint_bin_mmap(file, h);
+    if (data == NULL)
+        return 0;
+
+    poly->coeffs = data;
+    poly->alloc = h->r;
+    poly->length = h->r;
+    nmod_init(&poly->mod, h->mod);
+
+    return 1;
+}
@@ -0,0 +1,95 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "nmod_poly.h"
+#include "ulong_extras.h"
+
+int
+main(void)
+{
+    int i, j, result;
+    flint_rand_t state;
+
+    printf("fwrite_bin....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (i = 0; i < 500; i++)
+    {
+        nmod_poly_t a[3], b, c;
+        FILE * file = tmpfile();
+
+        for (j = 0; j < 3; j++)
+        {
+            nmod_poly_init(a[j], n_randtest_not_zero(state));
+            nmod_poly_randtest(a[j], state, n_randint(state, 1000));
+            result = nmod_poly_fwrite_bin(file, a[j]);
+            if (!result)
+            {
+                printf("FAIL (write):\n");
+                abort();
+            }
+        }
+        rewind(file);
+
+        nmod_poly_init(b, 2);
+
+        result = nmod_poly_fread_bin(file, b) && nmod_poly_equal(a[0], b)
+              && b->mod.n == a[0]->mod.n
+              && nmod_poly_mmap_init(c, file) && nmod_poly_equal(a[1], c)
+              && c->mod.n == a[1]->mod.n
+              && nmod_poly_fread_bin(file, b) && nmod_poly_equal(a[2], b)
+              && !nmod_poly_fread_bin(file, b);
+        if (!result)
+        {
+            printf("FAIL (read):\n");
+            nmod_poly_print(a[0]), printf("\n\n");
+            nmod_poly_print(a[1]), printf("\n\n");
+            nmod_poly_print(a[2]), printf("\n\n");
+            abort();
+        }
+
+        /* The mapped polynomial may be modified in place */
+        nmod_poly_neg(c, c);
+        nmod_poly_neg(c, c);
+        result = nmod_poly_equal(a[1], c);
+        if (!result)
+        {
+            printf("FAIL (neg):\n");
+            abort();
+        }
+        nmod_poly_mmap_clear(c);
+
+        for (j = 0; j < 3; j++)
+            nmod_poly_clear(a[j]);
+        nmod_poly_clear(b);
+        fclose(file);
+    }
+
+    flint_randclear(state);
+    printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,98 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "nmod_vec.h"
+#include "nmod_poly.h"
+
+mp_ptr *
+_nmod_poly_tree_alloc(long len)
+{
+    mp_ptr * tree = NULL;
+
+    if (len)
+    {
+        long i, height = FLINT_BIT_COUNT(len - 1);
+
+        tree = malloc(sizeof(mp_ptr) * (height + 1));
+        for (i = 0; i <= height; i++)
+            tree[i] = _nmod_vec_init(len + (len >> i) + 1);
+    }
+
+    return tree;
+}
+
+void
+_nmod_poly_tree_free(mp_ptr * tree, long len)
+{
+    if (len)
+    {
+        long i, height = FLINT_BIT_COUNT(len - 1);
+
+        for (i = 0; i <= height; i++)
+            _nmod_vec_clear(tree[i]);
+
+        free(tree);
+    }
+}
+
+void
+_nmod_poly_tree_build(mp_ptr * tree, mp_srcptr roots, long len, nmod_t mod)
+{
+    long height, pow, left, i;
+    mp_ptr pa, pb;
+
+    if (len == 0)
+        return;
+
+    height = FLINT_BIT_COUNT(len - 1);
+
+    /* level 0 holds the linear factors x - roots[i] */
+    for (i = 0; i < len; i++)
+    {
+        tree[0][2 * i + 1] = 1UL;
+        tree[0][2 * i] = nmod_neg(roots[i], mod);
+    }
+
+    /* level i + 1 holds products of pairs of level i */
+    for (i = 0; i < height; i++)
+    {
+        left = len;
+        pow = 1L << i;
+        pa = tree[i];
+        pb = tree[i + 1];
+
+        while (left >= 2 * pow)
+        {
+            _nmod_poly_mul(pb, pa, pow + 1, pa + pow + 1, pow + 1, mod);
+            left -= 2 * pow;
+            pa += 2 * pow + 2;
+            pb += 2 * pow + 1;
+        }
+
+        if (left > pow)
+            _nmod_poly_mul(pb, pa, pow + 1, pa + pow + 1, left - pow + 1, mod);
+        else if (left > 0)
+            _nmod_vec_set(pb, pa, left + 1);
+    }
+}
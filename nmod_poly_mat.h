@@ -150,6 +150,9 @@ void nmod_poly_mat_mul_classical(nmod_poly_mat_t C, const nmod_poly_mat_t A,
 void nmod_poly_mat_mul_KS(nmod_poly_mat_t C, const nmod_poly_mat_t A,
     const nmod_poly_mat_t B);
 
+void nmod_poly_mat_mul_interpolate(nmod_poly_mat_t C,
+    const nmod_poly_mat_t A, const nmod_poly_mat_t B);
+
 void nmod_poly_mat_sqr(nmod_poly_mat_t B, const nmod_poly_mat_t A);
 
 void nmod_poly_mat_sqr_classical(nmod_poly_mat_t B, const nmod_poly_mat_t A);
@@ -162,6 +165,12 @@ void nmod_poly_mat_pow(nmod_poly_mat_t B, const nmod_poly_mat_t A, ulong exp);
 
 void nmod_poly_mat_evaluate_nmod(nmod_mat_t B, const nmod_poly_mat_t A, mp_limb_t x);
 
+void nmod_poly_mat_evaluate_nmod_vec(nmod_mat_struct * B,
+                    const nmod_poly_mat_t A, mp_srcptr xs, long len);
+
+void nmod_poly_mat_interpolate_nmod_vec(nmod_poly_mat_t A, mp_srcptr xs,
+                    const nmod_mat_struct * B, long len);
+
 /* Row reduction *************************************************************/
 
 long nmod_poly_mat_find_pivot_any(const nmod_poly_mat_t mat,
@@ -203,6 +212,9 @@ int nmod_poly_mat_solve(nmod_poly_mat_t X, nmod_poly_t den,
 int nmod_poly_mat_solve_fflu(nmod_poly_mat_t X, nmod_poly_t den,
                             const nmod_poly_mat_t A, const nmod_poly_mat_t B);
 
+int nmod_poly_mat_solve_interpolate(nmod_poly_mat_t X, nmod_poly_t den,
+                            const nmod_poly_mat_t A, const nmod_poly_mat_t B);
+
 void nmod_poly_mat_solve_fflu_precomp(nmod_poly_mat_t X,
                     const long * perm,
                     const nmod_poly_mat_t FFLU, const nmod_poly_mat_t B);
@@ -23,18 +23,34 @@
 
 ******************************************************************************/
 
+#include <stdlib.h>
 #include <mpir.h>
 #include "flint.h"
 #include "nmod_vec.h"
 #include "nmod_poly.h"
 #include "nmod_poly_mat.h"
 
+typedef struct
+{
+    nmod_mat_struct * X;
+    mp_ptr d;
+}
+_det_interpolate_struct;
+
+static void
+_det_interpolate_worker(void * arg, long i)
+{
+    _det_interpolate_struct * s = (_det_interpolate_struct *) arg;
+
+    s->d[i] = _nmod_mat_det(s->X + i);
+}
+
 void
 nmod_poly_mat_det_interpolate(nmod_poly_t det, const nmod_poly_mat_t A)
 {
+    _det_interpolate_struct s;
+    nmod_mat_struct * X;
     long i, l, n, len;
-
-    nmod_mat_t X;
     mp_ptr x, d;
 
     n = A->r;
@@ -65,18 +81,28 @@ nmod_poly_mat_det_interpolate(nmod_poly_t det, const nmod_poly_mat_t A)
 
     x = _nmod_vec_init(len);
     d = _nmod_vec_init(len);
-    nmod_mat_init(X, n, n, nmod_poly_mat_modulus(A));
+    X = malloc(sizeof(nmod_mat_struct) * len);
 
     for (i = 0; i < len; i++)
     {
         x[i] = i;
-        nmod_poly_mat_evaluate_nmod(X, A, x[i]);
-        d[i] = nmod_mat_det(X);
+        nmod_mat_init(X + i, n, n, nmod_poly_mat_modulus(A));
     }
 
+    nmod_poly_mat_evaluate_nmod_vec(X, A, x, len);
+
+    /* The determinants at different points are independent */
+    s.X = X;
+    s.d = d;
+    flint_parallel_do(_det_interpolate_worker, &s, len,
+                                            flint_get_num_threads());
+
     nmod_poly_interpolate_nmod_vec(det, x, d, len);
 
+    for (i = 0; i < len; i++)
+        nmod_mat_clear(X + i);
+
+    free(X);
     _nmod_vec_clear(x);
     _nmod_vec_clear(d);
-    nmod_mat_clear(X);
 }
@@ -0,0 +1,93 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "nmod_vec.h"
+#include "nmod_poly.h"
+#include "nmod_poly_mat.h"
+
+typedef struct
+{
+    nmod_mat_struct * B;
+    const nmod_poly_mat_struct * A;
+    const mp_ptr * tree;
+    mp_srcptr xs;
+    long len;
+}
+_evaluate_vec_struct;
+
+/* Evaluates row i of A at all points */
+static void
+_evaluate_vec_worker(void * arg, long i)
+{
+    _evaluate_vec_struct * s = (_evaluate_vec_struct *) arg;
+    const nmod_poly_struct * p;
+    mp_ptr v;
+    long j, k;
+
+    v = _nmod_vec_init(s->len);
+
+    for (j = 0; j < s->A->c; j++)
+    {
+        p = nmod_poly_mat_entry(s->A, i, j);
+
+        if (p->length < NMOD_POLY_EVALUATE_VEC_FAST_CUTOFF)
+            _nmod_poly_evaluate_nmod_vec_iter(v, p->coeffs, p->length,
+                                                s->xs, s->len, p->mod);
+        else
+            _nmod_poly_evaluate_nmod_vec_fast_precomp(v, p->coeffs,
+                                    p->length, s->tree, s->len, p->mod);
+
+        for (k = 0; k < s->len; k++)
+            nmod_mat_entry(s->B + k, i, j) = v[k];
+    }
+
+    _nmod_vec_clear(v);
+}
+
+void
+nmod_poly_mat_evaluate_nmod_vec(nmod_mat_struct * B, const nmod_poly_mat_t A,
+                                                    mp_srcptr xs, long len)
+{
+    _evaluate_vec_struct s;
+    nmod_t mod;
+    mp_ptr * tree;
+
+    if (len == 0 || nmod_poly_mat_is_empty(A))
+        return;
+
+    nmod_init(&mod, nmod_poly_mat_modulus(A));
+
+    tree = _nmod_poly_tree_alloc(len);
+    _nmod_poly_tree_build(tree, xs, len, mod);
+
+    s.B = B;
+    s.A = A;
+    s.tree = tree;
+    s.xs = xs;
+    s.len = len;
+
+    flint_parallel_do(_evaluate_vec_worker, &s, A->r,
+                                            flint_get_num_threads());
+
+    _nmod_poly_tree_free(tree, len);
+}
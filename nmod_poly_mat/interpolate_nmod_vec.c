@@ -0,0 +1,102 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "nmod_vec.h"
+#include "nmod_poly.h"
+#include "nmod_poly_mat.h"
+
+typedef struct
+{
+    nmod_poly_mat_struct * A;
+    const nmod_mat_struct * B;
+    const mp_ptr * tree;
+    mp_srcptr weights;
+    long len;
+}
+_interpolate_vec_struct;
+
+/* Interpolates row i of A from the values at all points */
+static void
+_interpolate_vec_worker(void * arg, long i)
+{
+    _interpolate_vec_struct * s = (_interpolate_vec_struct *) arg;
+    nmod_poly_struct * p;
+    mp_ptr v;
+    long j, k;
+
+    v = _nmod_vec_init(s->len);
+
+    for (j = 0; j < s->A->c; j++)
+    {
+        p = nmod_poly_mat_entry(s->A, i, j);
+
+        for (k = 0; k < s->len; k++)
+            v[k] = nmod_mat_entry(s->B + k, i, j);
+
+        nmod_poly_fit_length(p, s->len);
+        _nmod_poly_interpolate_nmod_vec_fast_precomp(p->coeffs, v,
+                                s->tree, s->weights, s->len, p->mod);
+        p->length = s->len;
+        _nmod_poly_normalise(p);
+    }
+
+    _nmod_vec_clear(v);
+}
+
+void
+nmod_poly_mat_interpolate_nmod_vec(nmod_poly_mat_t A, mp_srcptr xs,
+                                    const nmod_mat_struct * B, long len)
+{
+    _interpolate_vec_struct s;
+    nmod_t mod;
+    mp_ptr * tree;
+    mp_ptr w;
+
+    if (nmod_poly_mat_is_empty(A))
+        return;
+
+    if (len == 0)
+    {
+        nmod_poly_mat_zero(A);
+        return;
+    }
+
+    nmod_init(&mod, nmod_poly_mat_modulus(A));
+
+    tree = _nmod_poly_tree_alloc(len);
+    _nmod_poly_tree_build(tree, xs, len, mod);
+    w = _nmod_vec_init(len);
+    _nmod_poly_interpolation_weights(w, tree, len, mod);
+
+    s.A = A;
+    s.B = B;
+    s.tree = tree;
+    s.weights = w;
+    s.len = len;
+
+    flint_parallel_do(_interpolate_vec_worker, &s, A->r,
+                                            flint_get_num_threads());
+
+    _nmod_vec_clear(w);
+    _nmod_poly_tree_free(tree, len);
+}
@@ -29,20 +29,40 @@
 
 #define KS_MIN_DIM 10
 #define KS_MAX_LENGTH 128
+/*
+    From profile/p-interpolate.c with a 62-bit prime: at dimension 32
+    interpolation beats KS at lengths 4, 16, 64 (0.91 vs 2.13 ms,
+    12.8 vs 17.8 ms, 158 vs 177 ms); at dimension 24 it loses for
+    lengths 16 and 64 (8.37 vs 7.52 ms, 89.6 vs 75.5 ms).
+*/
+#define INTERPOLATE_MIN_DIM 32
 
 void
 nmod_poly_mat_mul(nmod_poly_mat_t C, const nmod_poly_mat_t A,
     const nmod_poly_mat_t B)
 {
-    long ar, bc, br;
+    long ar, bc, br, A_len, B_len;
 
     ar = A->r;
     br = B->r;
     bc = B->c;
 
-    if (ar < KS_MIN_DIM || br < KS_MIN_DIM || bc < KS_MIN_DIM
-        || nmod_poly_mat_max_length(A) > KS_MAX_LENGTH
-        || nmod_poly_mat_max_length(B) > KS_MAX_LENGTH)
+    if (ar < KS_MIN_DIM || br < KS_MIN_DIM || bc < KS_MIN_DIM)
+    {
+        nmod_poly_mat_mul_classical(C, A, B);
+        return;
+    }
+
+    A_len = nmod_poly_mat_max_length(A);
+    B_len = nmod_poly_mat_max_length(B);
+
+    if (ar >= INTERPOLATE_MIN_DIM && br >= INTERPOLATE_MIN_DIM
+        && bc >= INTERPOLATE_MIN_DIM
+        && A_len + B_len - 1 <= nmod_poly_mat_modulus(A))
+    {
+        nmod_poly_mat_mul_interpolate(C, A, B);
+    }
+    else if (A_len > KS_MAX_LENGTH || B_len > KS_MAX_LENGTH)
     {
         nmod_poly_mat_mul_classical(C, A, B);
     }
@@ -0,0 +1,117 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "nmod_vec.h"
+#include "nmod_poly.h"
+#include "nmod_poly_mat.h"
+
+typedef struct
+{
+    nmod_mat_struct * C;
+    const nmod_mat_struct * A;
+    const nmod_mat_struct * B;
+}
+_mul_interpolate_struct;
+
+static void
+_mul_interpolate_worker(void * arg, long i)
+{
+    _mul_interpolate_struct * s = (_mul_interpolate_struct *) arg;
+
+    nmod_mat_mul(s->C + i, s->A + i, s->B + i);
+}
+
+void
+nmod_poly_mat_mul_interpolate(nmod_poly_mat_t C, const nmod_poly_mat_t A,
+    const nmod_poly_mat_t B)
+{
+    _mul_interpolate_struct s;
+    nmod_mat_struct *C_mod, *A_mod, *B_mod;
+    long i, len, A_len, B_len, ar, bc, br;
+    mp_limb_t n;
+    mp_ptr x;
+
+    ar = A->r;
+    br = B->r;
+    bc = B->c;
+
+    if (ar == 0 || bc == 0)
+        return;
+
+    A_len = nmod_poly_mat_max_length(A);
+    B_len = nmod_poly_mat_max_length(B);
+
+    if (br == 0 || A_len == 0 || B_len == 0)
+    {
+        nmod_poly_mat_zero(C);
+        return;
+    }
+
+    len = A_len + B_len - 1;
+
+    n = nmod_poly_mat_modulus(A);
+
+    /* Not enough points to interpolate */
+    if (len > n)
+    {
+        nmod_poly_mat_mul_KS(C, A, B);
+        return;
+    }
+
+    x = _nmod_vec_init(len);
+    A_mod = malloc(sizeof(nmod_mat_struct) * len);
+    B_mod = malloc(sizeof(nmod_mat_struct) * len);
+    C_mod = malloc(sizeof(nmod_mat_struct) * len);
+
+    for (i = 0; i < len; i++)
+    {
+        x[i] = i;
+        nmod_mat_init(A_mod + i, ar, br, n);
+        nmod_mat_init(B_mod + i, br, bc, n);
+        nmod_mat_init(C_mod + i, ar, bc, n);
+    }
+
+    nmod_poly_mat_evaluate_nmod_vec(A_mod, A, x, len);
+    nmod_poly_mat_evaluate_nmod_vec(B_mod, B, x, len);
+
+    /* The products at different points are independent */
+    s.C = C_mod;
+    s.A = A_mod;
+    s.B = B_mod;
+    flint_parallel_do(_mul_interpolate_worker, &s, len,
+                                            flint_get_num_threads());
+
+    nmod_poly_mat_interpolate_nmod_vec(C, x, C_mod, len);
+
+    for (i = 0; i < len; i++)
+    {
+        nmod_mat_clear(A_mod + i);
+        nmod_mat_clear(B_mod + i);
+        nmod_mat_clear(C_mod + i);
+    }
+
+    free(A_mod);
+    free(B_mod);
+    free(C_mod);
+    _nmod_vec_clear(x);
+}
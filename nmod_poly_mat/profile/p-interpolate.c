@@ -0,0 +1,211 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "profiler.h"
+#include "flint.h"
+#include "nmod_poly_mat.h"
+#include "ulong_extras.h"
+#include "fmpz.h"
+
+typedef struct
+{
+    long dim;
+    long len;
+    int algorithm;
+} mat_interpolate_t;
+
+void sample_mul(void * arg, ulong count)
+{
+    mat_interpolate_t * params = (mat_interpolate_t *) arg;
+    long i, dim = params->dim;
+    mp_limb_t n = n_nextprime(1UL << (FLINT_BITS - 2), 0);
+    flint_rand_t state;
+    nmod_poly_mat_t A, B, C;
+
+    flint_randinit(state);
+
+    nmod_poly_mat_init(A, dim, dim, n);
+    nmod_poly_mat_init(B, dim, dim, n);
+    nmod_poly_mat_init(C, dim, dim, n);
+    nmod_poly_mat_randtest(A, state, params->len);
+    nmod_poly_mat_randtest(B, state, params->len);
+
+    prof_start();
+
+    if (params->algorithm == 0)
+        for (i = 0; i < count; i++)
+            nmod_poly_mat_mul_KS(C, A, B);
+    else
+        for (i = 0; i < count; i++)
+            nmod_poly_mat_mul_interpolate(C, A, B);
+
+    prof_stop();
+
+    nmod_poly_mat_clear(A);
+    nmod_poly_mat_clear(B);
+    nmod_poly_mat_clear(C);
+
+    flint_randclear(state);
+}
+
+void sample_det(void * arg, ulong count)
+{
+    mat_interpolate_t * params = (mat_interpolate_t *) arg;
+    long i, dim = params->dim;
+    mp_limb_t n = n_nextprime(1UL << (FLINT_BITS - 2), 0);
+    flint_rand_t state;
+    nmod_poly_mat_t A;
+    nmod_poly_t det;
+
+    flint_randinit(state);
+
+    nmod_poly_mat_init(A, dim, dim, n);
+    nmod_poly_init(det, n);
+    nmod_poly_mat_randtest(A, state, params->len);
+
+    prof_start();
+
+    if (params->algorithm == 0)
+        for (i = 0; i < count; i++)
+            nmod_poly_mat_det_fflu(det, A);
+    else
+        for (i = 0; i < count; i++)
+            nmod_poly_mat_det_interpolate(det, A);
+
+    prof_stop();
+
+    nmod_poly_mat_clear(A);
+    nmod_poly_clear(det);
+
+    flint_randclear(state);
+}
+
+void sample_solve(void * arg, ulong count)
+{
+    mat_interpolate_t * params = (mat_interpolate_t *) arg;
+    long i, dim = params->dim;
+    mp_limb_t n = n_nextprime(1UL << (FLINT_BITS - 2), 0);
+    flint_rand_t state;
+    nmod_poly_mat_t A, B, X;
+    nmod_poly_t den;
+
+    flint_randinit(state);
+
+    nmod_poly_mat_init(A, dim, dim, n);
+    nmod_poly_mat_init(B, dim, 1, n);
+    nmod_poly_mat_init(X, dim, 1, n);
+    nmod_poly_init(den, n);
+    nmod_poly_mat_randtest(A, state, params->len);
+    nmod_poly_mat_randtest(B, state, params->len);
+
+    prof_start();
+
+    if (params->algorithm == 0)
+        for (i = 0; i < count; i++)
+            nmod_poly_mat_solve_fflu(X, den, A, B);
+    else
+        for (i = 0; i < count; i++)
+            nmod_poly_mat_solve_interpolate(X, den, A, B);
+
+    prof_stop();
+
+    nmod_poly_mat_clear(A);
+    nmod_poly_mat_clear(B);
+    nmod_poly_mat_clear(X);
+    nmod_poly_clear(den);
+
+    flint_randclear(state);
+}
+
+int main(void)
+{
+    double min_old, min_new, max;
+    mat_interpolate_t params;
+    long dim, len;
+    static const long mul_dims[] = {16, 24, 32, 48, 64, 0};
+    static const long det_dims[] = {4, 6, 8, 10, 12, 16, 0};
+    int d;
+
+    printf("nmod_poly_mat_mul: mul_KS vs mul_interpolate\n");
+
+    for (d = 0; (dim = mul_dims[d]) != 0; d++)
+    {
+        for (len = 4; len <= 64; len *= 4)
+        {
+            params.dim = dim;
+            params.len = len;
+
+            params.algorithm = 0;
+            prof_repeat(&min_old, &max, sample_mul, &params);
+
+            params.algorithm = 1;
+            prof_repeat(&min_new, &max, sample_mul, &params);
+
+            printf("dim = %ld, len = %ld, KS %.2f us interpolate %.2f us\n",
+                dim, len, min_old, min_new);
+        }
+    }
+
+    printf("\nnmod_poly_mat_det: det_fflu vs det_interpolate\n");
+
+    for (d = 0; (dim = det_dims[d]) != 0; d++)
+    {
+        for (len = 2; len <= 32; len *= 4)
+        {
+            params.dim = dim;
+            params.len = len;
+
+            params.algorithm = 0;
+            prof_repeat(&min_old, &max, sample_det, &params);
+
+            params.algorithm = 1;
+            prof_repeat(&min_new, &max, sample_det, &params);
+
+            printf("dim = %ld, len = %ld, fflu %.2f us interpolate %.2f us\n",
+                dim, len, min_old, min_new);
+        }
+    }
+
+    printf("\nnmod_poly_mat_solve: solve_fflu vs solve_interpolate, "
+           "one right hand side\n");
+
+    for (d = 0; (dim = det_dims[d]) != 0; d++)
+    {
+        for (len = 2; len <= 32; len *= 4)
+        {
+            params.dim = dim;
+            params.len = len;
+
+            params.algorithm = 0;
+            prof_repeat(&min_old, &max, sample_solve, &params);
+
+            params.algorithm = 1;
+            prof_repeat(&min_new, &max, sample_solve, &params);
+
+            printf("dim = %ld, len = %ld, fflu %.2f us interpolate %.2f us\n",
+                dim, len, min_old, min_new);
+        }
+    }
+
+    _fmpz_cleanup();
+    return 0;
+}
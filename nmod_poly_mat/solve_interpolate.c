@@ -0,0 +1,227 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "nmod_vec.h"
+#include "nmod_poly.h"
+#include "nmod_mat.h"
+#include "nmod_poly_mat.h"
+#include "perm.h"
+
+typedef struct
+{
+    nmod_mat_struct * X;
+    nmod_mat_struct * A;
+    const nmod_mat_struct * B;
+    mp_ptr d;
+    int * ok;
+}
+_solve_interpolate_struct;
+
+/*
+    Sets X[i] to det(A[i]) A[i]^{-1} B[i] and d[i] to det(A[i]), or
+    flags the point as unusable if A[i] is singular. A[i] is
+    overwritten by its LU decomposition.
+ */
+static void
+_solve_interpolate_worker(void * arg, long i)
+{
+    _solve_interpolate_struct * s = (_solve_interpolate_struct *) arg;
+    nmod_mat_struct * LU = s->A + i;
+    nmod_mat_t PB;
+    mp_limb_t det;
+    long j, n, *perm;
+
+    n = LU->r;
+    perm = _perm_init(n);
+
+    if (nmod_mat_lu(perm, LU, 1) < n)
+    {
+        s->ok[i] = 0;
+        _perm_clear(perm);
+        return;
+    }
+
+    det = 1UL;
+    for (j = 0; j < n; j++)
+        det = nmod_mul(det, nmod_mat_entry(LU, j, j), LU->mod);
+    if (_perm_parity(perm, n) == 1)
+        det = nmod_neg(det, LU->mod);
+
+    nmod_mat_window_init(PB, s->B + i, 0, 0, s->B[i].r, s->B[i].c);
+    for (j = 0; j < n; j++)
+        PB->rows[j] = s->B[i].rows[perm[j]];
+
+    nmod_mat_solve_tril(s->X + i, LU, PB, 1);
+    nmod_mat_solve_triu(s->X + i, LU, s->X + i, 0);
+    nmod_mat_scalar_mul(s->X + i, s->X + i, det);
+
+    nmod_mat_window_clear(PB);
+    _perm_clear(perm);
+
+    s->d[i] = det;
+    s->ok[i] = 1;
+}
+
+int
+nmod_poly_mat_solve_interpolate(nmod_poly_mat_t X, nmod_poly_t den,
+                    const nmod_poly_mat_t A, const nmod_poly_mat_t B)
+{
+    _solve_interpolate_struct s;
+    nmod_mat_struct *A_mod, *B_mod, *X_mod, tmp;
+    long i, n, m, len, det_len, good, bad, next, base, k;
+    mp_limb_t p;
+    mp_ptr x, y, d;
+    int * ok;
+    int result;
+
+    if (nmod_poly_mat_is_empty(B))
+    {
+        nmod_poly_one(den);
+        return 1;
+    }
+
+    n = A->r;
+    m = B->c;
+    p = nmod_poly_mat_modulus(A);
+
+    det_len = nmod_poly_mat_max_length(A);
+
+    if (det_len == 0)
+    {
+        nmod_poly_zero(den);
+        return 0;
+    }
+
+    /* Length bounds for det(A) and for adj(A) B */
+    len = (n - 1) * (det_len - 1) + nmod_poly_mat_max_length(B);
+    det_len = n * (det_len - 1) + 1;
+    len = FLINT_MAX(len, det_len);
+
+    /* Not enough points to interpolate */
+    if (len > p)
+        return nmod_poly_mat_solve_fflu(X, den, A, B);
+
+    x = _nmod_vec_init(len);
+    y = _nmod_vec_init(len);
+    d = _nmod_vec_init(len);
+    ok = malloc(sizeof(int) * len);
+    A_mod = malloc(sizeof(nmod_mat_struct) * len);
+    B_mod = malloc(sizeof(nmod_mat_struct) * len);
+    X_mod = malloc(sizeof(nmod_mat_struct) * len);
+
+    for (i = 0; i < len; i++)
+    {
+        nmod_mat_init(A_mod + i, n, n, p);
+        nmod_mat_init(B_mod + i, n, m, p);
+        nmod_mat_init(X_mod + i, n, m, p);
+    }
+
+    /*
+        Evaluate at the next len - good points in each round, keeping
+        the points at which A is nonsingular at the front of X_mod.
+        Since det(A) has fewer than det_len roots unless it is zero,
+        det_len unusable points prove that A is singular.
+     */
+    good = bad = next = 0;
+    result = 1;
+
+    while (good < len)
+    {
+        k = len - good;
+
+        if (next + k > p)
+        {
+            result = -1;
+            break;
+        }
+
+        for (i = 0; i < k; i++)
+            y[i] = next + i;
+        next += k;
+
+        nmod_poly_mat_evaluate_nmod_vec(A_mod, A, y, k);
+        nmod_poly_mat_evaluate_nmod_vec(B_mod, B, y, k);
+
+        s.X = X_mod + good;
+        s.A = A_mod;
+        s.B = B_mod;
+        s.d = d + good;
+        s.ok = ok;
+        flint_parallel_do(_solve_interpolate_worker, &s, k,
+                                            flint_get_num_threads());
+
+        base = good;
+
+        for (i = 0; i < k; i++)
+        {
+            if (ok[i])
+            {
+                x[good] = y[i];
+                d[good] = d[base + i];
+                tmp = X_mod[good];
+                X_mod[good] = X_mod[base + i];
+                X_mod[base + i] = tmp;
+                good++;
+            }
+            else
+                bad++;
+        }
+
+        if (bad >= det_len)
+        {
+            result = 0;
+            break;
+        }
+    }
+
+    if (result == 1)
+    {
+        nmod_poly_interpolate_nmod_vec(den, x, d, len);
+        nmod_poly_mat_interpolate_nmod_vec(X, x, X_mod, len);
+    }
+    else if (result == 0)
+    {
+        nmod_poly_zero(den);
+    }
+
+    for (i = 0; i < len; i++)
+    {
+        nmod_mat_clear(A_mod + i);
+        nmod_mat_clear(B_mod + i);
+        nmod_mat_clear(X_mod + i);
+    }
+
+    free(A_mod);
+    free(B_mod);
+    free(X_mod);
+    free(ok);
+    _nmod_vec_clear(x);
+    _nmod_vec_clear(y);
+    _nmod_vec_clear(d);
+
+    /* Ran out of points before finding enough nonsingular ones */
+    if (result == -1)
+        return nmod_poly_mat_solve_fflu(X, den, A, B);
+
+    return result;
+}
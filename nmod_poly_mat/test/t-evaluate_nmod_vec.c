@@ -0,0 +1,101 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "flint.h"
+#include "nmod_poly.h"
+#include "nmod_poly_mat.h"
+#include "fmpz.h"
+
+int
+main(void)
+{
+    flint_rand_t state;
+    long i, j;
+
+    printf("evaluate_nmod_vec....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (i = 0; i < 1000; i++)
+    {
+        nmod_poly_mat_t A;
+        nmod_mat_struct * B;
+        nmod_mat_t C;
+        mp_ptr x;
+        long m, n, deg, len;
+        mp_limb_t mod;
+
+        mod = n_randtest_not_zero(state);
+        m = n_randint(state, 10);
+        n = n_randint(state, 10);
+        deg = 1 + n_randint(state, 100);
+        len = n_randint(state, 100);
+
+        nmod_poly_mat_init(A, m, n, mod);
+        nmod_mat_init(C, m, n, mod);
+        B = malloc(sizeof(nmod_mat_struct) * len);
+        x = _nmod_vec_init(len);
+
+        nmod_poly_mat_randtest(A, state, deg);
+
+        for (j = 0; j < len; j++)
+        {
+            x[j] = n_randint(state, mod);
+            nmod_mat_init(B + j, m, n, mod);
+        }
+
+        nmod_poly_mat_evaluate_nmod_vec(B, A, x, len);
+
+        for (j = 0; j < len; j++)
+        {
+            nmod_poly_mat_evaluate_nmod(C, A, x[j]);
+
+            if (!nmod_mat_equal(C, B + j))
+            {
+                printf("FAIL:\n");
+                printf("mod = %lu, x = %lu\n", mod, x[j]);
+                printf("A:\n");
+                nmod_poly_mat_print(A, "x");
+                printf("B:\n");
+                nmod_mat_print_pretty(B + j);
+                printf("C:\n");
+                nmod_mat_print_pretty(C);
+                printf("\n");
+                abort();
+            }
+        }
+
+        for (j = 0; j < len; j++)
+            nmod_mat_clear(B + j);
+
+        free(B);
+        _nmod_vec_clear(x);
+        nmod_poly_mat_clear(A);
+        nmod_mat_clear(C);
+    }
+
+    flint_randclear(state);
+    _fmpz_cleanup();
+    printf("PASS\n");
+    return 0;
+}
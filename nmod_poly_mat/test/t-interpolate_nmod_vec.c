@@ -0,0 +1,96 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "flint.h"
+#include "nmod_poly.h"
+#include "nmod_poly_mat.h"
+#include "fmpz.h"
+
+int
+main(void)
+{
+    flint_rand_t state;
+    long i, j;
+
+    printf("interpolate_nmod_vec....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (i = 0; i < 1000; i++)
+    {
+        nmod_poly_mat_t A, C;
+        nmod_mat_struct * B;
+        mp_ptr x;
+        long m, n, deg, len;
+        mp_limb_t mod;
+
+        mod = n_randtest_prime(state, 0);
+        m = n_randint(state, 10);
+        n = n_randint(state, 10);
+        len = n_randint(state, FLINT_MIN(100, mod));
+        deg = n_randint(state, len + 1);
+
+        nmod_poly_mat_init(A, m, n, mod);
+        nmod_poly_mat_init(C, m, n, mod);
+        B = malloc(sizeof(nmod_mat_struct) * len);
+        x = _nmod_vec_init(len);
+
+        nmod_poly_mat_randtest(A, state, deg);
+        nmod_poly_mat_randtest(C, state, deg);  /* noise in output */
+
+        /* distinct points, in no particular order */
+        for (j = 0; j < len; j++)
+        {
+            x[j] = (mod - 1 - j * (mod / len)) % mod;
+            nmod_mat_init(B + j, m, n, mod);
+        }
+
+        nmod_poly_mat_evaluate_nmod_vec(B, A, x, len);
+        nmod_poly_mat_interpolate_nmod_vec(C, x, B, len);
+
+        if (!nmod_poly_mat_equal(A, C))
+        {
+            printf("FAIL:\n");
+            printf("mod = %lu, len = %ld\n", mod, len);
+            printf("A:\n");
+            nmod_poly_mat_print(A, "x");
+            printf("C:\n");
+            nmod_poly_mat_print(C, "x");
+            printf("\n");
+            abort();
+        }
+
+        for (j = 0; j < len; j++)
+            nmod_mat_clear(B + j);
+
+        free(B);
+        _nmod_vec_clear(x);
+        nmod_poly_mat_clear(A);
+        nmod_poly_mat_clear(C);
+    }
+
+    flint_randclear(state);
+    _fmpz_cleanup();
+    printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,183 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+
+#ifndef NMOD_SPARSE_MAT_H
+#define NMOD_SPARSE_MAT_H
+
+#undef ulong /* interferes with system includes */
+#include <stdlib.h>
+#define ulong unsigned long
+
+#include <mpir.h>
+#include "flint.h"
+#include "nmod_vec.h"
+#include "nmod_mat.h"
+
+/*
+    Sparse matrices over Z/nZ in compressed sparse row (CSR) format.
+    The nonzero entries of row i are entries[k] in column cols[k] for
+    rowptr[i] <= k < rowptr[i + 1]. Within a row the columns are strictly
+    increasing and no stored entry is zero.
+ */
+typedef struct
+{
+    mp_ptr entries;
+    long * cols;
+    long * rowptr;
+    long r;
+    long c;
+    long nnz;
+    long alloc;
+    nmod_t mod;
+}
+nmod_sparse_mat_struct;
+
+typedef nmod_sparse_mat_struct nmod_sparse_mat_t[1];
+
+/*
+    ELLPACK format: every row is padded with zero entries to the length
+    of the longest row, giving width entries per row stored contiguously.
+    Padding entries have column 0 and value 0.
+ */
+typedef struct
+{
+    mp_ptr entries;
+    long * cols;
+    long r;
+    long c;
+    long width;
+    nmod_t mod;
+}
+nmod_sparse_mat_ell_struct;
+
+typedef nmod_sparse_mat_ell_struct nmod_sparse_mat_ell_t[1];
+
+#define nmod_sparse_mat_nrows(mat) ((mat)->r)
+#define nmod_sparse_mat_ncols(mat) ((mat)->c)
+#define nmod_sparse_mat_nnz(mat) ((mat)->nnz)
+#define nmod_sparse_mat_row_length(mat, i) \
+    ((mat)->rowptr[(i) + 1] - (mat)->rowptr[i])
+
+/* Memory management */
+
+void nmod_sparse_mat_init(nmod_sparse_mat_t mat, long rows, long cols,
+                                                                mp_limb_t n);
+void nmod_sparse_mat_clear(nmod_sparse_mat_t mat);
+void nmod_sparse_mat_fit_nnz(nmod_sparse_mat_t mat, long nnz);
+
+/* Basic manipulation */
+
+void nmod_sparse_mat_set(nmod_sparse_mat_t B, const nmod_sparse_mat_t A);
+void nmod_sparse_mat_swap(nmod_sparse_mat_t A, nmod_sparse_mat_t B);
+void nmod_sparse_mat_zero(nmod_sparse_mat_t mat);
+int nmod_sparse_mat_equal(const nmod_sparse_mat_t A,
+                                                   const nmod_sparse_mat_t B);
+mp_limb_t nmod_sparse_mat_get_entry(const nmod_sparse_mat_t mat,
+                                                             long i, long j);
+
+void nmod_sparse_mat_set_from_entries(nmod_sparse_mat_t A, const long * rows,
+                            const long * cols, mp_srcptr vals, long len);
+
+void nmod_sparse_mat_set_nmod_mat(nmod_sparse_mat_t B, const nmod_mat_t A);
+void nmod_sparse_mat_get_nmod_mat(nmod_mat_t B, const nmod_sparse_mat_t A);
+
+void nmod_sparse_mat_transpose(nmod_sparse_mat_t B,
+                                                   const nmod_sparse_mat_t A);
+
+/* Random matrix generation */
+
+void nmod_sparse_mat_randtest(nmod_sparse_mat_t mat, flint_rand_t state,
+                                                            long row_weight);
+
+/* Input and output */
+
+void nmod_sparse_mat_print_pretty(const nmod_sparse_mat_t mat);
+
+/* ELLPACK storage */
+
+void nmod_sparse_mat_ell_init_set(nmod_sparse_mat_ell_t B,
+                                                   const nmod_sparse_mat_t A);
+void nmod_sparse_mat_ell_clear(nmod_sparse_mat_ell_t mat);
+void nmod_sparse_mat_ell_mul_vec(mp_ptr y, const nmod_sparse_mat_ell_t A,
+                                                                 mp_srcptr x);
+
+/* Multiplication */
+
+void nmod_sparse_mat_mul_vec(mp_ptr y, const nmod_sparse_mat_t A,
+                                                                 mp_srcptr x);
+void nmod_sparse_mat_mul_mat(nmod_mat_t Y, const nmod_sparse_mat_t A,
+                                                          const nmod_mat_t X);
+
+void _nmod_sparse_mat_mul_bits(mp_ptr y, const nmod_sparse_mat_t A,
+                                                               mp_srcptr x);
+
+/* Filtering and elimination */
+
+void nmod_sparse_mat_filter(nmod_sparse_mat_t B, nmod_sparse_mat_t M,
+                                     const nmod_sparse_mat_t A, long excess);
+
+long nmod_sparse_mat_echelon(nmod_sparse_mat_t E, const nmod_sparse_mat_t A);
+long nmod_sparse_mat_rank(const nmod_sparse_mat_t A);
+long nmod_sparse_mat_nullspace(nmod_mat_t X, const nmod_sparse_mat_t A);
+
+/* Iterative solvers */
+
+int nmod_sparse_mat_solve_wiedemann(mp_ptr x, const nmod_sparse_mat_t A,
+                                            mp_srcptr b, flint_rand_t state);
+int _nmod_sparse_mat_solve_block_wiedemann(mp_ptr x,
+                    const nmod_sparse_mat_t A, mp_srcptr b, long block,
+                                                          flint_rand_t state);
+int nmod_sparse_mat_solve_block_wiedemann(mp_ptr x,
+            const nmod_sparse_mat_t A, mp_srcptr b, flint_rand_t state);
+int nmod_sparse_mat_solve_lanczos(mp_ptr x, const nmod_sparse_mat_t A,
+                                            mp_srcptr b, flint_rand_t state);
+
+#if FLINT64
+mp_ptr _nmod_sparse_mat_block_lanczos(const nmod_sparse_mat_t B,
+                                                          flint_rand_t state);
+#endif
+long nmod_sparse_mat_nullspace_block_lanczos(nmod_mat_t X,
+                               const nmod_sparse_mat_t A, flint_rand_t state);
+
+/* Tuning parameters *********************************************************/
+
+/* Number of rows handled as one task in parallel products */
+#define NMOD_SPARSE_MAT_PARALLEL_ROWS 4096
+
+/* Number of columns of the dense operand processed at a time in
+   sparse by dense products */
+#define NMOD_SPARSE_MAT_MUL_PANEL 32
+
+/* Number of vectors per block in block Wiedemann; for a matrix with
+   10^6 rows, products by eight or more vectors cost 0.6 to 0.7 times a
+   product by one vector per vector, against 1.2 times for four */
+#define NMOD_SPARSE_MAT_WIEDEMANN_BLOCK 8
+
+/* Rows of at most this weight are merged away by the filter */
+#define NMOD_SPARSE_MAT_FILTER_MERGE_WEIGHT 8
+
+/* Excess of columns over rows kept by the filter before block Lanczos */
+#define NMOD_SPARSE_MAT_LANCZOS_EXCESS 64
+
+/* Maximum number of random projections tried by the iterative solvers */
+#define NMOD_SPARSE_MAT_SOLVE_TRIES 4
+
+#endif
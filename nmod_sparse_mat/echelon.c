@@ -0,0 +1,194 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "nmod_sparse_mat.h"
+#include "ulong_extras.h"
+
+long
+nmod_sparse_mat_echelon(nmod_sparse_mat_t E, const nmod_sparse_mat_t A)
+{
+    long ** pcols, * plen, * order, * start;
+    mp_ptr * pvals;
+    long * rc, * tc, * sw;
+    mp_ptr rv, tv, swv;
+    long i, j, k, m, s, t, len, tlen, rank, nnz;
+    mp_limb_t f, v;
+
+    pcols = malloc((A->c + 1) * sizeof(long *));
+    pvals = malloc((A->c + 1) * sizeof(mp_ptr));
+    plen = malloc((A->c + 1) * sizeof(long));
+    order = malloc((A->r + 1) * sizeof(long));
+    start = calloc(A->c + 2, sizeof(long));
+    rc = malloc((A->c + 1) * sizeof(long));
+    tc = malloc((A->c + 1) * sizeof(long));
+    rv = malloc((A->c + 1) * sizeof(mp_limb_t));
+    tv = malloc((A->c + 1) * sizeof(mp_limb_t));
+
+    for (j = 0; j < A->c; j++)
+        plen[j] = -1;
+
+    /* light rows first, to limit fill-in; counting sort by weight */
+    for (i = 0; i < A->r; i++)
+        start[A->rowptr[i + 1] - A->rowptr[i] + 1]++;
+    for (j = 0; j < A->c; j++)
+        start[j + 1] += start[j];
+    for (i = 0; i < A->r; i++)
+        order[start[A->rowptr[i + 1] - A->rowptr[i]]++] = i;
+
+    rank = 0;
+    nnz = 0;
+
+    for (m = 0; m < A->r; m++)
+    {
+        i = order[m];
+        len = A->rowptr[i + 1] - A->rowptr[i];
+
+        for (k = 0; k < len; k++)
+        {
+            rc[k] = A->cols[A->rowptr[i] + k];
+            rv[k] = A->entries[A->rowptr[i] + k];
+        }
+
+        /*
+            Eliminate the entries of the row in pivot columns, left to
+            right. The pivot row for column j has its leading entry 1 in
+            column j, so entries to the left of j are not touched.
+         */
+        k = 0;
+        while (k < len)
+        {
+            j = rc[k];
+
+            if (plen[j] == -1)
+            {
+                k++;
+                continue;
+            }
+
+            f = rv[k];
+
+            for (t = 0; t < k; t++)
+            {
+                tc[t] = rc[t];
+                tv[t] = rv[t];
+            }
+
+            /* merge rest of row minus f times pivot row, skipping column j */
+            tlen = k;
+            s = k + 1;
+            t = 1;
+            while (s < len || t < plen[j])
+            {
+                if (t >= plen[j] || (s < len && rc[s] < pcols[j][t]))
+                {
+                    tc[tlen] = rc[s];
+                    tv[tlen] = rv[s];
+                    tlen++;
+                    s++;
+                }
+                else
+                {
+                    v = nmod_mul(f, pvals[j][t], A->mod);
+
+                    if (s < len && rc[s] == pcols[j][t])
+                    {
+                        v = nmod_sub(rv[s], v, A->mod);
+                        s++;
+                    }
+                    else
+                        v = nmod_neg(v, A->mod);
+
+                    if (v != 0UL)
+                    {
+                        tc[tlen] = pcols[j][t];
+                        tv[tlen] = v;
+                        tlen++;
+                    }
+
+                    t++;
+                }
+            }
+
+            sw = rc; rc = tc; tc = sw;
+            swv = rv; rv = tv; tv = swv;
+            len = tlen;
+        }
+
+        if (len == 0)
+            continue;
+
+        /* new pivot in the leading column */
+        j = rc[0];
+        f = n_invmod(rv[0], A->mod.n);
+
+        pcols[j] = malloc(len * sizeof(long));
+        pvals[j] = malloc(len * sizeof(mp_limb_t));
+        plen[j] = len;
+
+        for (k = 0; k < len; k++)
+        {
+            pcols[j][k] = rc[k];
+            pvals[j][k] = nmod_mul(rv[k], f, A->mod);
+        }
+
+        rank++;
+        nnz += len;
+    }
+
+    nmod_sparse_mat_clear(E);
+    nmod_sparse_mat_init(E, rank, A->c, A->mod.n);
+    nmod_sparse_mat_fit_nnz(E, nnz);
+
+    for (j = 0, i = 0, nnz = 0; j < A->c; j++)
+    {
+        if (plen[j] == -1)
+            continue;
+
+        for (k = 0; k < plen[j]; k++)
+        {
+            E->cols[nnz] = pcols[j][k];
+            E->entries[nnz] = pvals[j][k];
+            nnz++;
+        }
+
+        E->rowptr[++i] = nnz;
+
+        free(pcols[j]);
+        free(pvals[j]);
+    }
+
+    E->nnz = nnz;
+
+    free(pcols);
+    free(pvals);
+    free(plen);
+    free(order);
+    free(start);
+    free(rc);
+    free(tc);
+    free(rv);
+    free(tv);
+
+    return rank;
+}
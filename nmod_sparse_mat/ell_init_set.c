@@ -0,0 +1,61 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "nmod_sparse_mat.h"
+
+void
+nmod_sparse_mat_ell_init_set(nmod_sparse_mat_ell_t B,
+                                                   const nmod_sparse_mat_t A)
+{
+    long i, k, t, width = 0;
+
+    for (i = 0; i < A->r; i++)
+        width = FLINT_MAX(width, A->rowptr[i + 1] - A->rowptr[i]);
+
+    B->r = A->r;
+    B->c = A->c;
+    B->width = width;
+    B->mod = A->mod;
+
+    if (A->r && width)
+    {
+        B->entries = calloc(A->r * width, sizeof(mp_limb_t));
+        B->cols = calloc(A->r * width, sizeof(long));
+
+        for (i = 0; i < A->r; i++)
+        {
+            for (k = A->rowptr[i], t = i * width; k < A->rowptr[i + 1];
+                                                                     k++, t++)
+            {
+                B->entries[t] = A->entries[k];
+                B->cols[t] = A->cols[k];
+            }
+        }
+    }
+    else
+    {
+        B->entries = NULL;
+        B->cols = NULL;
+    }
+}
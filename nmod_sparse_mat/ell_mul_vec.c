@@ -0,0 +1,46 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "nmod_sparse_mat.h"
+#include "nmod_vec.h"
+
+void
+nmod_sparse_mat_ell_mul_vec(mp_ptr y, const nmod_sparse_mat_ell_t A,
+                                                                 mp_srcptr x)
+{
+    long i, k;
+    int nlimbs;
+    const long * c;
+    mp_srcptr e;
+
+    nlimbs = _nmod_vec_dot_bound_limbs(A->width, A->mod);
+
+    for (i = 0; i < A->r; i++)
+    {
+        c = A->cols + i * A->width;
+        e = A->entries + i * A->width;
+
+        NMOD_VEC_DOT(y[i], k, A->width, e[k], x[c[k]], A->mod, nlimbs);
+    }
+}
@@ -0,0 +1,417 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+
+
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "nmod_sparse_mat.h"
+#include "ulong_extras.h"
+
+/*
+    Replaces the sparse vector (*c, *v) of length len, with increasing
+    indices, by (*c, *v) + t (jc, jv), and returns its new length. The
+    scalar t and the entries of jv must be nonzero. If weight is not
+    NULL, weight[r] is increased for each index r which appears and
+    decreased for each index r which cancels.
+ */
+static long
+_filter_addmul(long ** c, mp_ptr * v, long len, const long * jc,
+            mp_srcptr jv, long jlen, mp_limb_t t, long * weight, nmod_t mod)
+{
+    long * rc;
+    mp_ptr rv;
+    long s, u, rlen;
+    mp_limb_t w;
+
+    rc = malloc((len + jlen + 1) * sizeof(long));
+    rv = malloc((len + jlen + 1) * sizeof(mp_limb_t));
+
+    rlen = s = u = 0;
+    while (s < len || u < jlen)
+    {
+        if (u >= jlen || (s < len && (*c)[s] < jc[u]))
+        {
+            rc[rlen] = (*c)[s];
+            rv[rlen] = (*v)[s];
+            rlen++;
+            s++;
+        }
+        else
+        {
+            w = nmod_mul(t, jv[u], mod);
+
+            if (s < len && (*c)[s] == jc[u])
+            {
+                w = nmod_add((*v)[s], w, mod);
+                s++;
+
+                if (w == 0UL && weight != NULL)
+                    weight[jc[u]]--;
+            }
+            else if (weight != NULL)
+                weight[jc[u]]++;
+
+            if (w != 0UL)
+            {
+                rc[rlen] = jc[u];
+                rv[rlen] = w;
+                rlen++;
+            }
+
+            u++;
+        }
+    }
+
+    free(*c);
+    free(*v);
+    *c = rc;
+    *v = rv;
+
+    return rlen;
+}
+
+static mp_limb_t
+_filter_get(const long * c, mp_srcptr v, long len, long i)
+{
+    long k;
+
+    for (k = 0; k < len && c[k] != i; k++) ;
+
+    return v[k];
+}
+
+void
+nmod_sparse_mat_filter(nmod_sparse_mat_t B, nmod_sparse_mat_t M,
+                                    const nmod_sparse_mat_t A, long excess)
+{
+    nmod_sparse_mat_t T;
+    long ** ccols, ** hcols;
+    mp_ptr * cvals, * hvals;
+    long * clen, * hlen, * weight, * dirty, * stack, * order;
+    long * rowptr, * rowcols, * start;
+    long rc[NMOD_SPARSE_MAT_FILTER_MERGE_WEIGHT];
+    long i, j, k, c, r, w, top, ncols, nrows, nnz, delta, changed;
+    mp_limb_t inv, t;
+
+    ccols = malloc((A->c + 1) * sizeof(long *));
+    cvals = malloc((A->c + 1) * sizeof(mp_ptr));
+    clen = malloc((A->c + 1) * sizeof(long));
+    hcols = malloc((A->c + 1) * sizeof(long *));
+    hvals = malloc((A->c + 1) * sizeof(mp_ptr));
+    hlen = malloc((A->c + 1) * sizeof(long));
+    order = malloc((A->c + 1) * sizeof(long));
+    weight = malloc((A->r + 1) * sizeof(long));
+    dirty = malloc((A->r + 1) * sizeof(long));
+    stack = malloc((A->r + 1) * sizeof(long));
+    rowptr = malloc((FLINT_MAX(A->r, A->c) + 2) * sizeof(long));
+    rowcols = malloc((A->nnz + 1) * sizeof(long));
+    start = malloc((A->r + 2) * sizeof(long));
+
+    /*
+        Column j is kept as a sparse vector over the rows, together with
+        the combination h_j of columns of A it is equal to, so that the
+        remaining matrix is always A times the matrix of the h_j. A
+        deleted column has clen[j] = -1.
+     */
+    nmod_sparse_mat_init(T, A->c, A->r, A->mod.n);
+    nmod_sparse_mat_transpose(T, A);
+
+    for (j = 0; j < A->c; j++)
+    {
+        clen[j] = T->rowptr[j + 1] - T->rowptr[j];
+        ccols[j] = malloc((clen[j] + 1) * sizeof(long));
+        cvals[j] = malloc((clen[j] + 1) * sizeof(mp_limb_t));
+
+        for (k = 0; k < clen[j]; k++)
+        {
+            ccols[j][k] = T->cols[T->rowptr[j] + k];
+            cvals[j][k] = T->entries[T->rowptr[j] + k];
+        }
+
+        hlen[j] = 1;
+        hcols[j] = malloc(sizeof(long));
+        hvals[j] = malloc(sizeof(mp_limb_t));
+        hcols[j][0] = j;
+        hvals[j][0] = 1UL;
+    }
+
+    nmod_sparse_mat_clear(T);
+
+    for (i = 0; i < A->r; i++)
+        weight[i] = A->rowptr[i + 1] - A->rowptr[i];
+
+    ncols = A->c;
+    nnz = A->nnz;
+
+    do
+    {
+        changed = 0;
+
+        /* the live columns meeting each row, by counting sort */
+        rowcols = realloc(rowcols, (nnz + 1) * sizeof(long));
+
+        for (i = 0; i < A->r + 2; i++)
+            rowptr[i] = 0;
+        for (j = 0; j < A->c; j++)
+            for (k = 0; k < clen[j]; k++)
+                rowptr[ccols[j][k] + 2]++;
+        for (i = 2; i < A->r + 2; i++)
+            rowptr[i] += rowptr[i - 1];
+        for (j = 0; j < A->c; j++)
+            for (k = 0; k < clen[j]; k++)
+                rowcols[rowptr[ccols[j][k] + 1]++] = j;
+
+        for (i = 0; i < A->r; i++)
+            dirty[i] = 0;
+
+        /*
+            A row with a single nonzero entry forces the corresponding
+            variable to be zero, so the row and its column can be
+            deleted. Deleting the column may create new singleton rows.
+         */
+        top = 0;
+        for (i = 0; i < A->r; i++)
+            if (weight[i] == 1)
+                stack[top++] = i;
+
+        while (top > 0)
+        {
+            i = stack[--top];
+
+            if (weight[i] != 1)
+                continue;
+
+            for (k = rowptr[i]; clen[rowcols[k]] == -1; k++) ;
+            j = rowcols[k];
+
+            for (k = 0; k < clen[j]; k++)
+                if (--weight[ccols[j][k]] == 1)
+                    stack[top++] = ccols[j][k];
+
+            nnz -= clen[j];
+            ncols--;
+            clen[j] = -1;
+            changed = 1;
+        }
+
+        /*
+            Keep at most excess more columns than nonzero rows, deleting
+            the heaviest columns; this only loses kernel vectors.
+         */
+        if (excess >= 0)
+        {
+            for (i = nrows = 0; i < A->r; i++)
+                nrows += (weight[i] > 0);
+
+            if (ncols > nrows + excess)
+            {
+                for (i = 0; i < A->r + 2; i++)
+                    start[i] = 0;
+                for (j = 0; j < A->c; j++)
+                    if (clen[j] != -1)
+                        start[A->r - clen[j] + 1]++;
+                for (i = 1; i < A->r + 2; i++)
+                    start[i] += start[i - 1];
+                for (j = 0; j < A->c; j++)
+                    if (clen[j] != -1)
+                        order[start[A->r - clen[j]]++] = j;
+
+                for (k = ncols - nrows - excess - 1; k >= 0; k--)
+                {
+                    j = order[k];
+
+                    for (r = 0; r < clen[j]; r++)
+                        weight[ccols[j][r]]--;
+
+                    nnz -= clen[j];
+                    ncols--;
+                    clen[j] = -1;
+                }
+
+                changed = 1;
+            }
+        }
+
+        /*
+            Merges: a row of weight w is cleared by subtracting multiples
+            of its lightest column c from its other w - 1 columns, after
+            which the row and column c are deleted as for a singleton.
+            This adds at most w_c - 1 entries to each of those columns
+            for column c of weight w_c, and is done if it does not
+            increase ncols * nnz, which governs the cost of the
+            iterative methods. Rows touched by a merge are left to the
+            next pass, when the row lists have been rebuilt.
+         */
+        for (w = 2; w <= NMOD_SPARSE_MAT_FILTER_MERGE_WEIGHT; w++)
+        {
+            for (i = 0; i < A->r; i++)
+            {
+                if (weight[i] != w || dirty[i])
+                    continue;
+
+                for (k = rowptr[i], r = 0; k < rowptr[i + 1]; k++)
+                    if (clen[rowcols[k]] != -1)
+                        rc[r++] = rowcols[k];
+
+                for (c = rc[0], r = 1; r < w; r++)
+                    if (clen[rc[r]] < clen[c])
+                        c = rc[r];
+
+                delta = (w - 1) * (clen[c] - 1) - clen[c];
+
+                if (w > 2 && (double) (ncols - 1) * (double) (nnz + delta)
+                                            >= (double) ncols * (double) nnz)
+                    continue;
+
+                inv = n_invmod(_filter_get(ccols[c], cvals[c], clen[c], i),
+                                                                  A->mod.n);
+
+                for (r = 0; r < w; r++)
+                {
+                    j = rc[r];
+                    if (j == c)
+                        continue;
+
+                    t = nmod_mul(_filter_get(ccols[j], cvals[j], clen[j], i),
+                                                                inv, A->mod);
+                    t = nmod_neg(t, A->mod);
+
+                    nnz -= clen[j];
+                    clen[j] = _filter_addmul(ccols + j, cvals + j, clen[j],
+                            ccols[c], cvals[c], clen[c], t, weight, A->mod);
+                    nnz += clen[j];
+
+                    hlen[j] = _filter_addmul(hcols + j, hvals + j, hlen[j],
+                            hcols[c], hvals[c], hlen[c], t, NULL, A->mod);
+                }
+
+                for (k = 0; k < clen[c]; k++)
+                {
+                    weight[ccols[c][k]]--;
+                    dirty[ccols[c][k]] = 1;
+                }
+
+                nnz -= clen[c];
+                ncols--;
+                clen[c] = -1;
+                changed = 1;
+            }
+        }
+    } while (changed);
+
+    /* B: the nonzero rows of the remaining columns */
+    for (i = nrows = 0; i < A->r; i++)
+    {
+        stack[i] = nrows;
+        nrows += (weight[i] > 0);
+    }
+
+    nmod_sparse_mat_clear(B);
+    nmod_sparse_mat_init(B, nrows, ncols, A->mod.n);
+    nmod_sparse_mat_fit_nnz(B, nnz);
+
+    for (i = 0; i < A->r; i++)
+        if (weight[i] > 0)
+            B->rowptr[stack[i] + 1] = weight[i];
+    for (i = 0; i < nrows; i++)
+        B->rowptr[i + 1] += B->rowptr[i];
+    for (i = 0; i < nrows; i++)
+        rowptr[i] = B->rowptr[i];
+
+    /* columns are visited in increasing order, so rows come out sorted */
+    for (j = c = 0; j < A->c; j++)
+    {
+        if (clen[j] == -1)
+            continue;
+
+        for (k = 0; k < clen[j]; k++)
+        {
+            r = rowptr[stack[ccols[j][k]]]++;
+            B->cols[r] = c;
+            B->entries[r] = cvals[j][k];
+        }
+
+        c++;
+    }
+
+    B->nnz = nnz;
+
+    /* M: column c is the combination of columns of A for column c of B */
+    for (i = 0; i < A->c + 2; i++)
+        rowptr[i] = 0;
+    for (j = nnz = 0; j < A->c; j++)
+    {
+        if (clen[j] != -1)
+        {
+            for (k = 0; k < hlen[j]; k++)
+                rowptr[hcols[j][k] + 2]++;
+            nnz += hlen[j];
+        }
+    }
+    for (i = 2; i < A->c + 2; i++)
+        rowptr[i] += rowptr[i - 1];
+
+    nmod_sparse_mat_clear(M);
+    nmod_sparse_mat_init(M, A->c, ncols, A->mod.n);
+    nmod_sparse_mat_fit_nnz(M, nnz);
+
+    for (j = c = 0; j < A->c; j++)
+    {
+        if (clen[j] == -1)
+            continue;
+
+        for (k = 0; k < hlen[j]; k++)
+        {
+            r = rowptr[hcols[j][k] + 1]++;
+            M->cols[r] = c;
+            M->entries[r] = hvals[j][k];
+        }
+
+        c++;
+    }
+
+    for (i = 0; i <= A->c; i++)
+        M->rowptr[i] = rowptr[i];
+    M->nnz = nnz;
+
+    for (j = 0; j < A->c; j++)
+    {
+        free(ccols[j]);
+        free(cvals[j]);
+        free(hcols[j]);
+        free(hvals[j]);
+    }
+
+    free(ccols);
+    free(cvals);
+    free(clen);
+    free(hcols);
+    free(hvals);
+    free(hlen);
+    free(order);
+    free(weight);
+    free(dirty);
+    free(stack);
+    free(rowptr);
+    free(rowcols);
+    free(start);
+}
@@ -0,0 +1,49 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "nmod_sparse_mat.h"
+
+mp_limb_t
+nmod_sparse_mat_get_entry(const nmod_sparse_mat_t mat, long i, long j)
+{
+    long lo, hi, mid;
+
+    /* binary search for column j in row i */
+    lo = mat->rowptr[i];
+    hi = mat->rowptr[i + 1];
+
+    while (lo < hi)
+    {
+        mid = lo + (hi - lo) / 2;
+
+        if (mat->cols[mid] == j)
+            return mat->entries[mid];
+        else if (mat->cols[mid] < j)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    return 0UL;
+}
@@ -0,0 +1,43 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "nmod_sparse_mat.h"
+
+void
+_nmod_sparse_mat_mul_bits(mp_ptr y, const nmod_sparse_mat_t A,
+                                                               mp_srcptr x)
+{
+    long i, k;
+    mp_limb_t s;
+
+    for (i = 0; i < A->r; i++)
+    {
+        s = 0UL;
+
+        for (k = A->rowptr[i]; k < A->rowptr[i + 1]; k++)
+            s ^= x[A->cols[k]];
+
+        y[i] = s;
+    }
+}
@@ -0,0 +1,130 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "nmod_sparse_mat.h"
+#include "nmod_vec.h"
+
+typedef struct
+{
+    nmod_mat_struct * Y;
+    const nmod_sparse_mat_struct * A;
+    const nmod_mat_struct * X;
+    long width;
+    int nlimbs;
+}
+_mul_mat_struct;
+
+/*
+    Computes rows r0, ..., r1 - 1 of Y = A X. For each row of A, the
+    rows of X it selects are gathered once, and each column of the
+    product is then a dot product accumulated in registers. After the
+    first column the selected rows of X are in cache, so the random
+    accesses to X are paid once per panel of NMOD_SPARSE_MAT_MUL_PANEL
+    columns rather than once per column. The array xr has space for
+    the longest row of A.
+ */
+static void
+_nmod_sparse_mat_mul_mat_rows(nmod_mat_t Y, const nmod_sparse_mat_t A,
+        const nmod_mat_t X, long r0, long r1, int nlimbs, mp_srcptr * xr)
+{
+    const long * c;
+    mp_srcptr e;
+    long i, k, t, p0, w, len;
+
+    for (i = r0; i < r1; i++)
+    {
+        c = A->cols + A->rowptr[i];
+        e = A->entries + A->rowptr[i];
+        len = A->rowptr[i + 1] - A->rowptr[i];
+
+        for (p0 = 0; p0 < X->c; p0 += NMOD_SPARSE_MAT_MUL_PANEL)
+        {
+            w = FLINT_MIN(NMOD_SPARSE_MAT_MUL_PANEL, X->c - p0);
+
+            for (k = 0; k < len; k++)
+                xr[k] = X->rows[c[k]] + p0;
+
+            for (t = 0; t < w; t++)
+                NMOD_VEC_DOT(Y->rows[i][p0 + t], k, len, e[k], xr[k][t],
+                                                            A->mod, nlimbs);
+        }
+    }
+}
+
+static void
+_mul_mat_worker(void * arg, long i)
+{
+    _mul_mat_struct * s = (_mul_mat_struct *) arg;
+    mp_srcptr * xr;
+    long r0, r1;
+
+    r0 = i * NMOD_SPARSE_MAT_PARALLEL_ROWS;
+    r1 = FLINT_MIN(r0 + NMOD_SPARSE_MAT_PARALLEL_ROWS, s->A->r);
+
+    xr = malloc((s->width + 1) * sizeof(mp_srcptr));
+    _nmod_sparse_mat_mul_mat_rows(s->Y, s->A, s->X, r0, r1, s->nlimbs, xr);
+    free(xr);
+}
+
+void
+nmod_sparse_mat_mul_mat(nmod_mat_t Y, const nmod_sparse_mat_t A,
+                                                          const nmod_mat_t X)
+{
+    long i, width, num_blocks, num_threads;
+    int nlimbs;
+
+    if (X->c == 0)
+        return;
+
+    width = 0;
+    for (i = 0; i < A->r; i++)
+        width = FLINT_MAX(width, A->rowptr[i + 1] - A->rowptr[i]);
+
+    nlimbs = _nmod_vec_dot_bound_limbs(width, A->mod);
+    if (nlimbs == 0)
+        nlimbs = 1;
+
+    num_threads = flint_get_num_threads();
+    num_blocks = (A->r + NMOD_SPARSE_MAT_PARALLEL_ROWS - 1)
+                    / NMOD_SPARSE_MAT_PARALLEL_ROWS;
+
+    if (num_threads > 1 && num_blocks > 1)
+    {
+        _mul_mat_struct s;
+
+        s.Y = Y;
+        s.A = A;
+        s.X = X;
+        s.width = width;
+        s.nlimbs = nlimbs;
+
+        flint_parallel_do(_mul_mat_worker, &s, num_blocks, num_threads);
+    }
+    else
+    {
+        mp_srcptr * xr = malloc((width + 1) * sizeof(mp_srcptr));
+        _nmod_sparse_mat_mul_mat_rows(Y, A, X, 0, A->r, nlimbs, xr);
+        free(xr);
+    }
+}
@@ -0,0 +1,99 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "nmod_sparse_mat.h"
+#include "nmod_vec.h"
+
+typedef struct
+{
+    mp_ptr y;
+    const nmod_sparse_mat_struct * A;
+    mp_srcptr x;
+    int nlimbs;
+}
+_mul_vec_struct;
+
+static void
+_nmod_sparse_mat_mul_vec_rows(mp_ptr y, const nmod_sparse_mat_t A,
+                                mp_srcptr x, long r0, long r1, int nlimbs)
+{
+    long i, k, len;
+    const long * c;
+    mp_srcptr e;
+
+    for (i = r0; i < r1; i++)
+    {
+        c = A->cols + A->rowptr[i];
+        e = A->entries + A->rowptr[i];
+        len = A->rowptr[i + 1] - A->rowptr[i];
+
+        NMOD_VEC_DOT(y[i], k, len, e[k], x[c[k]], A->mod, nlimbs);
+    }
+}
+
+static void
+_mul_vec_worker(void * arg, long i)
+{
+    _mul_vec_struct * s = (_mul_vec_struct *) arg;
+    long r0, r1;
+
+    r0 = i * NMOD_SPARSE_MAT_PARALLEL_ROWS;
+    r1 = FLINT_MIN(r0 + NMOD_SPARSE_MAT_PARALLEL_ROWS, s->A->r);
+
+    _nmod_sparse_mat_mul_vec_rows(s->y, s->A, s->x, r0, r1, s->nlimbs);
+}
+
+void
+nmod_sparse_mat_mul_vec(mp_ptr y, const nmod_sparse_mat_t A, mp_srcptr x)
+{
+    long i, width, num_blocks, num_threads;
+    int nlimbs;
+
+    /* one bound on the accumulator size serves every row */
+    width = 0;
+    for (i = 0; i < A->r; i++)
+        width = FLINT_MAX(width, A->rowptr[i + 1] - A->rowptr[i]);
+
+    nlimbs = _nmod_vec_dot_bound_limbs(width, A->mod);
+
+    num_threads = flint_get_num_threads();
+    num_blocks = (A->r + NMOD_SPARSE_MAT_PARALLEL_ROWS - 1)
+                    / NMOD_SPARSE_MAT_PARALLEL_ROWS;
+
+    if (num_threads > 1 && num_blocks > 1)
+    {
+        _mul_vec_struct s;
+
+        s.y = y;
+        s.A = A;
+        s.x = x;
+        s.nlimbs = nlimbs;
+
+        flint_parallel_do(_mul_vec_worker, &s, num_blocks, num_threads);
+    }
+    else
+    {
+        _nmod_sparse_mat_mul_vec_rows(y, A, x, 0, A->r, nlimbs);
+    }
+}
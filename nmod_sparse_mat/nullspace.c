@@ -0,0 +1,92 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "nmod_sparse_mat.h"
+#include "nmod_vec.h"
+
+long
+nmod_sparse_mat_nullspace(nmod_mat_t X, const nmod_sparse_mat_t A)
+{
+    nmod_sparse_mat_t B, M, E;
+    long * pivots, * free_col;
+    long i, j, k, t, rank, nullity;
+    nmod_mat_t Y, Z;
+
+    nmod_sparse_mat_init(B, 0, 0, A->mod.n);
+    nmod_sparse_mat_init(M, 0, 0, A->mod.n);
+    nmod_sparse_mat_init(E, 0, 0, A->mod.n);
+
+    /* the kernel of A is M times the kernel of B */
+    nmod_sparse_mat_filter(B, M, A, -1);
+    rank = nmod_sparse_mat_echelon(E, B);
+    nullity = B->c - rank;
+
+    pivots = malloc((rank + 1) * sizeof(long));
+    free_col = calloc(B->c + 1, sizeof(long));
+
+    for (i = 0; i < rank; i++)
+    {
+        pivots[i] = E->cols[E->rowptr[i]];
+        free_col[pivots[i]] = -1;
+    }
+
+    nmod_mat_init(Y, B->c, nullity, A->mod.n);
+
+    for (j = 0, t = 0; j < B->c; j++)
+        if (free_col[j] == 0)
+            nmod_mat_entry(Y, j, t++) = 1UL;
+
+    /* back substitution on all kernel vectors at once */
+    if (nullity > 0)
+    {
+        for (i = rank - 1; i >= 0; i--)
+        {
+            for (k = E->rowptr[i] + 1; k < E->rowptr[i + 1]; k++)
+            {
+                _nmod_vec_scalar_addmul_nmod(Y->rows[pivots[i]],
+                    Y->rows[E->cols[k]], nullity,
+                    nmod_neg(E->entries[k], A->mod), A->mod);
+            }
+        }
+    }
+
+    nmod_mat_init(Z, A->c, nullity, A->mod.n);
+    nmod_sparse_mat_mul_mat(Z, M, Y);
+
+    nmod_mat_zero(X);
+
+    for (j = 0; j < A->c; j++)
+        for (t = 0; t < nullity; t++)
+            nmod_mat_entry(X, j, t) = nmod_mat_entry(Z, j, t);
+
+    nmod_mat_clear(Y);
+    nmod_mat_clear(Z);
+    nmod_sparse_mat_clear(B);
+    nmod_sparse_mat_clear(M);
+    nmod_sparse_mat_clear(E);
+    free(pivots);
+    free(free_col);
+
+    return nullity;
+}
@@ -0,0 +1,97 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "nmod_sparse_mat.h"
+#include "gf2_mat.h"
+
+long
+nmod_sparse_mat_nullspace_block_lanczos(nmod_mat_t X,
+                                const nmod_sparse_mat_t A, flint_rand_t state)
+{
+#if FLINT64
+    nmod_sparse_mat_t B, M;
+    gf2_mat_t V;
+    long P[64];
+    mp_ptr x = NULL, y;
+    long i, l, t, rank, try;
+#endif
+
+    if (A->mod.n != 2UL)
+    {
+        printf("Exception: nmod_sparse_mat_nullspace_block_lanczos: "
+               "modulus must be 2.\n");
+        abort();
+    }
+
+#if FLINT64
+
+    nmod_sparse_mat_init(B, 0, 0, 2UL);
+    nmod_sparse_mat_init(M, 0, 0, 2UL);
+    nmod_sparse_mat_filter(B, M, A, NMOD_SPARSE_MAT_LANCZOS_EXCESS);
+
+    if (B->c > 0)
+    {
+        for (try = 0; try < NMOD_SPARSE_MAT_SOLVE_TRIES && x == NULL; try++)
+            x = _nmod_sparse_mat_block_lanczos(B, state);
+    }
+
+    /*
+        The 64 candidate vectors are the bit slices of x, which M maps
+        into the kernel of A.
+     */
+    gf2_mat_init(V, 64, A->c);
+
+    if (x != NULL)
+    {
+        y = malloc((A->c + 1) * sizeof(mp_limb_t));
+        _nmod_sparse_mat_mul_bits(y, M, x);
+
+        for (i = 0; i < A->c; i++)
+            for (l = 0; l < 64; l++)
+                if ((y[i] >> l) & 1)
+                    gf2_mat_set_entry(V, l, i, 1);
+
+        free(x);
+        free(y);
+    }
+
+    rank = gf2_mat_rref(P, V);
+
+    nmod_mat_zero(X);
+
+    for (t = 0; t < rank; t++)
+        for (i = 0; i < A->c; i++)
+            nmod_mat_entry(X, i, t) = gf2_mat_get_entry(V, t, i);
+
+    gf2_mat_clear(V);
+    nmod_sparse_mat_clear(B);
+    nmod_sparse_mat_clear(M);
+
+    return rank;
+#else
+    /* block Lanczos needs 64-bit limbs */
+    return nmod_sparse_mat_nullspace(X, A);
+#endif
+}
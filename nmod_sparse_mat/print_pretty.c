@@ -0,0 +1,45 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "nmod_sparse_mat.h"
+
+void
+nmod_sparse_mat_print_pretty(const nmod_sparse_mat_t mat)
+{
+    long i, k;
+
+    printf("<%ld x %ld sparse matrix mod %lu, %ld nonzeros>\n",
+        mat->r, mat->c, mat->mod.n, mat->nnz);
+
+    for (i = 0; i < mat->r; i++)
+    {
+        printf("%ld:", i);
+
+        for (k = mat->rowptr[i]; k < mat->rowptr[i + 1]; k++)
+            printf(" (%ld, %lu)", mat->cols[k], mat->entries[k]);
+
+        printf("\n");
+    }
+}
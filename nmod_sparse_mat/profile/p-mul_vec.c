@@ -0,0 +1,100 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "profiler.h"
+#include "flint.h"
+#include "nmod_sparse_mat.h"
+#include "ulong_extras.h"
+
+typedef struct
+{
+    long dim;
+    long weight;
+    int algorithm;
+} mat_mul_t;
+
+void sample(void * arg, ulong count)
+{
+    mat_mul_t * params = (mat_mul_t *) arg;
+    long i, dim = params->dim;
+    int algorithm = params->algorithm;
+    mp_limb_t n = n_nextprime(1UL << (FLINT_BITS - 2), 0);
+    flint_rand_t state;
+    nmod_sparse_mat_t A;
+    nmod_sparse_mat_ell_t E;
+    mp_ptr x, y;
+
+    flint_randinit(state);
+
+    nmod_sparse_mat_init(A, dim, dim, n);
+    nmod_sparse_mat_randtest(A, state, 2 * params->weight);
+    nmod_sparse_mat_ell_init_set(E, A);
+
+    x = _nmod_vec_init(dim);
+    y = _nmod_vec_init(dim);
+    _nmod_vec_randtest(x, state, dim, A->mod);
+
+    prof_start();
+
+    if (algorithm == 0)
+        for (i = 0; i < count; i++)
+            nmod_sparse_mat_mul_vec(y, A, x);
+    else
+        for (i = 0; i < count; i++)
+            nmod_sparse_mat_ell_mul_vec(y, E, x);
+
+    prof_stop();
+
+    nmod_sparse_mat_clear(A);
+    nmod_sparse_mat_ell_clear(E);
+    _nmod_vec_clear(x);
+    _nmod_vec_clear(y);
+
+    flint_randclear(state);
+}
+
+int main(void)
+{
+    double min_csr, min_ell, max;
+    mat_mul_t params;
+    long dim;
+
+    printf("nmod_sparse_mat_mul_vec, 50 nonzeros per row on average:\n");
+
+    params.weight = 50;
+
+    for (dim = 1000; dim <= 100000; dim *= 10)
+    {
+        params.dim = dim;
+
+        params.algorithm = 0;
+        prof_repeat(&min_csr, &max, sample, &params);
+
+        params.algorithm = 1;
+        prof_repeat(&min_ell, &max, sample, &params);
+
+        printf("dim = %ld, csr %.2f us ell %.2f us\n", dim, min_csr, min_ell);
+    }
+
+    return 0;
+}
@@ -0,0 +1,126 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "profiler.h"
+#include "flint.h"
+#include "nmod_sparse_mat.h"
+#include "ulong_extras.h"
+
+typedef struct
+{
+    long dim;
+    long weight;
+    long block;
+} solve_t;
+
+void sample(void * arg, ulong count)
+{
+    solve_t * params = (solve_t *) arg;
+    long i, j, k, len, dim = params->dim, w = params->weight;
+    mp_limb_t n = n_nextprime(1UL << (FLINT_BITS - 2), 0);
+    flint_rand_t state;
+    nmod_sparse_mat_t A;
+    mp_ptr x, b, vals;
+    long * rows, * cols;
+
+    flint_randinit(state);
+
+    /* w random entries per row and a nonzero diagonal */
+    rows = malloc(dim * (w + 1) * sizeof(long));
+    cols = malloc(dim * (w + 1) * sizeof(long));
+    vals = _nmod_vec_init(dim * (w + 1));
+
+    for (i = len = 0; i < dim; i++)
+    {
+        for (k = 0; k < w; k++, len++)
+        {
+            rows[len] = i;
+            cols[len] = n_randint(state, dim);
+            vals[len] = n_randint(state, n);
+        }
+
+        rows[len] = cols[len] = i;
+        vals[len++] = 1 + n_randint(state, n - 1);
+    }
+
+    nmod_sparse_mat_init(A, dim, dim, n);
+    nmod_sparse_mat_set_from_entries(A, rows, cols, vals, len);
+
+    x = _nmod_vec_init(dim);
+    b = _nmod_vec_init(dim);
+    for (j = 0; j < dim; j++)
+        b[j] = n_randint(state, n);
+
+    prof_start();
+
+    for (i = 0; i < count; i++)
+    {
+        if (params->block == 0)
+            nmod_sparse_mat_solve_wiedemann(x, A, b, state);
+        else
+            _nmod_sparse_mat_solve_block_wiedemann(x, A, b,
+                                                       params->block, state);
+    }
+
+    prof_stop();
+
+    nmod_sparse_mat_clear(A);
+    _nmod_vec_clear(x);
+    _nmod_vec_clear(b);
+    _nmod_vec_clear(vals);
+    free(rows);
+    free(cols);
+
+    flint_randclear(state);
+}
+
+int main(void)
+{
+    double min, max;
+    solve_t params;
+    long dim, block;
+
+    printf("Wiedemann (block 0) and block Wiedemann, "
+           "50 nonzeros per row:\n");
+
+    params.weight = 50;
+
+    for (dim = 1000; dim <= 4000; dim *= 2)
+    {
+        params.dim = dim;
+
+        printf("dim = %ld:", dim);
+
+        for (block = 0; block <= 16; block = (block == 0) ? 2 : 2 * block)
+        {
+            params.block = block;
+            prof_repeat(&min, &max, sample, &params);
+            printf(" %ld: %.3f s", block, min / 1000000.0);
+            fflush(stdout);
+        }
+
+        printf("\n");
+    }
+
+    return 0;
+}
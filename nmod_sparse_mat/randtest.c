@@ -0,0 +1,66 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "nmod_sparse_mat.h"
+#include "ulong_extras.h"
+
+void
+nmod_sparse_mat_randtest(nmod_sparse_mat_t mat, flint_rand_t state,
+                                                            long row_weight)
+{
+    long i, j, len, w;
+    long * rows, * cols;
+    mp_ptr vals;
+
+    if (mat->c == 0)
+    {
+        nmod_sparse_mat_zero(mat);
+        return;
+    }
+
+    rows = malloc((mat->r * row_weight + 1) * sizeof(long));
+    cols = malloc((mat->r * row_weight + 1) * sizeof(long));
+    vals = malloc((mat->r * row_weight + 1) * sizeof(mp_limb_t));
+
+    len = 0;
+
+    for (i = 0; i < mat->r; i++)
+    {
+        w = n_randint(state, row_weight + 1);
+
+        for (j = 0; j < w; j++)
+        {
+            rows[len] = i;
+            cols[len] = n_randint(state, mat->c);
+            vals[len] = n_randtest(state) % mat->mod.n;
+            len++;
+        }
+    }
+
+    nmod_sparse_mat_set_from_entries(mat, rows, cols, vals, len);
+
+    free(rows);
+    free(cols);
+    free(vals);
+}
@@ -0,0 +1,46 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "nmod_sparse_mat.h"
+
+long
+nmod_sparse_mat_rank(const nmod_sparse_mat_t A)
+{
+    nmod_sparse_mat_t B, M, E;
+    long rank;
+
+    nmod_sparse_mat_init(B, 0, 0, A->mod.n);
+    nmod_sparse_mat_init(M, 0, 0, A->mod.n);
+    nmod_sparse_mat_init(E, 0, 0, A->mod.n);
+
+    /* each column removed by the filter carries one pivot */
+    nmod_sparse_mat_filter(B, M, A, -1);
+    rank = nmod_sparse_mat_echelon(E, B) + (A->c - B->c);
+
+    nmod_sparse_mat_clear(B);
+    nmod_sparse_mat_clear(M);
+    nmod_sparse_mat_clear(E);
+
+    return rank;
+}
@@ -0,0 +1,97 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "nmod_sparse_mat.h"
+
+typedef struct
+{
+    long r;
+    long c;
+    mp_limb_t v;
+}
+_triplet_struct;
+
+static int
+_triplet_cmp(const void * a, const void * b)
+{
+    const _triplet_struct * s = a;
+    const _triplet_struct * t = b;
+
+    if (s->r != t->r)
+        return (s->r < t->r) ? -1 : 1;
+    if (s->c != t->c)
+        return (s->c < t->c) ? -1 : 1;
+    return 0;
+}
+
+void
+nmod_sparse_mat_set_from_entries(nmod_sparse_mat_t A, const long * rows,
+                            const long * cols, mp_srcptr vals, long len)
+{
+    _triplet_struct * t;
+    long i, k;
+
+    t = malloc(len * sizeof(_triplet_struct));
+
+    for (i = 0; i < len; i++)
+    {
+        t[i].r = rows[i];
+        t[i].c = cols[i];
+        t[i].v = vals[i];
+    }
+
+    qsort(t, len, sizeof(_triplet_struct), _triplet_cmp);
+
+    /* sum repeated positions in place, then drop zeros */
+    for (i = 0, k = -1; i < len; i++)
+    {
+        if (k >= 0 && t[k].r == t[i].r && t[k].c == t[i].c)
+            t[k].v = nmod_add(t[k].v, t[i].v, A->mod);
+        else
+            t[++k] = t[i];
+    }
+
+    nmod_sparse_mat_fit_nnz(A, k + 1);
+
+    for (i = 0; i <= A->r; i++)
+        A->rowptr[i] = 0;
+
+    A->nnz = 0;
+
+    for (i = 0; i <= k; i++)
+    {
+        if (t[i].v != 0UL)
+        {
+            A->entries[A->nnz] = t[i].v;
+            A->cols[A->nnz] = t[i].c;
+            A->nnz++;
+            A->rowptr[t[i].r + 1]++;
+        }
+    }
+
+    for (i = 0; i < A->r; i++)
+        A->rowptr[i + 1] += A->rowptr[i];
+
+    free(t);
+}
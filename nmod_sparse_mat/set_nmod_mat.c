@@ -0,0 +1,57 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "nmod_sparse_mat.h"
+
+void
+nmod_sparse_mat_set_nmod_mat(nmod_sparse_mat_t B, const nmod_mat_t A)
+{
+    long i, j, nnz = 0;
+
+    for (i = 0; i < A->r; i++)
+        for (j = 0; j < A->c; j++)
+            nnz += (nmod_mat_entry(A, i, j) != 0UL);
+
+    nmod_sparse_mat_fit_nnz(B, nnz);
+
+    B->rowptr[0] = 0;
+    nnz = 0;
+
+    for (i = 0; i < A->r; i++)
+    {
+        for (j = 0; j < A->c; j++)
+        {
+            if (nmod_mat_entry(A, i, j) != 0UL)
+            {
+                B->entries[nnz] = nmod_mat_entry(A, i, j);
+                B->cols[nnz] = j;
+                nnz++;
+            }
+        }
+
+        B->rowptr[i + 1] = nnz;
+    }
+
+    B->nnz = nnz;
+}
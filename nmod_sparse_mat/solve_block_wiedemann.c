@@ -0,0 +1,394 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <mpir.h>
+#include "flint.h"
+#include "nmod_sparse_mat.h"
+#include "nmod_vec.h"
+#include "ulong_extras.h"
+
+/*
+    Given the m x m blocks S_0, ..., S_{L-1} of a sequence, finds an
+    order L approximant basis of [S(z) | -I], where S(z) = sum S_i z^i,
+    by the iterative algorithm of Beckermann and Labahn. Column j of the
+    basis is the polynomial vector P[j], of length 2m, whose coefficient
+    of z^k starts at P[j] + 2mk; its degree is at most pdeg[j]. On input
+    R[j] holds the residual [S(z) | -I] P[j] mod z^L, coefficient k at
+    R[j] + mk, for P the identity matrix, with space for 2m columns of
+    L + 1 coefficients in P.
+
+    At each step the column operations putting coefficient s of the
+    residual in echelon form are found on that coefficient alone, as
+    a matrix N expressing each column update in terms of the pivot
+    columns. They are then applied to the rest of the residual and to
+    the basis with one delayed reduction per entry, rather than one
+    reduction per column operation.
+
+    A column p, q of the output with deg q < deg p = d gives the
+    relation sum_k S_{i+k} p_{d-k} = 0 for 0 <= i < L - d.
+ */
+static void
+_block_generator(mp_ptr * P, long * pdeg, mp_ptr * R, long m, long L,
+                                                                  nmod_t mod)
+{
+    long * delta, * pivot, * cols;
+    mp_ptr C, N, cf;
+    mp_srcptr * rp, * pp;
+    long i, j, k, r, s, t, pos, piv, cnt, M = 2 * m;
+    mp_limb_t c, u, acc;
+    int nlimbs;
+
+    delta = malloc(M * sizeof(long));
+    pivot = malloc(m * sizeof(long));
+    cols = malloc(M * sizeof(long));
+    C = _nmod_vec_init(m * M);
+    N = _nmod_vec_init(m * M);
+    cf = _nmod_vec_init(m);
+    rp = malloc(m * sizeof(mp_srcptr));
+    pp = malloc(m * sizeof(mp_srcptr));
+
+    nlimbs = _nmod_vec_dot_bound_limbs(m, mod);
+    if (nlimbs == 0)
+        nlimbs = 1;
+
+    /* shifts making the degree of q count one more than that of p */
+    for (j = 0; j < M; j++)
+    {
+        delta[j] = (j >= m);
+        pdeg[j] = 0;
+    }
+
+    for (s = 0; s < L; s++)
+    {
+        for (r = 0; r < m; r++)
+            for (j = 0; j < M; j++)
+                C[r * M + j] = R[j][s * m + r];
+
+        _nmod_vec_zero(N, m * M);
+
+        /*
+            Column echelon form of coefficient s of the residual. Column
+            j becomes column j plus sum_r N[r, j] times the original
+            column pivot[r]; a pivot column is only modified before it
+            is chosen, so its row of N refers to earlier pivots only.
+         */
+        for (r = 0; r < m; r++)
+        {
+            piv = -1;
+            for (j = 0; j < M; j++)
+            {
+                for (i = 0; i < r && pivot[i] != j; i++) ;
+
+                if (i == r && C[r * M + j] != 0UL
+                    && (piv == -1 || delta[j] < delta[piv]))
+                    piv = j;
+            }
+
+            pivot[r] = piv;
+            if (piv == -1)
+                continue;
+
+            c = n_invmod(C[r * M + piv], mod.n);
+
+            for (j = 0; j < M; j++)
+            {
+                for (i = 0; i <= r && pivot[i] != j; i++) ;
+
+                if (i <= r || C[r * M + j] == 0UL)
+                    continue;
+
+                /* delta[j] >= delta[piv], so column j stays reduced */
+                u = nmod_neg(nmod_mul(C[r * M + j], c, mod), mod);
+
+                for (i = 0; i < m; i++)
+                    C[i * M + j] = nmod_add(C[i * M + j],
+                                        nmod_mul(u, C[i * M + piv], mod), mod);
+                for (i = 0; i < r; i++)
+                    N[i * M + j] = nmod_add(N[i * M + j],
+                                        nmod_mul(u, N[i * M + piv], mod), mod);
+                N[r * M + j] = nmod_add(N[r * M + j], u, mod);
+
+                pdeg[j] = FLINT_MAX(pdeg[j], pdeg[piv]);
+            }
+        }
+
+        /*
+            Apply the column operations, reading the original pivot
+            columns: the other columns first, then the pivot columns
+            from the last to the first.
+         */
+        for (j = t = 0; j < M; j++)
+        {
+            for (i = 0; i < m && pivot[i] != j; i++) ;
+            if (i == m)
+                cols[t++] = j;
+        }
+        for (r = m - 1; r >= 0; r--)
+            if (pivot[r] != -1)
+                cols[t++] = pivot[r];
+
+        for (k = 0; k < t; k++)
+        {
+            j = cols[k];
+
+            for (r = cnt = 0; r < m; r++)
+            {
+                if (pivot[r] != -1 && N[r * M + j] != 0UL)
+                {
+                    cf[cnt] = N[r * M + j];
+                    rp[cnt] = R[pivot[r]] + s * m;
+                    pp[cnt] = P[pivot[r]];
+                    cnt++;
+                }
+            }
+
+            if (cnt == 0)
+                continue;
+
+            for (pos = 0; pos < (L - s) * m; pos++)
+            {
+                NMOD_VEC_DOT(acc, i, cnt, cf[i], rp[i][pos], mod, nlimbs);
+                R[j][s * m + pos] = nmod_add(R[j][s * m + pos], acc, mod);
+            }
+
+            for (pos = 0; pos < (pdeg[j] + 1) * M; pos++)
+            {
+                NMOD_VEC_DOT(acc, i, cnt, cf[i], pp[i][pos], mod, nlimbs);
+                P[j][pos] = nmod_add(P[j][pos], acc, mod);
+            }
+        }
+
+        /* multiply the pivot columns by z */
+        for (r = 0; r < m; r++)
+        {
+            piv = pivot[r];
+            if (piv == -1)
+                continue;
+
+            memmove(R[piv] + (s + 1) * m, R[piv] + s * m,
+                                        (L - s - 1) * m * sizeof(mp_limb_t));
+            _nmod_vec_zero(R[piv] + s * m, m);
+
+            memmove(P[piv] + M, P[piv],
+                                    (pdeg[piv] + 1) * M * sizeof(mp_limb_t));
+            _nmod_vec_zero(P[piv], M);
+            pdeg[piv]++;
+            delta[piv]++;
+        }
+    }
+
+    free(delta);
+    free(pivot);
+    free(cols);
+    _nmod_vec_clear(C);
+    _nmod_vec_clear(N);
+    _nmod_vec_clear(cf);
+    free(rp);
+    free(pp);
+}
+
+int
+_nmod_sparse_mat_solve_block_wiedemann(mp_ptr x, const nmod_sparse_mat_t A,
+                                mp_srcptr b, long block, flint_rand_t state)
+{
+    nmod_mat_t U, V, W, T, S, Rnd;
+    nmod_mat_struct * Wi, * Wn, * Wt;
+    mp_ptr * P, * R, z, w, f;
+    long * pdeg, * order;
+    long i, j, k, l, m, n, L, M, d, dq, try, num;
+    mp_limb_t c;
+    int nlimbs, success = 0;
+
+    if (A->r != A->c)
+    {
+        printf("Exception: nmod_sparse_mat_solve_block_wiedemann: "
+               "matrix must be square.\n");
+        abort();
+    }
+
+    n = A->r;
+
+    if (_nmod_vec_is_zero(b, n))
+    {
+        _nmod_vec_zero(x, n);
+        return 1;
+    }
+
+    m = FLINT_MIN(block, n);
+    M = 2 * m;
+
+    /* enough terms for a generator of degree n / m to be checked */
+    L = 2 * ((n + m - 1) / m) + 4;
+
+    nmod_mat_init(U, m, n, A->mod.n);
+    nmod_mat_init(V, n, m, A->mod.n);
+    nmod_mat_init(W, n, m, A->mod.n);
+    nmod_mat_init(Rnd, n, m, A->mod.n);
+    nmod_mat_init(T, n, m, A->mod.n);
+    nmod_mat_init(S, m, m, A->mod.n);
+    nlimbs = _nmod_vec_dot_bound_limbs(m, A->mod);
+
+    P = malloc(M * sizeof(mp_ptr));
+    R = malloc(M * sizeof(mp_ptr));
+    for (j = 0; j < M; j++)
+    {
+        P[j] = _nmod_vec_init((L + 1) * M);
+        R[j] = _nmod_vec_init(L * m);
+    }
+
+    pdeg = malloc(M * sizeof(long));
+    order = malloc(M * sizeof(long));
+    z = _nmod_vec_init(n);
+    w = _nmod_vec_init(n);
+
+    for (try = 0; try < NMOD_SPARSE_MAT_SOLVE_TRIES && !success; try++)
+    {
+        /*
+            V = [b | A Rnd] for random Rnd, whose first column is unused.
+            A relation sum_k A^k V f_k = 0 with f_0[0] nonzero then gives
+            b f_0[0] = -A (Rnd f_0 + sum_{k > 0} A^{k-1} V f_k).
+         */
+        nmod_mat_randfull(U, state);
+        nmod_mat_randfull(Rnd, state);
+        for (i = 0; i < n; i++)
+            nmod_mat_entry(Rnd, i, 0) = 0UL;
+
+        nmod_sparse_mat_mul_mat(V, A, Rnd);
+        for (i = 0; i < n; i++)
+            nmod_mat_entry(V, i, 0) = b[i];
+
+        /* S_l = U A^l V, with all m vectors multiplied at once */
+        nmod_mat_set(W, V);
+        Wi = W;
+        Wn = T;
+        for (l = 0; l < L; l++)
+        {
+            nmod_mat_mul(S, U, Wi);
+
+            for (j = 0; j < m; j++)
+                for (i = 0; i < m; i++)
+                    R[j][l * m + i] = nmod_mat_entry(S, i, j);
+
+            if (l + 1 < L)
+            {
+                nmod_sparse_mat_mul_mat(Wn, A, Wi);
+                Wt = Wi; Wi = Wn; Wn = Wt;
+            }
+        }
+
+        for (j = 0; j < m; j++)
+        {
+            _nmod_vec_zero(R[m + j], L * m);
+            R[m + j][j] = A->mod.n - 1;
+        }
+
+        for (j = 0; j < M; j++)
+        {
+            _nmod_vec_zero(P[j], (L + 1) * M);
+            P[j][j] = 1UL;
+        }
+
+        _block_generator(P, pdeg, R, m, L, A->mod);
+
+        /* candidate columns with deg q < deg p, by increasing degree */
+        num = 0;
+        for (j = 0; j < M; j++)
+        {
+            for (d = pdeg[j]; d >= 0 && _nmod_vec_is_zero(P[j] + d * M, m); d--) ;
+            for (dq = pdeg[j]; dq >= 0
+                && _nmod_vec_is_zero(P[j] + dq * M + m, m); dq--) ;
+
+            if (d >= 0 && dq < d && P[j][d * M] != 0UL)
+            {
+                pdeg[j] = d;
+                for (k = num; k > 0 && pdeg[order[k - 1]] > d; k--)
+                    order[k] = order[k - 1];
+                order[k] = j;
+                num++;
+            }
+        }
+
+        for (k = 0; k < num && !success; k++)
+        {
+            j = order[k];
+            d = pdeg[j];
+
+            /* z = sum_{l > 0} A^{l-1} V f_l, f_l = p_{d-l}, by Horner */
+            _nmod_vec_zero(z, n);
+            for (l = d; l >= 1; l--)
+            {
+                if (l != d)
+                {
+                    nmod_sparse_mat_mul_vec(w, A, z);
+                    _nmod_vec_set(z, w, n);
+                }
+
+                f = P[j] + (d - l) * M;
+                for (i = 0; i < n; i++)
+                    z[i] = nmod_add(z[i], _nmod_vec_dot(V->rows[i], f, m,
+                                                    A->mod, nlimbs), A->mod);
+            }
+
+            f = P[j] + d * M;
+            for (i = 0; i < n; i++)
+                z[i] = nmod_add(z[i], _nmod_vec_dot(Rnd->rows[i], f, m,
+                                                    A->mod, nlimbs), A->mod);
+
+            c = nmod_neg(n_invmod(f[0], A->mod.n), A->mod);
+            _nmod_vec_scalar_mul_nmod(x, z, n, c, A->mod);
+
+            nmod_sparse_mat_mul_vec(w, A, x);
+            success = _nmod_vec_equal(w, b, n);
+        }
+    }
+
+    nmod_mat_clear(U);
+    nmod_mat_clear(V);
+    nmod_mat_clear(W);
+    nmod_mat_clear(Rnd);
+    nmod_mat_clear(T);
+    nmod_mat_clear(S);
+
+    for (j = 0; j < M; j++)
+    {
+        _nmod_vec_clear(P[j]);
+        _nmod_vec_clear(R[j]);
+    }
+    free(P);
+    free(R);
+    free(pdeg);
+    free(order);
+    _nmod_vec_clear(z);
+    _nmod_vec_clear(w);
+
+    return success;
+}
+
+int
+nmod_sparse_mat_solve_block_wiedemann(mp_ptr x, const nmod_sparse_mat_t A,
+                                            mp_srcptr b, flint_rand_t state)
+{
+    return _nmod_sparse_mat_solve_block_wiedemann(x, A, b,
+                                    NMOD_SPARSE_MAT_WIEDEMANN_BLOCK, state);
+}
@@ -0,0 +1,139 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "nmod_sparse_mat.h"
+#include "nmod_vec.h"
+#include "ulong_extras.h"
+
+/* y = A^T D A x, with t of length A->r as scratch */
+static void
+_nmod_sparse_mat_mul_sym(mp_ptr y, const nmod_sparse_mat_t A,
+        const nmod_sparse_mat_t At, mp_srcptr D, mp_srcptr x, mp_ptr t)
+{
+    long i;
+
+    nmod_sparse_mat_mul_vec(t, A, x);
+
+    for (i = 0; i < A->r; i++)
+        t[i] = nmod_mul(t[i], D[i], A->mod);
+
+    nmod_sparse_mat_mul_vec(y, At, t);
+}
+
+int
+nmod_sparse_mat_solve_lanczos(mp_ptr x, const nmod_sparse_mat_t A,
+                                            mp_srcptr b, flint_rand_t state)
+{
+    nmod_sparse_mat_t At;
+    mp_ptr D, bb, w, wp, wn, v, vp, t, tmp;
+    mp_limb_t d, dp, c;
+    long i, iter, m, n, try;
+    int nlimbs, success = 0;
+
+    m = A->r;
+    n = A->c;
+
+    nmod_sparse_mat_init(At, n, m, A->mod.n);
+    nmod_sparse_mat_transpose(At, A);
+
+    D = _nmod_vec_init(m + 1);
+    t = _nmod_vec_init(m + 1);
+    bb = _nmod_vec_init(n + 1);
+    w = _nmod_vec_init(n + 1);
+    wp = _nmod_vec_init(n + 1);
+    wn = _nmod_vec_init(n + 1);
+    v = _nmod_vec_init(n + 1);
+    vp = _nmod_vec_init(n + 1);
+
+    nlimbs = _nmod_vec_dot_bound_limbs(n, A->mod);
+
+    for (try = 0; try < NMOD_SPARSE_MAT_SOLVE_TRIES && !success; try++)
+    {
+        /*
+            Solve the symmetric system A^T D A x = A^T D b, where the
+            random nonsingular diagonal D makes self-orthogonal Krylov
+            vectors unlikely.
+         */
+        for (i = 0; i < m; i++)
+            D[i] = 1UL + n_randint(state, A->mod.n - 1);
+
+        for (i = 0; i < m; i++)
+            t[i] = nmod_mul(b[i], D[i], A->mod);
+
+        nmod_sparse_mat_mul_vec(bb, At, t);
+
+        _nmod_vec_zero(x, n);
+        _nmod_vec_set(w, bb, n);
+        _nmod_vec_zero(wp, n);
+        _nmod_vec_zero(vp, n);
+        dp = 1UL;
+
+        for (iter = 0; iter <= n; iter++)
+        {
+            if (_nmod_vec_is_zero(w, n))
+                break;
+
+            _nmod_sparse_mat_mul_sym(v, A, At, D, w, t);
+            d = _nmod_vec_dot(w, v, n, A->mod, nlimbs);
+
+            if (d == 0UL)
+                break;
+
+            /* x += (w^T b) / (w^T M w) w */
+            c = _nmod_vec_dot(w, bb, n, A->mod, nlimbs);
+            c = nmod_mul(c, n_invmod(d, A->mod.n), A->mod);
+            _nmod_vec_scalar_addmul_nmod(x, w, n, c, A->mod);
+
+            /* w_next = M w - (v^T v / d) w - (v^T v_prev / d_prev) w_prev */
+            _nmod_vec_set(wn, v, n);
+
+            c = _nmod_vec_dot(v, v, n, A->mod, nlimbs);
+            c = nmod_neg(nmod_mul(c, n_invmod(d, A->mod.n), A->mod), A->mod);
+            _nmod_vec_scalar_addmul_nmod(wn, w, n, c, A->mod);
+
+            c = _nmod_vec_dot(v, vp, n, A->mod, nlimbs);
+            c = nmod_neg(nmod_mul(c, n_invmod(dp, A->mod.n), A->mod), A->mod);
+            _nmod_vec_scalar_addmul_nmod(wn, wp, n, c, A->mod);
+
+            tmp = wp; wp = w; w = wn; wn = tmp;
+            tmp = vp; vp = v; v = tmp;
+            dp = d;
+        }
+
+        nmod_sparse_mat_mul_vec(t, A, x);
+        success = _nmod_vec_equal(t, b, m);
+    }
+
+    nmod_sparse_mat_clear(At);
+    _nmod_vec_clear(D);
+    _nmod_vec_clear(t);
+    _nmod_vec_clear(bb);
+    _nmod_vec_clear(w);
+    _nmod_vec_clear(wp);
+    _nmod_vec_clear(wn);
+    _nmod_vec_clear(v);
+    _nmod_vec_clear(vp);
+
+    return success;
+}
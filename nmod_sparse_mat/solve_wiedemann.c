@@ -0,0 +1,177 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "nmod_sparse_mat.h"
+#include "nmod_vec.h"
+#include "ulong_extras.h"
+
+/*
+    Sets C to the connection polynomial of the shortest linear recurrence
+    generating s[0], ..., s[N - 1] and returns its degree L, using the
+    Berlekamp-Massey algorithm. C has space for N + 1 coefficients.
+ */
+static long
+_berlekamp_massey(mp_ptr C, mp_srcptr s, long N, nmod_t mod)
+{
+    mp_ptr B, T;
+    mp_limb_t d, b, q;
+    long i, k, L, m;
+
+    B = _nmod_vec_init(N + 1);
+    T = _nmod_vec_init(N + 1);
+
+    _nmod_vec_zero(C, N + 1);
+    _nmod_vec_zero(B, N + 1);
+    C[0] = B[0] = 1UL;
+    L = 0;
+    m = 1;
+    b = 1UL;
+
+    for (k = 0; k < N; k++)
+    {
+        d = s[k];
+        for (i = 1; i <= L; i++)
+            d = nmod_add(d, nmod_mul(C[i], s[k - i], mod), mod);
+
+        if (d == 0UL)
+        {
+            m++;
+            continue;
+        }
+
+        q = nmod_neg(nmod_mul(d, n_invmod(b, mod.n), mod), mod);
+
+        if (2 * L <= k)
+        {
+            _nmod_vec_set(T, C, N + 1);
+            _nmod_vec_scalar_addmul_nmod(C + m, B, N + 1 - m, q, mod);
+            L = k + 1 - L;
+            _nmod_vec_set(B, T, N + 1);
+            b = d;
+            m = 1;
+        }
+        else
+        {
+            _nmod_vec_scalar_addmul_nmod(C + m, B, N + 1 - m, q, mod);
+            m++;
+        }
+    }
+
+    _nmod_vec_clear(B);
+    _nmod_vec_clear(T);
+
+    return L;
+}
+
+int
+nmod_sparse_mat_solve_wiedemann(mp_ptr x, const nmod_sparse_mat_t A,
+                                            mp_srcptr b, flint_rand_t state)
+{
+    mp_ptr u, v, w, s, t, C;
+    mp_limb_t c;
+    long i, k, n, L, try;
+    int nlimbs, success = 0;
+
+    if (A->r != A->c)
+    {
+        printf("Exception: nmod_sparse_mat_solve_wiedemann: "
+               "matrix must be square.\n");
+        abort();
+    }
+
+    n = A->r;
+
+    if (n == 0)
+        return 1;
+
+    u = _nmod_vec_init(n);
+    v = _nmod_vec_init(n);
+    w = _nmod_vec_init(n);
+    s = _nmod_vec_init(2 * n);
+    C = _nmod_vec_init(2 * n + 1);
+
+    nlimbs = _nmod_vec_dot_bound_limbs(n, A->mod);
+
+    for (try = 0; try < NMOD_SPARSE_MAT_SOLVE_TRIES && !success; try++)
+    {
+        /* s_i = u^T A^i b for a random projection u */
+        for (i = 0; i < n; i++)
+            u[i] = n_randint(state, A->mod.n);
+
+        _nmod_vec_set(v, b, n);
+
+        for (i = 0; i < 2 * n; i++)
+        {
+            s[i] = _nmod_vec_dot(u, v, n, A->mod, nlimbs);
+
+            if (i + 1 < 2 * n)
+            {
+                nmod_sparse_mat_mul_vec(w, A, v);
+                t = v; v = w; w = t;
+            }
+        }
+
+        L = _berlekamp_massey(C, s, 2 * n, A->mod);
+
+        if (L == 0)
+        {
+            /* the sequence vanishes, as it does for b = 0 */
+            _nmod_vec_zero(x, n);
+        }
+        else
+        {
+            if (C[L] == 0UL)
+                continue;
+
+            /*
+                With f(z) = z^L C(1/z) annihilating b and f(0) = C[L]
+                nonzero, x = -(f(A) - f(0)) / (A f(0)) b, evaluated by
+                Horner's rule.
+             */
+            _nmod_vec_set(v, b, n);
+
+            for (k = L - 1; k >= 1; k--)
+            {
+                nmod_sparse_mat_mul_vec(w, A, v);
+                _nmod_vec_scalar_addmul_nmod(w, b, n, C[L - k], A->mod);
+                t = v; v = w; w = t;
+            }
+
+            c = nmod_neg(n_invmod(C[L], A->mod.n), A->mod);
+            _nmod_vec_scalar_mul_nmod(x, v, n, c, A->mod);
+        }
+
+        nmod_sparse_mat_mul_vec(w, A, x);
+        success = _nmod_vec_equal(w, b, n);
+    }
+
+    _nmod_vec_clear(u);
+    _nmod_vec_clear(v);
+    _nmod_vec_clear(w);
+    _nmod_vec_clear(s);
+    _nmod_vec_clear(C);
+
+    return success;
+}
@@ -0,0 +1,173 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "nmod_vec.h"
+#include "nmod_mat.h"
+#include "nmod_sparse_mat.h"
+#include "ulong_extras.h"
+
+int
+main(void)
+{
+    long i, j, k;
+    flint_rand_t state;
+    flint_randinit(state);
+
+    printf("filter....");
+    fflush(stdout);
+
+    for (i = 0; i < 5000; i++)
+    {
+        nmod_sparse_mat_t A, B, M;
+        nmod_mat_t D, DM, P, E, F;
+        long m, n, r, excess;
+        mp_limb_t mod;
+
+        m = n_randint(state, 30);
+        n = n_randint(state, 30);
+        mod = n_randtest_prime(state, 0);
+        excess = n_randint(state, 2) ? -1 : (long) n_randint(state, 5);
+
+        nmod_sparse_mat_init(A, m, n, mod);
+        nmod_sparse_mat_init(B, 0, 0, mod);
+        nmod_sparse_mat_init(M, 0, 0, mod);
+
+        nmod_sparse_mat_randtest(A, state, n_randint(state, 6));
+        nmod_sparse_mat_filter(B, M, A, excess);
+
+        /* rows of weight at most two are always eliminated */
+        for (j = 0; j < B->r; j++)
+        {
+            if (nmod_sparse_mat_row_length(B, j) < 3)
+            {
+                printf("FAIL: row of length %ld\n",
+                    nmod_sparse_mat_row_length(B, j));
+                abort();
+            }
+        }
+
+        /* rows stay sorted, without zero entries */
+        for (j = 0; j < B->r; j++)
+        {
+            for (k = B->rowptr[j]; k < B->rowptr[j + 1]; k++)
+            {
+                if ((k > B->rowptr[j] && B->cols[k] <= B->cols[k - 1])
+                    || B->entries[k] == 0UL)
+                {
+                    printf("FAIL: B not in canonical form\n");
+                    abort();
+                }
+            }
+        }
+
+        if (M->r != n || M->c != B->c)
+        {
+            printf("FAIL: dimensions of M\n");
+            abort();
+        }
+
+        /* B is made of the nonzero rows of A M, in order */
+        nmod_mat_init(D, m, n, mod);
+        nmod_mat_init(DM, n, B->c, mod);
+        nmod_mat_init(P, m, B->c, mod);
+        nmod_mat_init(E, B->r, B->c, mod);
+        nmod_sparse_mat_get_nmod_mat(D, A);
+        nmod_sparse_mat_get_nmod_mat(DM, M);
+        nmod_sparse_mat_get_nmod_mat(E, B);
+        nmod_mat_mul(P, D, DM);
+
+        for (j = r = 0; j < m; j++)
+        {
+            if (B->c == 0 || _nmod_vec_is_zero(P->rows[j], B->c))
+                continue;
+
+            if (r >= B->r || !_nmod_vec_equal(P->rows[j], E->rows[r], B->c))
+            {
+                printf("FAIL: B != A M\n");
+                abort();
+            }
+
+            r++;
+        }
+
+        if (r != B->r)
+        {
+            printf("FAIL: B != A M\n");
+            abort();
+        }
+
+        /* M maps the kernel of B injectively into that of A */
+        if (nmod_mat_rank(DM) != B->c)
+        {
+            printf("FAIL: rank of M\n");
+            abort();
+        }
+
+        if (excess < 0)
+        {
+            /* each deleted column carries exactly one pivot */
+            if (nmod_mat_rank(D) != nmod_mat_rank(E) + n - B->c)
+            {
+                printf("FAIL: rank\n");
+                abort();
+            }
+        }
+        else if (B->c > B->r + excess)
+        {
+            printf("FAIL: %ld columns for %ld rows\n", B->c, B->r);
+            abort();
+        }
+
+        /* a kernel vector of B gives one of A */
+        nmod_mat_init(F, B->c, B->c, mod);
+        nmod_mat_nullspace(F, E);
+        nmod_mat_clear(P);
+        nmod_mat_init(P, n, B->c, mod);
+        nmod_mat_mul(P, DM, F);
+        nmod_mat_clear(F);
+        nmod_mat_init(F, m, B->c, mod);
+        nmod_mat_mul(F, D, P);
+
+        if (!nmod_mat_is_zero(F))
+        {
+            printf("FAIL: A M ker(B) != 0\n");
+            abort();
+        }
+
+        nmod_sparse_mat_clear(A);
+        nmod_sparse_mat_clear(B);
+        nmod_sparse_mat_clear(M);
+        nmod_mat_clear(D);
+        nmod_mat_clear(DM);
+        nmod_mat_clear(P);
+        nmod_mat_clear(E);
+        nmod_mat_clear(F);
+    }
+
+    flint_randclear(state);
+
+    printf("PASS\n");
+    return 0;
+}
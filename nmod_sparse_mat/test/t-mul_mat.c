@@ -0,0 +1,96 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "nmod_mat.h"
+#include "nmod_sparse_mat.h"
+#include "ulong_extras.h"
+
+int
+main(void)
+{
+    long i;
+    flint_rand_t state;
+    flint_randinit(state);
+
+    printf("mul_mat....");
+    fflush(stdout);
+
+    for (i = 0; i < 1000; i++)
+    {
+        nmod_sparse_mat_t A;
+        nmod_mat_t D, X, Y, Z;
+        long m, n, k;
+        mp_limb_t mod;
+
+        if (n_randint(state, 20) == 0)
+        {
+            m = n_randint(state, 3 * NMOD_SPARSE_MAT_PARALLEL_ROWS);
+            n = n_randint(state, 100);
+            k = n_randint(state, 10);
+        }
+        else
+        {
+            m = n_randint(state, 50);
+            n = n_randint(state, 50);
+            k = n_randint(state, 3 * NMOD_SPARSE_MAT_MUL_PANEL);
+        }
+
+        mod = n_randtest_not_zero(state);
+        flint_set_num_threads(n_randint(state, 4) + 1);
+
+        nmod_sparse_mat_init(A, m, n, mod);
+        nmod_sparse_mat_randtest(A, state, n_randint(state, 20));
+
+        nmod_mat_init(D, m, n, mod);
+        nmod_mat_init(X, n, k, mod);
+        nmod_mat_init(Y, m, k, mod);
+        nmod_mat_init(Z, m, k, mod);
+
+        nmod_sparse_mat_get_nmod_mat(D, A);
+        nmod_mat_randtest(X, state);
+
+        nmod_mat_mul(Y, D, X);
+        nmod_sparse_mat_mul_mat(Z, A, X);
+
+        if (!nmod_mat_equal(Y, Z))
+        {
+            printf("FAIL:\n");
+            printf("m = %ld, n = %ld, k = %ld, mod = %lu\n", m, n, k, mod);
+            abort();
+        }
+
+        nmod_sparse_mat_clear(A);
+        nmod_mat_clear(D);
+        nmod_mat_clear(X);
+        nmod_mat_clear(Y);
+        nmod_mat_clear(Z);
+    }
+
+    flint_set_num_threads(1);
+    flint_randclear(state);
+
+    printf("PASS\n");
+    return 0;
+}
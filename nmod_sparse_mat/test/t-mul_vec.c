@@ -0,0 +1,110 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "nmod_mat.h"
+#include "nmod_sparse_mat.h"
+#include "ulong_extras.h"
+
+int
+main(void)
+{
+    long i, j;
+    flint_rand_t state;
+    flint_randinit(state);
+
+    printf("mul_vec....");
+    fflush(stdout);
+
+    for (i = 0; i < 1000; i++)
+    {
+        nmod_sparse_mat_t A;
+        nmod_sparse_mat_ell_t E;
+        nmod_mat_t D, X, Y;
+        mp_ptr x, y, z;
+        long m, n;
+        mp_limb_t mod;
+
+        /* large enough to be split among threads */
+        if (n_randint(state, 20) == 0)
+        {
+            m = n_randint(state, 3 * NMOD_SPARSE_MAT_PARALLEL_ROWS);
+            n = n_randint(state, 100) + 1;
+        }
+        else
+        {
+            m = n_randint(state, 50);
+            n = n_randint(state, 50) + 1;
+        }
+
+        mod = n_randtest_not_zero(state);
+        flint_set_num_threads(n_randint(state, 4) + 1);
+
+        nmod_sparse_mat_init(A, m, n, mod);
+        nmod_sparse_mat_randtest(A, state, n_randint(state, 20));
+        nmod_sparse_mat_ell_init_set(E, A);
+
+        nmod_mat_init(D, m, n, mod);
+        nmod_mat_init(X, n, 1, mod);
+        nmod_mat_init(Y, m, 1, mod);
+        nmod_sparse_mat_get_nmod_mat(D, A);
+        nmod_mat_randtest(X, state);
+        nmod_mat_mul(Y, D, X);
+
+        x = _nmod_vec_init(n);
+        y = _nmod_vec_init(m + 1);
+        z = _nmod_vec_init(m + 1);
+
+        for (j = 0; j < n; j++)
+            x[j] = nmod_mat_entry(X, j, 0);
+
+        nmod_sparse_mat_mul_vec(y, A, x);
+        nmod_sparse_mat_ell_mul_vec(z, E, x);
+
+        for (j = 0; j < m; j++)
+        {
+            if (y[j] != nmod_mat_entry(Y, j, 0) || z[j] != y[j])
+            {
+                printf("FAIL:\n");
+                printf("m = %ld, n = %ld, mod = %lu, row %ld\n", m, n, mod, j);
+                abort();
+            }
+        }
+
+        nmod_sparse_mat_clear(A);
+        nmod_sparse_mat_ell_clear(E);
+        nmod_mat_clear(D);
+        nmod_mat_clear(X);
+        nmod_mat_clear(Y);
+        _nmod_vec_clear(x);
+        _nmod_vec_clear(y);
+        _nmod_vec_clear(z);
+    }
+
+    flint_set_num_threads(1);
+    flint_randclear(state);
+
+    printf("PASS\n");
+    return 0;
+}
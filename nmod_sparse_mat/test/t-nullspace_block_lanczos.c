@@ -0,0 +1,106 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "nmod_mat.h"
+#include "nmod_sparse_mat.h"
+#include "ulong_extras.h"
+
+int
+main(void)
+{
+    long i, empty = 0;
+    flint_rand_t state;
+    flint_randinit(state);
+
+    printf("nullspace_block_lanczos....");
+    fflush(stdout);
+
+    for (i = 0; i < 200; i++)
+    {
+        nmod_sparse_mat_t A;
+        nmod_mat_t D, X, Y;
+        long m, n, j, k, nullity;
+
+        /* more columns than rows, as for the quadratic sieve */
+        m = n_randint(state, 500);
+        n = m + n_randint(state, 100) + 1;
+
+        nmod_sparse_mat_init(A, m, n, 2UL);
+        nmod_sparse_mat_randtest(A, state, n_randint(state, 20) + 1);
+
+        nmod_mat_init(X, n, n, 2UL);
+        nmod_mat_randtest(X, state);
+        nullity = nmod_sparse_mat_nullspace_block_lanczos(X, A, state);
+
+        if (X->r != n || X->c != n || nullity > 64
+            || nmod_mat_rank(X) != nullity)
+        {
+            printf("FAIL:\n");
+            printf("m = %ld, n = %ld, nullity = %ld\n", m, n, nullity);
+            abort();
+        }
+
+        nmod_mat_init(D, m, n, 2UL);
+        nmod_mat_init(Y, m, n, 2UL);
+        nmod_sparse_mat_get_nmod_mat(D, A);
+        nmod_mat_mul(Y, D, X);
+
+        if (!nmod_mat_is_zero(Y))
+        {
+            printf("FAIL: A * X != 0\n");
+            abort();
+        }
+
+        for (j = 0; j < n; j++)
+        {
+            for (k = nullity; k < n; k++)
+            {
+                if (nmod_mat_entry(X, j, k) != 0UL)
+                {
+                    printf("FAIL: trailing columns of X not zero\n");
+                    abort();
+                }
+            }
+        }
+
+        empty += (nullity == 0);
+
+        nmod_sparse_mat_clear(A);
+        nmod_mat_clear(D);
+        nmod_mat_clear(X);
+        nmod_mat_clear(Y);
+    }
+
+    if (empty > 20)
+    {
+        printf("FAIL: no kernel vectors found in %ld cases\n", empty);
+        abort();
+    }
+
+    flint_randclear(state);
+
+    printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,87 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "nmod_mat.h"
+#include "nmod_sparse_mat.h"
+#include "ulong_extras.h"
+
+int
+main(void)
+{
+    long i;
+    flint_rand_t state;
+    flint_randinit(state);
+
+    printf("rank....");
+    fflush(stdout);
+
+    for (i = 0; i < 5000; i++)
+    {
+        nmod_sparse_mat_t A;
+        nmod_mat_t D;
+        long m, n, r, r1, r2;
+        mp_limb_t mod;
+
+        m = n_randint(state, 30);
+        n = n_randint(state, 30);
+        mod = n_randtest_prime(state, 0);
+
+        nmod_sparse_mat_init(A, m, n, mod);
+        nmod_mat_init(D, m, n, mod);
+
+        if (n_randint(state, 2))
+        {
+            nmod_sparse_mat_randtest(A, state, n_randint(state, 6));
+            nmod_sparse_mat_get_nmod_mat(D, A);
+        }
+        else
+        {
+            /* sparse matrices of given rank */
+            r = n_randint(state, FLINT_MIN(m, n) + 1);
+            nmod_mat_randrank(D, state, r);
+            nmod_mat_randops(D, n_randint(state, 2 * (m + n) + 1), state);
+            nmod_sparse_mat_set_nmod_mat(A, D);
+        }
+
+        r1 = nmod_sparse_mat_rank(A);
+        r2 = nmod_mat_rank(D);
+
+        if (r1 != r2)
+        {
+            printf("FAIL:\n");
+            printf("rank = %ld, expected %ld\n", r1, r2);
+            nmod_sparse_mat_print_pretty(A);
+            abort();
+        }
+
+        nmod_sparse_mat_clear(A);
+        nmod_mat_clear(D);
+    }
+
+    flint_randclear(state);
+
+    printf("PASS\n");
+    return 0;
+}
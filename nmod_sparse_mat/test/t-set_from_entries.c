@@ -0,0 +1,123 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "nmod_mat.h"
+#include "nmod_sparse_mat.h"
+#include "ulong_extras.h"
+
+int
+main(void)
+{
+    long i;
+    flint_rand_t state;
+    flint_randinit(state);
+
+    printf("set_from_entries....");
+    fflush(stdout);
+
+    for (i = 0; i < 2000; i++)
+    {
+        nmod_sparse_mat_t A, B;
+        nmod_mat_t D, E;
+        long m, n, len, k;
+        long * rows, * cols;
+        mp_ptr vals;
+        mp_limb_t mod;
+
+        m = n_randint(state, 30);
+        n = n_randint(state, 30);
+        mod = n_randtest_not_zero(state);
+        len = (m && n) ? n_randint(state, 2 * m * n + 1) : 0;
+
+        rows = malloc((len + 1) * sizeof(long));
+        cols = malloc((len + 1) * sizeof(long));
+        vals = malloc((len + 1) * sizeof(mp_limb_t));
+
+        nmod_sparse_mat_init(A, m, n, mod);
+        nmod_sparse_mat_init(B, m, n, mod);
+        nmod_mat_init(D, m, n, mod);
+        nmod_mat_init(E, m, n, mod);
+
+        /* repeated positions are summed */
+        for (k = 0; k < len; k++)
+        {
+            rows[k] = n_randint(state, m);
+            cols[k] = n_randint(state, n);
+            vals[k] = n_randint(state, mod);
+            nmod_mat_entry(D, rows[k], cols[k]) = nmod_add(
+                nmod_mat_entry(D, rows[k], cols[k]), vals[k], D->mod);
+        }
+
+        nmod_sparse_mat_set_from_entries(A, rows, cols, vals, len);
+        nmod_sparse_mat_get_nmod_mat(E, A);
+
+        if (!nmod_mat_equal(D, E))
+        {
+            printf("FAIL: set_from_entries\n");
+            abort();
+        }
+
+        for (k = 0; k < A->nnz; k++)
+        {
+            if (A->entries[k] == 0UL)
+            {
+                printf("FAIL: zero entry stored\n");
+                abort();
+            }
+        }
+
+        nmod_sparse_mat_set_nmod_mat(B, D);
+
+        if (!nmod_sparse_mat_equal(A, B))
+        {
+            printf("FAIL: set_nmod_mat\n");
+            abort();
+        }
+
+        for (k = 0; k < 10 && m && n; k++)
+        {
+            long r = n_randint(state, m), c = n_randint(state, n);
+
+            if (nmod_sparse_mat_get_entry(A, r, c) != nmod_mat_entry(D, r, c))
+            {
+                printf("FAIL: get_entry\n");
+                abort();
+            }
+        }
+
+        nmod_sparse_mat_clear(A);
+        nmod_sparse_mat_clear(B);
+        nmod_mat_clear(D);
+        nmod_mat_clear(E);
+        free(rows);
+        free(cols);
+        free(vals);
+    }
+
+    flint_randclear(state);
+
+    printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,133 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "nmod_mat.h"
+#include "nmod_sparse_mat.h"
+#include "ulong_extras.h"
+
+int
+main(void)
+{
+    long i, j, fails = 0;
+    flint_rand_t state;
+    flint_randinit(state);
+
+    printf("solve_block_wiedemann....");
+    fflush(stdout);
+
+    for (i = 0; i < 2000; i++)
+    {
+        nmod_sparse_mat_t A;
+        nmod_mat_t D;
+        mp_ptr x, b, y, vals;
+        long m, n, w, k, len, block, * rows, * cols;
+        mp_limb_t mod;
+
+        n = n_randint(state, 60);
+        m = n;
+        mod = n_randtest_prime(state, 0);
+
+        /* random sparse matrix plus a random nonzero diagonal */
+        w = (n == 0) ? 0 : n_randint(state, 5);
+        rows = malloc((m * (w + 1) + 1) * sizeof(long));
+        cols = malloc((m * (w + 1) + 1) * sizeof(long));
+        vals = _nmod_vec_init(m * (w + 1) + 1);
+        len = 0;
+
+        for (j = 0; j < m; j++)
+        {
+            for (k = 0; k < w; k++, len++)
+            {
+                rows[len] = j;
+                cols[len] = n_randint(state, n);
+                vals[len] = n_randint(state, mod);
+            }
+
+            if (j < n)
+            {
+                rows[len] = cols[len] = j;
+                vals[len] = n_randint(state, mod - 1) + 1;
+                len++;
+            }
+        }
+
+        nmod_sparse_mat_init(A, m, n, mod);
+        nmod_sparse_mat_set_from_entries(A, rows, cols, vals, len);
+
+        x = _nmod_vec_init(n + 1);
+        b = _nmod_vec_init(m + 1);
+        y = _nmod_vec_init(m + 1);
+
+        nmod_mat_init(D, m, n, mod);
+        nmod_sparse_mat_get_nmod_mat(D, A);
+
+        /* only square nonsingular systems are guaranteed to be solved */
+        if (nmod_mat_rank(D) == n)
+        {
+            for (j = 0; j < n; j++)
+                x[j] = n_randint(state, mod);
+
+            nmod_sparse_mat_mul_vec(b, A, x);
+
+            /* failure has probability O(n / p) per projection */
+            block = 1 + n_randint(state, 10);
+            if (!_nmod_sparse_mat_solve_block_wiedemann(x, A, b,
+                                                            block, state))
+            {
+                fails += (mod > 1000);
+            }
+            else
+            {
+                nmod_sparse_mat_mul_vec(y, A, x);
+
+                if (!_nmod_vec_equal(y, b, m))
+                {
+                    printf("FAIL: A x != b\n");
+                    abort();
+                }
+            }
+        }
+
+        nmod_sparse_mat_clear(A);
+        nmod_mat_clear(D);
+        free(rows);
+        free(cols);
+        _nmod_vec_clear(vals);
+        _nmod_vec_clear(x);
+        _nmod_vec_clear(b);
+        _nmod_vec_clear(y);
+    }
+
+    if (fails > 2)
+    {
+        printf("FAIL: %ld failures\n", fails);
+        abort();
+    }
+
+    flint_randclear(state);
+
+    printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,103 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "nmod_mat.h"
+#include "nmod_sparse_mat.h"
+#include "ulong_extras.h"
+
+int
+main(void)
+{
+    long i;
+    flint_rand_t state;
+    flint_randinit(state);
+
+    printf("transpose....");
+    fflush(stdout);
+
+    for (i = 0; i < 2000; i++)
+    {
+        nmod_sparse_mat_t A, B, C;
+        nmod_mat_t D, DT, E;
+        long m, n;
+        mp_limb_t mod;
+
+        m = n_randint(state, 40);
+        n = n_randint(state, 40);
+        mod = n_randtest_not_zero(state);
+
+        nmod_sparse_mat_init(A, m, n, mod);
+        nmod_sparse_mat_init(B, n, m, mod);
+        nmod_sparse_mat_init(C, m, n, mod);
+        nmod_mat_init(D, m, n, mod);
+        nmod_mat_init(DT, n, m, mod);
+        nmod_mat_init(E, n, m, mod);
+
+        nmod_sparse_mat_randtest(A, state, n_randint(state, 10));
+        nmod_sparse_mat_transpose(B, A);
+
+        nmod_sparse_mat_get_nmod_mat(D, A);
+        nmod_mat_transpose(DT, D);
+        nmod_sparse_mat_get_nmod_mat(E, B);
+
+        if (!nmod_mat_equal(DT, E))
+        {
+            printf("FAIL: transpose\n");
+            abort();
+        }
+
+        nmod_sparse_mat_transpose(C, B);
+
+        if (!nmod_sparse_mat_equal(A, C))
+        {
+            printf("FAIL: (A^T)^T != A\n");
+            abort();
+        }
+
+        if (m == n)
+        {
+            nmod_sparse_mat_set(C, A);
+            nmod_sparse_mat_transpose(C, C);
+
+            if (!nmod_sparse_mat_equal(B, C))
+            {
+                printf("FAIL: aliasing\n");
+                abort();
+            }
+        }
+
+        nmod_sparse_mat_clear(A);
+        nmod_sparse_mat_clear(B);
+        nmod_sparse_mat_clear(C);
+        nmod_mat_clear(D);
+        nmod_mat_clear(DT);
+        nmod_mat_clear(E);
+    }
+
+    flint_randclear(state);
+
+    printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,73 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "nmod_sparse_mat.h"
+
+void
+nmod_sparse_mat_transpose(nmod_sparse_mat_t B, const nmod_sparse_mat_t A)
+{
+    long i, k, pos;
+    long * next;
+
+    if (B == A)
+    {
+        nmod_sparse_mat_t T;
+        nmod_sparse_mat_init(T, A->c, A->r, A->mod.n);
+        nmod_sparse_mat_transpose(T, A);
+        nmod_sparse_mat_swap(B, T);
+        nmod_sparse_mat_clear(T);
+        return;
+    }
+
+    nmod_sparse_mat_fit_nnz(B, A->nnz);
+
+    /* counting sort by column; rows come out in increasing order */
+    for (i = 0; i <= A->c; i++)
+        B->rowptr[i] = 0;
+
+    for (k = 0; k < A->nnz; k++)
+        B->rowptr[A->cols[k] + 1]++;
+
+    for (i = 0; i < A->c; i++)
+        B->rowptr[i + 1] += B->rowptr[i];
+
+    next = malloc((A->c + 1) * sizeof(long));
+
+    for (i = 0; i < A->c; i++)
+        next[i] = B->rowptr[i];
+
+    for (i = 0; i < A->r; i++)
+    {
+        for (k = A->rowptr[i]; k < A->rowptr[i + 1]; k++)
+        {
+            pos = next[A->cols[k]]++;
+            B->cols[pos] = i;
+            B->entries[pos] = A->entries[k];
+        }
+    }
+
+    B->nnz = A->nnz;
+
+    free(next);
+}
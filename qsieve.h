@@ -286,8 +286,6 @@ static __inline__ void free_col(la_col_t * col)
 
 uint64_t get_null_entry(uint64_t * nullrows, long i, long l);
 
-void reduce_matrix(qs_t qs_inf, long * nrows, long * ncols, la_col_t * cols);
-
 uint64_t * block_lanczos(flint_rand_t state, long nrows, long dense_rows, 
                                                        long ncols, la_col_t *B);
 
@@ -180,25 +180,14 @@ mp_limb_t qsieve_ll_factor(mp_limb_t hi, mp_limb_t lo)
 
     free(sieve);
 
-    /************************************************************************
-        REDUCE MATRIX:
-        
-        Perform some light filtering on the matrix
-    ************************************************************************/
-
     ncols = qs_inf->num_primes + qs_inf->extra_rels;
     nrows = qs_inf->num_primes;
 
-#if QS_DEBUG
-    printf("Reduce matrix:\n");
-#endif
-
-	reduce_matrix(qs_inf, &nrows, &ncols, qs_inf->matrix); 
- 
     /************************************************************************
         BLOCK LANCZOS:
         
-        Find extra_rels nullspace vectors (if they exist)
+        Filter the matrix and find extra_rels nullspace vectors (if they 
+        exist)
     ************************************************************************/
 
 #if QS_DEBUG
@@ -0,0 +1,89 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "ulong_extras.h"
+
+void square_entry(void * arg, long i)
+{
+   mp_limb_t * v = (mp_limb_t *) arg;
+
+   v[i] = v[i] * v[i] + 1UL;
+}
+
+int main(void)
+{
+   int i, result;
+   flint_rand_t state;
+   flint_randinit(state);
+
+   printf("parallel_do....");
+   fflush(stdout);
+
+   for (i = 0; i < 1000; i++)
+   {
+      mp_limb_t * v;
+      long j, n;
+      int num_threads;
+
+      n = n_randint(state, 1000);
+      num_threads = n_randint(state, 5);
+
+      v = malloc((n + 1) * sizeof(mp_limb_t));
+      for (j = 0; j < n; j++)
+         v[j] = j;
+
+      /* Each index must be processed exactly once */
+      flint_parallel_do(square_entry, v, n, num_threads);
+
+      result = 1;
+      for (j = 0; j < n; j++)
+         result &= (v[j] == (mp_limb_t) j * j + 1UL);
+
+      if (!result)
+      {
+         printf("FAIL:\n");
+         printf("n = %ld, num_threads = %d\n", n, num_threads); 
+         abort();
+      }
+
+      free(v);
+   }
+
+   flint_set_num_threads(3);
+   result = (flint_get_num_threads() == 3);
+   flint_set_num_threads(0);
+   result &= (flint_get_num_threads() == 1);
+
+   if (!result)
+   {
+      printf("FAIL:\n");
+      printf("flint_set_num_threads/ flint_get_num_threads\n"); 
+      abort();
+   }
+
+   flint_randclear(state);
+
+   printf("PASS\n");
+   return 0;
+}
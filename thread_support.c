@@ -0,0 +1,142 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdlib.h>
+#include <pthread.h>
+#include "flint.h"
+
+#if defined(__GNUC__) && !defined(__APPLE__)
+#define FLINT_TLS __thread
+#else
+#define FLINT_TLS
+#endif
+
+static int _flint_num_threads = 1;
+
+/* Set while the current thread executes tasks of flint_parallel_do */
+static FLINT_TLS int _flint_in_parallel = 0;
+
+int
+flint_get_num_threads(void)
+{
+    /* Parallel regions are not nested; code called from within a
+       parallel region runs on a single thread */
+    return _flint_in_parallel ? 1 : _flint_num_threads;
+}
+
+void
+flint_set_num_threads(int num_threads)
+{
+    _flint_num_threads = FLINT_MAX(num_threads, 1);
+}
+
+typedef struct
+{
+    void (*func)(void *, long);
+    void * data;
+    long n;
+    long next;
+    pthread_mutex_t mutex;
+}
+_flint_parallel_struct;
+
+/* Each worker repeatedly claims the next unprocessed index, so that
+   threads which finish early pick up the remaining work */
+static void *
+_flint_parallel_worker(void * arg)
+{
+    _flint_parallel_struct * s = (_flint_parallel_struct *) arg;
+    long i;
+    int in_parallel = _flint_in_parallel;
+
+    _flint_in_parallel = 1;
+
+    while (1)
+    {
+        pthread_mutex_lock(&s->mutex);
+        i = s->next++;
+        pthread_mutex_unlock(&s->mutex);
+
+        if (i >= s->n)
+            break;
+
+        s->func(s->data, i);
+    }
+
+    _flint_in_parallel = in_parallel;
+
+    return NULL;
+}
+
+/* Entry point of the extra threads; MPFR keeps its constant caches in
+   thread-local storage, which would otherwise leak when the thread exits */
+static void *
+_flint_parallel_thread(void * arg)
+{
+    _flint_parallel_worker(arg);
+#if MPFR_VERSION_MAJOR >= 4
+    mpfr_free_cache2(MPFR_FREE_LOCAL_CACHE);
+#else
+    mpfr_free_cache();
+#endif
+
+    return NULL;
+}
+
+void
+flint_parallel_do(void (*func)(void *, long), void * data, long n,
+                                                            int num_threads)
+{
+    _flint_parallel_struct s;
+    pthread_t * threads;
+    long i, num_started;
+
+    if (num_threads > n)
+        num_threads = n;
+
+    if (num_threads <= 1)
+    {
+        for (i = 0; i < n; i++)
+            func(data, i);
+        return;
+    }
+
+    s.func = func;
+    s.data = data;
+    s.n = n;
+    s.next = 0;
+    pthread_mutex_init(&s.mutex, NULL);
+
+    threads = malloc(sizeof(pthread_t) * (num_threads - 1));
+
+    /* If a thread cannot be created the others simply do more work */
+    for (num_started = 0; num_started < num_threads - 1; num_started++)
+        if (pthread_create(threads + num_started, NULL,
+                                            _flint_parallel_thread, &s) != 0)
+            break;
+
+    _flint_parallel_worker(&s);
+
+    for (i = 0; i < num_started; i++)
+        pthread_join(threads[i], NULL);
+
+    free(threads);
+    pthread_mutex_destroy(&s.mutex);
+}
@@ -56,8 +56,38 @@ typedef struct factor_s
 #define FLINT_FACTOR_ONE_LINE_MAX (1UL<<39)
 #define FLINT_FACTOR_ONE_LINE_ITERS 40000
 
+/* Number of iterations and random polynomials tried in Pollard-Brent
+   rho, and number of steps between gcds */
+#define FLINT_FACTOR_POLLARD_BRENT_ITERS 1000000
+#define FLINT_FACTOR_POLLARD_BRENT_TRIES 100
+#define FLINT_FACTOR_POLLARD_BRENT_BLOCK 128
+
+/* Number of odd primes trial divided by in n_is_prime_vec and
+   n_factor_vec, at most FLINT_NUM_PRIMES_SMALL - 1 */
+#define N_IS_PRIME_VEC_TRIAL_PRIMES 64
+#define N_FACTOR_VEC_TRIAL_PRIMES 171
+
+/* Number of integers tested together in n_is_prime_vec */
+#define N_IS_PRIME_VEC_LANES 4
+
+/* Number of entries per block in n_is_prime_vec and n_factor_vec,
+   which is the unit of work for threads */
+#define N_VEC_BLOCK 1024
+
+/* Number of odd integers per segment of n_sieve_primes */
+#define N_SIEVE_PRIMES_BLOCK 32768
+
 #define FLINT_PRIME_PI_ODD_LOOKUP_CUTOFF 311
 
+/* n_prime_pi(n) for n >= N_PRIME_PI_LMO_CUTOFF and n_nth_prime(n) for
+   n > N_NTH_PRIME_TABLE_CUTOFF use the combinatorial algorithm instead
+   of the table of primes */
+#define N_PRIME_PI_LMO_CUTOFF 700000UL
+#define N_NTH_PRIME_TABLE_CUTOFF 75000UL
+
+/* Minimum segment length in n_prime_pi_lmo */
+#define N_PRIME_PI_SEGMENT 32768
+
 #if FLINT64
 #define ULONG_MAX_PRIME 18446744073709551557UL
 #else
@@ -112,6 +142,38 @@ mp_limb_t n_preinvert_limb(mp_limb_t n)
    return ninv;
 }
 
+/*
+    Montgomery arithmetic modulo an odd n: residues x are represented
+    by x 2^FLINT_BITS mod n, and products are reduced with the inverse
+    of n modulo 2^FLINT_BITS.
+ */
+static __inline__
+mp_limb_t n_preinvert_redc(mp_limb_t n)
+{
+   mp_limb_t ninv = (3 * n) ^ 2UL; /* correct to 5 bits */
+
+   ninv *= 2 - n * ninv;
+   ninv *= 2 - n * ninv;
+   ninv *= 2 - n * ninv;
+#if FLINT64
+   ninv *= 2 - n * ninv;
+#endif
+
+   return ninv;
+}
+
+static __inline__
+mp_limb_t n_mulredc(mp_limb_t a, mp_limb_t b, mp_limb_t n, mp_limb_t ninv)
+{
+   mp_limb_t hi, lo, mhi, mlo;
+
+   umul_ppmm(hi, lo, a, b);
+   umul_ppmm(mhi, mlo, lo * ninv, n);
+
+   /* the low limbs agree, so (hi, lo) - (mhi, mlo) = (hi - mhi) B */
+   return (hi < mhi) ? hi - mhi + n : hi - mhi;
+}
+
 mp_limb_t n_mod_precomp(mp_limb_t a, mp_limb_t n, double ninv);
 
 mp_limb_t n_mod2_precomp(mp_limb_t a, mp_limb_t n, double ninv);
@@ -221,6 +283,8 @@ int n_is_prime_pocklington(mp_limb_t n, ulong iterations);
 
 int n_is_prime(mp_limb_t n);
 
+void n_is_prime_vec(int * res, mp_srcptr vec, long len);
+
 void n_compute_primes(ulong num_primes);
 
 mp_limb_t n_nth_prime(ulong n);
@@ -229,8 +293,15 @@ void n_nth_prime_bounds(mp_limb_t *lo, mp_limb_t *hi, ulong n);
 
 ulong n_prime_pi(mp_limb_t n);
 
+ulong n_prime_pi_lmo(mp_limb_t n);
+
 void n_prime_pi_bounds(ulong *lo, ulong *hi, mp_limb_t n);
 
+mp_limb_t * n_sieve_primes(long * num, mp_limb_t n);
+
+void _n_sieve_odd_range(unsigned char * sieve, mp_limb_t lo, mp_limb_t hi,
+                                        const mp_limb_t * primes, long num);
+
 int n_remove(mp_limb_t * n, mp_limb_t p);
 
 int n_remove2_precomp(mp_limb_t * n, mp_limb_t p, double ppre);
@@ -263,8 +334,16 @@ mp_limb_t n_factor_lehman(mp_limb_t n);
 
 mp_limb_t n_factor_SQUFOF(mp_limb_t n, ulong iters);
 
+int n_factor_pollard_brent_single(mp_limb_t * factor, mp_limb_t n,
+                   mp_limb_t ninv, mp_limb_t a, mp_limb_t x0, ulong max_iters);
+
+int n_factor_pollard_brent(mp_limb_t * factor, flint_rand_t state,
+                            mp_limb_t n, ulong max_tries, ulong max_iters);
+
 void n_factor(n_factor_t * factors, mp_limb_t n, int proved);
 
+void n_factor_vec(n_factor_t * factors, mp_srcptr vec, long len);
+
 int n_is_squarefree(mp_limb_t n);
 
 int n_moebius_mu(mp_limb_t n);
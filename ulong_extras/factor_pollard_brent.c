@@ -0,0 +1,55 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <mpir.h>
+#include "flint.h"
+#include "ulong_extras.h"
+
+int
+n_factor_pollard_brent(mp_limb_t * factor, flint_rand_t state,
+                            mp_limb_t n, ulong max_tries, ulong max_iters)
+{
+    mp_limb_t ninv, a, x0;
+
+    if ((n & 1UL) == 0)
+    {
+        if (n <= 2UL)
+            return 0;
+
+        *factor = 2UL;
+        return 1;
+    }
+
+    if (n < 5UL)
+        return 0;
+
+    ninv = n_preinvert_redc(n);
+
+    for ( ; max_tries > 0; max_tries--)
+    {
+        a = 1 + n_randint(state, n - 1);
+        x0 = n_randint(state, n);
+
+        if (n_factor_pollard_brent_single(factor, n, ninv, a, x0, max_iters))
+            return 1;
+    }
+
+    return 0;
+}
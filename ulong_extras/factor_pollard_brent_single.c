@@ -0,0 +1,83 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <mpir.h>
+#include "flint.h"
+#include "ulong_extras.h"
+
+/* x^2 + a in Montgomery arithmetic */
+#define STEP(x) n_addmod(n_mulredc((x), (x), n, ninv), a, n)
+
+int
+n_factor_pollard_brent_single(mp_limb_t * factor, mp_limb_t n,
+                    mp_limb_t ninv, mp_limb_t a, mp_limb_t x0, ulong max_iters)
+{
+    mp_limb_t x, y, ys, q, g;
+    ulong r, k, i, m, iters;
+
+    y = x0;
+    q = 1UL;
+    g = 1UL;
+    r = 1UL;
+    iters = 0UL;
+
+    do
+    {
+        x = y;
+        for (i = 0; i < r; i++)
+            y = STEP(y);
+
+        k = 0;
+        do
+        {
+            /* multiply together a block of differences before a gcd */
+            ys = y;
+            m = FLINT_MIN(FLINT_FACTOR_POLLARD_BRENT_BLOCK, r - k);
+
+            for (i = 0; i < m; i++)
+            {
+                y = STEP(y);
+                q = n_mulredc(q, (x > y) ? x - y : y - x, n, ninv);
+            }
+
+            g = n_gcd(n, q);
+            k += m;
+        } while (k < r && g == 1UL);
+
+        iters += 2 * r;
+        r *= 2;
+    } while (g == 1UL && iters < max_iters);
+
+    /* the block went too far; redo it one difference at a time */
+    if (g == n)
+    {
+        do
+        {
+            ys = STEP(ys);
+            g = n_gcd(n, (x > ys) ? x - ys : ys - x);
+        } while (g == 1UL);
+    }
+
+    if (g == 1UL || g == n)
+        return 0;
+
+    *factor = g;
+    return 1;
+}
@@ -0,0 +1,231 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "ulong_extras.h"
+
+/*
+    Completes the factorisation of n^exp, where n > 1 is odd and
+    composite, and has no prime factors up to the trial division bound.
+*/
+static void
+_n_factor_cofactor(n_factor_t * factors, mp_limb_t n, ulong exp)
+{
+    mp_limb_t stack[FLINT_MAX_FACTORS_IN_LIMB];
+    ulong exps[FLINT_MAX_FACTORS_IN_LIMB];
+    mp_limb_t ninv, f, root, part[2];
+    ulong e, a;
+    long top;
+    int i, prime[2];
+
+    /* the stack only ever holds composites */
+    stack[0] = n;
+    exps[0] = exp;
+    top = 1;
+
+    while (top > 0)
+    {
+        top--;
+        n = stack[top];
+        exp = exps[top];
+
+        if ((root = n_factor_power235(&e, n)))
+        {
+            n = root;
+            exp *= e;
+
+            n_is_prime_vec(prime, &n, 1);
+            if (prime[0])
+            {
+                n_factor_insert(factors, n, exp);
+                continue;
+            }
+        }
+
+        ninv = n_preinvert_redc(n);
+
+        for (a = 1; a <= FLINT_FACTOR_POLLARD_BRENT_TRIES; a++)
+            if (n_factor_pollard_brent_single(&f, n, ninv, a, 2UL,
+                                            FLINT_FACTOR_POLLARD_BRENT_ITERS))
+                break;
+
+        if (a > FLINT_FACTOR_POLLARD_BRENT_TRIES
+            && !(f = n_factor_SQUFOF(n, FLINT_FACTOR_SQUFOF_ITERS)))
+        {
+            printf("Exception: failed to factor %lu\n", n);
+            abort();
+        }
+
+        part[0] = f;
+        part[1] = n / f;
+        n_is_prime_vec(prime, part, 2);
+
+        for (i = 0; i < 2; i++)
+        {
+            if (prime[i])
+            {
+                n_factor_insert(factors, part[i], exp);
+            }
+            else
+            {
+                stack[top] = part[i];
+                exps[top] = exp;
+                top++;
+            }
+        }
+    }
+}
+
+static void
+_n_factor_vec(n_factor_t * factors, mp_srcptr vec, long len)
+{
+    mp_limb_t pinv[N_FACTOR_VEC_TRIAL_PRIMES + 1];
+    mp_limb_t plim[N_FACTOR_VEC_TRIAL_PRIMES + 1];
+    mp_limb_t n, p, * cof;
+    long * idx;
+    int * prime;
+    long i, k, num;
+    unsigned int e;
+
+    for (k = 1; k <= N_FACTOR_VEC_TRIAL_PRIMES; k++)
+    {
+        p = flint_primes_small[k];
+        pinv[k] = n_preinvert_redc(p);
+        plim[k] = (~0UL) / p;
+    }
+
+    cof = malloc(sizeof(mp_limb_t) * len);
+    idx = malloc(sizeof(long) * len);
+    prime = malloc(sizeof(int) * len);
+    num = 0;
+
+    /* trial division of the whole block */
+    for (i = 0; i < len; i++)
+    {
+        n_factor_init(factors + i);
+        n = vec[i];
+
+        if (n <= 1UL)
+            continue;
+
+        count_trailing_zeros(e, n);
+        if (e != 0)
+        {
+            n_factor_insert(factors + i, 2UL, e);
+            n >>= e;
+        }
+
+        for (k = 1; k <= N_FACTOR_VEC_TRIAL_PRIMES; k++)
+        {
+            p = flint_primes_small[k];
+
+            if (p * p > n)
+                break;
+
+            if (n * pinv[k] <= plim[k])
+            {
+                e = 0;
+                do
+                {
+                    n *= pinv[k];   /* exact division */
+                    e++;
+                } while (n * pinv[k] <= plim[k]);
+
+                n_factor_insert(factors + i, p, e);
+            }
+        }
+
+        if (n == 1UL)
+            continue;
+
+        if (k <= N_FACTOR_VEC_TRIAL_PRIMES)
+        {
+            n_factor_insert(factors + i, n, 1);
+        }
+        else
+        {
+            cof[num] = n;
+            idx[num] = i;
+            num++;
+        }
+    }
+
+    /* primality of the remaining cofactors, tested as one batch */
+    if (num != 0)
+        n_is_prime_vec(prime, cof, num);
+
+    for (i = 0; i < num; i++)
+    {
+        if (prime[i])
+            n_factor_insert(factors + idx[i], cof[i], 1);
+        else
+            _n_factor_cofactor(factors + idx[i], cof[i], 1);
+    }
+
+    free(cof);
+    free(idx);
+    free(prime);
+}
+
+typedef struct
+{
+    n_factor_t * factors;
+    mp_srcptr vec;
+    long len;
+}
+_factor_vec_struct;
+
+static void
+_factor_vec_worker(void * arg, long i)
+{
+    _factor_vec_struct * s = (_factor_vec_struct *) arg;
+    long start = i * N_VEC_BLOCK;
+
+    _n_factor_vec(s->factors + start, s->vec + start,
+                                FLINT_MIN(N_VEC_BLOCK, s->len - start));
+}
+
+void
+n_factor_vec(n_factor_t * factors, mp_srcptr vec, long len)
+{
+    _factor_vec_struct s;
+    long i, num_blocks;
+    int num_threads;
+
+    num_blocks = (len + N_VEC_BLOCK - 1) / N_VEC_BLOCK;
+    num_threads = flint_get_num_threads();
+
+    s.factors = factors;
+    s.vec = vec;
+    s.len = len;
+
+    if (num_threads > 1 && num_blocks > 1)
+    {
+        flint_parallel_do(_factor_vec_worker, &s, num_blocks, num_threads);
+    }
+    else
+    {
+        for (i = 0; i < num_blocks; i++)
+            _factor_vec_worker(&s, i);
+    }
+}
@@ -0,0 +1,269 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "ulong_extras.h"
+
+#define LANES N_IS_PRIME_VEC_LANES
+
+/*
+    Clears res[j] for each j < num such that n[j] is not a strong
+    probable prime to base a. The n[j] must be odd, and there must be
+    at most LANES of them. The lanes are processed in lockstep so that
+    the independent multiplications can overlap in the pipeline.
+*/
+static void
+_n_sprp_lanes(int * res, const mp_limb_t * nn, long num, mp_limb_t a)
+{
+    mp_limb_t n[LANES], ninv[LANES], one[LANES], mone[LANES];
+    mp_limb_t d[LANES], x[LANES], am[LANES], t;
+    unsigned int s[LANES];
+    int bits, b, j, i, skip[LANES];
+
+    bits = 0;
+    for (j = 0; j < LANES; j++)
+    {
+        /* unused lanes repeat the first one */
+        n[j] = nn[j < num ? j : 0];
+        ninv[j] = n_preinvert_redc(n[j]);
+        one[j] = (-n[j]) % n[j];
+        mone[j] = n[j] - one[j];
+
+        d[j] = n[j] - 1;
+        count_trailing_zeros(s[j], d[j]);
+        d[j] >>= s[j];
+        bits = FLINT_MAX(bits, FLINT_BIT_COUNT(d[j]));
+
+        am[j] = a % n[j];
+        skip[j] = (am[j] == 0);
+        if (a != 2UL)
+            am[j] = n_ll_mod_preinv(am[j], 0, n[j], n_preinvert_limb(n[j]));
+
+        x[j] = one[j];
+    }
+
+    if (a == 2UL)
+    {
+        /* multiplication by the base is a doubling */
+        for (b = bits - 1; b >= 0; b--)
+        {
+            for (j = 0; j < LANES; j++)
+            {
+                x[j] = n_mulredc(x[j], x[j], n[j], ninv[j]);
+                t = n_addmod(x[j], x[j], n[j]);
+                x[j] = ((d[j] >> b) & 1) ? t : x[j];
+            }
+        }
+    }
+    else
+    {
+        for (b = bits - 1; b >= 0; b--)
+        {
+            for (j = 0; j < LANES; j++)
+            {
+                x[j] = n_mulredc(x[j], x[j], n[j], ninv[j]);
+                t = n_mulredc(x[j], am[j], n[j], ninv[j]);
+                x[j] = ((d[j] >> b) & 1) ? t : x[j];
+            }
+        }
+    }
+
+    for (j = 0; j < num; j++)
+    {
+        if (skip[j] || x[j] == one[j] || x[j] == mone[j])
+            continue;
+
+        for (i = 1; i < s[j]; i++)
+        {
+            x[j] = n_mulredc(x[j], x[j], n[j], ninv[j]);
+            if (x[j] == mone[j] || x[j] == one[j])
+                break;
+        }
+
+        if (i == s[j] || x[j] != mone[j])
+            res[j] = 0;
+    }
+}
+
+/*
+    Runs the strong probable prime test to each of the given bases on
+    the entries of vec with indices in idx, and clears the entries
+    of res for the composites found.
+*/
+static void
+_n_sprp_vec(int * res, mp_srcptr vec, long * idx, long num,
+                                    const mp_limb_t * bases, int num_bases)
+{
+    mp_limb_t n[LANES];
+    int r[LANES];
+    long i, j, k, len;
+    int b;
+
+    for (b = 0; b < num_bases; b++)
+    {
+        for (i = 0; i < num; i += LANES)
+        {
+            len = FLINT_MIN(LANES, num - i);
+
+            for (j = 0; j < len; j++)
+            {
+                n[j] = vec[idx[i + j]];
+                r[j] = 1;
+            }
+
+            _n_sprp_lanes(r, n, len, bases[b]);
+
+            for (j = 0; j < len; j++)
+                res[idx[i + j]] = r[j];
+        }
+
+        /* only the probable primes go on to the next base */
+        for (i = k = 0; i < num; i++)
+            if (res[idx[i]])
+                idx[k++] = idx[i];
+        num = k;
+    }
+}
+
+/*
+    These sets of bases give a correct primality test for all odd
+    n < 4759123141 (Jaeschke) and for all odd n < 2^64 (Sinclair).
+*/
+static const mp_limb_t _n_is_prime_bases_small[] = { 2, 7, 61 };
+
+#if FLINT64
+static const mp_limb_t _n_is_prime_bases_large[] =
+    { 2, 325, 9375, 28178, 450775, 9780504, 1795265022 };
+#endif
+
+static void
+_n_is_prime_vec(int * res, mp_srcptr vec, long len)
+{
+    mp_limb_t pinv[N_IS_PRIME_VEC_TRIAL_PRIMES + 1];
+    mp_limb_t plim[N_IS_PRIME_VEC_TRIAL_PRIMES + 1];
+    mp_limb_t n, p;
+    long * small, * large;
+    long i, k, num_small, num_large;
+
+    /* n is divisible by the odd prime p iff n p^(-1) mod B <= (B - 1) / p */
+    for (k = 1; k <= N_IS_PRIME_VEC_TRIAL_PRIMES; k++)
+    {
+        p = flint_primes_small[k];
+        pinv[k] = n_preinvert_redc(p);
+        plim[k] = (~0UL) / p;
+    }
+
+    small = malloc(sizeof(long) * len);
+    large = malloc(sizeof(long) * len);
+    num_small = num_large = 0;
+
+    for (i = 0; i < len; i++)
+    {
+        n = vec[i];
+
+        if (n < 2UL || (n & 1UL) == 0)
+        {
+            res[i] = (n == 2UL);
+            continue;
+        }
+
+        for (k = 1; k <= N_IS_PRIME_VEC_TRIAL_PRIMES; k++)
+        {
+            p = flint_primes_small[k];
+
+            if (p * p > n)
+            {
+                res[i] = 1;
+                break;
+            }
+
+            if (n * pinv[k] <= plim[k])
+            {
+                res[i] = (n == p);
+                break;
+            }
+        }
+
+        if (k <= N_IS_PRIME_VEC_TRIAL_PRIMES)
+            continue;
+
+        res[i] = 1;
+
+#if FLINT64
+        if (n >= 4759123141UL)
+            large[num_large++] = i;
+        else
+#endif
+            small[num_small++] = i;
+    }
+
+    _n_sprp_vec(res, vec, small, num_small, _n_is_prime_bases_small, 3);
+#if FLINT64
+    _n_sprp_vec(res, vec, large, num_large, _n_is_prime_bases_large, 7);
+#endif
+
+    free(small);
+    free(large);
+}
+
+typedef struct
+{
+    int * res;
+    mp_srcptr vec;
+    long len;
+}
+_is_prime_vec_struct;
+
+static void
+_is_prime_vec_worker(void * arg, long i)
+{
+    _is_prime_vec_struct * s = (_is_prime_vec_struct *) arg;
+    long start = i * N_VEC_BLOCK;
+
+    _n_is_prime_vec(s->res + start, s->vec + start,
+                                FLINT_MIN(N_VEC_BLOCK, s->len - start));
+}
+
+void
+n_is_prime_vec(int * res, mp_srcptr vec, long len)
+{
+    _is_prime_vec_struct s;
+    long i, num_blocks;
+    int num_threads;
+
+    num_blocks = (len + N_VEC_BLOCK - 1) / N_VEC_BLOCK;
+    num_threads = flint_get_num_threads();
+
+    s.res = res;
+    s.vec = vec;
+    s.len = len;
+
+    if (num_threads > 1 && num_blocks > 1)
+    {
+        flint_parallel_do(_is_prime_vec_worker, &s, num_blocks, num_threads);
+    }
+    else
+    {
+        for (i = 0; i < num_blocks; i++)
+            _is_prime_vec_worker(&s, i);
+    }
+}
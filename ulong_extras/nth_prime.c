@@ -25,19 +25,98 @@
 
 #include <stdlib.h>
 #include <stdio.h>
+#include <math.h>
 #include "flint.h"
 #include "ulong_extras.h"
 
 mp_limb_t n_nth_prime(ulong n)
 {
+    mp_limb_t x, f, lo, hi, lim, * base;
+    unsigned char * sieve;
+    double ln, lnln, t;
+    ulong count;
+    long num;
+
     if (n == 0)
     {
         printf("exception: n_nth_prime(0) is undefined");
         abort();
     }
 
-    if (n > flint_num_primes)
-        n_compute_primes(n+1);
+    if (n <= N_NTH_PRIME_TABLE_CUTOFF)
+    {
+        if (n > flint_num_primes)
+            n_compute_primes(n+1);
+
+        return flint_primes[n-1];
+    }
+
+    /* Cipolla's asymptotic expansion */
+    ln = log((double) n);
+    lnln = log(ln);
+    t = n * (ln + lnln - 1.0 + (lnln - 2.0) / ln);
+    x = (t >= (double) ULONG_MAX_PRIME) ? ULONG_MAX_PRIME : (mp_limb_t) t;
+    x |= 1UL;
+
+    count = n_prime_pi(x);
+
+    sieve = malloc(N_SIEVE_PRIMES_BLOCK);
+
+    if (count >= n)
+    {
+        /* find the (count - n + 1)-th prime counting down from x */
+        base = n_sieve_primes(&num, n_sqrt(x));
+        count = count - n + 1;
+
+        for (hi = x; ; hi = lo)
+        {
+            lo = hi - FLINT_MIN(N_SIEVE_PRIMES_BLOCK, hi);
+            _n_sieve_odd_range(sieve, lo, hi, base + 1, num - 1);
+            f = (lo + 1) | 1UL;
+
+            /* hi is odd */
+            for (x = hi; x > lo; x -= 2)
+                if (sieve[(x - f) / 2] && --count == 0)
+                    goto done;
+        }
+    }
+    else
+    {
+        count = n - count;
+        lim = x + x / 8;
+        lim = (lim < x) ? ~0UL : lim;
+        base = n_sieve_primes(&num, n_sqrt(lim));
+
+        for (lo = x; ; lo = hi)
+        {
+            if (lo >= ULONG_MAX_PRIME)
+            {
+                printf("Exception: n_nth_prime(%lu) does not fit in a limb\n",
+                                                                        n);
+                abort();
+            }
+
+            hi = lo + FLINT_MIN(N_SIEVE_PRIMES_BLOCK, ~0UL - lo);
+
+            if (hi > lim)
+            {
+                lim = (hi + hi / 8 < hi) ? ~0UL : hi + hi / 8;
+                free(base);
+                base = n_sieve_primes(&num, n_sqrt(lim));
+            }
+
+            _n_sieve_odd_range(sieve, lo, hi, base + 1, num - 1);
+
+            /* lo is odd, so the odd integers are lo + 2, lo + 4, ... */
+            for (x = lo + 2; x <= hi && x > lo; x += 2)
+                if (sieve[(x - lo - 2) / 2] && --count == 0)
+                    goto done;
+        }
+    }
+
+done:
+    free(base);
+    free(sieve);
 
-    return flint_primes[n-1];
+    return x;
 }
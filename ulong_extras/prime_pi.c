@@ -49,6 +49,9 @@ ulong n_prime_pi(mp_limb_t n)
         return FLINT_PRIME_PI_ODD_LOOKUP[(n-1)/2];
     }
 
+    if (n >= N_PRIME_PI_LMO_CUTOFF)
+        return n_prime_pi_lmo(n);
+
     n_prime_pi_bounds(&low, &high, n);
     n_compute_primes(high+1);
 
@@ -0,0 +1,386 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <math.h>
+#include <mpir.h>
+#include "flint.h"
+#include "ulong_extras.h"
+
+/*
+    We use the algorithm of Lagarias, Miller and Odlyzko. With
+    y >= x^(1/3) and a = pi(y),
+
+        pi(x) = phi(x, a) + a - 1 - P2(x, a),
+
+    where phi(x, a) counts the integers up to x with no prime factor
+    among the first a primes and P2(x, a) counts the integers up to x
+    with exactly two such prime factors. Writing p_b for the b-th prime,
+
+        phi(x, a) = S1 + S2,
+        S1 = sum_{n <= y} mu(n) phi(x / n, c),
+        S2 = - sum_{c < b < a} sum mu(m) phi(x / (p_b m), b - 1),
+
+    where the inner sum in S2 is over m <= y with m p_b > y and all prime
+    factors of m larger than p_b. The values of phi needed for S2 lie
+    below z = x / y; they are obtained from a segmented sieve of [1, z],
+    in which the multiples of p_1, p_2, ... are removed in turn and a
+    binary indexed tree counts the integers left in the segment.
+    When all primes up to y have been removed, only 1 and the primes
+    in (y, z] remain, which gives the values pi(x / p) for P2.
+
+    The interval [1, z] is split into one chunk for each thread. Each
+    chunk counts relative to its start, and the counts of the earlier
+    chunks are added afterwards.
+
+    All sums are computed modulo 2^FLINT_BITS, which is harmless since
+    the final result fits in a limb.
+*/
+
+/* Number of primes in the tables of phi(x, c) */
+#define PHI_C 6
+
+typedef struct
+{
+    mp_limb_t x;
+    mp_limb_t y;
+    mp_limb_t z;
+    mp_limb_t sqrtx;
+    long a;
+    long c;
+    const mp_limb_t * primes;
+    const unsigned int * lpf;
+    const signed char * mu;
+    long seg_size;
+    long num_chunks;
+    /* per chunk results */
+    mp_limb_t * S2;
+    mp_limb_t * musum;  /* num_chunks * (a + 1) */
+    mp_limb_t * count;  /* num_chunks * (a + 2) */
+    mp_limb_t * P2sum;
+    mp_limb_t * P2num;
+}
+_prime_pi_struct;
+
+static mp_limb_t
+_n_cbrt(mp_limb_t x)
+{
+    mp_limb_t r = (mp_limb_t) pow((double) x, 1.0 / 3.0);
+
+    while (r > 0 && (r > 2642245UL || r * r * r > x))
+        r--;
+    while (r < 2642245UL && (r + 1) * (r + 1) * (r + 1) <= x)
+        r++;
+
+    return r;
+}
+
+static void
+_prime_pi_worker(void * arg, long t)
+{
+    _prime_pi_struct * s = (_prime_pi_struct *) arg;
+    const mp_limb_t * primes = s->primes;
+    const mp_limb_t x = s->x;
+    mp_limb_t y = s->y;
+    long a = s->a;
+    unsigned char * sieve, * psieve;
+    int * tree;
+    mp_limb_t * phi, * musum;
+    mp_limb_t chunk_lo, chunk_hi, low, high, p, m, min_m, max_m;
+    mp_limb_t qlo, qhi, xn, j, S2, P2sum, P2num, before, v, q, f;
+    long b, i, k, size, count, psize, pos, cnt;
+
+    chunk_lo = 1 + ((s->z) * (mp_limb_t) t) / s->num_chunks;
+    chunk_hi = 1 + ((s->z) * (mp_limb_t) (t + 1)) / s->num_chunks;
+
+    sieve = malloc(s->seg_size);
+    tree = malloc(sizeof(int) * s->seg_size);
+    psieve = NULL;
+    psize = 0;
+
+    phi = s->count + t * (a + 2);
+    musum = s->musum + t * (a + 1);
+    for (b = 0; b <= a + 1; b++)
+        phi[b] = 0;
+    for (b = 0; b <= a; b++)
+        musum[b] = 0;
+
+    S2 = P2sum = P2num = 0;
+    before = 0;   /* integers left in the earlier segments of the chunk */
+
+    for (low = chunk_lo; low < chunk_hi; low += s->seg_size)
+    {
+        high = FLINT_MIN(low + s->seg_size, chunk_hi);
+        size = high - low;
+
+        memset(sieve, 1, size);
+        for (i = 0; i < size; i++)
+            tree[i] = 1;
+        for (i = 0; i < size; i++)
+        {
+            k = i | (i + 1);
+            if (k < size)
+                tree[k] += tree[i];
+        }
+        count = size;
+
+        for (b = 1; b <= a; b++)
+        {
+            p = primes[b - 1];
+
+            /* special leaves x / (p m) in [low, high) */
+            if (b > s->c && b < a)
+            {
+                min_m = FLINT_MAX(x / p / high, y / p);
+                max_m = FLINT_MIN(x / p / low, y);
+
+                for (m = max_m; m > min_m && m > p; m--)
+                {
+                    if (s->mu[m] == 0 || s->lpf[m] <= p)
+                        continue;
+
+                    xn = x / p / m;
+
+                    /* integers left in [low, xn] */
+                    cnt = 0;
+                    for (i = xn - low; i >= 0; i = (i & (i + 1)) - 1)
+                        cnt += tree[i];
+
+                    if (s->mu[m] > 0)
+                    {
+                        S2 -= phi[b] + cnt;
+                        musum[b]++;
+                    }
+                    else
+                    {
+                        S2 += phi[b] + cnt;
+                        musum[b]--;
+                    }
+                }
+            }
+
+            phi[b] += count;
+
+            /* remove the multiples of p */
+            for (j = ((low + p - 1) / p) * p; j < high; j += p)
+            {
+                if (sieve[j - low])
+                {
+                    sieve[j - low] = 0;
+                    count--;
+                    for (i = j - low; i < size; i |= (i + 1))
+                        tree[i]--;
+                }
+            }
+        }
+
+        phi[a + 1] += count;
+
+        /*
+            Now only 1 and primes larger than y are left. The primes
+            p in (y, sqrt(x)] with x / p in [low, high) are those in
+            (x / high, x / low].
+        */
+        qlo = FLINT_MAX(y, x / high);
+        qhi = FLINT_MIN(s->sqrtx, x / low);
+
+        if (qhi > qlo)
+        {
+            if (qhi - qlo > psize)
+            {
+                psize = qhi - qlo;
+                psieve = realloc(psieve, psize);
+            }
+
+            _n_sieve_odd_range(psieve, qlo, qhi, primes + 1, a - 1);
+            f = (qlo + 1) | 1UL;
+
+            /* x / q increases as q decreases */
+            pos = 0;
+            cnt = 0;
+            for (q = qhi; q > qlo; q--)
+            {
+                if (q % 2 == 0 || !psieve[(q - f) / 2])
+                    continue;
+
+                v = x / q;
+                while (pos <= (long) (v - low))
+                    cnt += sieve[pos++];
+
+                P2sum += before + cnt;
+                P2num++;
+            }
+        }
+
+        before += count;
+    }
+
+    s->S2[t] = S2;
+    s->P2sum[t] = P2sum;
+    s->P2num[t] = P2num;
+
+    free(sieve);
+    free(tree);
+    free(psieve);
+}
+
+ulong n_prime_pi_lmo(mp_limb_t x)
+{
+    _prime_pi_struct s;
+    mp_limb_t * primes, * before;
+    unsigned int * lpf;
+    signed char * mu;
+    int * table;
+    mp_limb_t y, n, p, j, S1, S2, P2, K, P, phiP, res;
+    long a, b, c, num_threads, t, i;
+    double alpha;
+
+    if (x < 1000UL)
+    {
+        primes = n_sieve_primes(&a, x);
+        free(primes);
+        return a;
+    }
+
+    /* y = alpha x^(1/3), and we need y^3 >= x */
+    alpha = FLINT_MAX(1.0, log((double) x) / 8.0);
+    y = _n_cbrt(x);
+    if (y * y * y < x)
+        y++;
+    y = (mp_limb_t) (y * alpha);
+    y = FLINT_MIN(y, n_sqrt(x));
+
+    primes = n_sieve_primes(&a, y);
+    c = FLINT_MIN(a, PHI_C);
+
+    /* least prime factors and Moebius function up to y */
+    lpf = malloc(sizeof(unsigned int) * (y + 1));
+    mu = malloc(y + 1);
+    for (n = 0; n <= y; n++)
+    {
+        lpf[n] = 0;
+        mu[n] = 1;
+    }
+    lpf[1] = UINT_MAX;
+
+    for (b = a - 1; b >= 0; b--)
+    {
+        p = primes[b];
+        for (j = p; j <= y; j += p)
+        {
+            lpf[j] = p;
+            mu[j] = -mu[j];
+        }
+        for (j = p * p; j <= y; j += p * p)
+            mu[j] = 0;
+    }
+
+    /* phi(v, c) = (v / P) phi(P) + table[v mod P] with P = p_1 ... p_c */
+    P = 1;
+    for (b = 0; b < c; b++)
+        P *= primes[b];
+    table = malloc(sizeof(int) * P);
+    for (n = 0, i = 0; n < P; n++)
+    {
+        for (b = 0; b < c; b++)
+            if (n % primes[b] == 0)
+                break;
+        i += (b == c);
+        table[n] = i;
+    }
+    phiP = table[P - 1];
+
+    S1 = 0;
+    for (n = 1; n <= y; n++)
+    {
+        if (mu[n] == 0 || (c > 0 && lpf[n] <= primes[c - 1]))
+            continue;
+
+        j = x / n;
+        j = (j / P) * phiP + table[j % P];
+
+        if (mu[n] > 0)
+            S1 += j;
+        else
+            S1 -= j;
+    }
+
+    num_threads = flint_get_num_threads();
+
+    s.x = x;
+    s.y = y;
+    s.z = x / y;
+    s.sqrtx = n_sqrt(x);
+    s.a = a;
+    s.c = c;
+    s.primes = primes;
+    s.lpf = lpf;
+    s.mu = mu;
+    s.seg_size = FLINT_MAX(N_PRIME_PI_SEGMENT, 2 * n_sqrt(s.z));
+    s.num_chunks = FLINT_MAX(1, FLINT_MIN(num_threads,
+                                            s.z / s.seg_size));
+    s.S2 = malloc(sizeof(mp_limb_t) * s.num_chunks);
+    s.P2sum = malloc(sizeof(mp_limb_t) * s.num_chunks);
+    s.P2num = malloc(sizeof(mp_limb_t) * s.num_chunks);
+    s.musum = malloc(sizeof(mp_limb_t) * s.num_chunks * (a + 1));
+    s.count = malloc(sizeof(mp_limb_t) * s.num_chunks * (a + 2));
+
+    if (s.num_chunks > 1)
+        flint_parallel_do(_prime_pi_worker, &s, s.num_chunks, num_threads);
+    else
+        _prime_pi_worker(&s, 0);
+
+    /* add the counts of the earlier chunks */
+    before = calloc(a + 2, sizeof(mp_limb_t));
+    S2 = P2 = K = 0;
+    for (t = 0; t < s.num_chunks; t++)
+    {
+        S2 += s.S2[t];
+        for (b = 1; b <= a; b++)
+            S2 -= s.musum[t * (a + 1) + b] * before[b];
+
+        P2 += s.P2sum[t] + s.P2num[t] * before[a + 1];
+        K += s.P2num[t];
+
+        for (b = 1; b <= a + 1; b++)
+            before[b] += s.count[t * (a + 2) + b];
+    }
+
+    /* the P2 primes have pi(p) = a + 1, ..., a + K, and pi(x / p) is
+       a - 1 plus the number of integers left up to x / p */
+    P2 = P2 - K * (K + 1) / 2;
+
+    res = S1 + S2 + a - 1 - P2;
+
+    free(before);
+    free(s.S2);
+    free(s.P2sum);
+    free(s.P2num);
+    free(s.musum);
+    free(s.count);
+    free(table);
+    free(lpf);
+    free(mu);
+    free(primes);
+
+    return res;
+}
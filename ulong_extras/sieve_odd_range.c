@@ -0,0 +1,64 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+
+#include <string.h>
+#include <mpir.h>
+#include "flint.h"
+#include "ulong_extras.h"
+
+void _n_sieve_odd_range(unsigned char * sieve, mp_limb_t lo, mp_limb_t hi,
+                                        const mp_limb_t * primes, long num)
+{
+    mp_limb_t f, p, start, j, last;
+    long i;
+
+    /* entry k represents f + 2k, with f the first odd integer above lo */
+    f = (lo + 1) | 1UL;
+    if (hi <= lo || f > hi)
+        return;
+
+    last = (hi - f) / 2;
+    memset(sieve, 1, last + 1);
+
+    /* written to avoid overflow near 2^FLINT_BITS */
+    for (i = 0; i < num; i++)
+    {
+        p = primes[i];
+
+        if (p > hi / p)
+            break;
+
+        if (lo / p + 1 > hi / p)
+            continue;
+
+        /* first odd multiple of p above lo, at least p^2 */
+        start = FLINT_MAX(lo / p + 1, p) * p;
+        if (start % 2 == 0)
+        {
+            if (hi - start < p)
+                continue;
+            start += p;
+        }
+
+        for (j = (start - f) / 2; j <= last; j += p)
+            sieve[j] = 0;
+    }
+}
@@ -0,0 +1,95 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+
+#include <stdlib.h>
+#include <string.h>
+#include <mpir.h>
+#include "flint.h"
+#include "ulong_extras.h"
+
+#define SIEVE_PUSH(x)                                                 \
+    do {                                                              \
+        if (len == alloc)                                             \
+        {                                                             \
+            alloc *= 2;                                               \
+            primes = realloc(primes, alloc * sizeof(mp_limb_t));      \
+        }                                                             \
+        primes[len++] = (x);                                          \
+    } while (0)
+
+mp_limb_t * n_sieve_primes(long * num, mp_limb_t n)
+{
+    mp_limb_t * primes, * small;
+    unsigned char * sieve;
+    long alloc, len, num_small;
+    mp_limb_t i, j, lo, hi, r;
+
+    alloc = 64;
+    len = 0;
+    primes = malloc(alloc * sizeof(mp_limb_t));
+
+    if (n < 2)
+    {
+        *num = 0;
+        return primes;
+    }
+
+    SIEVE_PUSH(2UL);
+
+    if (n < 3)
+    {
+        *num = len;
+        return primes;
+    }
+
+    /* The entry i of the sieve represents 2i + 1 */
+    r = n_sqrt(n);
+    sieve = malloc(FLINT_MAX(r / 2 + 1, N_SIEVE_PRIMES_BLOCK));
+    memset(sieve, 1, r / 2 + 1);
+
+    for (i = 1; (2*i + 1) * (2*i + 1) <= r; i++)
+        if (sieve[i])
+            for (j = (2*i + 1) * (2*i + 1) / 2; j <= r / 2; j += 2*i + 1)
+                sieve[j] = 0;
+
+    small = malloc((r / 2 + 1) * sizeof(mp_limb_t));
+    num_small = 0;
+    for (i = 1; 2*i + 1 <= r; i++)
+        if (sieve[i])
+            small[num_small++] = 2*i + 1;
+
+    /* Sieve the odd integers 2i + 1 <= n in segments */
+    for (lo = 1; lo <= (n - 1) / 2; lo = hi)
+    {
+        hi = FLINT_MIN(lo + N_SIEVE_PRIMES_BLOCK, (n - 1) / 2 + 1);
+        _n_sieve_odd_range(sieve, 2*lo, 2*hi - 1, small, num_small);
+
+        for (i = lo; i < hi; i++)
+            if (sieve[i - lo])
+                SIEVE_PUSH(2*i + 1);
+    }
+
+    free(sieve);
+    free(small);
+
+    *num = len;
+    return primes;
+}
@@ -0,0 +1,76 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "ulong_extras.h"
+
+int main(void)
+{
+    mp_limb_t n, p, q, f;
+    long i, bits;
+    flint_rand_t state;
+
+    printf("factor_pollard_brent....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (i = 0; i < 2000; i++)
+    {
+        bits = 2 + n_randint(state, FLINT_BITS / 2 - 1);
+        p = n_randprime(state, bits, 0);
+        q = n_randprime(state, bits, 0);
+
+        if (p == 2UL || q == 2UL)
+            continue;
+
+        n = p * q;
+        if (n_randint(state, 4) == 0 && n < (1UL << (FLINT_BITS / 2)))
+            n *= p;
+
+        if (!n_factor_pollard_brent(&f, state, n,
+                FLINT_FACTOR_POLLARD_BRENT_TRIES,
+                FLINT_FACTOR_POLLARD_BRENT_ITERS))
+        {
+            /* rho cannot split p^2 if it never separates the two
+               copies of p, so only distinct primes must succeed */
+            if (p != q)
+            {
+                printf("FAIL (no factor found):\n");
+                printf("n = %lu = %lu * %lu\n", n, p, q);
+                abort();
+            }
+        }
+        else if (f <= 1UL || f >= n || n % f != 0UL)
+        {
+            printf("FAIL:\n");
+            printf("n = %lu, f = %lu\n", n, f);
+            abort();
+        }
+    }
+
+    flint_randclear(state);
+
+    printf("PASS\n");
+    return 0;
+}
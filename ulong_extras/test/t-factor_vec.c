@@ -0,0 +1,123 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "ulong_extras.h"
+
+int main(void)
+{
+    mp_limb_t * vec, n, p, q;
+    n_factor_t * factors, fac;
+    long i, j, k, l, len;
+    flint_rand_t state;
+
+    printf("factor_vec....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (i = 0; i < 30; i++)
+    {
+        len = n_randint(state, 3000);
+
+        vec = malloc(sizeof(mp_limb_t) * (len + 1));
+        factors = malloc(sizeof(n_factor_t) * (len + 1));
+
+        for (j = 0; j < len; j++)
+        {
+            switch (n_randint(state, 4))
+            {
+                case 0:
+                    vec[j] = n_randtest(state);
+                    break;
+                case 1:
+                    p = n_randprime(state, 2 + n_randint(state,
+                                                    FLINT_BITS / 2 - 1), 0);
+                    q = n_randprime(state, 2 + n_randint(state,
+                                                    FLINT_BITS / 2 - 1), 0);
+                    vec[j] = p * q;
+                    break;
+                case 2:
+                    /* powers of primes beyond the trial division bound */
+                    p = n_randprime(state, 11 + n_randint(state,
+                                                    FLINT_BITS / 2 - 11), 0);
+                    vec[j] = p * p;
+                    if (p < (1UL << (FLINT_BITS / 3)))
+                        vec[j] *= p;
+                    break;
+                default:
+                    vec[j] = n_randlimb(state);
+            }
+        }
+
+        flint_set_num_threads(1 + n_randint(state, 3));
+        n_factor_vec(factors, vec, len);
+        flint_set_num_threads(1);
+
+        for (j = 0; j < len; j++)
+        {
+            n = 1UL;
+            for (k = 0; k < factors[j].num; k++)
+            {
+                n *= n_pow(factors[j].p[k], factors[j].exp[k]);
+
+                if (!n_is_prime(factors[j].p[k]))
+                {
+                    printf("FAIL (composite factor):\n");
+                    printf("n = %lu, p = %lu\n", vec[j], factors[j].p[k]);
+                    abort();
+                }
+
+                for (l = 0; l < k; l++)
+                {
+                    if (factors[j].p[l] == factors[j].p[k])
+                    {
+                        printf("FAIL (repeated factor):\n");
+                        printf("n = %lu, p = %lu\n", vec[j], factors[j].p[k]);
+                        abort();
+                    }
+                }
+            }
+
+            n_factor_init(&fac);
+            if (vec[j] != 0UL)
+                n_factor(&fac, vec[j], 1);
+
+            if ((vec[j] > 1UL && n != vec[j]) || fac.num != factors[j].num)
+            {
+                printf("FAIL:\n");
+                printf("n = %lu, product = %lu, num = %d, %d\n",
+                                    vec[j], n, factors[j].num, fac.num);
+                abort();
+            }
+        }
+
+        free(vec);
+        free(factors);
+    }
+
+    flint_randclear(state);
+
+    printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,102 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "ulong_extras.h"
+
+int main(void)
+{
+    /* strong pseudoprimes to several small bases */
+    const mp_limb_t spsp[] = { 2047UL, 1373653UL, 25326001UL, 3215031751UL,
+#if FLINT64
+        2152302898747UL, 3474749660383UL, 341550071728321UL,
+        3825123056546413051UL,
+#endif
+        0UL };
+    mp_limb_t * vec, p, q;
+    int * res;
+    long i, j, len;
+    flint_rand_t state;
+
+    printf("is_prime_vec....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (i = 0; i < 300; i++)
+    {
+        len = n_randint(state, 3000);
+
+        vec = malloc(sizeof(mp_limb_t) * (len + 1));
+        res = malloc(sizeof(int) * (len + 1));
+
+        for (j = 0; j < len; j++)
+        {
+            switch (n_randint(state, 5))
+            {
+                case 0:
+                    vec[j] = n_randtest(state);
+                    break;
+                case 1:
+                    vec[j] = n_randtest_prime(state, 0);
+                    break;
+                case 2:
+                    /* products of two primes of about the same size */
+                    p = n_randprime(state, 2 + n_randint(state,
+                                                    FLINT_BITS / 2 - 1), 0);
+                    q = n_randprime(state, 2 + n_randint(state,
+                                                    FLINT_BITS / 2 - 1), 0);
+                    vec[j] = p * q;
+                    break;
+                case 3:
+                    vec[j] = spsp[n_randint(state,
+                                            sizeof(spsp) / sizeof(mp_limb_t))];
+                    break;
+                default:
+                    vec[j] = n_randint(state, 5000);
+            }
+        }
+
+        flint_set_num_threads(1 + n_randint(state, 3));
+        n_is_prime_vec(res, vec, len);
+        flint_set_num_threads(1);
+
+        for (j = 0; j < len; j++)
+        {
+            if (res[j] != n_is_prime(vec[j]))
+            {
+                printf("FAIL:\n");
+                printf("n = %lu, res = %d\n", vec[j], res[j]);
+                abort();
+            }
+        }
+
+        free(vec);
+        free(res);
+    }
+
+    flint_randclear(state);
+
+    printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,79 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "ulong_extras.h"
+
+int main(void)
+{
+    /* the (10^k)-th primes */
+    const mp_limb_t p10[] = { 29UL, 541UL, 7919UL, 104729UL, 1299709UL,
+        15485863UL, 179424673UL, 2038074743UL,
+#if FLINT64
+        22801763489UL, 252097800623UL
+#endif
+    };
+    mp_limb_t * primes;
+    ulong n;
+    long i, num;
+    flint_rand_t state;
+
+    printf("nth_prime....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    n = 1UL;
+    for (i = 0; i < sizeof(p10) / sizeof(mp_limb_t); i++)
+    {
+        n *= 10;
+
+        if (n_nth_prime(n) != p10[i])
+        {
+            printf("FAIL:\n");
+            printf("p_%lu = %lu\n", n, n_nth_prime(n));
+            abort();
+        }
+    }
+
+    primes = n_sieve_primes(&num, 1UL << 25);
+
+    for (i = 0; i < 1000; i++)
+    {
+        n = 1 + n_randint(state, num);
+
+        if (n_nth_prime(n) != primes[n - 1])
+        {
+            printf("FAIL:\n");
+            printf("p_%lu = %lu, got %lu\n", n, primes[n - 1], n_nth_prime(n));
+            abort();
+        }
+    }
+
+    free(primes);
+
+    flint_randclear(state);
+
+    printf("PASS\n");
+    return 0;
+}
@@ -55,6 +55,54 @@ int main(void)
         }
     }
 
+    /* Large arguments, using the combinatorial algorithm */
+    {
+        const mp_limb_t pi10[] = { 4UL, 25UL, 168UL, 1229UL, 9592UL, 78498UL,
+            664579UL, 5761455UL, 50847534UL,
+#if FLINT64
+            455052511UL, 4118054813UL, 37607912018UL
+#endif
+        };
+        mp_limb_t x, * primes;
+        long i, num;
+        flint_rand_t state;
+
+        flint_randinit(state);
+
+        x = 1UL;
+        for (i = 0; i < sizeof(pi10) / sizeof(mp_limb_t); i++)
+        {
+            x *= 10;
+            flint_set_num_threads(1 + n_randint(state, 4));
+
+            if (n_prime_pi(x) != pi10[i])
+            {
+                printf("FAIL:\n");
+                printf("pi(%lu) = %lu\n", x, n_prime_pi(x));
+                abort();
+            }
+        }
+
+        flint_set_num_threads(1);
+
+        for (i = 0; i < 100; i++)
+        {
+            x = n_randint(state, 1UL << (10 + n_randint(state, 16)));
+            primes = n_sieve_primes(&num, x);
+
+            if (n_prime_pi_lmo(x) != num)
+            {
+                printf("FAIL:\n");
+                printf("pi(%lu) = %ld, got %lu\n", x, num, n_prime_pi_lmo(x));
+                abort();
+            }
+
+            free(primes);
+        }
+
+        flint_randclear(state);
+    }
+
     printf("PASS\n");
     return 0;
 }
@@ -0,0 +1,90 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "ulong_extras.h"
+
+int main(void)
+{
+    long i, k, num;
+    mp_limb_t lo, hi, f, n, * primes;
+    unsigned char * sieve;
+    int expected;
+    flint_rand_t state;
+
+    printf("sieve_odd_range....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    /* odd primes up to 10^5 */
+    primes = n_sieve_primes(&num, 100000UL);
+    sieve = malloc(1000);
+
+    for (i = 0; i < 3000; i++)
+    {
+        /* small ranges, ranges below 10^9 and ranges at the top */
+        if (i < 1000)
+            lo = n_randint(state, 2000);
+        else if (i < 2000)
+            lo = n_randint(state, 1000000000UL);
+        else
+            lo = -n_randint(state, 10000) - 1;
+
+        hi = lo + n_randint(state, FLINT_MIN(2000, ~0UL - lo) + 1);
+
+        _n_sieve_odd_range(sieve, lo, hi, primes + 1, num - 1);
+
+        f = (lo + 1) | 1UL;
+        for (n = f, k = 0; n <= hi && n > lo; n += 2, k++)
+        {
+            /* n is removed iff it is composite with a listed factor */
+            if (n < 1000000000UL)
+                expected = (n == 1 || n_is_prime(n));
+            else
+            {
+                long j;
+
+                expected = 1;
+                for (j = 1; j < num && expected; j++)
+                    expected = (n % primes[j] != 0);
+            }
+
+            if (sieve[k] != expected)
+            {
+                printf("FAIL:\n");
+                printf("lo = %lu, hi = %lu, n = %lu, sieve = %d\n",
+                    lo, hi, n, sieve[k]);
+                abort();
+            }
+        }
+    }
+
+    free(sieve);
+    free(primes);
+    flint_randclear(state);
+
+    printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,77 @@
+/*=============================================================================
+
+    This file is part of FLINT.
+
+    FLINT is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    FLINT is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FLINT; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+=============================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpir.h>
+#include "flint.h"
+#include "ulong_extras.h"
+
+int main(void)
+{
+    long i, j, num;
+    mp_limb_t n, p, * primes;
+    flint_rand_t state;
+
+    printf("sieve_primes....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (i = 0; i < 200; i++)
+    {
+        if (i < 100)
+            n = i;
+        else if (i < 190)
+            n = n_randint(state, 100000);
+        else
+            n = n_randint(state, 3000000);
+
+        primes = n_sieve_primes(&num, n);
+
+        p = 1;
+        for (j = 0; j < num; j++)
+        {
+            p = n_nextprime(p, 1);
+
+            if (primes[j] != p)
+            {
+                printf("FAIL:\n");
+                printf("n = %lu, j = %ld, primes[j] = %lu, p = %lu\n",
+                    n, j, primes[j], p);
+                abort();
+            }
+        }
+
+        if (n_nextprime(p, 1) <= n)
+        {
+            printf("FAIL:\n");
+            printf("n = %lu, missing primes after %lu\n", n, p);
+            abort();
+        }
+
+        free(primes);
+    }
+
+    flint_randclear(state);
+
+    printf("PASS\n");
+    return 0;
+}